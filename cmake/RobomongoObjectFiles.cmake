@@ -0,0 +1,45 @@
+# Links object files of robomongo executable, except of its main(), into
+# target (i.e. robo_unit_tests, robo_bench), so that application code is
+# built only once.
+function(link_robomongo_objects target)
+    add_dependencies(${target} robomongo)
+
+    if(NOT CMAKE_VERSION VERSION_LESS 3.15)
+        # Includes objects of moc and rcc, wherever autogen puts them
+        target_link_libraries(${target}
+            "$<FILTER:$<TARGET_OBJECTS:robomongo>,EXCLUDE,[/\\\\]main(\\.cpp)?\\.(o|obj)$>")
+        return()
+    endif()
+
+    # Older CMake: object paths are built the same way as generators do
+    get_target_property(robo_sources robomongo SOURCES)
+    list(FILTER robo_sources INCLUDE REGEX "cpp")
+    list(FILTER robo_sources EXCLUDE REGEX "main.cpp")
+
+    if(SYSTEM_WINDOWS)
+        set(obj_dir ${CMAKE_BINARY_DIR}/src/robomongo/robomongo.dir/${CMAKE_BUILD_TYPE}/)
+        set(obj_files
+            ${obj_dir}mocs_compilation.obj
+            ${obj_dir}qrc_gui.obj
+            ${obj_dir}qrc_robo.obj)
+        foreach(src_file ${robo_sources})
+            get_filename_component(file_name ${src_file} NAME)
+            string(REPLACE ".cpp" ".obj" file_name ${file_name})
+            list(APPEND obj_files ${obj_dir}${file_name})
+        endforeach()
+    else()
+        # Makefile and Ninja generators of Linux and macOS
+        set(obj_dir ${CMAKE_BINARY_DIR}/src/robomongo/CMakeFiles/robomongo.dir/)
+        set(obj_files
+            ${obj_dir}/robomongo_autogen/mocs_compilation.cpp.o
+            ${obj_dir}/robomongo_autogen/YHP5W5E6RA/qrc_gui.cpp.o
+            ${obj_dir}/robomongo_autogen/3YJK5W5UP7/qrc_robo.cpp.o)
+        foreach(src_file ${robo_sources})
+            string(REPLACE ".cpp" ".cpp.o" obj_file ${src_file})
+            list(APPEND obj_files ${obj_dir}${obj_file})
+        endforeach()
+    endif()
+
+    set_source_files_properties(${obj_files} PROPERTIES EXTERNAL_OBJECT TRUE GENERATED TRUE)
+    target_link_libraries(${target} ${obj_files})
+endfunction()
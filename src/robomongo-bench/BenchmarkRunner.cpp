@@ -0,0 +1,121 @@
+#include "robomongo-bench/BenchmarkRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "robomongo-bench/DocumentGenerators.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    volatile size_t Sink = 0;
+}
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        BenchmarkRunner::BenchmarkRunner(int repeats, const std::string &filter) :
+            _repeats(std::max(repeats, 1)),
+            _filter(filter)
+        {
+        }
+
+        void BenchmarkRunner::run(const std::string &name, const Dataset &dataset, const std::function<void()> &body)
+        {
+            if (!enabled(name, dataset.name))
+                return;
+
+            body();     // Warm-up: allocator, caches, lazy singletons
+
+            std::vector<double> times;
+            times.reserve(_repeats);
+            for (int i = 0; i < _repeats; ++i) {
+                auto const start = std::chrono::steady_clock::now();
+                body();
+                auto const end = std::chrono::steady_clock::now();
+                times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            }
+
+            record(name, dataset.name, static_cast<int>(dataset.documents.size()), dataset.bsonBytes, times);
+        }
+
+        bool BenchmarkRunner::enabled(const std::string &name, const std::string &dataset) const
+        {
+            return _filter.empty() || (name + "/" + dataset).find(_filter) != std::string::npos;
+        }
+
+        void BenchmarkRunner::record(const std::string &name, const std::string &dataset, int documents,
+                                     long long bsonBytes, std::vector<double> times)
+        {
+            if (times.empty() || !enabled(name, dataset))
+                return;
+
+            std::sort(times.begin(), times.end());
+            BenchmarkResult result;
+            result.name = name;
+            result.dataset = dataset;
+            result.documents = documents;
+            result.bsonBytes = bsonBytes;
+            result.repeats = static_cast<int>(times.size());
+            result.minMs = times.front();
+            result.medianMs = times[times.size() / 2];
+            _results.push_back(result);
+
+            // Progress for humans, JSON goes to stdout
+            std::fprintf(stderr, "%-48s %10.2f ms  (min %.2f ms)\n", result.id().c_str(),
+                         result.medianMs, result.minMs);
+        }
+
+        QJsonDocument BenchmarkRunner::toJson() const
+        {
+            QJsonArray benchmarks;
+            for (auto const &result : _results) {
+                double const seconds = result.medianMs / 1000;
+                QJsonObject item;
+                item["id"] = QtUtils::toQString(result.id());
+                item["name"] = QtUtils::toQString(result.name);
+                item["dataset"] = QtUtils::toQString(result.dataset);
+                item["documents"] = result.documents;
+                item["bsonBytes"] = static_cast<double>(result.bsonBytes);
+                item["repeats"] = result.repeats;
+                item["minMs"] = result.minMs;
+                item["medianMs"] = result.medianMs;
+                item["documentsPerSec"] = seconds > 0 ? result.documents / seconds : 0;
+                item["mbPerSec"] = seconds > 0 ? result.bsonBytes / (1024.0 * 1024.0) / seconds : 0;
+                benchmarks.append(item);
+            }
+
+            QJsonObject root;
+            root["benchmarks"] = benchmarks;
+            return QJsonDocument(root);
+        }
+
+        std::vector<std::string> BenchmarkRunner::regressions(const QJsonDocument &baseline, double tolerance) const
+        {
+            QHash<QString, double> baselineMs;
+            for (auto const &value : baseline.object()["benchmarks"].toArray()) {
+                QJsonObject const item = value.toObject();
+                baselineMs.insert(item["id"].toString(), item["medianMs"].toDouble());
+            }
+
+            std::vector<std::string> slower;
+            for (auto const &result : _results) {
+                auto const it = baselineMs.constFind(QtUtils::toQString(result.id()));
+                if (it != baselineMs.constEnd() && result.medianMs > it.value() * (1 + tolerance))
+                    slower.push_back(result.id());
+            }
+            return slower;
+        }
+
+        void consume(size_t value)
+        {
+            Sink = Sink + value;
+        }
+    }
+}
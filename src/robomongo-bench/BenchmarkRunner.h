@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <QJsonDocument>
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        struct Dataset;
+
+        struct BenchmarkResult
+        {
+            std::string name;           // i.e. "jsonString"
+            std::string dataset;        // i.e. "wide"
+            int documents;
+            long long bsonBytes;
+            int repeats;
+            double minMs;
+            double medianMs;
+
+            std::string id() const { return name + "/" + dataset; }
+        };
+
+        /**
+         * @brief Times benchmarks over datasets: one warm-up run, then 'repeats'
+         *        measured runs, of which minimum and median are reported.
+         */
+        class BenchmarkRunner
+        {
+        public:
+            // Benchmarks, ids of which do not contain 'filter', are skipped
+            BenchmarkRunner(int repeats, const std::string &filter);
+
+            void run(const std::string &name, const Dataset &dataset, const std::function<void()> &body);
+
+            // False if benchmark with this name and dataset is filtered out
+            bool enabled(const std::string &name, const std::string &dataset) const;
+
+            /**
+             * @brief Adds result of times, measured by caller (i.e. one per page or per
+             *        reply of end-to-end benchmarks). Every time counts as one repeat.
+             */
+            void record(const std::string &name, const std::string &dataset, int documents,
+                        long long bsonBytes, std::vector<double> times);
+
+            int repeats() const { return _repeats; }
+
+            const std::vector<BenchmarkResult> &results() const { return _results; }
+
+            // { "benchmarks": [ { "id": "jsonString/wide", "medianMs": 12.5, ... }, ... ] }
+            QJsonDocument toJson() const;
+
+            /**
+             * @brief Ids of results with median slower than in 'baseline' (output of
+             *        toJson() of an earlier run) by more than 'tolerance' (0.1 is 10%).
+             */
+            std::vector<std::string> regressions(const QJsonDocument &baseline, double tolerance) const;
+
+        private:
+            int const _repeats;
+            std::string const _filter;
+            std::vector<BenchmarkResult> _results;
+        };
+
+        // Keeps results of benchmarked code from being optimized away
+        void consume(size_t value);
+    }
+}
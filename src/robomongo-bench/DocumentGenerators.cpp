@@ -0,0 +1,202 @@
+#include "robomongo-bench/DocumentGenerators.h"
+
+#include <mongo/db/jsobj.h>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/BsonUtils.h"
+
+namespace
+{
+    // Fixed pseudo-random sequence, documents must not differ between runs
+    class Sequence
+    {
+    public:
+        explicit Sequence(int seed) : _state(static_cast<unsigned>(seed) * 2654435761u + 1) {}
+
+        unsigned next()
+        {
+            _state = _state * 1664525u + 1013904223u;
+            return _state >> 8;
+        }
+
+    private:
+        unsigned _state;
+    };
+
+    const char *const Words[] = {
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+        "india", "juliett", "kilo", "lima", "mike", "november", "oscar", "papa"
+    };
+
+    std::string text(Sequence &sequence, int words)
+    {
+        std::string result;
+        for (int i = 0; i < words; ++i) {
+            if (i > 0)
+                result += ' ';
+            result += Words[sequence.next() % (sizeof(Words) / sizeof(Words[0]))];
+        }
+        return result;
+    }
+
+    std::string fieldName(const char *prefix, int index)
+    {
+        return prefix + std::to_string(index);
+    }
+
+    // 2019-01-01 plus up to ~3 years
+    long long millis(Sequence &sequence)
+    {
+        return 1546300800000LL + static_cast<long long>(sequence.next() % 100000000) * 1000;
+    }
+
+    void appendUuid(mongo::BSONObjBuilder &builder, const std::string &name, Sequence &sequence,
+                    mongo::BinDataType type)
+    {
+        unsigned char bytes[16];
+        for (auto &byte : bytes)
+            byte = static_cast<unsigned char>(sequence.next());
+        builder.appendBinData(name, sizeof(bytes), type, bytes);
+    }
+}
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        mongo::BSONObj wideDocument(int index, int fields)
+        {
+            Sequence sequence(index);
+            mongo::BSONObjBuilder builder;
+            builder.append("_id", mongo::OID::gen());
+            for (int i = 0; i < fields; ++i) {
+                std::string const name = fieldName("field_", i);
+                switch (i % 5) {
+                case 0: builder.append(name, static_cast<int>(sequence.next())); break;
+                case 1: builder.append(name, text(sequence, 3)); break;
+                case 2: builder.append(name, sequence.next() / 1000.0); break;
+                case 3: builder.append(name, static_cast<long long>(sequence.next()) << 20); break;
+                default: builder.append(name, sequence.next() % 2 == 0); break;
+                }
+            }
+            return builder.obj();
+        }
+
+        mongo::BSONObj deepDocument(int index, int depth)
+        {
+            Sequence sequence(index);
+            mongo::BSONObj child = BSON("leaf" << text(sequence, 2));
+            for (int level = depth; level > 0; --level) {
+                mongo::BSONObjBuilder builder;
+                builder.append("level", level);
+                builder.append("name", text(sequence, 2));
+                builder.append("value", sequence.next() / 100.0);
+                builder.append("child", child);
+                child = builder.obj();
+            }
+
+            mongo::BSONObjBuilder document;
+            document.append("_id", mongo::OID::gen());
+            document.append("root", child);
+            return document.obj();
+        }
+
+        mongo::BSONObj arrayDocument(int index, int items)
+        {
+            Sequence sequence(index);
+            mongo::BSONObjBuilder builder;
+            builder.append("_id", mongo::OID::gen());
+
+            mongo::BSONArrayBuilder numbers(builder.subarrayStart("numbers"));
+            for (int i = 0; i < items; ++i)
+                numbers.append(static_cast<int>(sequence.next() % 100000));
+            numbers.done();
+
+            mongo::BSONArrayBuilder tags(builder.subarrayStart("tags"));
+            for (int i = 0; i < items; ++i)
+                tags.append(text(sequence, 1));
+            tags.done();
+
+            mongo::BSONArrayBuilder lines(builder.subarrayStart("lines"));
+            for (int i = 0; i < items / 4; ++i) {
+                lines.append(BSON("sku" << fieldName("SKU-", sequence.next() % 10000)
+                                  << "quantity" << static_cast<int>(sequence.next() % 10)
+                                  << "price" << sequence.next() / 10000.0
+                                  << "dimensions" << BSON_ARRAY(1.5 << 2.5 << 3.5)));
+            }
+            lines.done();
+            return builder.obj();
+        }
+
+        mongo::BSONObj dateDocument(int index, int fields)
+        {
+            Sequence sequence(index);
+            mongo::BSONObjBuilder builder;
+            builder.append("_id", mongo::OID::gen());
+            for (int i = 0; i < fields; ++i) {
+                std::string const name = fieldName("date_", i);
+                if (i % 4 == 3)
+                    builder.append(name, mongo::Timestamp(static_cast<unsigned>(millis(sequence) / 1000), i));
+                else
+                    builder.appendDate(name, mongo::Date_t::fromMillisSinceEpoch(millis(sequence)));
+            }
+
+            mongo::BSONArrayBuilder history(builder.subarrayStart("history"));
+            for (int i = 0; i < fields / 4; ++i) {
+                mongo::BSONObjBuilder event;
+                event.appendDate("at", mongo::Date_t::fromMillisSinceEpoch(millis(sequence)));
+                event.append("action", text(sequence, 1));
+                history.append(event.obj());
+            }
+            history.done();
+            return builder.obj();
+        }
+
+        mongo::BSONObj uuidDocument(int index, int fields)
+        {
+            Sequence sequence(index);
+            mongo::BSONObjBuilder builder;
+            appendUuid(builder, "_id", sequence, mongo::newUUID);
+            for (int i = 0; i < fields; ++i) {
+                // Legacy UUIDs are shown according to "UUID encoding" setting
+                appendUuid(builder, fieldName("uuid_", i), sequence,
+                           i % 3 == 2 ? mongo::bdtUUID : mongo::newUUID);
+            }
+            return builder.obj();
+        }
+
+        std::vector<Dataset> makeDatasets(int documents)
+        {
+            typedef mongo::BSONObj (*Generator)(int);
+            struct Kind { const char *name; Generator generate; };
+            Kind const kinds[] = {
+                { "wide",  [](int index) { return wideDocument(index); } },
+                { "deep",  [](int index) { return deepDocument(index); } },
+                { "array", [](int index) { return arrayDocument(index); } },
+                { "date",  [](int index) { return dateDocument(index); } },
+                { "uuid",  [](int index) { return uuidDocument(index); } }
+            };
+
+            std::vector<Dataset> datasets;
+            for (auto const &kind : kinds) {
+                Dataset dataset;
+                dataset.name = kind.name;
+                dataset.bsonBytes = 0;
+
+                std::vector<MongoDocumentPtr> docs;
+                docs.reserve(documents);
+                dataset.json.reserve(documents);
+                for (int i = 0; i < documents; ++i) {
+                    mongo::BSONObj const obj = kind.generate(i);
+                    dataset.bsonBytes += obj.objsize();
+                    dataset.json.push_back(BsonUtils::jsonString(obj, mongo::TenGen, 1, DefaultEncoding, Utc));
+                    docs.push_back(MongoDocument::fromBsonObj(obj));
+                }
+
+                dataset.documents = MongoDocumentList(std::move(docs));
+                datasets.push_back(std::move(dataset));
+            }
+            return datasets;
+        }
+    }
+}
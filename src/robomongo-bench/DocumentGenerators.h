@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/domain/MongoDocumentList.h"
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        /**
+         * @brief Synthetic documents, shaped after results that are slow to display.
+         *        Generators are deterministic: the same 'index' gives the same
+         *        document (except of "_id"), so runs on different builds compare.
+         */
+
+        // 'fields' top-level fields of mixed scalar types
+        mongo::BSONObj wideDocument(int index, int fields = 300);
+
+        // Sub-documents nested 'depth' levels deep, few fields on each level
+        mongo::BSONObj deepDocument(int index, int depth = 40);
+
+        // Arrays of numbers, strings and sub-documents
+        mongo::BSONObj arrayDocument(int index, int items = 100);
+
+        // Dates, timestamps and nested dates
+        mongo::BSONObj dateDocument(int index, int fields = 60);
+
+        // UUIDs of new (4) and legacy (3) binary subtypes
+        mongo::BSONObj uuidDocument(int index, int fields = 60);
+
+        struct Dataset
+        {
+            std::string name;                   // "wide", "deep", "array", "date", "uuid"
+            MongoDocumentList documents;
+            std::vector<std::string> json;      // Documents, as shown in text mode
+            long long bsonBytes;
+        };
+
+        // Datasets of each generator, 'documents' documents each
+        std::vector<Dataset> makeDatasets(int documents);
+    }
+}
@@ -0,0 +1,968 @@
+#include "robomongo-bench/FakeMongoServer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <limits>
+#include <set>
+
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <mongo/db/jsobj.h>
+
+namespace
+{
+    enum OpCode
+    {
+        OpReply = 1,
+        OpQuery = 2004,
+        OpMsg = 2013
+    };
+
+    const int HeaderSize = 16;
+    const int MaxMessageSize = 48 * 1000 * 1000;
+    const int MaxBsonObjectSize = 16 * 1024 * 1024;
+    const int MaxBatchBytes = MaxBsonObjectSize - 1024 * 1024;
+
+    const unsigned MsgChecksumPresent = 1 << 0;
+    const unsigned MsgMoreToCome = 1 << 1;
+
+    // Wire protocol is little-endian, as are all platforms of Robo 3T
+    int32_t readInt32(const char *data)
+    {
+        int32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    void appendInt32(std::string &buffer, int32_t value)
+    {
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void appendInt64(std::string &buffer, int64_t value)
+    {
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void appendObj(std::string &buffer, const mongo::BSONObj &obj)
+    {
+        buffer.append(obj.objdata(), obj.objsize());
+    }
+
+    long long nowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    mongo::BSONObj ok()
+    {
+        return BSON("ok" << 1.0);
+    }
+
+    mongo::BSONObj error(int code, const std::string &codeName, const std::string &message)
+    {
+        return BSON("ok" << 0.0 << "errmsg" << message << "code" << code << "codeName" << codeName);
+    }
+
+    // Accepted connections are handed over as socket descriptors, so that
+    // each connection thread creates (and owns) its own QTcpSocket
+    class Listener : public QTcpServer
+    {
+    public:
+        explicit Listener(std::function<void(qintptr)> onConnection) :
+            _onConnection(onConnection) {}
+
+    protected:
+        void incomingConnection(qintptr descriptor) override
+        {
+            _onConnection(descriptor);
+        }
+
+    private:
+        std::function<void(qintptr)> _onConnection;
+    };
+
+    bool readExactly(QTcpSocket &socket, char *data, qint64 size, const std::atomic<bool> &stopping)
+    {
+        while (socket.bytesAvailable() < size) {
+            if (stopping || socket.state() != QAbstractSocket::ConnectedState)
+                return false;
+            socket.waitForReadyRead(50);
+        }
+        return socket.read(data, size) == size;
+    }
+
+    bool writeAll(QTcpSocket &socket, const std::string &data, const std::atomic<bool> &stopping)
+    {
+        if (socket.write(data.data(), data.size()) != static_cast<qint64>(data.size()))
+            return false;
+
+        while (socket.bytesToWrite() > 0) {
+            if (!socket.waitForBytesWritten(100) &&
+                (stopping || socket.state() != QAbstractSocket::ConnectedState))
+                return false;
+        }
+        return true;
+    }
+
+    // Query operators, supported by matches(): $eq, $ne, $gt, $gte, $lt, $lte, $in, $exists
+    bool matchesValue(const mongo::BSONElement &value, const mongo::BSONElement &condition)
+    {
+        if (condition.type() == mongo::Object) {
+            mongo::BSONObj const operators = condition.Obj();
+            if (!operators.isEmpty() && operators.firstElementFieldName()[0] == '$') {
+                for (mongo::BSONObjIterator it(operators); it.more(); ) {
+                    mongo::BSONElement const op = it.next();
+                    std::string const name = op.fieldName();
+                    int const cmp = value.eoo() ? 0 : value.woCompare(op, false);
+                    bool matched = false;
+                    if (name == "$eq")
+                        matched = !value.eoo() && cmp == 0;
+                    else if (name == "$ne")
+                        matched = value.eoo() || cmp != 0;
+                    else if (name == "$gt")
+                        matched = !value.eoo() && cmp > 0;
+                    else if (name == "$gte")
+                        matched = !value.eoo() && cmp >= 0;
+                    else if (name == "$lt")
+                        matched = !value.eoo() && cmp < 0;
+                    else if (name == "$lte")
+                        matched = !value.eoo() && cmp <= 0;
+                    else if (name == "$exists")
+                        matched = value.eoo() != op.trueValue();
+                    else if (name == "$in" && op.type() == mongo::Array) {
+                        for (mongo::BSONObjIterator items(op.Obj()); items.more() && !matched; )
+                            matched = !value.eoo() && value.woCompare(items.next(), false) == 0;
+                    }
+
+                    if (!matched)
+                        return false;
+                }
+                return true;
+            }
+        }
+
+        return !value.eoo() && value.woCompare(condition, false) == 0;
+    }
+
+    bool matches(const mongo::BSONObj &doc, const mongo::BSONObj &filter)
+    {
+        for (mongo::BSONObjIterator it(filter); it.more(); ) {
+            mongo::BSONElement const condition = it.next();
+            std::string const name = condition.fieldName();
+            if (name == "$and" || name == "$or") {
+                bool const all = name == "$and";
+                bool any = false;
+                for (mongo::BSONObjIterator items(condition.Obj()); items.more(); ) {
+                    mongo::BSONElement const item = items.next();
+                    bool const matched = item.type() == mongo::Object && matches(doc, item.Obj());
+                    if (all && !matched)
+                        return false;
+                    any = any || matched;
+                }
+                if (!all && !any)
+                    return false;
+                continue;
+            }
+
+            if (!matchesValue(doc.getFieldDotted(name), condition))
+                return false;
+        }
+        return true;
+    }
+
+    // Replacement document or top-level $set / $unset
+    mongo::BSONObj updated(const mongo::BSONObj &doc, const mongo::BSONObj &update)
+    {
+        mongo::BSONObjBuilder builder;
+        if (update.isEmpty() || update.firstElementFieldName()[0] != '$') {
+            mongo::BSONElement const id = doc["_id"];
+            if (!id.eoo())
+                builder.append(id);
+            for (mongo::BSONObjIterator it(update); it.more(); ) {
+                mongo::BSONElement const elem = it.next();
+                if (std::strcmp(elem.fieldName(), "_id") != 0 || id.eoo())
+                    builder.append(elem);
+            }
+            return builder.obj();
+        }
+
+        mongo::BSONObj const set = update.getObjectField("$set");
+        mongo::BSONObj const unset = update.getObjectField("$unset");
+        for (mongo::BSONObjIterator it(doc); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (unset.hasField(elem.fieldName()))
+                continue;
+
+            mongo::BSONElement const value = set[elem.fieldName()];
+            builder.append(value.eoo() ? elem : value);
+        }
+
+        for (mongo::BSONObjIterator it(set); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (!doc.hasField(elem.fieldName()))
+                builder.append(elem);
+        }
+        return builder.obj();
+    }
+}
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        FakeMongoServer::FakeMongoServer(const Options &options) :
+            _options(options),
+            _stopping(false),
+            _port(0),
+            _lastCursorId(0),
+            _lastOperationId(0),
+            _lastRequestId(0),
+            _stats()
+        {
+        }
+
+        FakeMongoServer::~FakeMongoServer()
+        {
+            stop();
+        }
+
+        bool FakeMongoServer::start()
+        {
+            std::promise<int> port;
+            _stopping = false;
+            _acceptThread = std::thread([this, &port]() {
+                // Blocking accept loop, this thread has no event loop
+                Listener listener([this](qintptr descriptor) { addConnection(descriptor); });
+                if (!listener.listen(QHostAddress::LocalHost, 0)) {
+                    port.set_value(0);
+                    return;
+                }
+
+                port.set_value(listener.serverPort());
+                while (!_stopping)
+                    listener.waitForNewConnection(50);
+            });
+
+            _port = port.get_future().get();
+            if (_port == 0)
+                stop();
+            return _port != 0;
+        }
+
+        void FakeMongoServer::stop()
+        {
+            _stopping = true;
+            if (_acceptThread.joinable())
+                _acceptThread.join();
+
+            std::vector<std::thread> connections;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                connections.swap(_connections);
+            }
+            for (auto &connection : connections)
+                connection.join();
+        }
+
+        void FakeMongoServer::setCollection(const std::string &ns, const std::vector<mongo::BSONObj> &documents)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Collection &collection = _collections[ns];
+            collection.documents.clear();
+            collection.documents.reserve(documents.size());
+            for (auto const &doc : documents)
+                collection.documents.push_back(doc.getOwned());
+        }
+
+        size_t FakeMongoServer::documentCount(const std::string &ns) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto const it = _collections.find(ns);
+            return it != _collections.end() ? it->second.documents.size() : 0;
+        }
+
+        void FakeMongoServer::setQueryDelay(const std::string &ns, int ms)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _collections[ns].queryDelayMs = ms;
+        }
+
+        FakeMongoServer::Stats FakeMongoServer::stats() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _stats;
+        }
+
+        void FakeMongoServer::addConnection(qintptr descriptor)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _connections.emplace_back(&FakeMongoServer::serve, this, descriptor);
+        }
+
+        void FakeMongoServer::serve(qintptr descriptor)
+        {
+            QTcpSocket socket;
+            if (!socket.setSocketDescriptor(descriptor))
+                return;
+            socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+            while (!_stopping) {
+                char header[HeaderSize];
+                if (!readExactly(socket, header, HeaderSize, _stopping))
+                    break;
+
+                int32_t const length = readInt32(header);
+                if (length < HeaderSize || length > MaxMessageSize)
+                    break;
+
+                std::string message(length, '\0');
+                std::memcpy(&message[0], header, HeaderSize);
+                if (!readExactly(socket, &message[HeaderSize], length - HeaderSize, _stopping))
+                    break;
+
+                std::string const reply = handleMessage(message);
+                if (reply.empty())
+                    continue;
+
+                // Round trip, then transfer time of the reply
+                long long delayMs = _options.latencyMs;
+                if (_options.bandwidthKBps > 0)
+                    delayMs += static_cast<long long>(reply.size()) * 1000 / (_options.bandwidthKBps * 1024LL);
+                if (delayMs > 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stats.bytesIn += length;
+                    _stats.bytesOut += reply.size();
+                }
+
+                if (!writeAll(socket, reply, _stopping))
+                    break;
+            }
+        }
+
+        std::string FakeMongoServer::handleMessage(const std::string &message)
+        {
+            const char *const data = message.data();
+            int32_t const requestId = readInt32(data + 4);
+            int32_t const opCode = readInt32(data + 12);
+
+            mongo::BSONObj result;
+            std::string body;
+            int32_t replyOpCode = OpMsg;
+
+            if (opCode == OpQuery) {
+                // Handshake of drivers: { isMaster: 1 } on "admin.$cmd"
+                const char *const ns = data + HeaderSize + 4;
+                size_t const nsLength = std::strlen(ns);
+                mongo::BSONObj query(ns + nsLength + 1 + 8);
+                std::string const fullName(ns, nsLength);
+                size_t const dot = fullName.find('.');
+
+                if (dot == std::string::npos || fullName.compare(dot, std::string::npos, ".$cmd") != 0) {
+                    result = BSON("$err" << "Only commands are supported by OP_QUERY" << "code" << 352);
+                }
+                else {
+                    mongo::BSONElement const wrapped = query.hasField("$query") ? query["$query"] : query["query"];
+                    result = runCommand(fullName.substr(0, dot), wrapped.type() == mongo::Object ? wrapped.Obj() : query);
+                }
+
+                replyOpCode = OpReply;
+                appendInt32(body, 0);       // responseFlags
+                appendInt64(body, 0);       // cursorID
+                appendInt32(body, 0);       // startingFrom
+                appendInt32(body, 1);       // numberReturned
+                appendObj(body, result);
+            }
+            else if (opCode == OpMsg) {
+                uint32_t const flags = static_cast<uint32_t>(readInt32(data + HeaderSize));
+                size_t const end = message.size() - ((flags & MsgChecksumPresent) ? 4 : 0);
+                size_t position = HeaderSize + 4;
+
+                // Body (kind 0) and document sequences (kind 1, i.e. "documents" of insert),
+                // sequences are merged into body as arrays
+                mongo::BSONObj command;
+                std::vector<std::pair<std::string, std::vector<mongo::BSONObj>>> sequences;
+                while (position < end) {
+                    char const kind = data[position++];
+                    if (kind == 0) {
+                        command = mongo::BSONObj(data + position);
+                        position += command.objsize();
+                    }
+                    else {
+                        int32_t const size = readInt32(data + position);
+                        size_t const sequenceEnd = position + size;
+                        const char *const identifier = data + position + 4;
+                        position += 4 + std::strlen(identifier) + 1;
+
+                        sequences.push_back(std::make_pair(std::string(identifier), std::vector<mongo::BSONObj>()));
+                        while (position < sequenceEnd) {
+                            mongo::BSONObj const doc(data + position);
+                            sequences.back().second.push_back(doc);
+                            position += doc.objsize();
+                        }
+                    }
+                }
+
+                if (!sequences.empty()) {
+                    mongo::BSONObjBuilder merged;
+                    merged.appendElements(command);
+                    for (auto const &sequence : sequences) {
+                        mongo::BSONArrayBuilder array(merged.subarrayStart(sequence.first));
+                        for (auto const &doc : sequence.second)
+                            array.append(doc);
+                        array.done();
+                    }
+                    command = merged.obj();
+                }
+
+                result = runCommand(command["$db"].str(), command);
+                if (flags & MsgMoreToCome)
+                    return std::string();
+
+                appendInt32(body, 0);       // flagBits
+                body.push_back(0);          // Section of kind 0
+                appendObj(body, result);
+            }
+            else {
+                // Legacy OP_INSERT, OP_GET_MORE etc. are not used by drivers of supported servers
+                return std::string();
+            }
+
+            int32_t replyId;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                replyId = ++_lastRequestId;
+            }
+
+            std::string reply;
+            reply.reserve(HeaderSize + body.size());
+            appendInt32(reply, static_cast<int32_t>(HeaderSize + body.size()));
+            appendInt32(reply, replyId);
+            appendInt32(reply, requestId);
+            appendInt32(reply, replyOpCode);
+            reply += body;
+            return reply;
+        }
+
+        mongo::BSONObj FakeMongoServer::runCommand(const std::string &db, const mongo::BSONObj &command)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_stats.commands;
+            }
+
+            std::string const name = command.isEmpty() ? std::string() : command.firstElementFieldName();
+            if (name == "isMaster" || name == "ismaster" || name == "hello")
+                return hello();
+            if (name == "buildInfo" || name == "buildinfo") {
+                return BSON("version" << "4.2.0" << "versionArray" << BSON_ARRAY(4 << 2 << 0 << 0)
+                            << "gitVersion" << "robo_bench" << "bits" << 64
+                            << "maxBsonObjectSize" << MaxBsonObjectSize << "ok" << 1.0);
+            }
+            if (name == "serverStatus") {
+                return BSON("host" << "127.0.0.1" << "version" << "4.2.0" << "process" << "mongod"
+                            << "storageEngine" << BSON("name" << "inMemory") << "ok" << 1.0);
+            }
+            if (name == "whatsmyuri")
+                return BSON("you" << "127.0.0.1" << "ok" << 1.0);
+            if (name == "getLastError" || name == "getlasterror")
+                return BSON("n" << 0 << "err" << mongo::BSONNULL << "ok" << 1.0);
+            if (name == "getLog")
+                return BSON("totalLinesWritten" << 0 << "log" << mongo::BSONArray() << "ok" << 1.0);
+            if (name == "getCmdLineOpts")
+                return BSON("argv" << mongo::BSONArray() << "parsed" << mongo::BSONObj() << "ok" << 1.0);
+            if (name == "connectionStatus") {
+                return BSON("authInfo" << BSON("authenticatedUsers" << mongo::BSONArray()
+                            << "authenticatedUserRoles" << mongo::BSONArray()) << "ok" << 1.0);
+            }
+            if (name == "getFreeMonitoringStatus")
+                return BSON("state" << "disabled" << "ok" << 1.0);
+            if (name == "ping" || name == "endSessions" || name == "create" || name == "createIndexes" ||
+                name == "getParameter")
+                return ok();
+            if (name == "listDatabases")
+                return listDatabases();
+            if (name == "listCollections")
+                return listCollections(db, command);
+            if (name == "listIndexes")
+                return listIndexes(db, command);
+            if (name == "find")
+                return find(db, command);
+            if (name == "aggregate")
+                return aggregate(db, command);
+            if (name == "getMore")
+                return getMore(db, command);
+            if (name == "killCursors")
+                return killCursors(command);
+            if (name == "count")
+                return count(db, command);
+            if (name == "collStats")
+                return collStats(db, command);
+            if (name == "insert")
+                return insert(db, command);
+            if (name == "update")
+                return update(db, command);
+            if (name == "delete")
+                return remove(db, command);
+            if (name == "drop") {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _collections.erase(db + "." + command.firstElement().str());
+                return ok();
+            }
+            if (name == "currentOp")
+                return currentOp();
+            if (name == "killOp")
+                return killOp(command);
+            if (name == "sleep") {
+                int const ms = command.hasField("millis") ? command["millis"].numberInt() : 100;
+                return runOperation(std::string(), command, ms)
+                    ? ok() : error(11601, "Interrupted", "operation was interrupted");
+            }
+
+            return error(59, "CommandNotFound", "no such command: '" + name + "'");
+        }
+
+        mongo::BSONObj FakeMongoServer::hello() const
+        {
+            // Wire version 8 (4.2): OP_MSG, no compression and no sessions are announced
+            mongo::BSONObjBuilder builder;
+            builder.append("ismaster", true);
+            builder.append("maxBsonObjectSize", MaxBsonObjectSize);
+            builder.append("maxMessageSizeBytes", MaxMessageSize);
+            builder.append("maxWriteBatchSize", 100000);
+            builder.appendDate("localTime", mongo::Date_t::now());
+            builder.append("minWireVersion", 0);
+            builder.append("maxWireVersion", 8);
+            builder.append("readOnly", false);
+            builder.append("ok", 1.0);
+            return builder.obj();
+        }
+
+        mongo::BSONObj FakeMongoServer::listDatabases() const
+        {
+            std::set<std::string> names { "admin" };
+            long long totalSize = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto const &collection : _collections) {
+                    names.insert(collection.first.substr(0, collection.first.find('.')));
+                    for (auto const &doc : collection.second.documents)
+                        totalSize += doc.objsize();
+                }
+            }
+
+            mongo::BSONObjBuilder builder;
+            mongo::BSONArrayBuilder databases(builder.subarrayStart("databases"));
+            for (auto const &name : names)
+                databases.append(BSON("name" << name << "sizeOnDisk" << 0.0 << "empty" << false));
+            databases.done();
+            builder.append("totalSize", static_cast<double>(totalSize));
+            builder.append("ok", 1.0);
+            return builder.obj();
+        }
+
+        mongo::BSONObj FakeMongoServer::listCollections(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const prefix = db + ".";
+            mongo::BSONObj const filter = command.getObjectField("filter");
+            std::vector<mongo::BSONObj> infos;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto const &collection : _collections) {
+                    if (collection.first.compare(0, prefix.size(), prefix) != 0)
+                        continue;
+
+                    mongo::BSONObj const info = BSON("name" << collection.first.substr(prefix.size())
+                        << "type" << "collection" << "options" << mongo::BSONObj()
+                        << "info" << BSON("readOnly" << false));
+                    if (matches(info, filter))
+                        infos.push_back(info);
+                }
+            }
+
+            long long const batchSize = command.getObjectField("cursor").hasField("batchSize")
+                ? command.getObjectField("cursor")["batchSize"].safeNumberLong() : DefaultBatchSize;
+            return cursorReply(db + ".$cmd.listCollections", std::move(infos), batchSize, false, "firstBatch");
+        }
+
+        mongo::BSONObj FakeMongoServer::listIndexes(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_collections.find(ns) == _collections.end())
+                    return error(26, "NamespaceNotFound", "ns does not exist: " + ns);
+            }
+
+            std::vector<mongo::BSONObj> indexes {
+                BSON("v" << 2 << "key" << BSON("_id" << 1) << "name" << "_id_" << "ns" << ns)
+            };
+            return cursorReply(ns, std::move(indexes), DefaultBatchSize, false, "firstBatch");
+        }
+
+        mongo::BSONObj FakeMongoServer::find(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            mongo::BSONObj const filter = command.getObjectField("filter");
+            long long const skip = command["skip"].safeNumberLong();
+            long long limit = command["limit"].safeNumberLong();
+            bool const singleBatch = command["singleBatch"].trueValue() || limit < 0;
+            limit = std::abs(limit);
+
+            std::vector<mongo::BSONObj> found;
+            int delayMs = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto const it = _collections.find(ns);
+                if (it != _collections.end()) {
+                    delayMs = it->second.queryDelayMs;
+                    long long skipped = 0;
+                    for (auto const &doc : it->second.documents) {
+                        if (!matches(doc, filter))
+                            continue;
+                        if (skipped < skip) {
+                            ++skipped;
+                            continue;
+                        }
+
+                        found.push_back(doc);
+                        if (limit > 0 && static_cast<long long>(found.size()) >= limit)
+                            break;
+                    }
+                }
+            }
+
+            if (delayMs > 0 && !runOperation(ns, command, delayMs))
+                return error(11601, "Interrupted", "operation was interrupted");
+
+            long long const batchSize = command.hasField("batchSize")
+                ? command["batchSize"].safeNumberLong() : DefaultBatchSize;
+            return cursorReply(ns, std::move(found), batchSize, singleBatch, "firstBatch");
+        }
+
+        mongo::BSONObj FakeMongoServer::aggregate(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            std::vector<mongo::BSONObj> documents;
+            int delayMs = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto const it = _collections.find(ns);
+                if (it != _collections.end()) {
+                    documents = it->second.documents;
+                    delayMs = it->second.queryDelayMs;
+                }
+            }
+
+            // Stages, that do not change documents: $match, $skip, $limit, $sample (first N), $count
+            for (mongo::BSONObjIterator stages(command.getObjectField("pipeline")); stages.more(); ) {
+                mongo::BSONObj const stage = stages.next().Obj();
+                std::string const name = stage.firstElementFieldName();
+                mongo::BSONElement const spec = stage.firstElement();
+                if (name == "$match") {
+                    std::vector<mongo::BSONObj> matched;
+                    for (auto const &doc : documents) {
+                        if (matches(doc, spec.Obj()))
+                            matched.push_back(doc);
+                    }
+                    documents.swap(matched);
+                }
+                else if (name == "$skip") {
+                    size_t const skip = std::min<size_t>(spec.safeNumberLong(), documents.size());
+                    documents.erase(documents.begin(), documents.begin() + skip);
+                }
+                else if (name == "$limit" || name == "$sample") {
+                    long long const size = name == "$limit" ? spec.safeNumberLong() : spec.Obj()["size"].safeNumberLong();
+                    if (size >= 0 && static_cast<size_t>(size) < documents.size())
+                        documents.resize(size);
+                }
+                else if (name == "$count") {
+                    mongo::BSONObj const counted = BSON(spec.str() << static_cast<int>(documents.size()));
+                    documents.assign(1, counted);
+                }
+                else {
+                    return error(40324, "Location40324", "Unrecognized pipeline stage name: '" + name + "'");
+                }
+            }
+
+            if (delayMs > 0 && !runOperation(ns, command, delayMs))
+                return error(11601, "Interrupted", "operation was interrupted");
+
+            mongo::BSONObj const cursor = command.getObjectField("cursor");
+            long long const batchSize = cursor.hasField("batchSize") ? cursor["batchSize"].safeNumberLong() : DefaultBatchSize;
+            return cursorReply(ns, std::move(documents), batchSize, false, "firstBatch");
+        }
+
+        mongo::BSONObj FakeMongoServer::getMore(const std::string &db, const mongo::BSONObj &command)
+        {
+            long long const id = command.firstElement().safeNumberLong();
+            long long const batchSize = command.hasField("batchSize")
+                ? command["batchSize"].safeNumberLong() : std::numeric_limits<int>::max();
+
+            Cursor cursor;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto const it = _cursors.find(id);
+                if (it == _cursors.end())
+                    return error(43, "CursorNotFound", "cursor id " + std::to_string(id) + " not found");
+
+                cursor = std::move(it->second);
+                _cursors.erase(it);
+            }
+
+            cursor.documents.erase(cursor.documents.begin(), cursor.documents.begin() + cursor.position);
+            return cursorReply(cursor.ns, std::move(cursor.documents), batchSize, false, "nextBatch");
+        }
+
+        mongo::BSONObj FakeMongoServer::killCursors(const mongo::BSONObj &command)
+        {
+            mongo::BSONArrayBuilder killed;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (mongo::BSONObjIterator it(command.getObjectField("cursors")); it.more(); ) {
+                    long long const id = it.next().safeNumberLong();
+                    if (_cursors.erase(id))
+                        killed.append(id);
+                }
+            }
+
+            return BSON("cursorsKilled" << killed.arr() << "cursorsNotFound" << mongo::BSONArray()
+                        << "cursorsAlive" << mongo::BSONArray() << "cursorsUnknown" << mongo::BSONArray()
+                        << "ok" << 1.0);
+        }
+
+        mongo::BSONObj FakeMongoServer::count(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            mongo::BSONObj const query = command.getObjectField("query");
+            long long n = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto const it = _collections.find(ns);
+                if (it != _collections.end()) {
+                    for (auto const &doc : it->second.documents)
+                        n += matches(doc, query) ? 1 : 0;
+                }
+            }
+
+            n = std::max(0LL, n - command["skip"].safeNumberLong());
+            long long const limit = std::abs(command["limit"].safeNumberLong());
+            if (limit > 0)
+                n = std::min(n, limit);
+            return BSON("n" << n << "ok" << 1.0);
+        }
+
+        mongo::BSONObj FakeMongoServer::collStats(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            long long count = 0;
+            long long size = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto const it = _collections.find(ns);
+                if (it == _collections.end())
+                    return error(26, "NamespaceNotFound", "Collection [" + ns + "] not found.");
+
+                count = it->second.documents.size();
+                for (auto const &doc : it->second.documents)
+                    size += doc.objsize();
+            }
+
+            return BSON("ns" << ns << "count" << count << "size" << size << "storageSize" << size
+                        << "avgObjSize" << (count > 0 ? size / count : 0) << "nindexes" << 1
+                        << "totalIndexSize" << count * 16 << "ok" << 1.0);
+        }
+
+        mongo::BSONObj FakeMongoServer::insert(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            int n = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                Collection &collection = _collections[ns];
+                for (mongo::BSONObjIterator it(command.getObjectField("documents")); it.more(); ++n)
+                    collection.documents.push_back(it.next().Obj().getOwned());
+            }
+            return BSON("n" << n << "ok" << 1.0);
+        }
+
+        mongo::BSONObj FakeMongoServer::update(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            int matched = 0;
+            mongo::BSONArrayBuilder upserted;
+            int index = 0;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            Collection &collection = _collections[ns];
+            for (mongo::BSONObjIterator it(command.getObjectField("updates")); it.more(); ++index) {
+                mongo::BSONObj const statement = it.next().Obj();
+                mongo::BSONObj const query = statement.getObjectField("q");
+                mongo::BSONObj const change = statement.getObjectField("u");
+                bool const multi = statement["multi"].trueValue();
+
+                int statementMatched = 0;
+                for (auto &doc : collection.documents) {
+                    if (!matches(doc, query))
+                        continue;
+
+                    doc = updated(doc, change);
+                    ++statementMatched;
+                    if (!multi)
+                        break;
+                }
+
+                matched += statementMatched;
+                if (statementMatched == 0 && statement["upsert"].trueValue()) {
+                    // Save of a document is an upsert by its _id
+                    mongo::BSONObjBuilder inserted;
+                    mongo::BSONElement const id = query["_id"];
+                    if (!id.eoo() && !change.hasField("_id"))
+                        inserted.append(id);
+                    inserted.appendElements(updated(mongo::BSONObj(), change));
+                    collection.documents.push_back(inserted.obj());
+
+                    mongo::BSONElement const insertedId = collection.documents.back()["_id"];
+                    mongo::BSONObjBuilder entry;
+                    entry.append("index", index);
+                    if (!insertedId.eoo())
+                        entry.appendAs(insertedId, "_id");
+                    upserted.append(entry.obj());
+                    ++matched;
+                }
+            }
+
+            mongo::BSONObjBuilder reply;
+            reply.append("n", matched);
+            reply.append("nModified", matched);
+            mongo::BSONArray const upsertedIds = upserted.arr();
+            if (!upsertedIds.isEmpty())
+                reply.append("upserted", upsertedIds);
+            reply.append("ok", 1.0);
+            return reply.obj();
+        }
+
+        mongo::BSONObj FakeMongoServer::remove(const std::string &db, const mongo::BSONObj &command)
+        {
+            std::string const ns = db + "." + command.firstElement().str();
+            int n = 0;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            Collection &collection = _collections[ns];
+            for (mongo::BSONObjIterator it(command.getObjectField("deletes")); it.more(); ) {
+                mongo::BSONObj const statement = it.next().Obj();
+                mongo::BSONObj const query = statement.getObjectField("q");
+                bool const justOne = statement["limit"].safeNumberLong() == 1;
+
+                auto &documents = collection.documents;
+                for (auto doc = documents.begin(); doc != documents.end(); ) {
+                    if (!matches(*doc, query)) {
+                        ++doc;
+                        continue;
+                    }
+
+                    doc = documents.erase(doc);
+                    ++n;
+                    if (justOne)
+                        break;
+                }
+            }
+            return BSON("n" << n << "ok" << 1.0);
+        }
+
+        mongo::BSONObj FakeMongoServer::currentOp() const
+        {
+            long long const now = nowMs();
+            mongo::BSONObjBuilder builder;
+            mongo::BSONArrayBuilder inprog(builder.subarrayStart("inprog"));
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto const &operation : _operations) {
+                    inprog.append(BSON("opid" << operation.first << "active" << true << "op" << "command"
+                                       << "ns" << operation.second.ns << "command" << operation.second.command
+                                       << "microsecs_running" << (now - operation.second.startedMs) * 1000
+                                       << "killPending" << operation.second.killed));
+                }
+            }
+            inprog.done();
+            builder.append("ok", 1.0);
+            return builder.obj();
+        }
+
+        mongo::BSONObj FakeMongoServer::killOp(const mongo::BSONObj &command)
+        {
+            int const id = command["op"].numberInt();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto const it = _operations.find(id);
+                if (it != _operations.end())
+                    it->second.killed = true;
+            }
+            return BSON("info" << "attempting to kill op" << "ok" << 1.0);
+        }
+
+        bool FakeMongoServer::runOperation(const std::string &ns, const mongo::BSONObj &command, int ms)
+        {
+            long long const started = nowMs();
+            int id;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                id = ++_lastOperationId;
+                _operations[id] = Operation { ns, command.getOwned(), started, false };
+            }
+
+            bool killed = false;
+            while (!killed && nowMs() - started < ms) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(_mutex);
+                killed = _operations[id].killed || _stopping;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _operations.erase(id);
+            return !killed;
+        }
+
+        mongo::BSONObj FakeMongoServer::cursorReply(const std::string &ns, std::vector<mongo::BSONObj> documents,
+                                                    long long batchSize, bool singleBatch, const char *batchName)
+        {
+            mongo::BSONObjBuilder builder;
+            mongo::BSONObjBuilder cursor(builder.subobjStart("cursor"));
+            mongo::BSONArrayBuilder batch(cursor.subarrayStart(batchName));
+
+            size_t position = 0;
+            long long bytes = 0;
+            while (position < documents.size() && static_cast<long long>(position) < batchSize) {
+                bytes += documents[position].objsize();
+                if (position > 0 && bytes > MaxBatchBytes)
+                    break;
+                batch.append(documents[position]);
+                ++position;
+            }
+            batch.done();
+
+            long long id = 0;
+            if (position < documents.size() && !singleBatch) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                id = ++_lastCursorId;
+                _cursors[id] = Cursor { ns, std::move(documents), position };
+            }
+
+            cursor.append("id", id);
+            cursor.append("ns", ns);
+            cursor.done();
+            builder.append("ok", 1.0);
+            return builder.obj();
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QtGlobal>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        /**
+         * @brief In-process stand-in of mongod on 127.0.0.1, serving documents from memory.
+         *
+         *        Speaks enough of the wire protocol for MongoWorker, MongoClient and the
+         *        shell of ScriptEngine: OP_QUERY commands (handshake), OP_MSG commands
+         *        hello/isMaster, buildInfo, serverStatus, listDatabases, listCollections,
+         *        listIndexes, find, getMore, killCursors, count, aggregate (simple stages),
+         *        insert, update, delete, currentOp, killOp and sleep. Unknown commands fail
+         *        with CommandNotFound, the way real server does.
+         *
+         *        Every connection is served by its own thread with blocking sockets.
+         *        Replies are delayed by configured latency and bandwidth.
+         */
+        class FakeMongoServer
+        {
+        public:
+            struct Options
+            {
+                int latencyMs = 0;          // Added to every reply
+                int bandwidthKBps = 0;      // Reply throughput, 0 is unlimited
+            };
+
+            struct Stats
+            {
+                long long commands;
+                long long bytesIn;
+                long long bytesOut;
+            };
+
+            static constexpr int DefaultBatchSize = 101;
+
+            explicit FakeMongoServer(const Options &options = Options());
+            ~FakeMongoServer();
+
+            // Listens on free port of 127.0.0.1, returns false if it cannot
+            bool start();
+            void stop();
+            int port() const { return _port; }
+
+            void setCollection(const std::string &ns, const std::vector<mongo::BSONObj> &documents);
+            size_t documentCount(const std::string &ns) const;
+
+            /**
+             * @brief Every find and aggregate on 'ns' waits 'ms' before the first batch,
+             *        like a slow query, unless killed by killOp.
+             */
+            void setQueryDelay(const std::string &ns, int ms);
+
+            Stats stats() const;
+
+        private:
+            struct Collection
+            {
+                std::vector<mongo::BSONObj> documents;
+                int queryDelayMs = 0;
+            };
+
+            struct Cursor
+            {
+                std::string ns;
+                std::vector<mongo::BSONObj> documents;
+                size_t position;
+            };
+
+            struct Operation
+            {
+                std::string ns;
+                mongo::BSONObj command;
+                long long startedMs;
+                bool killed;
+            };
+
+            void addConnection(qintptr descriptor);
+            void serve(qintptr descriptor);
+
+            // Reply to one wire protocol message, empty if no reply is expected
+            std::string handleMessage(const std::string &message);
+            mongo::BSONObj runCommand(const std::string &db, const mongo::BSONObj &command);
+
+            mongo::BSONObj hello() const;
+            mongo::BSONObj listDatabases() const;
+            mongo::BSONObj listCollections(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj listIndexes(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj find(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj aggregate(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj getMore(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj killCursors(const mongo::BSONObj &command);
+            mongo::BSONObj count(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj collStats(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj insert(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj update(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj remove(const std::string &db, const mongo::BSONObj &command);
+            mongo::BSONObj currentOp() const;
+            mongo::BSONObj killOp(const mongo::BSONObj &command);
+
+            /**
+             * @brief Waits 'ms' as operation, that is listed by currentOp.
+             *        Returns false, if it was killed (or server stops) meanwhile.
+             */
+            bool runOperation(const std::string &ns, const mongo::BSONObj &command, int ms);
+
+            // Reply of find, aggregate and getMore, keeps rest of 'documents' as cursor
+            mongo::BSONObj cursorReply(const std::string &ns, std::vector<mongo::BSONObj> documents,
+                                       long long batchSize, bool singleBatch, const char *batchName);
+
+            Options const _options;
+            std::atomic<bool> _stopping;
+            int _port;
+            std::thread _acceptThread;
+
+            mutable std::mutex _mutex;       // Guards members below
+            std::vector<std::thread> _connections;
+            std::map<std::string, Collection> _collections;
+            std::map<long long, Cursor> _cursors;
+            std::map<int, Operation> _operations;
+            long long _lastCursorId;
+            int _lastOperationId;
+            int _lastRequestId;
+            Stats _stats;
+        };
+    }
+}
@@ -0,0 +1,397 @@
+#include "robomongo-bench/LatencyHarness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include <QThread>
+
+#include <mongo/client/dbclient_connection.h>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/MongoQueryInfo.h"
+#include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/BsonTableModel.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
+
+#include "robomongo-bench/BenchmarkRunner.h"
+#include "robomongo-bench/DocumentGenerators.h"
+#include "robomongo-bench/FakeMongoServer.h"
+
+namespace
+{
+    const char *const Database = "bench";
+    const int WideFields = 40;          // Typical width of documents in table mode
+    const int PageSize = 50;            // Default "batch size" of query results
+    const int Pages = 10;
+    const int Inserts = 100;
+    const int SlowQueryMs = 10 * 60 * 1000;
+
+    // Arguments of MongoWorker, as used by MongoServer by default
+    const int BatchSize = 50;
+    const double MongoTimeoutSec = 60;
+    const int ShellTimeoutSec = 120;
+
+    typedef std::chrono::steady_clock Clock;
+
+    double elapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    long long bsonBytes(const Robomongo::MongoDocumentList &documents)
+    {
+        long long bytes = 0;
+        for (auto const &doc : documents)
+            bytes += doc->bsonObj().objsize();
+        return bytes;
+    }
+}
+
+namespace Robomongo
+{
+    namespace Bench
+    {
+        LatencyHarness::LatencyHarness(BenchmarkRunner &runner, const Options &options) :
+            _runner(runner),
+            _options(options),
+            _dataset("fake-" + std::to_string(options.latencyMs) + "ms" +
+                     (options.bandwidthKBps > 0 ? "-" + std::to_string(options.bandwidthKBps) + "KBps" : "")),
+            _worker(nullptr),
+            _pending(0)
+        {
+            FakeMongoServer::Options serverOptions;
+            serverOptions.latencyMs = options.latencyMs;
+            serverOptions.bandwidthKBps = options.bandwidthKBps;
+            _server.reset(new FakeMongoServer(serverOptions));
+
+            _timeout.setSingleShot(true);
+            VERIFY(QObject::connect(&_timeout, SIGNAL(timeout()), &_loop, SLOT(quit())));
+        }
+
+        LatencyHarness::~LatencyHarness()
+        {
+            if (_worker)
+                _worker->stopAndDelete();
+
+            _server->stop();
+        }
+
+        bool LatencyHarness::run()
+        {
+            std::vector<mongo::BSONObj> wide;
+            wide.reserve(_options.documents);
+            for (int i = 0; i < _options.documents; ++i)
+                wide.push_back(wideDocument(i, WideFields));
+
+            _server->setCollection("bench.wide", wide);
+            _server->setCollection("bench.slow", std::vector<mongo::BSONObj>(
+                wide.begin(), wide.begin() + std::min(_options.documents, PageSize)));
+            _server->setQueryDelay("bench.slow", SlowQueryMs);
+            _server->setCollection("bench.writes", std::vector<mongo::BSONObj>());
+
+            if (!_server->start()) {
+                std::fprintf(stderr, "Cannot start fake server\n");
+                return false;
+            }
+
+            if (!connect())
+                return false;
+
+            // Worker, shared by the rest of scenarios, the way MongoServer keeps one
+            _worker = createWorker();
+            if (roundTrip(_worker, new EstablishConnectionRequest(this, ConnectionPrimary, "robo_bench")) < 0) {
+                std::fprintf(stderr, "Cannot connect to fake server: %s\n", _error.c_str());
+                return false;
+            }
+
+            bool ok = true;
+            ok = query() && ok;
+            ok = paging() && ok;
+            ok = bulkWrites() && ok;
+            ok = cancellation() && ok;
+            ok = script() && ok;
+
+            auto const stats = _server->stats();
+            std::fprintf(stderr, "Fake server: %lld commands, %lld KB in, %lld KB out\n",
+                         stats.commands, stats.bytesIn / 1024, stats.bytesOut / 1024);
+            return ok;
+        }
+
+        void LatencyHarness::handle(EstablishConnectionResponse *event)
+        {
+            replied(event);
+        }
+
+        void LatencyHarness::handle(ExecuteQueryResponse *event)
+        {
+            if (!event->isError())
+                _documents = event->documents;
+            replied(event);
+        }
+
+        void LatencyHarness::handle(InsertDocumentResponse *event)
+        {
+            replied(event);
+        }
+
+        void LatencyHarness::handle(RemoveDocumentResponse *event)
+        {
+            replied(event);
+        }
+
+        void LatencyHarness::handle(ExecuteScriptResponse *event)
+        {
+            replied(event);
+        }
+
+        MongoWorker *LatencyHarness::createWorker() const
+        {
+            // Worker owns (and deletes) its settings
+            auto settings = new ConnectionSettings(false);
+            settings->setServerHost("127.0.0.1");
+            settings->setServerPort(_server->port());
+            return new MongoWorker(settings, false, BatchSize, MongoTimeoutSec, ShellTimeoutSec);
+        }
+
+        std::string LatencyHarness::address() const
+        {
+            return "127.0.0.1:" + std::to_string(_server->port());
+        }
+
+        double LatencyHarness::roundTrip(MongoWorker *worker, Event *request)
+        {
+            auto const start = Clock::now();
+            AppRegistry::instance().bus()->send(worker, request);
+            if (!wait(1) || !_error.empty())
+                return -1;
+
+            return elapsedMs(start);
+        }
+
+        bool LatencyHarness::wait(int replies)
+        {
+            _error.clear();
+            _pending = replies;
+            _timeout.start(_options.timeoutMs);
+            while (_pending > 0 && _timeout.isActive())
+                _loop.exec();
+            _timeout.stop();
+
+            if (_pending > 0)
+                _error = "no reply in " + std::to_string(_options.timeoutMs) + " ms";
+            return _pending <= 0;
+        }
+
+        void LatencyHarness::replied(const Event *event)
+        {
+            if (event->isError() && _error.empty())
+                _error = event->error().errorMessage();
+
+            if (--_pending <= 0)
+                _loop.quit();
+        }
+
+        bool LatencyHarness::connect()
+        {
+            if (!_runner.enabled("connect", _dataset))
+                return true;
+
+            // Includes handshake, buildInfo of main connection and start of the shell
+            std::vector<double> times;
+            for (int i = 0; i < _runner.repeats(); ++i) {
+                MongoWorker *const worker = createWorker();
+                double const ms = roundTrip(worker, new EstablishConnectionRequest(this, ConnectionPrimary, "robo_bench"));
+                worker->stopAndDelete();
+                if (ms < 0) {
+                    std::fprintf(stderr, "connect failed: %s\n", _error.c_str());
+                    return false;
+                }
+                times.push_back(ms);
+            }
+
+            _runner.record("connect", _dataset, 0, 0, times);
+            return true;
+        }
+
+        bool LatencyHarness::query()
+        {
+            if (!_runner.enabled("query", _dataset))
+                return true;
+
+            int const limit = std::min(_options.documents, 1000);
+            CollectionInfo const info(address(), Database, "wide");
+            MongoQueryInfo const queryInfo(info, mongo::BSONObj(), mongo::BSONObj(), limit, 0, 0, 0, false);
+
+            std::vector<double> replyTimes;
+            std::vector<double> renderedTimes;
+            long long bytes = 0;
+            for (int i = 0; i < _runner.repeats(); ++i) {
+                double const ms = roundTrip(_worker, new ExecuteQueryRequest(this, 0, queryInfo));
+                if (ms < 0) {
+                    std::fprintf(stderr, "query failed: %s\n", _error.c_str());
+                    return false;
+                }
+
+                // What OutputItemContentWidget builds for tree and table modes
+                auto const start = Clock::now();
+                BsonTreeModel model(_documents);
+                BsonTableModelProxy proxy;
+                proxy.setSourceModel(&model);
+                consume(proxy.columnCount(QModelIndex()));
+
+                replyTimes.push_back(ms);
+                renderedTimes.push_back(ms + elapsedMs(start));
+                bytes = bsonBytes(_documents);
+            }
+
+            _runner.record("query", _dataset, limit, bytes, replyTimes);
+            _runner.record("query+render", _dataset, limit, bytes, renderedTimes);
+            return true;
+        }
+
+        bool LatencyHarness::paging()
+        {
+            if (!_runner.enabled("paging", _dataset))
+                return true;
+
+            // Every page is separate query with skip, like "next page" button
+            CollectionInfo const info(address(), Database, "wide");
+            std::vector<double> times;
+            long long bytes = 0;
+            for (int i = 0; i < _runner.repeats(); ++i) {
+                for (int page = 0; page < Pages; ++page) {
+                    MongoQueryInfo const queryInfo(info, mongo::BSONObj(), mongo::BSONObj(),
+                                                   PageSize, page * PageSize, 0, 0, false);
+                    double const ms = roundTrip(_worker, new ExecuteQueryRequest(this, 0, queryInfo));
+                    if (ms < 0) {
+                        std::fprintf(stderr, "paging failed: %s\n", _error.c_str());
+                        return false;
+                    }
+
+                    times.push_back(ms);
+                    bytes = bsonBytes(_documents);
+                }
+            }
+
+            _runner.record("paging", _dataset, PageSize, bytes, times);
+            return true;
+        }
+
+        bool LatencyHarness::bulkWrites()
+        {
+            if (!_runner.enabled("bulkInsert", _dataset) && !_runner.enabled("removeAll", _dataset))
+                return true;
+
+            MongoNamespace const ns(Database, "writes");
+            std::vector<double> insertTimes;
+            std::vector<double> removeTimes;
+            long long bytes = 0;
+            for (int i = 0; i < _runner.repeats(); ++i) {
+                // All requests are queued at once, worker executes them one by one
+                auto const start = Clock::now();
+                for (int doc = 0; doc < Inserts; ++doc) {
+                    mongo::BSONObj const obj = wideDocument(doc, WideFields);
+                    bytes += i == 0 ? obj.objsize() : 0;
+                    AppRegistry::instance().bus()->send(_worker, new InsertDocumentRequest(this, obj, ns));
+                }
+                if (!wait(Inserts) || !_error.empty()) {
+                    std::fprintf(stderr, "bulk insert failed: %s\n", _error.c_str());
+                    return false;
+                }
+                insertTimes.push_back(elapsedMs(start));
+
+                double const ms = roundTrip(_worker, new RemoveDocumentRequest(this, mongo::Query(), ns,
+                                                                               RemoveDocumentCount::ALL, 0));
+                if (ms < 0) {
+                    std::fprintf(stderr, "remove failed: %s\n", _error.c_str());
+                    return false;
+                }
+                removeTimes.push_back(ms);
+            }
+
+            _runner.record("bulkInsert", _dataset, Inserts, bytes, insertTimes);
+            _runner.record("removeAll", _dataset, Inserts, bytes, removeTimes);
+            return true;
+        }
+
+        bool LatencyHarness::cancellation()
+        {
+            if (!_runner.enabled("cancel", _dataset))
+                return true;
+
+            // Robo 3T has no way to interrupt running query in the worker, query is killed
+            // on server by another connection, as with db.killOp() in the shell
+            mongo::DBClientConnection admin(true);
+            mongo::Status const status = admin.connect(mongo::HostAndPort("127.0.0.1", _server->port()), "robo_bench");
+            if (!status.isOK()) {
+                std::fprintf(stderr, "cancel failed: %s\n", status.reason().c_str());
+                return false;
+            }
+
+            CollectionInfo const info(address(), Database, "slow");
+            MongoQueryInfo const queryInfo(info, mongo::BSONObj(), mongo::BSONObj(), PageSize, 0, 0, 0, false);
+
+            std::vector<double> times;
+            for (int i = 0; i < _runner.repeats(); ++i) {
+                AppRegistry::instance().bus()->send(_worker, new ExecuteQueryRequest(this, 0, queryInfo));
+
+                // Wait until query reaches the server
+                int opid = -1;
+                auto const started = Clock::now();
+                while (opid < 0 && elapsedMs(started) < _options.timeoutMs) {
+                    mongo::BSONObj ops;
+                    admin.runCommand("admin", BSON("currentOp" << 1), ops);
+                    for (mongo::BSONObjIterator it(ops.getObjectField("inprog")); it.more(); ) {
+                        mongo::BSONObj const op = it.next().Obj();
+                        if (op["ns"].str() == "bench.slow")
+                            opid = op["opid"].numberInt();
+                    }
+
+                    if (opid < 0)
+                        QThread::msleep(2);
+                }
+
+                auto const start = Clock::now();
+                mongo::BSONObj result;
+                if (opid < 0 || !admin.runCommand("admin", BSON("killOp" << 1 << "op" << opid), result)) {
+                    std::fprintf(stderr, "cancel failed: query is not running on server\n");
+                    return false;
+                }
+
+                // Killed query replies with "operation was interrupted" error
+                if (!wait(1) || _error.empty()) {
+                    std::fprintf(stderr, "cancel failed: %s\n", _error.empty() ? "query was not interrupted" : _error.c_str());
+                    return false;
+                }
+                times.push_back(elapsedMs(start));
+            }
+
+            _runner.record("cancel", _dataset, 0, 0, times);
+            return true;
+        }
+
+        bool LatencyHarness::script()
+        {
+            if (!_runner.enabled("script", _dataset))
+                return true;
+
+            std::vector<double> times;
+            for (int i = 0; i < _runner.repeats(); ++i) {
+                double const ms = roundTrip(_worker, new ExecuteScriptRequest(this, "db.wide.find().limit(50)", Database));
+                if (ms < 0) {
+                    std::fprintf(stderr, "script failed: %s\n", _error.c_str());
+                    return false;
+                }
+                times.push_back(ms);
+            }
+
+            _runner.record("script", _dataset, PageSize, 0, times);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <QEventLoop>
+#include <QObject>
+#include <QTimer>
+
+#include "robomongo/core/domain/MongoDocumentList.h"
+
+namespace Robomongo
+{
+    class Event;
+    class MongoWorker;
+    struct EstablishConnectionResponse;
+    class ExecuteQueryResponse;
+    class ExecuteScriptResponse;
+    class InsertDocumentResponse;
+    struct RemoveDocumentResponse;
+
+    namespace Bench
+    {
+        class BenchmarkRunner;
+        class FakeMongoServer;
+
+        /**
+         * @brief End-to-end latency of MongoWorker against FakeMongoServer: time from
+         *        request event to reply event (and to rendered models for queries).
+         *
+         *        Scenarios: connect, query (+ render), paging, bulk insert, remove,
+         *        cancellation of slow query (by killOp) and shell script. Results are
+         *        recorded to runner with dataset "fake-<latency>ms".
+         */
+        class LatencyHarness : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            struct Options
+            {
+                int documents = 2000;       // Documents in queried collection
+                int latencyMs = 0;
+                int bandwidthKBps = 0;
+                int timeoutMs = 60000;      // For one reply
+            };
+
+            LatencyHarness(BenchmarkRunner &runner, const Options &options);
+            ~LatencyHarness();
+
+            // Returns false if fake server does not start or worker cannot connect
+            bool run();
+
+        protected Q_SLOTS:
+            void handle(EstablishConnectionResponse *event);
+            void handle(ExecuteQueryResponse *event);
+            void handle(InsertDocumentResponse *event);
+            void handle(RemoveDocumentResponse *event);
+            void handle(ExecuteScriptResponse *event);
+
+        private:
+            MongoWorker *createWorker() const;
+            std::string address() const;       // "127.0.0.1:<port>" of fake server
+
+            /**
+             * @brief Sends 'request' to worker and waits for reply.
+             *        Returns milliseconds to reply, or negative value on error or timeout.
+             */
+            double roundTrip(MongoWorker *worker, Event *request);
+
+            // Waits for 'replies' replies, false on error or timeout
+            bool wait(int replies);
+            void replied(const Event *event);
+
+            bool connect();
+            bool query();
+            bool paging();
+            bool bulkWrites();
+            bool cancellation();
+            bool script();
+
+            BenchmarkRunner &_runner;
+            Options const _options;
+            std::string const _dataset;
+            std::unique_ptr<FakeMongoServer> _server;
+            MongoWorker *_worker;
+
+            QEventLoop _loop;
+            QTimer _timeout;
+            int _pending;
+            std::string _error;
+            MongoDocumentList _documents;   // Of the last ExecuteQueryResponse
+        };
+    }
+}
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <mongo/db/jsobj.h>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/LargeTextBuffer.h"
+#include "robomongo/gui/widgets/workarea/BsonTableModel.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
+#include "robomongo/gui/widgets/workarea/JsonPrepareThread.h"
+#include "robomongo/shell/bson/json.h"
+
+#include "robomongo-bench/BenchmarkRunner.h"
+#include "robomongo-bench/DocumentGenerators.h"
+#include "robomongo-bench/LatencyHarness.h"
+
+using namespace Robomongo;
+using namespace Robomongo::Bench;
+
+namespace
+{
+    UUIDEncoding const Encoding = DefaultEncoding;
+    SupportedTimes const TimeZone = Utc;
+
+    void runBenchmarks(BenchmarkRunner &runner, const Dataset &dataset)
+    {
+        // Text mode, one document after another
+        runner.run("jsonString", dataset, [&]() {
+            for (auto const &doc : dataset.documents)
+                consume(BsonUtils::jsonString(doc->bsonObj(), mongo::TenGen, 1, Encoding, TimeZone).size());
+        });
+
+        // Values of tree and table cells
+        runner.run("buildJsonString", dataset, [&]() {
+            for (auto const &doc : dataset.documents) {
+                std::string json;
+                BsonUtils::buildJsonString(doc->bsonObj(), json, Encoding, TimeZone);
+                consume(json.size());
+            }
+        });
+
+        // Documents, edited in text
+        runner.run("fromjson", dataset, [&]() {
+            for (auto const &json : dataset.json)
+                consume(mongo::Robomongo::fromjson(json).objsize());
+        });
+
+        runner.run("BsonTreeModel", dataset, [&]() {
+            BsonTreeModel model(dataset.documents);
+            consume(model.rowCount());
+        });
+
+        BsonTreeModel model(dataset.documents);
+        runner.run("BsonTableModelProxy::setSourceModel", dataset, [&]() {
+            BsonTableModelProxy proxy;
+            proxy.setSourceModel(&model);
+            consume(proxy.columnCount(QModelIndex()));
+        });
+
+        runner.run("JsonPrepareThread", dataset, [&]() {
+            auto const target = std::make_shared<LargeTextBuffer>();
+            JsonPrepareThread thread(dataset.documents, Encoding, TimeZone, target);
+            thread.start();
+            thread.wait();
+            consume(target->size());
+        });
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Qt objects (models, threads) do not need display, Core application is enough
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("robo_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks of BSON display paths on synthetic documents and end-to-end\n"
+                                     "latency of MongoWorker against in-process fake server.");
+    parser.addHelpOption();
+    QCommandLineOption const documentsOption("documents", "Documents in each dataset (default 2000).", "count", "2000");
+    QCommandLineOption const repeatsOption("repeats", "Measured runs of each benchmark (default 5).", "count", "5");
+    QCommandLineOption const filterOption("filter", "Run benchmarks with id (name/dataset) containing text.", "text");
+    QCommandLineOption const outputOption("output", "Write JSON results to file instead of stdout.", "file");
+    QCommandLineOption const baselineOption("baseline", "JSON results of an earlier run to compare with.", "file");
+    QCommandLineOption const toleranceOption("tolerance", "Allowed slowdown against baseline (default 0.15).",
+                                             "ratio", "0.15");
+    QCommandLineOption const e2eOption("e2e", "Run end-to-end latency of MongoWorker against fake server "
+                                       "instead of display benchmarks.");
+    QCommandLineOption const latencyOption("latency", "Round trip of fake server in ms (default 0).", "ms", "0");
+    QCommandLineOption const bandwidthOption("bandwidth", "Reply throughput of fake server in KB/s "
+                                             "(default 0, unlimited).", "kbps", "0");
+    parser.addOptions({ documentsOption, repeatsOption, filterOption, outputOption, baselineOption, toleranceOption,
+                        e2eOption, latencyOption, bandwidthOption });
+    parser.process(app);
+
+    // Settings, encryption key and .mongorc.js are under home directory, run with
+    // defaults in a temporary one rather than with (or over) settings of the user
+    QTemporaryDir home;
+    if (!home.isValid()) {
+        std::fprintf(stderr, "Cannot create temporary home directory\n");
+        return 2;
+    }
+    qputenv("HOME", QFile::encodeName(home.path()));
+    qputenv("USERPROFILE", QFile::encodeName(QDir::toNativeSeparators(home.path())));
+
+    // Settings are read by models, load them outside of measured runs
+    AppRegistry::instance();
+
+    int const documents = std::max(parser.value(documentsOption).toInt(), 1);
+    BenchmarkRunner runner(parser.value(repeatsOption).toInt(), parser.value(filterOption).toStdString());
+    if (parser.isSet(e2eOption)) {
+        LatencyHarness::Options options;
+        options.documents = documents;
+        options.latencyMs = std::max(parser.value(latencyOption).toInt(), 0);
+        options.bandwidthKBps = std::max(parser.value(bandwidthOption).toInt(), 0);
+
+        LatencyHarness harness(runner, options);
+        if (!harness.run())
+            return 2;
+    }
+    else {
+        for (auto const &dataset : makeDatasets(documents))
+            runBenchmarks(runner, dataset);
+    }
+
+    QByteArray const json = runner.toJson().toJson();
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "Cannot write %s\n", qPrintable(parser.value(outputOption)));
+            return 2;
+        }
+        file.write(json);
+    }
+    else {
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+    }
+
+    if (!parser.isSet(baselineOption))
+        return 0;
+
+    QFile baselineFile(parser.value(baselineOption));
+    if (!baselineFile.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "Cannot read %s\n", qPrintable(parser.value(baselineOption)));
+        return 2;
+    }
+
+    // Non-zero exit code fails CI job on regression
+    auto const slower = runner.regressions(QJsonDocument::fromJson(baselineFile.readAll()),
+                                           parser.value(toleranceOption).toDouble());
+    for (auto const &id : slower)
+        std::fprintf(stderr, "REGRESSION: %s\n", id.c_str());
+    return slower.empty() ? 0 : 1;
+}
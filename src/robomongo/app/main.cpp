@@ -2,6 +2,7 @@
 #include <QDesktopWidget>
 #include <QCommandLineParser>
 #include <QCommandLineOption>
+#include <QTimer>
 
 #include <locale.h>
 
@@ -17,8 +18,11 @@
 #include <mongo/db/storage/storage_engine_init.h>
 
 #include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/mongodb/WireCompression.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/Logger.h"       
+#include "robomongo/core/utils/StartupTrace.h"
+#include "robomongo/core/utils/Tracer.h"
 #include "robomongo/gui/MainWindow.h"
 #include "robomongo/gui/AppStyle.h"
 #include "robomongo/gui/dialogs/EulaDialog.h"
@@ -27,9 +31,13 @@
 
 int main(int argc, char *argv[], char** envp)
 {
+    auto &startupTrace = Robomongo::StartupTrace::instance();
+
     if (rbm_ssh_init()) 
         return 1;
 
+    startupTrace.mark("SSH library");
+
     // Please check, do we really need envp for other OSes?
 #ifdef Q_OS_WIN
     envp = NULL;
@@ -44,6 +52,9 @@ int main(int argc, char *argv[], char** envp)
     // Cross Platform High DPI support - Qt 5.7
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 
+    // Offer all compressors during handshake, each connection narrows them down later
+    Robomongo::WireCompression::registerAvailable();
+
     // Initialization routine for MongoDB shell
     mongo::runGlobalInitializersOrDie(argc, argv, envp);
     mongo::setGlobalServiceContext(mongo::ServiceContext::make());
@@ -59,9 +70,11 @@ int main(int argc, char *argv[], char** envp)
     auto tlPtr = serviceContext->getTransportLayer();
     uassertStatusOK(tlPtr->setup());
     uassertStatusOK(tlPtr->start());    
+    startupTrace.mark("MongoDB driver and shell");
 
     // Initialize Qt application
     QApplication app(argc, argv);
+    startupTrace.mark("Qt application");
 
     // Set up command line parser
     QCommandLineParser parser;
@@ -75,8 +88,18 @@ int main(int argc, char *argv[], char** envp)
         "file");
     parser.addOption(configFileOption);
 
+    QCommandLineOption traceStartupOption("trace-startup",
+        "Print time spent in each startup phase.");
+    parser.addOption(traceStartupOption);
+
+    QCommandLineOption traceOption("trace",
+        "Record trace spans from startup, see Help > Debug > Export Trace.");
+    parser.addOption(traceOption);
+
     // Process command line arguments
     parser.process(app);
+    startupTrace.setEnabled(parser.isSet(traceStartupOption));
+    Robomongo::Tracer::setEnabled(parser.isSet(traceOption));
 
     // On Unix/Linux Qt is configured to use the system locale settings by default.
     // This can cause a conflict when using POSIX functions, for instance, when
@@ -93,6 +116,7 @@ int main(int argc, char *argv[], char** envp)
      
     // Load external config file if specified
     auto const& settings { Robomongo::AppRegistry::instance().settingsManager() };
+    startupTrace.mark("Settings");
     if (parser.isSet(configFileOption)) {
         QString configFilePath = parser.value(configFileOption);
         if (!settings->loadConnectionsFromFile(configFilePath)) {
@@ -118,6 +142,8 @@ int main(int argc, char *argv[], char** envp)
         settings->save();
     }  
 
+    Robomongo::Logger::instance().setFileEnabled(settings->logToFile());
+
     // Init GUI style
     Robomongo::AppStyleUtils::initStyle();
 
@@ -125,10 +151,19 @@ int main(int argc, char *argv[], char** envp)
     settings->setProgramExitedNormally(false);
     settings->save();
 
+    startupTrace.mark("EULA check and style");
+
     // Application main window
     Robomongo::MainWindow mainWindow;
+    startupTrace.mark("Main window construction");
     mainWindow.show();
 
+    // Runs once the first events (i.e. painting of main window) are processed
+    QTimer::singleShot(0, [&startupTrace]() {
+        startupTrace.mark("Main window shown");
+        startupTrace.finish();
+    });
+
     for(auto const& msgAndSeverity : Robomongo::RoboCrypt::roboCryptLogs())
         Robomongo::LOG_MSG(msgAndSeverity.first, msgAndSeverity.second);
 
@@ -2,6 +2,7 @@
 
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/settings/MetadataCache.h"
 #include "robomongo/core/domain/App.h"
 
 namespace Robomongo
@@ -9,6 +10,7 @@ namespace Robomongo
     AppRegistry::AppRegistry() :
         _bus(new EventBus()),
         _settingsManager(new SettingsManager()),
+        _metadataCache(new MetadataCache()),
         _app(new App(_bus.get()))
     {
     }
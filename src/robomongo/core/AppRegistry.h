@@ -6,6 +6,7 @@
 namespace Robomongo
 {
     class SettingsManager;
+    class MetadataCache;
 
     class AppRegistry: public Patterns::LazySingleton<AppRegistry>
     {
@@ -13,6 +14,7 @@ namespace Robomongo
     public:
 
         SettingsManager *const settingsManager() const { return _settingsManager.get(); }
+        MetadataCache *const metadataCache() const { return _metadataCache.get(); }
         App *const app() const { return _app.get(); }
         EventBus *const bus() const { return _bus.get(); }
 
@@ -22,6 +24,7 @@ namespace Robomongo
 
         const EventBusScopedPtr _bus;
         const SettingsManagerScopedPtr _settingsManager;
+        const MetadataCacheScopedPtr _metadataCache;
         const AppScopedPtr _app;
     };
 }
@@ -19,6 +19,9 @@ namespace Robomongo
     class SettingsManager;
     typedef boost::scoped_ptr<SettingsManager> SettingsManagerScopedPtr;
 
+    class MetadataCache;
+    typedef boost::scoped_ptr<MetadataCache> MetadataCacheScopedPtr;
+
     class App;
     typedef boost::scoped_ptr<App> AppScopedPtr;
 
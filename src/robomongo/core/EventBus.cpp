@@ -10,6 +10,7 @@
 #include "robomongo/core/Event.h"
 #include "robomongo/core/EventWrapper.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace
 {
@@ -56,6 +57,7 @@ namespace Robomongo
 
     void EventBus::publish(Event *event)
     {
+        TraceSpan const span("event", "EventBus::publish", event->typeString());
         QMutexLocker lock(&_lock);
         QList<QObject*> theReceivers;
         EventBusDispatcher *dis = nullptr;
@@ -79,6 +81,7 @@ namespace Robomongo
 
     void EventBus::send(QObject *receiver, Event *event)
     {
+        TraceSpan const span("event", "EventBus::send", event->typeString());
         QMutexLocker lock(&_lock);
 
         if (!receiver)
@@ -92,6 +95,7 @@ namespace Robomongo
 
     void EventBus::send(QList<QObject *> receivers, Event *event)
     {
+        TraceSpan const span("event", "EventBus::send", event->typeString());
         QMutexLocker lock(&_lock);
 
         if (receivers.count() == 0)
@@ -139,7 +143,7 @@ namespace Robomongo
             return (*disIt).second;
         }
         else {
-            EventBusDispatcher *dis = new EventBusDispatcher();
+            EventBusDispatcher *dis = new EventBusDispatcher(thread);
             dis->moveToThread(thread);
             _dispatchersByThread.push_back(ThreadAndDispatcher(thread, dis));
             return dis;
@@ -152,6 +156,10 @@ namespace Robomongo
      */
     void EventBus::sendEvent(EventBusDispatcher *dispatcher, EventWrapper *wrapper)
     {
+        if (Tracer::isEnabled())
+            wrapper->setTraceFlowId(Tracer::instance().beginFlow(wrapper->event()->typeString()));
+
+        dispatcher->eventQueued();
         if (dispatcher->thread() == QThread::currentThread()) {
             QCoreApplication::sendEvent(dispatcher, wrapper);
             delete wrapper;
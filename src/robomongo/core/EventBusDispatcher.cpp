@@ -1,13 +1,32 @@
 #include "robomongo/core/EventBusDispatcher.h"
+
+#include <QCoreApplication>
+#include <QThread>
+
 #include "robomongo/core/EventWrapper.h"
+#include "robomongo/core/utils/Metrics.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace Robomongo
 {
 
-    EventBusDispatcher::EventBusDispatcher(QObject *parent) :
+    EventBusDispatcher::EventBusDispatcher(QThread *thread, QObject *parent) :
         QObject(parent)
     {
+        QCoreApplication *const app = QCoreApplication::instance();
+        QString name = thread->objectName();
+        if (name.isEmpty())
+            name = app && app->thread() == thread ? QString("GUI") : QString("Thread");
+
+        QString const scope = thread->property("metricsScope").toString();
+        _pending = MetricsRegistry::instance().gauge(
+            scope.isEmpty() ? MetricsRegistry::ApplicationScope : scope.toStdString(),
+            "events.pending." + name.toStdString());
+    }
 
+    void EventBusDispatcher::eventQueued()
+    {
+        _pending->add(1);
     }
 
     bool EventBusDispatcher::event(QEvent *qevent)
@@ -17,11 +36,17 @@ namespace Robomongo
         if (!wrapper)
             return false;
 
+        _pending->add(-1);
         Event *event = wrapper->event();
 
         const char *typeName = event->typeString();
         const QList<QObject*> &recivers = wrapper->receivers();
         for (QList<QObject*>::const_iterator it = recivers.begin(); it != recivers.end(); ++it) {
+            // Span of handle() of each receiver, i.e. MongoWorker::handle(ExecuteQueryRequest*)
+            TraceSpan const span("handle", typeName, (*it)->metaObject()->className());
+            if (it == recivers.begin())
+                Tracer::instance().endFlow(typeName, wrapper->traceFlowId());
+
             QMetaObject::invokeMethod(*it, "handle", QGenericArgument(typeName, &event));
         }
 
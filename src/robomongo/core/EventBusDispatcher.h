@@ -1,8 +1,11 @@
 #pragma once
+#include <memory>
 #include <QObject>
 
 namespace Robomongo
 {
+    class Gauge;
+
     /**
      * @brief The EventBusDispatcher class
      */
@@ -10,8 +13,18 @@ namespace Robomongo
     {
         Q_OBJECT
     public:
-        EventBusDispatcher(QObject *parent = 0);
+        /**
+         * @brief Dispatcher of events for receivers of 'thread'. Events waiting to be
+         *        dispatched are counted by "events.pending.<thread name>" gauge, in
+         *        scope of "metricsScope" property of the thread (see MetricsRegistry).
+         */
+        EventBusDispatcher(QThread *thread, QObject *parent = 0);
+
+        // Called for each event, before it is sent or posted to this dispatcher
+        void eventQueued();
     protected:
         virtual bool event(QEvent *qevent);
+    private:
+        std::shared_ptr<Gauge> _pending;
     };
 }
@@ -12,8 +12,13 @@ namespace Robomongo
         Event *event() const;
         const QList<QObject *> &receivers() const;
 
+        // Flow of trace from sender to receivers thread (see Tracer::beginFlow)
+        unsigned long long traceFlowId() const { return _traceFlowId; }
+        void setTraceFlowId(unsigned long long id) { _traceFlowId = id; }
+
     private:
         const boost::scoped_ptr<Event> _event;
         const QList<QObject *> _receivers;
+        unsigned long long _traceFlowId = 0;
     };
 }
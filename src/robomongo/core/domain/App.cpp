@@ -4,6 +4,8 @@
 #include <QInputDialog>
 #include <QMessageBox>
 
+#include "robomongo/core/domain/CompletionIndex.h"
+#include "robomongo/core/domain/CollectionSchema.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoShell.h"
 #include "robomongo/core/domain/MongoCollection.h"
@@ -38,7 +40,10 @@ namespace Robomongo
     }
 
     App::~App()
-    {}
+    {
+        for (auto const& tunnel : _sshTunnels)
+            tunnel.control->stop();
+    }
 
     App::App(EventBus *const bus) : QObject(),
         _bus(bus), _lastServerHandle(0) {
@@ -107,6 +112,7 @@ namespace Robomongo
 
         ConnectionSettings* settingsCopy = connSettings->clone();
         SshTunnelWorker* sshWorker = new SshTunnelWorker(settingsCopy);
+        _sshTunnels.insert(_lastServerHandle, SshTunnel{ sshWorker->control(), 0 });
         _bus->send(sshWorker, new EstablishSshConnectionRequest(this, _lastServerHandle, sshWorker, settingsCopy, type));
         return nullptr;
     }
@@ -172,6 +178,9 @@ namespace Robomongo
     {
         _servers.erase(std::remove_if(_servers.begin(), _servers.end(), 
             [&](auto const& el) { return el.get() == server; }), _servers.end());
+
+        // Server is deleted, so all its connections through the tunnel are closed
+        releaseSshTunnel(server);
     }
 
     void App::openShell(MongoCollection *collection, const QString &filePathToSave)
@@ -215,6 +224,12 @@ namespace Robomongo
         if (!serverClone || !server)
             return;
 
+        // Tab connects through SSH tunnel of explorer's server (if any), so
+        // that no additional SSH handshake is needed
+        auto const tunnel = _sshTunnelUsers.constFind(server);
+        if (tunnel != _sshTunnelUsers.constEnd())
+            retainSshTunnel(serverClone.get(), tunnel.value());
+
         auto shell{ std::make_unique<MongoShell>(serverClone.get(), scriptInfo) };
         _servers.push_back(move(serverClone));
         // Connection between explorer's server and tab's MongoShells
@@ -245,6 +260,7 @@ namespace Robomongo
 
     void App::handle(EstablishSshConnectionResponse *event) {
         if (event->isError()) {
+            _sshTunnels.remove(event->serverHandle);
             _bus->publish(new ConnectionFailedEvent(
                 this, event->serverHandle, event->connectionType, event->error().errorMessage(),
                 ConnectionFailedEvent::SshConnection));
@@ -253,14 +269,16 @@ namespace Robomongo
 
         LOG_MSG(QString("SSH tunnel created successfully"), mongo::logger::LogSeverity::Info());
 
-        _servers.push_back(move(
+        auto server{
             continueOpenServer(event->serverHandle, event->settings, event->connectionType, event->localport)
-        ));
+        };
+        retainSshTunnel(server.get(), event->serverHandle);
+        _servers.push_back(move(server));
         _bus->send(event->worker, new ListenSshConnectionRequest(this, event->serverHandle, event->connectionType));
     }
 
     void App::handle(LogEvent *event) {
-        LOG_MSG(event->message, event->mongoLogSeverity());
+        Logger::instance().print(event->message, event->mongoLogSeverity(), true, event->source);
 
         if (!event->informUser)
             return;
@@ -273,6 +291,9 @@ namespace Robomongo
     }
 
     void App::handle(ListenSshConnectionResponse *event) {
+        // Tunnel is finished, servers that still use it will fail to reconnect
+        _sshTunnels.remove(event->serverHandle);
+
         if (event->isError()) {
             _bus->publish(
                 new ConnectionFailedEvent(this, event->serverHandle, event->connectionType, 
@@ -281,7 +302,35 @@ namespace Robomongo
             return;
         }
 
-        LOG_MSG(QString("SSH tunnel closed."), mongo::logger::LogSeverity::Error());
+        LOG_MSG(QString("SSH tunnel closed."), mongo::logger::LogSeverity::Info());
+    }
+
+    void App::retainSshTunnel(MongoServer const* server, int tunnelHandle)
+    {
+        auto const it = _sshTunnels.find(tunnelHandle);
+        if (it == _sshTunnels.end())
+            return;
+
+        ++it->refs;
+        _sshTunnelUsers.insert(server, tunnelHandle);
+    }
+
+    void App::releaseSshTunnel(MongoServer const* server)
+    {
+        auto const user = _sshTunnelUsers.find(server);
+        if (user == _sshTunnelUsers.end())
+            return;
+
+        int const tunnelHandle = user.value();
+        _sshTunnelUsers.erase(user);
+
+        auto const it = _sshTunnels.find(tunnelHandle);
+        if (it == _sshTunnels.end() || --it->refs > 0)
+            return;
+
+        LOG_MSG(QString("Closing SSH tunnel, it is no longer used."), mongo::logger::LogSeverity::Info());
+        it->control->stop();
+        _sshTunnels.erase(it);
     }
 
     void App::fireConnectionFailedEvent(int serverHandle, ConnectionType type, std::string errormsg,
@@ -316,4 +365,31 @@ namespace Robomongo
         return ok;
     }
 
+    CompletionIndex &App::completionIndex(const QString &uuid)
+    {
+        std::shared_ptr<CompletionIndex> &index = _completionIndexes[uuid];
+        if (!index)
+            index = std::make_shared<CompletionIndex>();
+        return *index;
+    }
+
+    CollectionSchema &App::collectionSchema(const QString &uuid, const std::string &ns, bool *created)
+    {
+        std::shared_ptr<CollectionSchema> &schema = _collectionSchemas[uuid][QtUtils::toQString(ns)];
+        if (created)
+            *created = !schema;
+        if (!schema)
+            schema = std::make_shared<CollectionSchema>();
+        return *schema;
+    }
+
+    const CollectionSchema *App::findCollectionSchema(const QString &uuid, const std::string &ns) const
+    {
+        auto const schemas = _collectionSchemas.constFind(uuid);
+        if (schemas == _collectionSchemas.constEnd())
+            return nullptr;
+
+        auto const schema = schemas->constFind(QtUtils::toQString(ns));
+        return schema != schemas->constEnd() ? schema->get() : nullptr;
+    }
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <QObject>
+#include <QHash>
 #include <vector>
+#include <memory>
 #include <robomongo/core/events/MongoEvents.h>
 
 #include "robomongo/core/domain/ScriptInfo.h"
@@ -15,6 +17,9 @@ namespace Robomongo
     class MongoDatabase;
     class EstablishSshConnectionResponse;
     class LogEvent;
+    class SshTunnelControl;
+    class CompletionIndex;
+    class CollectionSchema;
 
     namespace detail
     {
@@ -87,6 +92,21 @@ namespace Robomongo
 
         int getLastServerHandle() const { return _lastServerHandle; };
 
+        /**
+         * @brief Autocompletion index of connection 'uuid', shared by its explorer
+         *        server, which keeps collection names up to date, and its shells.
+         */
+        CompletionIndex &completionIndex(const QString &uuid);
+
+        /**
+         * @brief Schema of collection 'ns' of connection 'uuid', shared by shells of
+         *        the connection. 'created' is set, if it did not exist yet.
+         */
+        CollectionSchema &collectionSchema(const QString &uuid, const std::string &ns, bool *created = nullptr);
+
+        // Null, if no shell has sampled collection 'ns' yet
+        const CollectionSchema *findCollectionSchema(const QString &uuid, const std::string &ns) const;
+
     public Q_SLOTS:
         void handle(EstablishSshConnectionResponse *event);
         void handle(ListenSshConnectionResponse *event);
@@ -105,6 +125,34 @@ namespace Robomongo
         */
         bool askSslPassphrasePromptDialog(ConnectionSettings *connSettings) const;
 
+        /**
+         * @brief SSH tunnel is opened once per connection and shared by its explorer
+         * server and all shell tabs (they connect to the same local port). Every
+         * such MongoServer holds one reference, tunnel is stopped with the last one.
+         * Sharing is safe, because a failed channel of one server does not stop
+         * the tunnel for others (see rbm_ssh_open_tunnel).
+         */
+        void retainSshTunnel(MongoServer const* server, int tunnelHandle);
+        void releaseSshTunnel(MongoServer const* server);
+
+        struct SshTunnel
+        {
+            std::shared_ptr<SshTunnelControl> control;
+            int refs;
+        };
+
+        // Running SSH tunnels, by handle of the server that opened tunnel
+        QHash<int, SshTunnel> _sshTunnels;
+
+        // Handle of SSH tunnel, used by server
+        QHash<MongoServer const*, int> _sshTunnelUsers;
+
+        // By connection uuid
+        QHash<QString, std::shared_ptr<CompletionIndex>> _completionIndexes;
+
+        // By connection uuid, then by namespace
+        QHash<QString, QHash<QString, std::shared_ptr<CollectionSchema>>> _collectionSchemas;
+
         /**
          * MongoServers, owned by this App.
          */
@@ -0,0 +1,199 @@
+#include "robomongo/core/domain/CollectionSchema.h"
+
+#include <algorithm>
+
+namespace Robomongo
+{
+    CollectionSchema::CollectionSchema() :
+        _nodes(1),
+        _documents(0)
+    {
+        _nodes[0].documents = 0;
+        _nodes[0].lastDocument = 0;
+    }
+
+    void CollectionSchema::addDocument(const mongo::BSONObj &document)
+    {
+        ++_documents;
+        _nodes[0].documents = _documents;
+        addObject(0, document, 1);
+    }
+
+    void CollectionSchema::merge(const CollectionSchema &other)
+    {
+        if (&other == this)
+            return;
+
+        // Paths of 'other' are counted in its own documents, later documents
+        // of this schema get greater numbers than any of them
+        _documents += other._documents;
+        _nodes[0].documents = _documents;
+        mergeNode(0, other, 0);
+    }
+
+    double CollectionSchema::presence(const std::string &path) const
+    {
+        int const node = find(path);
+        if (node <= 0 || _documents == 0)
+            return 0;
+
+        return static_cast<double>(_nodes[node].documents) / _documents;
+    }
+
+    CollectionSchema::TypeHistogram CollectionSchema::types(const std::string &path) const
+    {
+        int const node = find(path);
+        if (node <= 0)
+            return TypeHistogram();
+
+        TypeHistogram types = _nodes[node].types;
+        std::stable_sort(types.begin(), types.end(), [](const std::pair<int, long long> &left,
+                                                        const std::pair<int, long long> &right) {
+            return left.second > right.second;
+        });
+        return types;
+    }
+
+    std::vector<std::string> CollectionSchema::fieldPaths() const
+    {
+        std::vector<std::string> paths;
+        paths.reserve(pathCount());
+        collectPaths(0, std::string(), paths);
+        return paths;
+    }
+
+    std::vector<std::string> CollectionSchema::topLevelFields() const
+    {
+        std::vector<std::string> fields;
+        fields.reserve(_nodes[0].children.size());
+        for (int child : _nodes[0].children)
+            fields.push_back(_nodes[child].name);
+        return fields;
+    }
+
+    void CollectionSchema::addObject(int node, const mongo::BSONObj &obj, int depth)
+    {
+        size_t position = 0;
+        for (mongo::BSONObjIterator it(obj); it.more(); ++position) {
+            mongo::BSONElement const elem = it.next();
+            int field = child(node, elem.fieldName(), position);
+            if (field < 0) {
+                if (pathCount() >= MaxPaths)
+                    continue;
+                field = addChild(node, elem.fieldName());
+            }
+
+            addValue(field, elem, depth);
+        }
+    }
+
+    void CollectionSchema::addValue(int node, const mongo::BSONElement &elem, int depth)
+    {
+        Node &field = _nodes[node];
+        if (field.lastDocument != _documents) {
+            field.lastDocument = _documents;
+            ++field.documents;
+        }
+
+        int const type = elem.type();
+        auto const it = std::find_if(field.types.begin(), field.types.end(),
+                                     [type](const std::pair<int, long long> &count) { return count.first == type; });
+        if (it != field.types.end())
+            ++it->second;
+        else
+            field.types.push_back(std::make_pair(type, 1LL));
+
+        // 'field' is invalidated by children added below
+        if (depth >= MaxDepth)
+            return;
+
+        if (elem.type() == mongo::Object) {
+            addObject(node, elem.Obj(), depth + 1);
+        }
+        else if (elem.type() == mongo::Array) {
+            for (mongo::BSONObjIterator items(elem.Obj()); items.more(); ) {
+                mongo::BSONElement const item = items.next();
+                if (item.type() == mongo::Object)
+                    addObject(node, item.Obj(), depth + 1);
+            }
+        }
+    }
+
+    void CollectionSchema::mergeNode(int node, const CollectionSchema &other, int otherNode)
+    {
+        auto const &otherChildren = other._nodes[otherNode].children;
+        for (size_t i = 0; i < otherChildren.size(); ++i) {
+            Node const &source = other._nodes[otherChildren[i]];
+            int field = child(node, source.name.c_str(), i);
+            if (field < 0) {
+                if (pathCount() >= MaxPaths)
+                    continue;
+                field = addChild(node, source.name.c_str());
+            }
+
+            Node &target = _nodes[field];
+            target.documents += source.documents;
+            for (auto const &count : source.types) {
+                auto const it = std::find_if(target.types.begin(), target.types.end(),
+                    [&count](const std::pair<int, long long> &existing) { return existing.first == count.first; });
+                if (it != target.types.end())
+                    it->second += count.second;
+                else
+                    target.types.push_back(count);
+            }
+
+            mergeNode(field, other, otherChildren[i]);
+        }
+    }
+
+    void CollectionSchema::collectPaths(int node, const std::string &prefix, std::vector<std::string> &paths) const
+    {
+        for (int child : _nodes[node].children) {
+            std::string const path = prefix + _nodes[child].name;
+            paths.push_back(path);
+            collectPaths(child, path + '.', paths);
+        }
+    }
+
+    int CollectionSchema::child(int node, const char *name, size_t hint) const
+    {
+        // Documents of a collection usually have the same fields in the same order
+        auto const &children = _nodes[node].children;
+        if (hint < children.size() && _nodes[children[hint]].name == name)
+            return children[hint];
+
+        for (int child : children) {
+            if (_nodes[child].name == name)
+                return child;
+        }
+        return -1;
+    }
+
+    int CollectionSchema::addChild(int node, const char *name)
+    {
+        int const added = static_cast<int>(_nodes.size());
+        _nodes.emplace_back();    // Invalidates references to nodes
+
+        Node &field = _nodes.back();
+        field.name = name;
+        field.documents = 0;
+        field.lastDocument = 0;
+        _nodes[node].children.push_back(added);
+        return added;
+    }
+
+    int CollectionSchema::find(const std::string &path) const
+    {
+        int node = 0;
+        size_t start = 0;
+        while (node >= 0 && start <= path.size()) {
+            size_t end = path.find('.', start);
+            if (end == std::string::npos)
+                end = path.size();
+
+            node = child(node, path.substr(start, end - start).c_str(), 0);
+            start = end + 1;
+        }
+        return node;
+    }
+}
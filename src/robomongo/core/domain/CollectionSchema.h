@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Field paths of documents of one collection, as a tree of field names
+     *        (i.e. "address" -> "city"), with number of documents, that have each path,
+     *        and histogram of BSON types of its values.
+     *
+     *        Built on MongoWorker from "$sample" of collection and extended on the GUI
+     *        thread with documents of results, as they arrive (see MongoShell).
+     *        Fields of objects inside arrays are children of the array field,
+     *        the same way as in queries (i.e. "tags.name").
+     */
+    class CollectionSchema
+    {
+    public:
+        // Deeper fields and fields over the limit are not tracked
+        static constexpr int MaxDepth = 5;
+        static constexpr size_t MaxPaths = 2000;
+
+        // (BSONType, number of values), most frequent first
+        typedef std::vector<std::pair<int, long long>> TypeHistogram;
+
+        CollectionSchema();
+
+        void addDocument(const mongo::BSONObj &document);
+        void merge(const CollectionSchema &other);
+
+        long long documentCount() const { return _documents; }
+        size_t pathCount() const { return _nodes.size() - 1; }
+
+        // Share of documents having dotted 'path', from 0 to 1
+        double presence(const std::string &path) const;
+        TypeHistogram types(const std::string &path) const;
+
+        // Dotted paths, parents first, in order of first appearance
+        std::vector<std::string> fieldPaths() const;
+        std::vector<std::string> topLevelFields() const;
+
+    private:
+        struct Node
+        {
+            std::string name;
+            long long documents;         // Documents with this path
+            long long lastDocument;      // Last counted document, path may repeat in arrays
+            std::vector<std::pair<int, long long>> types;
+            std::vector<int> children;   // In order of first appearance
+        };
+
+        void addObject(int node, const mongo::BSONObj &obj, int depth);
+        void addValue(int node, const mongo::BSONElement &elem, int depth);
+        void mergeNode(int node, const CollectionSchema &other, int otherNode);
+        void collectPaths(int node, const std::string &prefix, std::vector<std::string> &paths) const;
+
+        // Child of 'node' with 'name', 'hint' is its expected position. -1 if there is none
+        int child(int node, const char *name, size_t hint) const;
+        int addChild(int node, const char *name);
+        int find(const std::string &path) const;
+
+        std::vector<Node> _nodes;   // Root first
+        long long _documents;
+    };
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "CollectionSchema.h"
+
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    typedef std::vector<std::string> Paths;
+}
+
+TEST(collection_schema_tests, paths_presence_and_types)
+{
+    CollectionSchema schema;
+    schema.addDocument(BSON("_id" << 1 << "name" << "a" << "address" << BSON("city" << "X")));
+    schema.addDocument(BSON("_id" << 2 << "name" << 5));
+    schema.addDocument(BSON("_id" << 3 << "tags" << BSON_ARRAY(BSON("name" << "t1") << BSON("name" << "t2"))));
+    schema.addDocument(BSON("name" << "b" << "_id" << 4));
+
+    EXPECT_EQ(4, schema.documentCount());
+    EXPECT_EQ(Paths({ "_id", "name", "address", "tags" }), schema.topLevelFields());
+    EXPECT_EQ(Paths({ "_id", "name", "address", "address.city", "tags", "tags.name" }), schema.fieldPaths());
+
+    EXPECT_DOUBLE_EQ(1.0, schema.presence("_id"));
+    EXPECT_DOUBLE_EQ(0.75, schema.presence("name"));
+    EXPECT_DOUBLE_EQ(0.25, schema.presence("address.city"));
+    // Counted once per document, though present in two array elements
+    EXPECT_DOUBLE_EQ(0.25, schema.presence("tags.name"));
+    EXPECT_DOUBLE_EQ(0.0, schema.presence("missing"));
+
+    CollectionSchema::TypeHistogram const types = schema.types("name");
+    ASSERT_EQ(2u, types.size());
+    EXPECT_EQ(std::make_pair(static_cast<int>(mongo::String), 2LL), types[0]);
+    EXPECT_EQ(std::make_pair(static_cast<int>(mongo::NumberInt), 1LL), types[1]);
+    EXPECT_EQ(2LL, schema.types("tags.name")[0].second);
+}
+
+TEST(collection_schema_tests, merge_sample_with_results)
+{
+    CollectionSchema sample;
+    for (int i = 0; i < 3; ++i)
+        sample.addDocument(BSON("_id" << i << "a" << 1));
+
+    CollectionSchema schema;
+    schema.addDocument(BSON("_id" << 10 << "b" << BSON("c" << true)));
+    schema.merge(sample);
+    schema.addDocument(BSON("_id" << 11 << "a" << "text"));
+
+    EXPECT_EQ(5, schema.documentCount());
+    EXPECT_EQ(Paths({ "_id", "b", "b.c", "a" }), schema.fieldPaths());
+    EXPECT_DOUBLE_EQ(1.0, schema.presence("_id"));
+    EXPECT_DOUBLE_EQ(0.8, schema.presence("a"));
+    EXPECT_EQ(2u, schema.types("a").size());
+}
+
+TEST(collection_schema_tests, limits)
+{
+    CollectionSchema schema;
+    mongo::BSONObjBuilder wide;
+    for (size_t i = 0; i < CollectionSchema::MaxPaths + 100; ++i)
+        wide.append("field" + std::to_string(i), static_cast<int>(i));
+    schema.addDocument(wide.obj());
+    EXPECT_EQ(CollectionSchema::MaxPaths, schema.pathCount());
+
+    CollectionSchema deep;
+    mongo::BSONObj obj = BSON("leaf" << 1);
+    for (int i = 0; i < CollectionSchema::MaxDepth + 3; ++i)
+        obj = BSON("n" << obj);
+    deep.addDocument(obj);
+    EXPECT_EQ(static_cast<size_t>(CollectionSchema::MaxDepth), deep.pathCount());
+}
@@ -0,0 +1,194 @@
+#include "robomongo/core/domain/CompletionIndex.h"
+
+namespace
+{
+    // Methods end with '(', as completions of shellAutocomplete() did
+    const char *const Globals[] = {
+        "db", "rs", "sh", "BinData(", "Date(", "DBRef(", "HexData(", "ISODate(", "MD5(", "MaxKey", "MinKey",
+        "Mongo(", "NumberDecimal(", "NumberInt(", "NumberLong(", "ObjectId(", "Timestamp(", "UUID(",
+        "load(", "print(", "printjson(", "printjsononeline(", "sleep(", "tojson("
+    };
+
+    const char *const DbMethods[] = {
+        "adminCommand(", "aggregate(", "auth(", "cloneDatabase(", "commandHelp(", "copyDatabase(",
+        "createCollection(", "createRole(", "createUser(", "createView(", "currentOp(", "dropAllUsers(",
+        "dropDatabase(", "dropUser(", "eval(", "fsyncLock(", "fsyncUnlock(", "getCollection(",
+        "getCollectionInfos(", "getCollectionNames(", "getLastError(", "getLastErrorObj(", "getLogComponents(",
+        "getMongo(", "getName(", "getProfilingLevel(", "getProfilingStatus(", "getReplicationInfo(",
+        "getRole(", "getRoles(", "getSiblingDB(", "getUser(", "getUsers(", "grantRolesToUser(", "help(",
+        "hostInfo(", "isMaster(", "killOp(", "listCommands(", "logout(", "printCollectionStats(",
+        "printReplicationInfo(", "printShardingStatus(", "printSlaveReplicationInfo(", "repairDatabase(",
+        "revokeRolesFromUser(", "runCommand(", "serverBuildInfo(", "serverCmdLineOpts(", "serverStatus(",
+        "setLogLevel(", "setProfilingLevel(", "shutdownServer(", "stats(", "updateUser(", "version("
+    };
+
+    const char *const CollectionMethods[] = {
+        "aggregate(", "bulkWrite(", "copyTo(", "count(", "countDocuments(", "createIndex(", "createIndexes(",
+        "dataSize(", "deleteMany(", "deleteOne(", "distinct(", "drop(", "dropIndex(", "dropIndexes(",
+        "ensureIndex(", "estimatedDocumentCount(", "explain(", "find(", "findAndModify(", "findOne(",
+        "findOneAndDelete(", "findOneAndReplace(", "findOneAndUpdate(", "getIndexes(", "getName(",
+        "getShardDistribution(", "getShardVersion(", "group(", "initializeOrderedBulkOp(",
+        "initializeUnorderedBulkOp(", "insert(", "insertMany(", "insertOne(", "isCapped(", "latencyStats(",
+        "mapReduce(", "reIndex(", "remove(", "renameCollection(", "replaceOne(", "save(", "stats(",
+        "storageSize(", "totalIndexSize(", "totalSize(", "update(", "updateMany(", "updateOne(",
+        "validate(", "watch("
+    };
+
+    const char *const CursorMethods[] = {
+        "addOption(", "batchSize(", "close(", "collation(", "comment(", "count(", "explain(", "forEach(",
+        "hasNext(", "hint(", "isClosed(", "isExhausted(", "itcount(", "limit(", "map(", "max(", "maxScan(",
+        "maxTimeMS(", "min(", "next(", "noCursorTimeout(", "objsLeftInBatch(", "pretty(", "readConcern(",
+        "readPref(", "returnKey(", "showRecordId(", "size(", "skip(", "snapshot(", "sort(", "tailable(",
+        "toArray("
+    };
+
+    const char *const RsMethods[] = {
+        "add(", "addArb(", "conf(", "config(", "freeze(", "help(", "initiate(", "isMaster(",
+        "printReplicationInfo(", "printSlaveReplicationInfo(", "reconfig(", "remove(", "slaveOk(",
+        "status(", "stepDown(", "syncFrom("
+    };
+
+    const char *const ShMethods[] = {
+        "addShard(", "addShardTag(", "addShardToZone(", "addTagRange(", "balancerCollectionStatus(",
+        "disableAutoSplit(", "disableBalancing(", "enableAutoSplit(", "enableBalancing(", "enableSharding(",
+        "getBalancerState(", "help(", "isBalancerRunning(", "moveChunk(", "removeRangeFromZone(",
+        "removeShardFromZone(", "removeShardTag(", "removeTagRange(", "setBalancerState(",
+        "shardCollection(", "splitAt(", "splitFind(", "startBalancer(", "status(", "stopBalancer(",
+        "updateZoneKeyRange(", "waitForBalancer("
+    };
+
+    template <size_t N>
+    void insertAll(Robomongo::CompletionTrie &trie, const char *const (&words)[N])
+    {
+        for (const char *word : words)
+            trie.insert(word);
+    }
+
+    // Collections with such names can be accessed as property of db, i.e. "db.fs.files"
+    bool isPropertyName(const std::string &name)
+    {
+        if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+            return false;
+
+        for (char ch : name) {
+            bool const valid = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+                               (ch >= '0' && ch <= '9') || ch == '_' || ch == '$' || ch == '.';
+            if (!valid)
+                return false;
+        }
+        return true;
+    }
+}
+
+namespace Robomongo
+{
+    CompletionIndex::CompletionIndex()
+    {
+        insertAll(_globals, Globals);
+        insertAll(_dbMethods, DbMethods);
+        insertAll(_collectionMethods, CollectionMethods);
+        insertAll(_cursorMethods, CursorMethods);
+        insertAll(_rsMethods, RsMethods);
+        insertAll(_shMethods, ShMethods);
+    }
+
+    bool CompletionIndex::hasCollections(const std::string &database) const
+    {
+        return _collections.find(database) != _collections.end();
+    }
+
+    void CompletionIndex::setCollections(const std::string &database, const std::vector<std::string> &names)
+    {
+        CompletionTrie &collections = _collections[database];
+        collections.clear();
+        for (auto const &name : names)
+            collections.insert(name);
+    }
+
+    void CompletionIndex::addCollection(const std::string &database, const std::string &name)
+    {
+        // Databases, which were never listed, stay unknown
+        auto const it = _collections.find(database);
+        if (it != _collections.end())
+            it->second.insert(name);
+    }
+
+    void CompletionIndex::removeCollection(const std::string &database, const std::string &name)
+    {
+        auto const it = _collections.find(database);
+        if (it != _collections.end())
+            it->second.remove(name);
+    }
+
+    void CompletionIndex::addField(const std::string &path)
+    {
+        if (_fields.size() >= MaxFields && !_fields.contains(path))
+            _fields.clear();
+
+        _fields.insert(path);
+    }
+
+    std::vector<std::string> CompletionIndex::complete(const std::string &text, const std::string &database,
+                                                       bool collectionNames) const
+    {
+        std::vector<std::string> result;
+        size_t const dot = text.rfind('.');
+        if (dot == std::string::npos) {
+            _globals.complete(text, MaxCompletions, result);
+            _fields.complete(text, MaxCompletions - result.size(), result);
+            return result;
+        }
+
+        std::string const head = text.substr(0, dot + 1);
+        std::string const partial = text.substr(dot + 1);
+        std::vector<std::string> words;
+
+        if (head == "db.") {
+            if (collectionNames)
+                completeCollections(database, partial, result);
+            _dbMethods.complete(partial, MaxCompletions - result.size(), words);
+        }
+        else if (head.compare(0, 3, "db.") == 0) {
+            // Sub-collections (i.e. "db.fs.fi"), then methods of collection
+            if (collectionNames)
+                completeCollections(database, text.substr(3), result);
+            _collectionMethods.complete(partial, MaxCompletions - result.size(), words);
+        }
+        else if (head == "rs.") {
+            _rsMethods.complete(partial, MaxCompletions, words);
+        }
+        else if (head == "sh.") {
+            _shMethods.complete(partial, MaxCompletions, words);
+        }
+        else if (dot == 0) {
+            // Method chained after call, i.e. "find().so"
+            _cursorMethods.complete(partial, MaxCompletions, words);
+        }
+        else {
+            // Nested field. Type of other receivers (variables) is not known,
+            // methods of a wrong type would only be noise.
+            _fields.complete(text, MaxCompletions, result);
+        }
+
+        for (auto const &word : words)
+            result.push_back(head + word);
+        return result;
+    }
+
+    void CompletionIndex::completeCollections(const std::string &database, const std::string &prefix,
+                                              std::vector<std::string> &result) const
+    {
+        auto const it = _collections.find(database);
+        if (it == _collections.end())
+            return;
+
+        std::vector<std::string> names;
+        it->second.complete(prefix, MaxCompletions - result.size(), names);
+        for (auto const &name : names) {
+            if (isPropertyName(name))
+                result.push_back("db." + name);
+            else
+                result.push_back("db.getCollection('" + name + "')");
+        }
+    }
+}
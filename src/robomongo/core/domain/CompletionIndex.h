@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "robomongo/core/utils/CompletionTrie.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Autocompletion of shell scripts of one connection, answered on the
+     *        GUI thread: shell globals and methods of db, rs, sh, collections and cursors,
+     *        collection names of each database and field names seen in recent results.
+     *
+     *        Collection names are kept up to date incrementally, the same way as
+     *        MetadataCache (see MongoDatabase), fields are added by MongoShell.
+     */
+    class CompletionIndex
+    {
+    public:
+        static constexpr size_t MaxCompletions = 200;
+
+        // Field names are forgotten, when there are more of them
+        static constexpr size_t MaxFields = 5000;
+
+        CompletionIndex();
+
+        bool hasCollections(const std::string &database) const;
+        void setCollections(const std::string &database, const std::vector<std::string> &names);
+        void addCollection(const std::string &database, const std::string &name);
+        void removeCollection(const std::string &database, const std::string &name);
+
+        // Dotted path of field, i.e. "address.city"
+        void addField(const std::string &path);
+
+        /**
+         * @brief Completions of 'text' (expression left of cursor, i.e. "db.us" or ".sor")
+         *        as replacements of the whole text, with current database 'database'.
+         */
+        std::vector<std::string> complete(const std::string &text, const std::string &database,
+                                          bool collectionNames = true) const;
+
+    private:
+        void completeCollections(const std::string &database, const std::string &prefix,
+                                 std::vector<std::string> &result) const;
+
+        CompletionTrie _globals;
+        CompletionTrie _dbMethods;
+        CompletionTrie _collectionMethods;
+        CompletionTrie _cursorMethods;
+        CompletionTrie _rsMethods;
+        CompletionTrie _shMethods;
+        CompletionTrie _fields;
+        std::unordered_map<std::string, CompletionTrie> _collections;  // By database
+    };
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "CompletionIndex.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace Robomongo;
+
+namespace
+{
+    typedef std::vector<std::string> Words;
+
+    CompletionIndex makeIndex()
+    {
+        CompletionIndex index;
+        index.setCollections("shop", { "users", "UserEvents", "orders", "fs.files", "fs.chunks", "price-list" });
+        index.setCollections("logs", { "events" });
+        return index;
+    }
+
+    bool contains(const Words &words, const std::string &word)
+    {
+        return std::find(words.begin(), words.end(), word) != words.end();
+    }
+}
+
+TEST(completion_index_tests, trie)
+{
+    CompletionTrie trie;
+    trie.insert("find(");
+    trie.insert("findOne(");
+    trie.insert("FindX");
+    trie.insert("find(");
+    trie.insert("count(");
+    EXPECT_EQ(4u, trie.size());
+
+    Words words;
+    trie.complete("FIN", 10, words);
+    EXPECT_EQ(Words({ "find(", "findOne(", "FindX" }), words);
+
+    words.clear();
+    trie.complete("f", 2, words);
+    EXPECT_EQ(2u, words.size());
+
+    EXPECT_TRUE(trie.remove("findOne("));
+    EXPECT_FALSE(trie.remove("findOne("));
+    EXPECT_FALSE(trie.contains("findOne("));
+    words.clear();
+    trie.complete("findo", 10, words);
+    EXPECT_TRUE(words.empty());
+}
+
+TEST(completion_index_tests, collections_and_methods)
+{
+    CompletionIndex index = makeIndex();
+
+    Words const db = index.complete("db.us", "shop");
+    EXPECT_EQ(Words({ "db.UserEvents", "db.users" }), db);
+
+    Words const methods = index.complete("db.users.findO", "shop");
+    EXPECT_EQ(Words({ "db.users.findOne(", "db.users.findOneAndDelete(", "db.users.findOneAndReplace(",
+                      "db.users.findOneAndUpdate(" }), methods);
+
+    EXPECT_TRUE(contains(index.complete("db.fs.", "shop"), "db.fs.files"));
+    EXPECT_TRUE(contains(index.complete("db.p", "shop"), "db.getCollection('price-list')"));
+    EXPECT_TRUE(contains(index.complete("db.getS", "shop"), "db.getSiblingDB("));
+    EXPECT_EQ(Words({ ".sort(" }), index.complete(".so", "shop"));
+    EXPECT_TRUE(contains(index.complete("Obj", "shop"), "ObjectId("));
+
+    // Other database, or collection names disabled
+    EXPECT_FALSE(contains(index.complete("db.", "logs"), "db.users"));
+    EXPECT_TRUE(contains(index.complete("db.", "logs"), "db.events"));
+    EXPECT_FALSE(contains(index.complete("db.", "shop", false), "db.users"));
+}
+
+TEST(completion_index_tests, replica_set_and_sharding)
+{
+    CompletionIndex index = makeIndex();
+
+    EXPECT_EQ(Words({ "rs.status(", "rs.stepDown(" }), index.complete("rs.st", "shop"));
+    EXPECT_TRUE(contains(index.complete("rs.", "shop"), "rs.reconfig("));
+    EXPECT_EQ(Words({ "sh.shardCollection(" }), index.complete("sh.shard", "shop"));
+    EXPECT_TRUE(contains(index.complete("sh.", "shop"), "sh.enableSharding("));
+
+    // Not methods of cursor
+    EXPECT_FALSE(contains(index.complete("rs.s", "shop"), "rs.sort("));
+    EXPECT_FALSE(contains(index.complete("sh.s", "shop"), "sh.skip("));
+}
+
+TEST(completion_index_tests, unknown_receiver)
+{
+    CompletionIndex index = makeIndex();
+    index.addField("cursor.id");
+
+    // Only fields, type of variable is not known
+    EXPECT_TRUE(index.complete("cur.so", "shop").empty());
+    EXPECT_TRUE(index.complete("result.", "shop").empty());
+    EXPECT_EQ(Words({ "cursor.id" }), index.complete("cursor.", "shop"));
+}
+
+TEST(completion_index_tests, incremental_updates)
+{
+    CompletionIndex index = makeIndex();
+    index.addCollection("shop", "carts");
+    index.removeCollection("shop", "orders");
+    index.addCollection("unknown", "items");
+
+    EXPECT_TRUE(contains(index.complete("db.ca", "shop"), "db.carts"));
+    EXPECT_FALSE(contains(index.complete("db.or", "shop"), "db.orders"));
+    EXPECT_FALSE(index.hasCollections("unknown"));
+
+    index.addField("address.city");
+    index.addField("address.zip");
+    EXPECT_EQ(Words({ "address.city", "address.zip" }), index.complete("address.", "shop"));
+}
+
+TEST(completion_index_tests, large_database)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 100000; ++i)
+        names.push_back("collection_" + std::to_string(i));
+
+    CompletionIndex index;
+    index.setCollections("big", names);
+
+    auto const start = std::chrono::steady_clock::now();
+    Words const words = index.complete("db.collection_1", "big");
+    auto const end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(CompletionIndex::MaxCompletions, words.size());
+    EXPECT_EQ("db.collection_1", words.front());
+    RecordProperty("completeUs", static_cast<int>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+}
@@ -17,8 +17,14 @@ namespace Robomongo
         std::string fullName() const { return _ns.toString(); }
         MongoDatabase *database() const { return _database; }
 
-//        std::string sizeString() const;
-//        QString storageSizeString() const;
+        std::string sizeString() const;
+        QString storageSizeString() const;
+
+        /**
+         * @brief Replaces statistics (size, storage size, count) of this collection.
+         *        Namespace of 'info' should be the same as of this collection.
+         */
+        void setInfo(const MongoCollectionInfo &info) { _info = info; }
 
     private:
 
@@ -4,9 +4,16 @@
 
 namespace Robomongo
 {
-    MongoCollectionInfo::MongoCollectionInfo(const std::string &ns) : _ns(ns) {}
+    MongoCollectionInfo::MongoCollectionInfo() : 
+        _sizeBytes(0), _storageSizeBytes(0), _count(0), _indexCount(0), _totalIndexSizeBytes(0), 
+        _hasStats(false) {}
 
-/*    MongoCollectionInfo::MongoCollectionInfo(mongo::BSONObj stats) : _ns(stats.getStringField("ns"))
+    MongoCollectionInfo::MongoCollectionInfo(const std::string &ns) : 
+        _ns(ns), _sizeBytes(0), _storageSizeBytes(0), _count(0), _indexCount(0), _totalIndexSizeBytes(0), 
+        _hasStats(false) {}
+
+    MongoCollectionInfo::MongoCollectionInfo(const std::string &ns, mongo::BSONObj stats) : 
+        _ns(ns), _hasStats(true)
     {
         // if "size" and "storageSize" are of type Int32 or Int64, they
         // will be converted to double by "numberDouble()" function.
@@ -15,6 +22,21 @@ namespace Robomongo
 
         // NumberLong because of mongodb can have very big collections
         _count = BsonUtils::getField<mongo::NumberLong>(stats,"count");
-    }*/
+
+        _indexCount = stats.getIntField("nindexes");
+        _totalIndexSizeBytes = BsonUtils::getField<mongo::NumberDouble>(stats, "totalIndexSize");
+
+        mongo::BSONObj const indexSizes = stats.getObjectField("indexSizes");
+        for (mongo::BSONObjIterator it(indexSizes); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            _indexSizes[elem.fieldName()] = elem.numberDouble();
+        }
+    }
+
+    double MongoCollectionInfo::indexSizeBytes(const std::string &indexName) const
+    {
+        auto const it = _indexSizes.find(indexName);
+        return it != _indexSizes.end() ? it->second : -1;
+    }
 }
 
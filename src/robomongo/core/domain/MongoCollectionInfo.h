@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <mongo/bson/bsonobj.h>
 #include "robomongo/core/domain/MongoNamespace.h"
 
@@ -7,29 +8,46 @@ namespace Robomongo
     class MongoCollectionInfo
     {
     public:
-        MongoCollectionInfo() {}
+        MongoCollectionInfo();
         MongoCollectionInfo(const std::string &ns);
-//        MongoCollectionInfo(mongo::BSONObj stats);
+
+        /**
+         * @brief Creates info from result of "collStats" command
+         */
+        MongoCollectionInfo(const std::string &ns, mongo::BSONObj stats);
 
         std::string name() const { return _ns.collectionName(); }
         std::string fullName() const { return _ns.toString(); }
         MongoNamespace ns() const { return _ns; }
 
+        /**
+         * @brief Returns true, if size, storage size and count were loaded
+         */
+        bool hasStats() const { return _hasStats; }
+
         /**
          * @brief Size in bytes
          * It is double, because db.stats()'s "size" field may be double
          * for large values, while Int32 for small.
          */
-//        double sizeBytes() const { return _sizeBytes; }
+        double sizeBytes() const { return _sizeBytes; }
 
         /**
          * @brief Storage size in bytes
          * It is double, because db.stats()'s "storageSize" field may be double
          * for large values, while Int32 for small.
          */
-//        double storageSizeBytes() const { return _storageSizeBytes; }
+        double storageSizeBytes() const { return _storageSizeBytes; }
 
-//        long long count() const { return _count; }
+        long long count() const { return _count; }
+
+        int indexCount() const { return _indexCount; }
+        double totalIndexSizeBytes() const { return _totalIndexSizeBytes; }
+
+        /**
+         * @brief Size of index 'indexName' in bytes, or -1 if unknown
+         */
+        double indexSizeBytes(const std::string &indexName) const;
 
     private:
         MongoNamespace _ns;
@@ -49,6 +67,9 @@ namespace Robomongo
         double _storageSizeBytes;
 
         long long _count;
+        int _indexCount;
+        double _totalIndexSizeBytes;
+        std::map<std::string, double> _indexSizes;
+        bool _hasStats;
     };
 }
-
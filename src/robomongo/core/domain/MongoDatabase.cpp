@@ -1,16 +1,37 @@
 #include "robomongo/core/domain/MongoDatabase.h"
 
+#include <algorithm>
+
+#include "robomongo/core/domain/App.h"
+#include "robomongo/core/domain/CompletionIndex.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoCollection.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/settings/MetadataCache.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/utils/common.h"
 
+namespace
+{
+    Robomongo::MetadataCache *metadataCache()
+    {
+        return Robomongo::AppRegistry::instance().metadataCache();
+    }
+
+    Robomongo::CompletionIndex &completionIndex(Robomongo::MongoServer *server)
+    {
+        return Robomongo::AppRegistry::instance().app()->completionIndex(server->connectionRecord()->uuid());
+    }
+}
+
 namespace Robomongo
 {
     R_REGISTER_EVENT(MongoDatabaseCollectionListLoadedEvent)
+    R_REGISTER_EVENT(MongoDatabaseCollectionStatsLoadedEvent)
+    R_REGISTER_EVENT(MongoDatabaseIndexCatalogLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseUsersLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseFunctionsLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseUsersLoadingEvent)
@@ -29,7 +50,12 @@ namespace Robomongo
         _system(name == "admin" || name == "local"),
         _server(server),
         _bus(AppRegistry::instance().bus()),
-        _name(name) {}
+        _name(name),
+        _collectionsFromCache(false),
+        _indexCatalogPending(0)
+    {
+        _collectionStatsClock.start();
+    }
 
     MongoDatabase::~MongoDatabase()
     {
@@ -38,10 +64,89 @@ namespace Robomongo
 
     void MongoDatabase::loadCollections()
     {
-        _bus->publish(new MongoDatabaseCollectionsLoadingEvent(this));
+        // First expand after (re)connect: render last known collections right away.
+        // Real list is requested below and replaces cached one only if it differs.
+        if (_collections.empty() && loadCollectionsFromCache()) {
+            _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, _collections));
+        }
+        else {
+            _bus->publish(new MongoDatabaseCollectionsLoadingEvent(this));
+        }
+
         _bus->send(_server->worker(), new LoadCollectionNamesRequest(this, _name));
     }
 
+    void MongoDatabase::loadCollectionStats(const std::vector<std::string> &collections)
+    {
+        std::vector<std::string> namespaces;
+        for (auto const& name : collections) {
+            auto const stats = _collectionStats.find(name);
+            bool const fresh = stats != _collectionStats.end() &&
+                _collectionStatsClock.elapsed() - stats->second.loadedAt < CollectionStatsTtlMsec;
+
+            std::string const ns = _name + '.' + name;
+            if (!fresh && _collectionStatsRequested.insert(ns).second)
+                namespaces.push_back(ns);
+        }
+
+        if (namespaces.empty())
+            return;
+
+        // Only collections visible in explorer get here. Each request is served by its own
+        // pooled connection of MongoWorker, so collStats commands run in parallel and
+        // explorer is updated as each part arrives.
+        size_t const requests = std::min<size_t>(CollectionStatsRequests, namespaces.size());
+        std::vector<std::vector<std::string>> parts(requests);
+        for (size_t i = 0; i < namespaces.size(); ++i)
+            parts[i % requests].push_back(namespaces[i]);
+
+        for (auto const& part : parts)
+            _bus->send(_server->worker(), new LoadCollectionStatsRequest(this, _name, part));
+    }
+
+    void MongoDatabase::loadIndexCatalog()
+    {
+        if (_indexCatalogPending > 0 || _collections.empty())
+            return;
+
+        bool const fresh = _indexCatalogAge.isValid() && _indexCatalogAge.elapsed() < CollectionStatsTtlMsec;
+        if (fresh)
+            return;
+
+        // listIndexes is one round trip per collection, parts run in parallel the same
+        // way as collStats (see loadCollectionStats)
+        size_t const requests = std::min<size_t>(CollectionStatsRequests, _collections.size());
+        std::vector<std::vector<MongoCollectionInfo>> collections(requests);
+        for (size_t i = 0; i < _collections.size(); ++i)
+            collections[i % requests].push_back(_collections[i]->info());
+
+        _indexCatalog.clear();
+        _indexCatalogFailed.clear();
+        _indexCatalogPending = static_cast<int>(requests);
+        for (auto const& part : collections)
+            _bus->send(_server->worker(), new LoadDatabaseIndexesRequest(this, _name, part));
+    }
+
+    bool MongoDatabase::cachedIndexes(const std::string &collection, std::vector<IndexInfo> &indexes) const
+    {
+        if (!_indexCatalogAge.isValid() || _indexCatalogAge.elapsed() >= CollectionStatsTtlMsec)
+            return false;
+
+        auto const it = _indexCatalog.find(collection);
+        if (it == _indexCatalog.end())
+            return false;
+
+        indexes = it->second;
+
+        // Sizes are known only if statistics of collection were loaded
+        auto const stats = _collectionStats.find(collection);
+        if (stats != _collectionStats.end()) {
+            for (auto &index : indexes)
+                index._sizeBytes = stats->second.info.indexSizeBytes(index._name);
+        }
+        return true;
+    }
+
     void MongoDatabase::loadUsers()
     {
         _bus->publish(new MongoDatabaseUsersLoadingEvent(this));
@@ -109,20 +214,100 @@ namespace Robomongo
     void MongoDatabase::handle(LoadCollectionNamesResponse *event)
     {
         if (event->isError()) {
+            // Names rendered from cache were not confirmed by the server, do not keep them
+            if (_collectionsFromCache) {
+                _collectionsFromCache = false;
+                clearCollections();
+                _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, _collections));
+            }
+
             _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, event->error()));            
             genericEventErrorHandler(event, "Failed to refresh 'Collections'.", _bus, this);
             return;
         }
 
+        QStringList names;
+        std::vector<std::string> completionNames;
+        for (auto const& collectionInfo : event->collectionInfos()) {
+            names.append(QString::fromStdString(collectionInfo.name()));
+            completionNames.push_back(collectionInfo.name());
+        }
+        completionIndex(_server).setCollections(_name, completionNames);
+
+        bool const changed = metadataCache()->setCollections(_server->connectionRecord()->uuid(),
+                                                             QString::fromStdString(_name), names);
+
+        // Cached list was already rendered and server has nothing new: keep explorer as is
+        if (_collectionsFromCache && !changed) {
+            _collectionsFromCache = false;
+            loadIndexCatalog();
+            LOG_MSG("'Collections' are up to date.", mongo::logger::LogSeverity::Info());
+            return;
+        }
+
+        _collectionsFromCache = false;
         clearCollections();
 
         for (auto const& collectionInfo : event->collectionInfos())
             addCollection(new MongoCollection(this, collectionInfo));
 
+        // Statistics of visible collections are requested by explorer, until then show last known
+        applyCollectionStats();
         _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, _collections));
+        loadIndexCatalog();
         LOG_MSG("'Collections' refreshed.", mongo::logger::LogSeverity::Info());
     }
 
+    void MongoDatabase::handle(LoadCollectionStatsResponse *event)
+    {
+        for (auto const& ns : event->namespaces())
+            _collectionStatsRequested.erase(ns);
+
+        // Collections of failed part have no statistics and are requested again when shown
+        if (event->isError()) {
+            LOG_MSG("Failed to load collection statistics. " + event->error().errorMessage(),
+                    mongo::logger::LogSeverity::Warning());
+            return;
+        }
+
+        qint64 const loadedAt = _collectionStatsClock.elapsed();
+        for (auto const& info : event->collectionInfos())
+            _collectionStats[info.name()] = CollectionStats{ info, loadedAt };
+
+        applyCollectionStats();
+        _bus->publish(new MongoDatabaseCollectionStatsLoadedEvent(this, _collections));
+    }
+
+    void MongoDatabase::handle(LoadDatabaseIndexesResponse *event)
+    {
+        --_indexCatalogPending;
+
+        if (event->isError()) {
+            LOG_MSG("Failed to load indexes of database \'" + _name + "\'. " + event->error().errorMessage(),
+                    mongo::logger::LogSeverity::Warning());
+        }
+
+        // Not in catalog, indexes of them are requested per collection (LoadCollectionIndexesRequest)
+        for (auto const& name : event->failedCollections())
+            _indexCatalogFailed.insert(name);
+
+        for (auto const& index : event->indexes())
+            _indexCatalog[index._collection.name()].push_back(index);
+
+        if (_indexCatalogPending > 0)
+            return;
+
+        // Other collections without indexes are known to have none
+        for (auto const& collection : _collections) {
+            if (_indexCatalogFailed.find(collection->name()) == _indexCatalogFailed.end())
+                _indexCatalog[collection->name()];
+        }
+        _indexCatalogFailed.clear();
+
+        _indexCatalogAge.start();
+        _bus->publish(new MongoDatabaseIndexCatalogLoadedEvent(this));
+    }
+
     void MongoDatabase::handle(CreateFunctionResponse *event)
     {
         if (event->isError()) {
@@ -190,6 +375,48 @@ namespace Robomongo
         _collections.push_back(collection);
     }
 
+    bool MongoDatabase::loadCollectionsFromCache()
+    {
+        bool found = false;
+        QStringList const names = metadataCache()->collections(_server->connectionRecord()->uuid(),
+                                                               QString::fromStdString(_name), &found);
+        if (!found)
+            return false;
+
+        for (auto const& name : names)
+            addCollection(new MongoCollection(this, MongoCollectionInfo(_name + '.' + name.toStdString())));
+
+        _collectionsFromCache = true;
+        return true;
+    }
+
+    void MongoDatabase::applyCollectionStats()
+    {
+        for (auto const& collection : _collections) {
+            auto const it = _collectionStats.find(collection->name());
+            if (it != _collectionStats.end())
+                collection->setInfo(it->second.info);
+        }
+    }
+
+    void MongoDatabase::updateCachedCollections(std::string const& removed, std::string const& added)
+    {
+        // Sizes, counts and indexes are not valid anymore after DDL operation
+        _collectionStats.clear();
+        _indexCatalogAge.invalidate();
+
+        auto const& uuid = _server->connectionRecord()->uuid();
+        if (!removed.empty()) {
+            metadataCache()->removeCollection(uuid, QString::fromStdString(_name), QString::fromStdString(removed));
+            completionIndex(_server).removeCollection(_name, removed);
+        }
+
+        if (!added.empty()) {
+            metadataCache()->addCollection(uuid, QString::fromStdString(_name), QString::fromStdString(added));
+            completionIndex(_server).addCollection(_name, added);
+        }
+    }
+
     void MongoDatabase::handle(CreateCollectionResponse *event) 
     {
         if (event->isError()) {
@@ -197,6 +424,7 @@ namespace Robomongo
             genericEventErrorHandler(event, "Failed to create collection \'" + event->collection + "\'.", _bus, this);
         }
         else {
+            updateCachedCollections("", event->collection);
             loadCollections();
             LOG_MSG("Collection \'" + event->collection + "\' created.", mongo::logger::LogSeverity::Info());
         }
@@ -209,6 +437,7 @@ namespace Robomongo
             genericEventErrorHandler(event, "Failed to drop collection \'" + event->collection + "\'.", _bus, this);
         }
         else {
+            updateCachedCollections(event->collection, "");
             loadCollections();
             LOG_MSG("Collection \'" + event->collection + "\' dropped", mongo::logger::LogSeverity::Info());
         }
@@ -246,6 +475,7 @@ namespace Robomongo
             genericEventErrorHandler(event, "Failed to rename collection.", _bus, this);
         }
         else {
+            updateCachedCollections(event->oldCollection, event->newCollection);
             loadCollections();
             LOG_MSG("Collection \'" + event->oldCollection + "\' renamed to \'" + 
                     event->newCollection +"\'." , mongo::logger::LogSeverity::Info());
@@ -260,6 +490,7 @@ namespace Robomongo
                                    _bus, this);
         }
         else {
+            updateCachedCollections("", event->duplicateCollection);
             loadCollections();
             LOG_MSG("Collection \'" + event->sourceCollection + "\' duplicated as \'" +
                     event->duplicateCollection + "\'.", mongo::logger::LogSeverity::Info());
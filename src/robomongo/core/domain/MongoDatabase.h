@@ -1,6 +1,9 @@
 #pragma once
 
 #include <QObject>
+#include <QElapsedTimer>
+#include <unordered_map>
+#include <unordered_set>
 #include <mongo/bson/bsonobj.h>
 
 #include "robomongo/core/Core.h"
@@ -49,6 +52,34 @@ namespace Robomongo
          */
         void loadCollections();
 
+        /**
+         * @brief Initiate asynchronous loading of statistics (size, storage size, count)
+         *        of 'collections' (i.e. those visible in explorer), in up to
+         *        CollectionStatsRequests parallel parts. Statistics are cached per
+         *        collection for CollectionStatsTtlMsec, collections with fresh or
+         *        already requested statistics are skipped.
+         */
+        void loadCollectionStats(const std::vector<std::string> &collections);
+
+        /**
+         * @brief Initiate asynchronous loading of indexes of all loaded collections
+         *        (index catalog), in up to CollectionStatsRequests parallel parts.
+         *        Catalog is cached like collection statistics. Collections, which
+         *        failed to list indexes, are left out of it.
+         */
+        void loadIndexCatalog();
+
+        /**
+         * @brief Returns cached indexes of 'collection'.
+         * @return false if catalog is not loaded, outdated or has no such collection
+         */
+        bool cachedIndexes(const std::string &collection, std::vector<IndexInfo> &indexes) const;
+
+        /**
+         * @brief Should be called when indexes are changed (added, edited or dropped)
+         */
+        void invalidateIndexCatalog() { _indexCatalogAge.invalidate(); }
+
         /**
          * @brief Initiate loadUsers asynchronous operation.
          */
@@ -81,6 +112,8 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(LoadCollectionNamesResponse *event);
+        void handle(LoadCollectionStatsResponse *event);
+        void handle(LoadDatabaseIndexesResponse *event);
         void handle(LoadUsersResponse *event);
         void handle(LoadFunctionsResponse *event);
         void handle(CreateFunctionResponse *event);
@@ -97,12 +130,55 @@ namespace Robomongo
         void addCollection(MongoCollection *collection);
         void handleIfReplicaSetUnreachable(Event *event);
 
+        /**
+         * @brief Fills collections from MetadataCache.
+         * @return false if there are no cached collections for this database
+         */
+        bool loadCollectionsFromCache();
+
+        /**
+         * @brief Applies result of successful create/drop/rename operation to MetadataCache.
+         *        Empty name means "nothing removed" or "nothing added".
+         */
+        void updateCachedCollections(std::string const& removed, std::string const& added);
+
+        /**
+         * @brief Copies cached statistics (also outdated) to collections.
+         */
+        void applyCollectionStats();
+
     private:
         MongoServer *_server;
         std::vector<MongoCollection *> _collections;
         const std::string _name;
         const bool _system;
         EventBus *_bus;
+
+        // True while rendered collections come from MetadataCache and
+        // were not yet confirmed by the server
+        bool _collectionsFromCache;
+
+        // Collection statistics by collection name, see loadCollectionStats()
+        static const int CollectionStatsTtlMsec = 60 * 1000;
+        // Statistics and index catalog are requested in parts, at most one per
+        // pooled connection of MongoWorker
+        static const int CollectionStatsRequests = 3;
+        struct CollectionStats
+        {
+            MongoCollectionInfo info;
+            qint64 loadedAt;    // Time of _collectionStatsClock
+        };
+        std::unordered_map<std::string, CollectionStats> _collectionStats;
+        QElapsedTimer _collectionStatsClock;
+        // Namespaces, which statistics are being loaded
+        std::unordered_set<std::string> _collectionStatsRequested;
+
+        // Indexes by collection name, see loadIndexCatalog()
+        std::unordered_map<std::string, std::vector<IndexInfo>> _indexCatalog;
+        QElapsedTimer _indexCatalogAge;
+        int _indexCatalogPending;
+        // Collections of the catalog being loaded, which failed to list indexes
+        std::unordered_set<std::string> _indexCatalogFailed;
     };
 
     class MongoDatabaseCollectionListLoadedEvent : public Event
@@ -119,6 +195,23 @@ namespace Robomongo
         std::vector<MongoCollection *> collections;
     };
 
+    class MongoDatabaseCollectionStatsLoadedEvent : public Event
+    {
+        R_EVENT
+
+        MongoDatabaseCollectionStatsLoadedEvent(QObject *sender, const std::vector<MongoCollection *> &list) :
+            Event(sender),
+            collections(list) { }
+
+        std::vector<MongoCollection *> collections;
+    };
+
+    class MongoDatabaseIndexCatalogLoadedEvent : public Event
+    {
+        R_EVENT
+        MongoDatabaseIndexCatalogLoadedEvent(QObject *sender) : Event(sender) {}
+    };
+
     class MongoDatabaseUsersLoadedEvent : public Event
     {
         R_EVENT
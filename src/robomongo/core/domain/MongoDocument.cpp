@@ -1,4 +1,5 @@
 #include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/ResultMemoryGovernor.h"
 
 #include <mongo/client/dbclient_base.h>
 #include "robomongo/core/settings/SettingsManager.h"
@@ -7,7 +8,9 @@
 
 namespace Robomongo
 {
-    MongoDocument::MongoDocument()
+    MongoDocument::MongoDocument() :
+        _byteSize(_bsonObj.objsize()),
+        _spillOffset(-1)
     {
 
     }
@@ -19,10 +22,28 @@ namespace Robomongo
     /*
     ** Create MongoDocument from BsonObj. It will take owned version of BSONObj
     */
-    MongoDocument::MongoDocument(mongo::BSONObj bsonObj) :_bsonObj(bsonObj)
+    MongoDocument::MongoDocument(mongo::BSONObj bsonObj) :
+        _bsonObj(bsonObj),
+        _byteSize(bsonObj.objsize()),
+        _spillOffset(-1)
     {
     }
 
+    mongo::BSONObj MongoDocument::bsonObj() const
+    {
+        if (_spillFile)
+            return _spillFile->at(_spillOffset);
+
+        return _bsonObj;
+    }
+
+    void MongoDocument::spill(std::shared_ptr<const ResultSpillFile> file, qint64 offset)
+    {
+        _spillFile = file;
+        _spillOffset = offset;
+        _bsonObj = mongo::BSONObj();
+    }
+
     /*
     ** Create MongoDocument from BsonObj. It will take owned version of BSONObj
     */ 
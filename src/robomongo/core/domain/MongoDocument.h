@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <QStringList>
 #include <mongo/bson/bsonobj.h>
 
@@ -7,15 +8,21 @@
 
 namespace Robomongo
 {
+    class ResultSpillFile;
+
     /*
     ** Represents MongoDB object.
     */
     class MongoDocument
     {
         /*
-        ** Owned BSONObj
+        ** Owned BSONObj, empty when document is spilled to disk
         */
-        const mongo::BSONObj _bsonObj;
+        mongo::BSONObj _bsonObj;
+        int _byteSize;
+
+        std::shared_ptr<const ResultSpillFile> _spillFile;
+        qint64 _spillOffset;
     public:
         /*
         ** Constructs empty Document, i.e. { }
@@ -39,8 +46,20 @@ namespace Robomongo
         static std::vector<MongoDocumentPtr> fromBsonObj(const std::vector<mongo::BSONObj> &bsonObj);
 
         /*
-        ** Return "native" BSONObj
+        ** Return "native" BSONObj, read back from disk if document is spilled
+        */
+        mongo::BSONObj bsonObj() const;
+
+        /*
+        ** Size of BSON, also of spilled document
+        */
+        int byteSize() const { return _byteSize; }
+
+        /*
+        ** Releases BSONObj, which is at 'offset' of 'file' from now (see ResultMemoryGovernor).
+        ** Not thread-safe, document must not be shared with other threads yet.
         */
-        mongo::BSONObj bsonObj() const { return _bsonObj; }
+        void spill(std::shared_ptr<const ResultSpillFile> file, qint64 offset);
+        bool isSpilled() const { return _spillFile != nullptr; }
     };
 }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "robomongo/core/Core.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Immutable list of documents of one result, handed over from
+     *        MongoClient/ScriptEngine through events and shell results to views.
+     *
+     *        The vector is filled once and moved in, copies of the list share it,
+     *        so that a hop costs one reference count increment instead of one per
+     *        document plus a reallocation.
+     */
+    class MongoDocumentList
+    {
+    public:
+        typedef std::vector<MongoDocumentPtr>::const_iterator const_iterator;
+
+        MongoDocumentList() : _documents(noDocuments()) {}
+
+        explicit MongoDocumentList(std::vector<MongoDocumentPtr> &&documents) :
+            _documents(std::make_shared<const std::vector<MongoDocumentPtr>>(std::move(documents))) {}
+
+        size_t size() const { return _documents->size(); }
+        bool empty() const { return _documents->empty(); }
+
+        const MongoDocumentPtr &operator[](size_t index) const { return (*_documents)[index]; }
+        const MongoDocumentPtr &front() const { return _documents->front(); }
+        const_iterator begin() const { return _documents->begin(); }
+        const_iterator end() const { return _documents->end(); }
+
+        // Lists sharing the same documents
+        bool sharesWith(const MongoDocumentList &other) const { return _documents == other._documents; }
+
+    private:
+        static std::shared_ptr<const std::vector<MongoDocumentPtr>> const &noDocuments()
+        {
+            static auto const documents = std::make_shared<const std::vector<MongoDocumentPtr>>();
+            return documents;
+        }
+
+        std::shared_ptr<const std::vector<MongoDocumentPtr>> _documents;
+    };
+}
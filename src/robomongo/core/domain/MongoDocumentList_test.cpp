@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include "MongoDocumentList.h"
+#include "MongoDocument.h"
+#include "MongoShellResult.h"
+
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+TEST(mongo_document_list_tests, copies_share_documents)
+{
+    std::vector<MongoDocumentPtr> docs;
+    for (int i = 0; i < 1000; ++i)
+        docs.push_back(MongoDocument::fromBsonObj(BSON("_id" << i)));
+    MongoDocumentPtr const first = docs.front();
+
+    MongoDocumentList const list(std::move(docs));
+    EXPECT_EQ(1000u, list.size());
+    EXPECT_EQ(2, first.use_count());
+
+    // Hand-off as it happens from ScriptEngine to OutputItemContentWidget
+    MongoShellResult const result("", "", list, MongoQueryInfo(), "", 0);
+    MongoDocumentList const copy = result.documents();
+    MongoShellResult const resultCopy = result;
+
+    EXPECT_TRUE(copy.sharesWith(list));
+    EXPECT_TRUE(resultCopy.documents().sharesWith(list));
+    EXPECT_EQ(first.get(), copy[0].get());
+    EXPECT_EQ(2, first.use_count());
+}
+
+TEST(mongo_document_list_tests, empty_list)
+{
+    MongoDocumentList const list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    EXPECT_TRUE(list.sharesWith(MongoDocumentList()));
+}
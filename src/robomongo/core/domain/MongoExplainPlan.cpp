@@ -0,0 +1,231 @@
+#include "robomongo/core/domain/MongoExplainPlan.h"
+
+#include <algorithm>
+
+namespace
+{
+    using Robomongo::ExplainStage;
+
+    struct Totals
+    {
+        Totals() : nReturned(-1), docsExamined(-1), keysExamined(-1), executionTimeMillis(-1) {}
+
+        long long nReturned;
+        long long docsExamined;
+        long long keysExamined;
+        long long executionTimeMillis;
+    };
+
+    long long numberOr(const mongo::BSONObj &obj, const char *field, long long defaultValue = -1)
+    {
+        mongo::BSONElement const elem = obj.getField(field);
+        return elem.isNumber() ? elem.numberLong() : defaultValue;
+    }
+
+    // Adds 'value' to 'total', where -1 means "not reported"
+    void accumulate(long long &total, long long value)
+    {
+        if (value < 0)
+            return;
+
+        total = total < 0 ? value : total + value;
+    }
+
+    // Winning plan of "queryPlanner" section. SBE plans (MongoDB 5.0+) keep
+    // classic stage tree in "queryPlan" field.
+    mongo::BSONObj winningPlan(const mongo::BSONObj &queryPlanner)
+    {
+        mongo::BSONObj const plan = queryPlanner.getObjectField("winningPlan");
+        mongo::BSONElement const queryPlan = plan.getField("queryPlan");
+        return queryPlan.isABSONObj() ? queryPlan.Obj() : plan;
+    }
+
+    ExplainStage parseStage(const mongo::BSONObj &obj)
+    {
+        ExplainStage stage;
+        stage.name = obj.getStringField("stage");
+        stage.indexName = obj.getStringField("indexName");
+        stage.nReturned = numberOr(obj, "nReturned");
+        stage.docsExamined = numberOr(obj, "docsExamined");
+        stage.keysExamined = numberOr(obj, "keysExamined");
+        stage.executionTimeMillis = numberOr(obj, "executionTimeMillisEstimate");
+
+        mongo::BSONElement const input = obj.getField("inputStage");
+        if (input.isABSONObj())
+            stage.children.push_back(parseStage(input.Obj()));
+
+        mongo::BSONElement const inputs = obj.getField("inputStages");
+        if (inputs.type() == mongo::Array) {
+            for (auto const& child : inputs.Array()) {
+                if (child.isABSONObj())
+                    stage.children.push_back(parseStage(child.Obj()));
+            }
+        }
+
+        // Sharded find: SHARD_MERGE or SINGLE_SHARD stage with plan of every shard
+        mongo::BSONElement const shards = obj.getField("shards");
+        if (shards.type() == mongo::Array) {
+            for (auto const& elem : shards.Array()) {
+                if (!elem.isABSONObj())
+                    continue;
+
+                mongo::BSONObj const shard = elem.Obj();
+                mongo::BSONObj plan = shard.getObjectField("executionStages");
+                if (plan.isEmpty())
+                    plan = winningPlan(shard);
+
+                ExplainStage child;
+                child.name = std::string("shard: ") + shard.getStringField("shardName");
+                child.nReturned = numberOr(shard, "nReturned");
+                child.docsExamined = numberOr(shard, "totalDocsExamined");
+                child.keysExamined = numberOr(shard, "totalKeysExamined");
+                child.executionTimeMillis = numberOr(shard, "executionTimeMillis");
+                child.children.push_back(parseStage(plan));
+                stage.children.push_back(child);
+            }
+        }
+
+        return stage;
+    }
+
+    ExplainStage parseExplain(const mongo::BSONObj &explain, Totals &totals)
+    {
+        // Find and fully pushed down aggregations
+        mongo::BSONObj const stats = explain.getObjectField("executionStats");
+        if (!stats.isEmpty()) {
+            totals.nReturned = numberOr(stats, "nReturned");
+            totals.docsExamined = numberOr(stats, "totalDocsExamined");
+            totals.keysExamined = numberOr(stats, "totalKeysExamined");
+            totals.executionTimeMillis = numberOr(stats, "executionTimeMillis");
+            return parseStage(stats.getObjectField("executionStages"));
+        }
+
+        // Aggregation pipeline, stages are listed in order of execution
+        mongo::BSONElement const stages = explain.getField("stages");
+        if (stages.type() == mongo::Array) {
+            ExplainStage pipeline;
+            pipeline.name = "PIPELINE";
+            for (auto const& elem : stages.Array()) {
+                if (!elem.isABSONObj())
+                    continue;
+
+                mongo::BSONObj const stageObj = elem.Obj();
+                std::string const name = stageObj.firstElementFieldName();
+
+                ExplainStage stage;
+                if (name == "$cursor") {
+                    // Part of pipeline, executed by query engine
+                    Totals cursor;
+                    stage = parseExplain(stageObj.getObjectField("$cursor"), cursor);
+                    totals.docsExamined = cursor.docsExamined;
+                    totals.keysExamined = cursor.keysExamined;
+                    if (stage.nReturned < 0)
+                        stage.nReturned = cursor.nReturned;
+                }
+                else {
+                    stage.name = name;
+                }
+
+                // Since MongoDB 4.4 every stage of pipeline reports its statistics
+                stage.nReturned = numberOr(stageObj, "nReturned", stage.nReturned);
+                stage.executionTimeMillis =
+                    numberOr(stageObj, "executionTimeMillisEstimate", stage.executionTimeMillis);
+                pipeline.children.push_back(stage);
+            }
+
+            if (!pipeline.children.empty()) {
+                // Time estimates of pipeline stages are cumulative
+                pipeline.nReturned = pipeline.children.back().nReturned;
+                pipeline.executionTimeMillis = pipeline.children.back().executionTimeMillis;
+            }
+
+            totals.nReturned = pipeline.nReturned;
+            totals.executionTimeMillis = pipeline.executionTimeMillis;
+            return pipeline;
+        }
+
+        // Sharded aggregation: { shards: { <shard name>: <explain of shard> } }
+        mongo::BSONElement const shards = explain.getField("shards");
+        if (shards.type() == mongo::Object) {
+            ExplainStage merge;
+            merge.name = "SHARDS";
+            for (mongo::BSONObjIterator it(shards.Obj()); it.more(); ) {
+                mongo::BSONElement const shard = it.next();
+                if (!shard.isABSONObj())
+                    continue;
+
+                Totals shardTotals;
+                ExplainStage child;
+                child.name = std::string("shard: ") + shard.fieldName();
+                child.children.push_back(parseExplain(shard.Obj(), shardTotals));
+                child.nReturned = shardTotals.nReturned;
+                child.docsExamined = shardTotals.docsExamined;
+                child.keysExamined = shardTotals.keysExamined;
+                child.executionTimeMillis = shardTotals.executionTimeMillis;
+
+                accumulate(totals.nReturned, shardTotals.nReturned);
+                accumulate(totals.docsExamined, shardTotals.docsExamined);
+                accumulate(totals.keysExamined, shardTotals.keysExamined);
+                // Shards run in parallel
+                totals.executionTimeMillis =
+                    std::max(totals.executionTimeMillis, shardTotals.executionTimeMillis);
+                merge.children.push_back(child);
+            }
+            return merge;
+        }
+
+        // No execution statistics (i.e. pipeline that was not executed)
+        mongo::BSONObj const queryPlanner = explain.getObjectField("queryPlanner");
+        if (!queryPlanner.isEmpty())
+            return parseStage(winningPlan(queryPlanner));
+
+        return ExplainStage();
+    }
+
+    void collectIndexes(const ExplainStage &stage, std::vector<std::string> &indexes)
+    {
+        if (!stage.indexName.empty() &&
+            std::find(indexes.begin(), indexes.end(), stage.indexName) == indexes.end())
+            indexes.push_back(stage.indexName);
+
+        for (auto const& child : stage.children)
+            collectIndexes(child, indexes);
+    }
+
+    bool containsCollectionScan(const ExplainStage &stage)
+    {
+        if (stage.isCollectionScan())
+            return true;
+
+        return std::any_of(stage.children.begin(), stage.children.end(), containsCollectionScan);
+    }
+}
+
+namespace Robomongo
+{
+    MongoExplainPlan::MongoExplainPlan() :
+        _nReturned(-1), _totalDocsExamined(-1), _totalKeysExamined(-1), _executionTimeMillis(-1) {}
+
+    MongoExplainPlan::MongoExplainPlan(const mongo::BSONObj &explain) :
+        _raw(explain.getOwned())
+    {
+        Totals totals;
+        _root = parseExplain(_raw, totals);
+        _nReturned = totals.nReturned;
+        _totalDocsExamined = totals.docsExamined;
+        _totalKeysExamined = totals.keysExamined;
+        _executionTimeMillis = totals.executionTimeMillis;
+    }
+
+    std::vector<std::string> MongoExplainPlan::indexesUsed() const
+    {
+        std::vector<std::string> indexes;
+        collectIndexes(_root, indexes);
+        return indexes;
+    }
+
+    bool MongoExplainPlan::hasCollectionScan() const
+    {
+        return containsCollectionScan(_root);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief One stage of query plan (i.e. "IXSCAN", "FETCH" or "$group").
+     *        Counters are -1 when server did not report them.
+     */
+    struct ExplainStage
+    {
+        ExplainStage() : nReturned(-1), docsExamined(-1), keysExamined(-1), executionTimeMillis(-1) {}
+
+        bool isCollectionScan() const { return name == "COLLSCAN"; }
+
+        std::string name;
+        std::string indexName;
+        long long nReturned;
+        long long docsExamined;
+        long long keysExamined;
+        long long executionTimeMillis;
+        std::vector<ExplainStage> children;
+    };
+
+    /**
+     * @brief Parsed result of "explain" command with "executionStats" verbosity.
+     *        Understands output of find, aggregate (pipeline "stages") and
+     *        sharded ("shards") explains, and falls back to "queryPlanner"
+     *        winning plan when server returned no execution statistics.
+     */
+    class MongoExplainPlan
+    {
+    public:
+        MongoExplainPlan();
+        explicit MongoExplainPlan(const mongo::BSONObj &explain);
+
+        bool isValid() const { return !_root.name.empty(); }
+        const ExplainStage &root() const { return _root; }
+
+        long long nReturned() const { return _nReturned; }
+        long long totalDocsExamined() const { return _totalDocsExamined; }
+        long long totalKeysExamined() const { return _totalKeysExamined; }
+        long long executionTimeMillis() const { return _executionTimeMillis; }
+
+        /**
+         * @brief Names of all indexes used by plan, without duplicates
+         */
+        std::vector<std::string> indexesUsed() const;
+
+        /**
+         * @brief True if at least one stage scans the whole collection
+         */
+        bool hasCollectionScan() const;
+
+        mongo::BSONObj raw() const { return _raw; }
+
+    private:
+        mongo::BSONObj _raw;
+        ExplainStage _root;
+        long long _nReturned;
+        long long _totalDocsExamined;
+        long long _totalKeysExamined;
+        long long _executionTimeMillis;
+    };
+}
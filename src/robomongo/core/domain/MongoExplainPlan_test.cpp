@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+#include "MongoExplainPlan.h"
+
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+TEST(mongo_explain_plan_tests, find_with_index_scan)
+{
+    auto const explain = BSON(
+        "queryPlanner" << BSON("winningPlan" << BSON("stage" << "FETCH")) <<
+        "executionStats" << BSON(
+            "nReturned" << 3 << "executionTimeMillis" << 2 <<
+            "totalKeysExamined" << 3 << "totalDocsExamined" << 3 <<
+            "executionStages" << BSON(
+                "stage" << "FETCH" << "nReturned" << 3 << "docsExamined" << 3 <<
+                "executionTimeMillisEstimate" << 1 <<
+                "inputStage" << BSON(
+                    "stage" << "IXSCAN" << "indexName" << "age_1" << "nReturned" << 3 <<
+                    "keysExamined" << 3 << "executionTimeMillisEstimate" << 0))));
+
+    MongoExplainPlan const plan(explain);
+    ASSERT_TRUE(plan.isValid());
+    EXPECT_EQ(3, plan.nReturned());
+    EXPECT_EQ(3, plan.totalDocsExamined());
+    EXPECT_EQ(2, plan.executionTimeMillis());
+    EXPECT_FALSE(plan.hasCollectionScan());
+
+    EXPECT_EQ("FETCH", plan.root().name);
+    ASSERT_EQ(1u, plan.root().children.size());
+    EXPECT_EQ("age_1", plan.root().children[0].indexName);
+    EXPECT_EQ(-1, plan.root().children[0].docsExamined);
+    EXPECT_EQ(std::vector<std::string>{"age_1"}, plan.indexesUsed());
+}
+
+TEST(mongo_explain_plan_tests, find_with_collection_scan)
+{
+    auto const explain = BSON(
+        "executionStats" << BSON(
+            "nReturned" << 1 << "totalDocsExamined" << 1000 << "totalKeysExamined" << 0 <<
+            "executionStages" << BSON("stage" << "COLLSCAN" << "docsExamined" << 1000)));
+
+    MongoExplainPlan const plan(explain);
+    EXPECT_TRUE(plan.hasCollectionScan());
+    EXPECT_EQ(1000, plan.totalDocsExamined());
+    EXPECT_TRUE(plan.indexesUsed().empty());
+}
+
+TEST(mongo_explain_plan_tests, aggregation_pipeline_stages)
+{
+    auto const explain = BSON("stages" << BSON_ARRAY(
+        BSON("$cursor" << BSON(
+            "executionStats" << BSON(
+                "nReturned" << 50 << "totalDocsExamined" << 50 << "totalKeysExamined" << 50 <<
+                "executionStages" << BSON("stage" << "IXSCAN" << "indexName" << "city_1"))) <<
+             "nReturned" << 50 << "executionTimeMillisEstimate" << 4) <<
+        BSON("$group" << BSON("_id" << "$city") << "nReturned" << 5 << "executionTimeMillisEstimate" << 6)));
+
+    MongoExplainPlan const plan(explain);
+    EXPECT_EQ("PIPELINE", plan.root().name);
+    ASSERT_EQ(2u, plan.root().children.size());
+    EXPECT_EQ("IXSCAN", plan.root().children[0].name);
+    EXPECT_EQ("$group", plan.root().children[1].name);
+    EXPECT_EQ(5, plan.nReturned());
+    EXPECT_EQ(50, plan.totalDocsExamined());
+    EXPECT_EQ(6, plan.executionTimeMillis());
+}
+
+TEST(mongo_explain_plan_tests, empty_explain_is_invalid)
+{
+    EXPECT_FALSE(MongoExplainPlan().isValid());
+    EXPECT_FALSE(MongoExplainPlan(BSON("ok" << 1)).isValid());
+}
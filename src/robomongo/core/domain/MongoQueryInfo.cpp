@@ -2,6 +2,15 @@
 
 #include <mongo/client/dbclient_base.h>
 
+namespace
+{
+    // Special fields, that are rebuilt by MongoQueryInfo::rewritten()
+    bool isQueryOrSortField(const std::string &name)
+    {
+        return name == "query" || name == "$query" || name == "orderby" || name == "$orderby";
+    }
+}
+
 namespace Robomongo
 {
     namespace detail
@@ -42,4 +51,91 @@ namespace Robomongo
         _options(options),
         _special(special)
         {}
+
+    mongo::BSONObj MongoQueryInfo::filter() const
+    {
+        if (!_special)
+            return _query;
+
+        mongo::BSONElement query = _query.getField("query");
+        if (query.eoo())
+            query = _query.getField("$query");
+
+        return query.isABSONObj() ? query.Obj() : mongo::BSONObj();
+    }
+
+    mongo::BSONObj MongoQueryInfo::sort() const
+    {
+        if (!_special)
+            return mongo::BSONObj();
+
+        mongo::BSONElement orderby = _query.getField("orderby");
+        if (orderby.eoo())
+            orderby = _query.getField("$orderby");
+
+        return orderby.isABSONObj() ? orderby.Obj() : mongo::BSONObj();
+    }
+
+    mongo::BSONObj MongoQueryInfo::hint() const
+    {
+        if (!_special)
+            return mongo::BSONObj();
+
+        mongo::BSONElement const hint = _query.getField("$hint");
+        return hint.isABSONObj() ? hint.Obj() : mongo::BSONObj();
+    }
+
+    MongoQueryInfo MongoQueryInfo::rewritten(const mongo::BSONObj &sort, const mongo::BSONObj &predicate,
+                                             const mongo::BSONObj &hint) const
+    {
+        mongo::BSONObj query = filter();
+        if (!predicate.isEmpty())
+            query = query.isEmpty() ? predicate : BSON("$and" << BSON_ARRAY(query << predicate));
+
+        mongo::BSONObjBuilder builder;
+        builder.append("query", query);
+        if (!sort.isEmpty())
+            builder.append("orderby", sort);
+
+        if (!hint.isEmpty())
+            builder.append("$hint", hint);
+
+        if (_special) {
+            for (mongo::BSONObjIterator it(_query); it.more(); ) {
+                mongo::BSONElement const elem = it.next();
+                std::string const name = elem.fieldName();
+                if (isQueryOrSortField(name) || (name == "$hint" && !hint.isEmpty()))
+                    continue;
+
+                builder.append(elem);
+            }
+        }
+
+        MongoQueryInfo result(*this);
+        result._query = builder.obj();
+        result._special = true;
+        return result;
+    }
+
+    MongoQueryInfo MongoQueryInfo::withReadPreference(const mongo::BSONObj &readPreference) const
+    {
+        mongo::BSONObjBuilder builder;
+        if (_special) {
+            for (mongo::BSONObjIterator it(_query); it.more(); ) {
+                mongo::BSONElement const elem = it.next();
+                if (std::string(elem.fieldName()) != "$readPreference")
+                    builder.append(elem);
+            }
+        }
+        else
+            builder.append("query", _query);
+
+        builder.append("$readPreference", readPreference);
+
+        MongoQueryInfo result(*this);
+        result._query = builder.obj();
+        result._special = true;
+        result._options |= mongo::QueryOption_SlaveOk;
+        return result;
+    }
 }
@@ -28,6 +28,38 @@ namespace Robomongo
                   mongo::BSONObj query, mongo::BSONObj fields, int limit, int skip, int batchSize,
                   int options, bool special);
 
+        /**
+         * @brief Query predicate without special fields (i.e. "orderby", "$hint")
+         */
+        mongo::BSONObj filter() const;
+
+        /**
+         * @brief Sort specification of this query, empty object if not sorted
+         */
+        mongo::BSONObj sort() const;
+
+        /**
+         * @brief Index hint of this query (key pattern), empty object if not hinted
+         */
+        mongo::BSONObj hint() const;
+
+        /**
+         * @brief Returns copy of this query with new sort specification and with
+         *        'predicate' added to the filter (combined with $and).
+         *        Other special fields (i.e. "$max", "$comment") are preserved.
+         * @param sort: new sort specification, empty object removes sorting
+         * @param hint: index to use, empty object keeps hint of this query (if any)
+         */
+        MongoQueryInfo rewritten(const mongo::BSONObj &sort, const mongo::BSONObj &predicate,
+                                 const mongo::BSONObj &hint = mongo::BSONObj()) const;
+
+        /**
+         * @brief Returns copy of this query routed by replica set read preference
+         *        (i.e. { mode: "nearest", maxStalenessSeconds: 120 }), which also
+         *        allows reading from secondaries.
+         */
+        MongoQueryInfo withReadPreference(const mongo::BSONObj &readPreference) const;
+
         CollectionInfo _info;
         mongo::BSONObj _query;
         mongo::BSONObj _fields;
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include "MongoQueryInfo.h"
+
+#include <mongo/client/dbclient_base.h>
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    MongoQueryInfo makeQueryInfo(mongo::BSONObj query, bool special)
+    {
+        return MongoQueryInfo(CollectionInfo("localhost:27017", "test", "users"), 
+                              query, mongo::BSONObj(), 50, 0, 50, 0, special);
+    }
+}
+
+TEST(mongo_query_info_tests, filter_and_sort_of_plain_query)
+{
+    auto const info = makeQueryInfo(BSON("age" << 30), false);
+    EXPECT_EQ(BSON("age" << 30), info.filter());
+    EXPECT_TRUE(info.sort().isEmpty());
+}
+
+TEST(mongo_query_info_tests, filter_and_sort_of_special_query)
+{
+    auto const info = makeQueryInfo(BSON("query" << BSON("age" << 30) << "orderby" << BSON("name" << 1)), true);
+    EXPECT_EQ(BSON("age" << 30), info.filter());
+    EXPECT_EQ(BSON("name" << 1), info.sort());
+}
+
+TEST(mongo_query_info_tests, rewritten_adds_sort_and_hint)
+{
+    auto const info = makeQueryInfo(BSON("age" << 30), false)
+                        .rewritten(BSON("name" << -1), mongo::BSONObj(), BSON("name" << 1));
+    EXPECT_TRUE(info._special);
+    EXPECT_EQ(BSON("age" << 30), info.filter());
+    EXPECT_EQ(BSON("name" << -1), info.sort());
+    EXPECT_EQ(BSON("name" << 1), info._query.getObjectField("$hint"));
+}
+
+TEST(mongo_query_info_tests, rewritten_combines_predicates_and_keeps_specials)
+{
+    auto const original = makeQueryInfo(
+        BSON("query" << BSON("age" << 30) << "orderby" << BSON("name" << 1) << "$comment" << "c"), true);
+    auto const info = original.rewritten(mongo::BSONObj(), BSON("city" << "Paris"));
+
+    EXPECT_EQ(BSON("$and" << BSON_ARRAY(BSON("age" << 30) << BSON("city" << "Paris"))), info.filter());
+    EXPECT_TRUE(info.sort().isEmpty());
+    EXPECT_STREQ("c", info._query.getStringField("$comment"));
+}
+
+TEST(mongo_query_info_tests, with_read_preference_keeps_special_fields)
+{
+    auto const readPref = BSON("mode" << "nearest" << "maxStalenessSeconds" << 120);
+    auto const info = makeQueryInfo(BSON("age" << 30), false)
+                        .rewritten(BSON("name" << 1), mongo::BSONObj())
+                        .withReadPreference(BSON("mode" << "secondaryPreferred"))
+                        .withReadPreference(readPref);
+    EXPECT_EQ(BSON("age" << 30), info.filter());
+    EXPECT_EQ(BSON("name" << 1), info.sort());
+    EXPECT_EQ(readPref, info._query.getObjectField("$readPreference"));
+    EXPECT_TRUE(info._options & mongo::QueryOption_SlaveOk);
+}
@@ -5,6 +5,7 @@
 #include "robomongo/core/settings/SshSettings.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
+#include "robomongo/core/settings/MetadataCache.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
 #include "robomongo/core/mongodb/SshTunnelWorker.h"
 #include "robomongo/core/AppRegistry.h"
@@ -46,6 +47,9 @@ namespace Robomongo {
     MongoServer::~MongoServer() {
         clearDatabases();
 
+        if (ConnectionPrimary == _connectionType)
+            AppRegistry::instance().metadataCache()->flush(_connSettings->uuid());
+
         if (_worker) {
             _worker->stopAndDelete();
         }
@@ -58,6 +62,7 @@ namespace Robomongo {
 
     void MongoServer::tryConnect() 
     {
+        _connectTimer.start();
         _bus->send(_worker, new EstablishConnectionRequest(this, _connectionType, _connSettings->uuid().toStdString()));
     }
 
@@ -213,6 +218,8 @@ namespace Robomongo {
             addDatabase(db);    // todo: serverClones for replica sets should not do this
         }
 
+        updateCachedDatabases(info._databases);
+
         if (_connSettings->isReplicaSet()) {
             _bus->publish(new ConnectionEstablishedEvent(this, event->connectionType, info));
             // In order to do first connection much faster, time consuming refresh 
@@ -220,6 +227,9 @@ namespace Robomongo {
             // successful connection.
             if (ConnectionPrimary == event->connectionType)
                 _bus->send(_worker, new RefreshReplicaSetFolderRequest(this, false));
+
+            // Explorer builds database items of replica set from this list
+            logTimeToInteractive();
         }
 
         // Save connected db version if not saved before and if this is primary connection.
@@ -238,6 +248,12 @@ namespace Robomongo {
         handleReplicaSetRefreshEvents(event->isError(), event->error(), event->replicaSet, event->expanded);
     }
 
+    void MongoServer::handle(ReplicaSetTopologyUpdated *event)
+    {
+        _replicaSetTopology = event->members;
+        _bus->publish(new ReplicaSetTopologyUpdated(this, event->members));
+    }
+
     void MongoServer::handle(LoadDatabaseNamesResponse *event) 
     {
         if (event->isError()) {
@@ -250,9 +266,12 @@ namespace Robomongo {
         for (auto const& dbname : event->databaseNames) 
             addDatabase(new MongoDatabase(this, dbname));
 
+        updateCachedDatabases(event->databaseNames);
+
         _bus->publish(new DatabaseListLoadedEvent(this, _databases));
         LOG_MSG("Database list refreshed. Connection: " + _connSettings->connectionName(), 
                  mongo::logger::LogSeverity::Info());
+        logTimeToInteractive();
     }
 
     void MongoServer::handle(InsertDocumentResponse *event) 
@@ -326,6 +345,8 @@ namespace Robomongo {
             genericEventErrorHandler(event, "Failed to create database \'" + event->database + "\'.", _bus, this);
         }
         else {
+            AppRegistry::instance().metadataCache()->addDatabase(_connSettings->uuid(),
+                                                                 QString::fromStdString(event->database));
             loadDatabases();
             LOG_MSG("Database \'" + event->database + "\' created.", mongo::logger::LogSeverity::Info());
         }
@@ -342,6 +363,8 @@ namespace Robomongo {
             genericEventErrorHandler(event, "Failed to drop database \'" + event->database + "\'.", _bus, this);
         }
         else {
+            AppRegistry::instance().metadataCache()->removeDatabase(_connSettings->uuid(),
+                                                                    QString::fromStdString(event->database));
             loadDatabases();
             LOG_MSG("Database \'" + event->database + "\' dropped.", mongo::logger::LogSeverity::Info());
         }
@@ -357,6 +380,30 @@ namespace Robomongo {
         _worker->changeTimeout(newTimeout);
     }
 
+    void MongoServer::updateCachedDatabases(std::vector<std::string> const& dbNames)
+    {
+        if (ConnectionPrimary != _connectionType)
+            return;
+
+        QStringList names;
+        for (auto const& dbName : dbNames)
+            names.append(QString::fromStdString(dbName));
+
+        auto const cache = AppRegistry::instance().metadataCache();
+        if (cache->setDatabases(_connSettings->uuid(), names))
+            cache->flush(_connSettings->uuid());
+    }
+
+    void MongoServer::logTimeToInteractive()
+    {
+        if (ConnectionPrimary != _connectionType || !_connectTimer.isValid())
+            return;
+
+        LOG_MSG("Time to interactive: " + std::to_string(_connectTimer.elapsed()) + " ms. Connection: " +
+                _connSettings->connectionName(), mongo::logger::LogSeverity::Info());
+        _connectTimer.invalidate();
+    }
+
     void MongoServer::handleReplicaSetRefreshEvents(bool isError, EventError eventError, 
                                                     ReplicaSet const& replicaSet, bool expanded)
     {
@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <QElapsedTimer>
 
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/events/MongoEvents.h"
@@ -14,6 +15,7 @@ namespace Robomongo
     // Messages
     struct EstablishConnectionResponse;
     struct RefreshReplicaSetFolderResponse;
+    struct ReplicaSetTopologyUpdated;
     class LoadDatabaseNamesResponse;
     class InsertDocumentResponse;
     struct CreateDatabaseResponse;
@@ -103,6 +105,9 @@ namespace Robomongo
 
         ReplicaSet* replicaSetInfo() const { return _replicaSetInfo.get(); }
 
+        // Latest round trip times and lags of replica set members, empty until first measured
+        std::vector<ReplicaMemberStats> const& replicaSetTopology() const { return _replicaSetTopology; }
+
         void handle(ReplicaSetRefreshed *event);
 
         void changeWorkerShellTimeout(int newTimeout);
@@ -110,6 +115,7 @@ namespace Robomongo
     protected Q_SLOTS:
         void handle(EstablishConnectionResponse *event);
         void handle(RefreshReplicaSetFolderResponse *event);
+        void handle(ReplicaSetTopologyUpdated *event);
         void handle(LoadDatabaseNamesResponse *event);
         void handle(InsertDocumentResponse *event);
         void handle(RemoveDocumentResponse *event);
@@ -123,6 +129,10 @@ namespace Robomongo
         void updateReplicaSetSettings(EstablishConnectionResponse* event);
         void handleConnectionFailure(EstablishConnectionResponse* event);
         void hideProgressBar() const;
+        void updateCachedDatabases(std::vector<std::string> const& dbNames);
+
+        // Logs time since tryConnect(), once, when explorer receives the first database list
+        void logTimeToInteractive();
 
         MongoWorker *_worker;
         std::unique_ptr<ConnectionSettings> _connSettings;
@@ -137,6 +147,10 @@ namespace Robomongo
 
         QList<MongoDatabase *> _databases;
         std::unique_ptr<ReplicaSet> _replicaSetInfo;
+        std::vector<ReplicaMemberStats> _replicaSetTopology;
+
+        // Measures time from connect request until the first database list reaches explorer
+        QElapsedTimer _connectTimer;
     };
 
     class MongoServerLoadingDatabasesEvent : public Event
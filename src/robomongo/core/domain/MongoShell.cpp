@@ -2,18 +2,46 @@
 
 #include "mongo/scripting/engine.h"
 
+#include "robomongo/core/domain/App.h"
+#include "robomongo/core/domain/CompletionIndex.h"
+#include "robomongo/core/domain/CollectionSchema.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/settings/MetadataCache.h"
 #include "robomongo/core/settings/SettingsManager.h"
 
 namespace Robomongo
 {  
     auto const& eventBus = []() { return AppRegistry::instance().bus(); };
 
+    namespace
+    {
+        // Documents of each result, field names of which are completed
+        const size_t SampledDocuments = 20;
+        const int SampledDepth = 3;
+
+        // Documents of "$sample", schema of collection is built from when its first result arrives
+        const int SchemaSampleSize = 1000;
+
+        void addFields(CompletionIndex &index, const mongo::BSONObj &obj, const std::string &prefix, int depth)
+        {
+            for (mongo::BSONObjIterator it(obj); it.more(); ) {
+                mongo::BSONElement const elem = it.next();
+                std::string const path = prefix + elem.fieldName();
+                index.addField(path);
+
+                if (elem.type() == mongo::Object && depth > 1)
+                    addFields(index, elem.Obj(), path + '.', depth - 1);
+            }
+        }
+    }
+
     MongoShell::MongoShell(MongoServer *server, ScriptInfo scriptInfo) :
         QObject(),
         _scriptInfo(scriptInfo),
@@ -53,17 +81,71 @@ namespace Robomongo
         eventBus()->send(_server->worker(), new ExecuteQueryRequest(this, resultIndex, info));
     }
 
-    void MongoShell::autocomplete(const std::string &prefix)
+    void MongoShell::explain(int resultIndex, const MongoQueryInfo &info, const AggrInfo &aggrInfo)
+    {
+        std::string const dbName = _currentDatabase.empty() ? dbname() : _currentDatabase;
+        eventBus()->send(_server->worker(), 
+            new ExplainQueryRequest(this, resultIndex, info, aggrInfo, dbName));
+    }
+
+    QStringList MongoShell::complete(const QString &prefix)
+    {
+        AutocompletionMode const mode = AppRegistry::instance().settingsManager()->autocompletionMode();
+        if (mode == AutocompleteNone)
+            return QStringList();
+
+        std::string const database = _currentDatabase.empty() ? dbname() : _currentDatabase;
+        QString const& uuid = _server->connectionRecord()->uuid();
+        CompletionIndex &index = AppRegistry::instance().app()->completionIndex(uuid);
+
+        if (mode == AutocompleteAll && !index.hasCollections(database)) {
+            // Names known since last session, or listed once by explorer's database, which
+            // keeps index up to date from then on
+            bool found = false;
+            QStringList const cached = AppRegistry::instance().metadataCache()->collections(
+                uuid, QtUtils::toQString(database), &found);
+
+            std::vector<std::string> names;
+            for (auto const& name : cached)
+                names.push_back(QtUtils::toStdString(name));
+            index.setCollections(database, names);
+
+            if (!found) {
+                for (auto const& server : AppRegistry::instance().app()->getServers()) {
+                    MongoDatabase *db = server->connectionRecord()->uuid() == uuid
+                        ? server->findDatabaseByName(database) : nullptr;
+                    if (db) {
+                        db->loadCollections();
+                        break;
+                    }
+                }
+            }
+        }
+
+        QStringList result;
+        for (auto const& completion : index.complete(QtUtils::toStdString(prefix), database, mode == AutocompleteAll))
+            result.append(QtUtils::toQString(completion));
+        return result;
+    }
+
+    void MongoShell::sampleFields(const MongoNamespace &ns, const MongoDocumentList &documents)
     {
-        AutocompletionMode autocompletionMode {
-            AppRegistry::instance().settingsManager()->autocompletionMode()
-        };
-        if (autocompletionMode == AutocompleteNone)
+        QString const& uuid = _server->connectionRecord()->uuid();
+        CompletionIndex &index = AppRegistry::instance().app()->completionIndex(uuid);
+        for (size_t i = 0; i < documents.size() && i < SampledDocuments; ++i)
+            addFields(index, documents[i]->bsonObj(), std::string(), SampledDepth);
+
+        // Results of aggregations and commands have no collection
+        if (!ns.isValid())
             return;
 
-        eventBus()->send(_server->worker(), 
-            new AutocompleteRequest(this, prefix, autocompletionMode)
-        );
+        bool created = false;
+        CollectionSchema &schema = AppRegistry::instance().app()->collectionSchema(uuid, ns.toString(), &created);
+        if (created)
+            eventBus()->send(_server->worker(), new SampleSchemaRequest(this, ns, SchemaSampleSize));
+
+        for (size_t i = 0; i < documents.size() && i < SampledDocuments; ++i)
+            schema.addDocument(documents[i]->bsonObj());
     }
 
     void MongoShell::stop()
@@ -94,15 +176,46 @@ namespace Robomongo
             return;
         }
 
+        sampleFields(event->queryInfo._info._ns, event->documents);
         eventBus()->publish(
             new DocumentListLoadedEvent(this, 
                 event->resultIndex, event->queryInfo, query(), event->documents)
         );
     }
 
+    void MongoShell::handle(ExplainQueryResponse *event)
+    {
+        if (event->isError()) {
+            eventBus()->publish(new QueryExplainedEvent(this, event->resultIndex, event->error()));
+            return;
+        }
+
+        eventBus()->publish(new QueryExplainedEvent(this, event->resultIndex, event->explain));
+    }
+
+    void MongoShell::handle(SampleSchemaResponse *event)
+    {
+        // Schema stays built from results only
+        if (event->isError())
+            return;
+
+        QString const& uuid = _server->connectionRecord()->uuid();
+        AppRegistry::instance().app()->collectionSchema(uuid, event->ns.toString()).merge(event->schema);
+
+        CompletionIndex &index = AppRegistry::instance().app()->completionIndex(uuid);
+        for (auto const& path : event->schema.fieldPaths())
+            index.addField(path);
+    }
+
     void MongoShell::handle(ExecuteScriptResponse *event)
     {
         if (!event->isError()) {
+            if (event->result.isCurrentDatabaseValid())
+                _currentDatabase = event->result.currentDatabase();
+
+            for (auto const& result : event->result.results())
+                sampleFields(result.queryInfo()._info._ns, result.documents());
+
             eventBus()->publish(
                 new ScriptExecutedEvent(this, event->result, event->empty, event->timeoutReached())
             );
@@ -126,14 +239,4 @@ namespace Robomongo
             return;
         }
     }
-
-    void MongoShell::handle(AutocompleteResponse *event)
-    {
-        if (event->isError()) {
-            eventBus()->publish(new AutocompleteResponse(this, event->error()));
-            return;
-        }
-
-        eventBus()->publish(new AutocompleteResponse(this, event->list, event->prefix));
-    }
 }
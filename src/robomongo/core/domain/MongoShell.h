@@ -17,7 +17,18 @@ namespace Robomongo
 
         void open(const std::string &script, const std::string &dbName = std::string());
         void query(int resultIndex, const MongoQueryInfo &info);
-        void autocomplete(const std::string &prefix);
+
+        /**
+         * @brief Explain find query or, if 'aggrInfo' is valid, aggregation
+         *        of result 'resultIndex'. Publishes QueryExplainedEvent.
+         */
+        void explain(int resultIndex, const MongoQueryInfo &info, const AggrInfo &aggrInfo);
+
+        /**
+         * @brief Completions of 'prefix' (see CompletionIndex), answered without
+         *        a round trip to MongoWorker.
+         */
+        QStringList complete(const QString &prefix);
         void stop();
         MongoServer *server() const { return _server; }
         std::string query() const;
@@ -37,13 +48,23 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(ExecuteQueryResponse *event);
+        void handle(ExplainQueryResponse *event);
+        void handle(SampleSchemaResponse *event);
         void handle(ExecuteScriptResponse *event);
-        void handle(AutocompleteResponse *event);
 
     private:        
+        /**
+         * @brief Adds field names of first documents of results to completions and
+         *        to schema of collection 'ns', which is sampled with the first result.
+         */
+        void sampleFields(const MongoNamespace &ns, const MongoDocumentList &documents);
+
         ScriptInfo _scriptInfo;
         AggrInfo _aggrInfo;
         MongoServer *_server;
+
+        // Database, selected in shell after last script execution ("use <db>")
+        std::string _currentDatabase;
     };
 
 }
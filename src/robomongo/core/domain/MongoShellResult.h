@@ -2,6 +2,7 @@
 #include "robomongo/core/domain/MongoQueryInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
 #include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
 
 namespace Robomongo
 {
@@ -11,7 +12,7 @@ namespace Robomongo
     public:
         MongoShellResult(
             const std::string &type, const std::string &response,
-            const std::vector<MongoDocumentPtr> &documents,
+            const MongoDocumentList &documents,
             const MongoQueryInfo &queryInfo, const std::string &statement,
             qint64 elapsedms, AggrInfo aggrInfo = AggrInfo()) :
             _type(type),
@@ -25,7 +26,7 @@ namespace Robomongo
 
         std::string response() const { return _response; }
         std::string type() const { return _type; }
-        std::vector<MongoDocumentPtr> documents() const { return _documents; }
+        MongoDocumentList const& documents() const { return _documents; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
         std::string statement() const { return _statement; }
         std::string statementShort() const {
@@ -41,7 +42,7 @@ namespace Robomongo
     private:
         std::string _type;
         std::string _response;
-        std::vector<MongoDocumentPtr> _documents;
+        MongoDocumentList _documents;
         MongoQueryInfo _queryInfo;
         std::string const _statement;
         qint64 _elapsedms;
@@ -0,0 +1,393 @@
+#include "robomongo/core/domain/OperationShapes.h"
+
+#include <cstring>
+#include <functional>
+#include <limits>
+
+#include <mongo/db/jsobj.h>
+
+namespace
+{
+    using namespace Robomongo;
+
+    // Index may have at most 32 fields
+    size_t const MaxIndexFields = 32;
+
+    long long numberField(const mongo::BSONObj &obj, const char *name)
+    {
+        mongo::BSONElement const elem = obj.getField(name);
+        return elem.isNumber() ? elem.numberLong() : -1;
+    }
+
+    bool isOperator(const char *name)
+    {
+        return name[0] == '$';
+    }
+
+    // Object, which is a set of query operators, i.e. { $gt: 5, $lt: 10 }
+    bool isOperatorObject(const mongo::BSONElement &elem)
+    {
+        return elem.type() == mongo::Object && isOperator(elem.Obj().firstElementFieldName());
+    }
+
+    bool hasScalarsOnly(const mongo::BSONObj &array)
+    {
+        for (mongo::BSONObjIterator it(array); it.more(); ) {
+            if (it.next().isABSONObj())
+                return false;
+        }
+        return true;
+    }
+
+    void appendShape(std::string &out, const mongo::BSONObj &obj, bool isArray, bool keepOrder);
+
+    void appendValueShape(std::string &out, const mongo::BSONElement &elem, bool keepOrder)
+    {
+        switch (elem.type()) {
+        case mongo::Object:
+            appendShape(out, elem.Obj(), false, keepOrder || std::strcmp(elem.fieldName(), "$sort") == 0);
+            return;
+        case mongo::Array:
+            if (elem.Obj().isEmpty())
+                out += "[]";
+            else if (hasScalarsOnly(elem.Obj()))
+                out += "[?]";
+            else
+                appendShape(out, elem.Obj(), true, keepOrder);
+            return;
+        case mongo::String:
+            // Field reference of pipeline is a part of shape
+            if (isOperator(elem.valuestr())) {
+                out += '"' + elem.str() + '"';
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        out += '?';
+    }
+
+    void appendShape(std::string &out, const mongo::BSONObj &obj, bool isArray, bool keepOrder)
+    {
+        std::vector<mongo::BSONElement> elements;
+        for (mongo::BSONObjIterator it(obj); it.more(); )
+            elements.push_back(it.next());
+
+        if (elements.empty()) {
+            out += isArray ? "[]" : "{}";
+            return;
+        }
+
+        if (!isArray && !keepOrder) {
+            std::sort(elements.begin(), elements.end(), [](const mongo::BSONElement &a, const mongo::BSONElement &b) {
+                return std::strcmp(a.fieldName(), b.fieldName()) < 0;
+            });
+        }
+
+        out += isArray ? "[ " : "{ ";
+        for (size_t i = 0; i < elements.size(); ++i) {
+            if (i > 0)
+                out += ", ";
+            if (!isArray)
+                out += elements[i].fieldName() + std::string(": ");
+            appendValueShape(out, elements[i], keepOrder && !isArray);
+        }
+        out += isArray ? " ]" : " }";
+    }
+
+    /**
+     * @brief Sorts fields of 'filter' into equality and range ones, false if
+     *        filter can not be served by a regular index.
+     */
+    bool collectIndexFields(const mongo::BSONObj &filter, std::vector<std::string> &equality,
+                            std::vector<std::string> &range)
+    {
+        for (mongo::BSONObjIterator it(filter); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+
+            if (name == "$and" && elem.type() == mongo::Array) {
+                for (mongo::BSONObjIterator andIt(elem.Obj()); andIt.more(); ) {
+                    mongo::BSONElement const clause = andIt.next();
+                    if (clause.type() == mongo::Object && !collectIndexFields(clause.Obj(), equality, range))
+                        return false;
+                }
+                continue;
+            }
+
+            if (name == "$comment")
+                continue;
+
+            // $or, $nor, $text, $where, $expr, ...
+            if (isOperator(name.c_str()))
+                return false;
+
+            if (elem.type() == mongo::RegEx) {
+                range.push_back(elem.fieldName());
+                continue;
+            }
+
+            if (!isOperatorObject(elem)) {
+                equality.push_back(elem.fieldName());
+                continue;
+            }
+
+            mongo::BSONObj const operators = elem.Obj();
+            if (operators.hasField("$eq") || operators.hasField("$in"))
+                equality.push_back(elem.fieldName());
+            else if (operators.hasField("$gt") || operators.hasField("$gte") || operators.hasField("$lt") ||
+                     operators.hasField("$lte") || operators.hasField("$regex"))
+                range.push_back(elem.fieldName());
+            // $ne, $nin, $exists, $elemMatch, geo operators, ... do not help an index prefix
+        }
+        return true;
+    }
+
+    // Filter and sort of command, as reported by profiler or currentOp
+    void readCommand(const mongo::BSONObj &command, OperationSample &sample)
+    {
+        if (command.isEmpty())
+            return;
+
+        std::string const name = command.firstElementFieldName();
+        mongo::BSONObj filter;
+        mongo::BSONObj sort;
+        if (name == "find") {
+            filter = command.getObjectField("filter");
+            sort = command.getObjectField("sort");
+        }
+        else if (name == "aggregate") {
+            filter = command.getObjectField("pipeline");
+        }
+        else if (name == "count" || name == "distinct") {
+            filter = command.getObjectField("query");
+        }
+        else if (name == "findAndModify" || name == "findandmodify") {
+            filter = command.getObjectField("query");
+            sort = command.getObjectField("sort");
+        }
+        else if (name == "update" || name == "delete") {
+            // Running update or delete: the first statement of batch
+            mongo::BSONObj const statements = command.getObjectField(name == "update" ? "updates" : "deletes");
+            filter = statements.getObjectField("0").getObjectField("q");
+        }
+        else if (command.hasField("q")) {
+            // Profiled statement of update or delete
+            filter = command.getObjectField("q");
+            sample.command = sample.op;
+            sample.filter = filter.getOwned();
+            return;
+        }
+        else if (command.hasField("$query")) {
+            // Legacy OP_QUERY
+            filter = command.getObjectField("$query");
+            sort = command.getObjectField("$orderby");
+            sample.command = "find";
+            sample.filter = filter.getOwned();
+            sample.sort = sort.getOwned();
+            return;
+        }
+
+        sample.command = name;
+        sample.filter = filter.getOwned();
+        sample.sort = sort.getOwned();
+    }
+}
+
+namespace Robomongo
+{
+    OperationSample OperationSample::fromProfile(const mongo::BSONObj &entry)
+    {
+        OperationSample sample;
+        sample.ns = entry.getStringField("ns");
+        sample.op = entry.getStringField("op");
+        sample.planSummary = entry.getStringField("planSummary");
+        sample.micros = std::max(0LL, numberField(entry, "millis")) * 1000;
+        sample.docsExamined = numberField(entry, "docsExamined");
+        sample.keysExamined = numberField(entry, "keysExamined");
+        sample.returned = numberField(entry, "nreturned");
+
+        // Before 3.2 profiler reported "query" instead of "command"
+        mongo::BSONObj command = entry.getObjectField("command");
+        if (command.isEmpty())
+            command = entry.getObjectField("query");
+        if (sample.op == "getmore" && entry.hasField("originatingCommand"))
+            command = entry.getObjectField("originatingCommand");
+
+        readCommand(command, sample);
+        return sample;
+    }
+
+    OperationSample OperationSample::fromCurrentOp(const mongo::BSONObj &op)
+    {
+        OperationSample sample;
+        sample.ns = op.getStringField("ns");
+        sample.op = op.getStringField("op");
+        sample.planSummary = op.getStringField("planSummary");
+
+        long long const micros = numberField(op, "microsecs_running");
+        sample.micros = micros >= 0 ? micros : std::max(0LL, numberField(op, "secs_running")) * 1000 * 1000;
+
+        // Through mongos opid is a string "shard:opid"
+        mongo::BSONElement const opid = op.getField("opid");
+        if (opid.isNumber())
+            sample.opid = opid.numberLong();
+        else if (opid.type() == mongo::String)
+            sample.opid = std::hash<std::string>()(opid.str()) & std::numeric_limits<long long>::max();
+        else
+            sample.opid = 0;
+
+        mongo::BSONObj command = op.getObjectField("command");
+        if (sample.op == "getmore" && op.hasField("originatingCommand"))
+            command = op.getObjectField("originatingCommand");
+
+        readCommand(command, sample);
+        return sample;
+    }
+
+    bool OperationShape::isInefficient() const
+    {
+        if (planSummary.compare(0, 8, "COLLSCAN") == 0)
+            return true;
+
+        long long const RatioThreshold = 10;
+        return docsExamined > RatioThreshold * std::max(returned, 1LL);
+    }
+
+    void OperationShapeTable::addSample(const std::vector<OperationSample> &operations)
+    {
+        std::map<long long, std::pair<long long, std::string>> running;
+        for (auto const &operation : operations) {
+            std::string const key = keyOf(operation);
+            OperationShape &s = shape(key, operation);
+            s.maxMicros = std::max(s.maxMicros, operation.micros);
+
+            if (!operation.isRunning()) {
+                ++s.profiledCount;
+                s.profiledMicros += operation.micros;
+                s.docsExamined += std::max(0LL, operation.docsExamined);
+                s.keysExamined += std::max(0LL, operation.keysExamined);
+                s.returned += std::max(0LL, operation.returned);
+                continue;
+            }
+
+            // Only the time, that passed since the previous sample
+            long long seen = 0;
+            auto const previous = _running.find(operation.opid);
+            if (previous != _running.end() && previous->second.second == key)
+                seen = previous->second.first;
+            else
+                ++s.observedCount;
+
+            s.observedMicros += std::max(0LL, operation.micros - seen);
+            running[operation.opid] = std::make_pair(operation.micros, key);
+        }
+        _running.swap(running);
+    }
+
+    std::vector<OperationShape> OperationShapeTable::top(size_t count) const
+    {
+        std::vector<OperationShape> shapes;
+        shapes.reserve(_shapes.size());
+        for (auto const &item : _shapes)
+            shapes.push_back(item.second);
+
+        count = std::min(count, shapes.size());
+        std::partial_sort(shapes.begin(), shapes.begin() + count, shapes.end(),
+                          [](const OperationShape &a, const OperationShape &b) {
+                              return a.totalMicros() > b.totalMicros();
+                          });
+        shapes.resize(count);
+        return shapes;
+    }
+
+    void OperationShapeTable::clear()
+    {
+        _shapes.clear();
+        _running.clear();
+    }
+
+    std::string OperationShapeTable::fingerprint(const mongo::BSONObj &query, bool isArray)
+    {
+        std::string shape;
+        appendShape(shape, query, isArray, false);
+        return shape;
+    }
+
+    mongo::BSONObj OperationShapeTable::suggestIndex(const mongo::BSONObj &filter, const mongo::BSONObj &sort)
+    {
+        std::vector<std::string> equality;
+        std::vector<std::string> range;
+        if (!collectIndexFields(filter, equality, range))
+            return mongo::BSONObj();
+
+        std::vector<std::pair<std::string, int>> fields;
+        auto const add = [&fields](const std::string &name, int direction) {
+            auto const found = std::find_if(fields.begin(), fields.end(),
+                                            [&name](const std::pair<std::string, int> &field) { return field.first == name; });
+            if (found == fields.end())
+                fields.push_back(std::make_pair(name, direction));
+        };
+
+        for (auto const &name : equality)
+            add(name, 1);
+        for (mongo::BSONObjIterator it(sort); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            // { score: { $meta: "textScore" } } can not be served by index
+            if (!elem.isNumber())
+                return mongo::BSONObj();
+            add(elem.fieldName(), elem.numberInt() < 0 ? -1 : 1);
+        }
+        for (auto const &name : range)
+            add(name, 1);
+
+        // Collection already has index on _id
+        if (fields.empty() || fields.front().first == "_id")
+            return mongo::BSONObj();
+
+        mongo::BSONObjBuilder keys;
+        for (size_t i = 0; i < fields.size() && i < MaxIndexFields; ++i)
+            keys.append(fields[i].first, fields[i].second);
+        return keys.obj();
+    }
+
+    std::string OperationShapeTable::keyOf(const OperationSample &operation)
+    {
+        std::string shape = fingerprint(operation.filter, operation.command == "aggregate");
+        if (!operation.sort.isEmpty())
+            shape += " sort: " + operation.sort.toString();
+
+        return operation.ns + '\t' + operation.op + '\t' + operation.command + '\t' + shape;
+    }
+
+    OperationShape &OperationShapeTable::shape(const std::string &key, const OperationSample &operation)
+    {
+        auto it = _shapes.find(key);
+        if (it == _shapes.end()) {
+            if (_shapes.size() >= MaxShapes) {
+                auto const least = std::min_element(_shapes.begin(), _shapes.end(),
+                    [](const std::pair<const std::string, OperationShape> &a,
+                       const std::pair<const std::string, OperationShape> &b) {
+                        return a.second.totalMicros() < b.second.totalMicros();
+                    });
+                _shapes.erase(least);
+            }
+
+            OperationShape created;
+            created.ns = operation.ns;
+            created.op = operation.op;
+            created.command = operation.command;
+            created.shape = key.substr(operation.ns.size() + operation.op.size() + operation.command.size() + 3);
+            it = _shapes.insert(std::make_pair(key, created)).first;
+        }
+
+        // The latest operation represents the shape
+        OperationShape &s = it->second;
+        s.filter = operation.filter;
+        s.sort = operation.sort;
+        if (!operation.planSummary.empty())
+            s.planSummary = operation.planSummary;
+        return s;
+    }
+}
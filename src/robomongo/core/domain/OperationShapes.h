@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief One operation, as reported by "system.profile" (finished) or by
+     *        "currentOp" (still running). Built on MongoWorker, so that only
+     *        the parts, needed for aggregation, travel to GUI thread.
+     */
+    struct OperationSample
+    {
+        std::string ns;
+        std::string op;             // "query", "update", "remove", "command", ...
+        std::string command;        // "find", "aggregate", "count", ..., empty if unknown
+        mongo::BSONObj filter;      // Filter, or pipeline of "aggregate"
+        mongo::BSONObj sort;
+        std::string planSummary;    // i.e. "COLLSCAN", "IXSCAN { status: 1 }"
+        long long micros = 0;       // Duration, or running time so far
+        long long docsExamined = -1;
+        long long keysExamined = -1;
+        long long returned = -1;
+        long long opid = -1;        // Running operations only
+
+        bool isRunning() const { return opid >= 0; }
+
+        static OperationSample fromProfile(const mongo::BSONObj &entry);
+        static OperationSample fromCurrentOp(const mongo::BSONObj &op);
+    };
+
+    /**
+     * @brief Operations of one namespace, type and query shape.
+     *
+     *        Finished operations come from the profiler and running ones from
+     *        currentOp, the same operation may be seen by both. Each source alone
+     *        is a lower bound of the real figures, so shape reports the one,
+     *        that has seen more time.
+     */
+    struct OperationShape
+    {
+        std::string ns;
+        std::string op;
+        std::string command;
+        std::string shape;          // Filter with literal values replaced by '?'
+
+        // Of the latest operation: for explain and index suggestion
+        mongo::BSONObj filter;
+        mongo::BSONObj sort;
+        std::string planSummary;
+
+        long long profiledCount = 0;
+        long long profiledMicros = 0;
+        long long observedCount = 0;    // Distinct running operations seen
+        long long observedMicros = 0;   // Running time, seen between samples
+        long long maxMicros = 0;
+        long long docsExamined = 0;     // Of profiled operations
+        long long keysExamined = 0;
+        long long returned = 0;
+
+        long long count() const { return profiledMicros >= observedMicros ? profiledCount : observedCount; }
+        long long totalMicros() const { return std::max(profiledMicros, observedMicros); }
+
+        // Collection scan, or much more documents examined than returned
+        bool isInefficient() const;
+    };
+
+    /**
+     * @brief Aggregation of sampled operations by shape, with bounded memory:
+     *        when there are MaxShapes of them, new shape replaces the one with
+     *        the least total time.
+     */
+    class OperationShapeTable
+    {
+    public:
+        static constexpr size_t MaxShapes = 256;
+
+        /**
+         * @brief Adds one sample: finished operations since the previous sample
+         *        and all operations running now. Running time of an operation
+         *        is counted once, even though it is seen by several samples.
+         */
+        void addSample(const std::vector<OperationSample> &operations);
+
+        // 'count' shapes with the most total time, most first
+        std::vector<OperationShape> top(size_t count) const;
+
+        size_t size() const { return _shapes.size(); }
+        void clear();
+
+        /**
+         * @brief Normalized shape of 'query': fields in sorted order, literal values
+         *        replaced by '?', arrays of literals (i.e. of $in) collapsed to [?].
+         *        Stages of pipeline ('isArray') keep their order, so do fields of
+         *        $sort, field references ("$field") are kept.
+         *
+         *        { b: { $in: [1, 2] }, a: 5 }  ->  { a: ?, b: { $in: [?] } }
+         */
+        static std::string fingerprint(const mongo::BSONObj &query, bool isArray = false);
+
+        /**
+         * @brief Index for 'filter' and 'sort' after Equality-Sort-Range rule:
+         *        equality fields first, then sort fields, then range fields.
+         *        Empty if filter can not use a regular index ($or, $text, $where,
+         *        $expr) or if the index would start with "_id".
+         */
+        static mongo::BSONObj suggestIndex(const mongo::BSONObj &filter, const mongo::BSONObj &sort);
+
+    private:
+        // Namespace, type and shape of 'operation'
+        static std::string keyOf(const OperationSample &operation);
+        OperationShape &shape(const std::string &key, const OperationSample &operation);
+
+        std::unordered_map<std::string, OperationShape> _shapes;
+
+        // Running time of operations (by opid) seen by the previous sample and their shapes
+        std::map<long long, std::pair<long long, std::string>> _running;
+    };
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "OperationShapes.h"
+
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    OperationSample profiled(const std::string &ns, const mongo::BSONObj &filter, long long millis)
+    {
+        return OperationSample::fromProfile(BSON(
+            "op" << "query" << "ns" << ns << "millis" << millis << "docsExamined" << 100 << "nreturned" << 1 <<
+            "planSummary" << "COLLSCAN" <<
+            "command" << BSON("find" << ns.substr(ns.find('.') + 1) << "filter" << filter)));
+    }
+
+    OperationSample running(long long opid, const mongo::BSONObj &filter, long long micros)
+    {
+        return OperationSample::fromCurrentOp(BSON(
+            "opid" << opid << "op" << "query" << "ns" << "db.users" << "microsecs_running" << micros <<
+            "command" << BSON("find" << "users" << "filter" << filter)));
+    }
+}
+
+TEST(operation_shapes_tests, fingerprint_replaces_literals)
+{
+    EXPECT_EQ("{ a: ?, b: { $in: [?] } }",
+              OperationShapeTable::fingerprint(BSON("b" << BSON("$in" << BSON_ARRAY(1 << 2)) << "a" << 5)));
+    EXPECT_EQ(OperationShapeTable::fingerprint(BSON("a" << 1 << "b" << "x")),
+              OperationShapeTable::fingerprint(BSON("b" << "y" << "a" << 2)));
+    EXPECT_EQ("{}", OperationShapeTable::fingerprint(mongo::BSONObj()));
+
+    // Pipeline keeps order of stages and of $sort fields, and field references
+    mongo::BSONObj const pipeline = BSON_ARRAY(
+        BSON("$match" << BSON("status" << "A")) <<
+        BSON("$sort" << BSON("z" << 1 << "a" << -1)) <<
+        BSON("$group" << BSON("_id" << "$cust")));
+    EXPECT_EQ("[ { $match: { status: ? } }, { $sort: { z: ?, a: ? } }, { $group: { _id: \"$cust\" } } ]",
+              OperationShapeTable::fingerprint(pipeline, true));
+}
+
+TEST(operation_shapes_tests, suggests_index_after_equality_sort_range)
+{
+    mongo::BSONObj const filter = BSON("age" << BSON("$gt" << 30) << "status" << "A" <<
+                                       "$and" << BSON_ARRAY(BSON("city" << BSON("$in" << BSON_ARRAY("X" << "Y")))));
+    EXPECT_EQ(BSON("status" << 1 << "city" << 1 << "created" << -1 << "age" << 1),
+              OperationShapeTable::suggestIndex(filter, BSON("created" << -1)));
+
+    EXPECT_TRUE(OperationShapeTable::suggestIndex(BSON("_id" << 5), mongo::BSONObj()).isEmpty());
+    EXPECT_TRUE(OperationShapeTable::suggestIndex(
+        BSON("$or" << BSON_ARRAY(BSON("a" << 1) << BSON("b" << 2))), mongo::BSONObj()).isEmpty());
+    EXPECT_TRUE(OperationShapeTable::suggestIndex(mongo::BSONObj(), mongo::BSONObj()).isEmpty());
+}
+
+TEST(operation_shapes_tests, aggregates_by_shape_and_counts_running_time_once)
+{
+    OperationShapeTable table;
+    table.addSample({ profiled("db.users", BSON("name" << "a"), 10),
+                      profiled("db.users", BSON("name" << "b"), 20),
+                      profiled("db.orders", BSON("total" << BSON("$gt" << 5)), 5) });
+
+    auto shapes = table.top(10);
+    ASSERT_EQ(2u, shapes.size());
+    EXPECT_EQ("db.users", shapes[0].ns);
+    EXPECT_EQ("find", shapes[0].command);
+    EXPECT_EQ("{ name: ? }", shapes[0].shape);
+    EXPECT_EQ(2, shapes[0].count());
+    EXPECT_EQ(30000, shapes[0].totalMicros());
+    EXPECT_EQ(20000, shapes[0].maxMicros);
+    EXPECT_EQ(BSON("name" << "b"), shapes[0].filter);
+    EXPECT_TRUE(shapes[0].isInefficient());
+
+    // Operation 7 is seen by two samples, its running time adds up to 500 ms
+    OperationShapeTable runningTable;
+    runningTable.addSample({ running(7, BSON("age" << 1), 200000) });
+    runningTable.addSample({ running(7, BSON("age" << 1), 500000), running(8, BSON("age" << 2), 1000) });
+    shapes = runningTable.top(1);
+    ASSERT_EQ(1u, shapes.size());
+    EXPECT_EQ(2, shapes[0].count());
+    EXPECT_EQ(501000, shapes[0].totalMicros());
+}
+
+TEST(operation_shapes_tests, keeps_bounded_number_of_shapes)
+{
+    OperationShapeTable table;
+    for (size_t i = 0; i < OperationShapeTable::MaxShapes + 10; ++i) {
+        std::string const field = "f" + std::to_string(i);
+        table.addSample({ profiled("db.c", BSON(field << 1), 100 + i) });
+    }
+
+    EXPECT_EQ(OperationShapeTable::MaxShapes, table.size());
+    EXPECT_EQ("{ f265: ? }", table.top(1)[0].shape);
+
+    table.clear();
+    EXPECT_EQ(0u, table.size());
+}
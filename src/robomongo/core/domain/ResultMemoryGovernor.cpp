@@ -0,0 +1,121 @@
+#include "robomongo/core/domain/ResultMemoryGovernor.h"
+
+#include <QDir>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/Logger.h"
+
+namespace Robomongo
+{
+    std::shared_ptr<ResultSpillFile> ResultSpillFile::create(const std::vector<mongo::BSONObj> &objs,
+                                                             std::vector<qint64> &offsets)
+    {
+        std::shared_ptr<ResultSpillFile> spill(new ResultSpillFile);
+        spill->_file.setFileTemplate(
+            QString("%1/" PROJECT_NAME_LOWERCASE "-results-XXXXXX.bson").arg(QDir::tempPath()));
+        if (!spill->_file.open())
+            return nullptr;
+
+        std::vector<qint64> written;
+        for (auto const& obj : objs) {
+            written.push_back(spill->_size);
+            if (spill->_file.write(obj.objdata(), obj.objsize()) != obj.objsize())
+                return nullptr;
+
+            spill->_size += obj.objsize();
+        }
+
+        if (!spill->_file.flush())
+            return nullptr;
+
+        if (spill->_size > 0) {
+            spill->_data = spill->_file.map(0, spill->_size);
+            if (!spill->_data)
+                return nullptr;
+        }
+
+        offsets.insert(offsets.end(), written.begin(), written.end());
+        return spill;
+    }
+
+    mongo::BSONObj ResultSpillFile::at(qint64 offset) const
+    {
+        return mongo::BSONObj(reinterpret_cast<const char *>(_data + offset)).getOwned();
+    }
+
+    ResultMemoryGovernor::ResultMemoryGovernor(qint64 budgetBytes) :
+        _budgetBytes(budgetBytes),
+        _memoryBytes(0)
+    {
+    }
+
+    ResultMemoryGovernor &ResultMemoryGovernor::instance()
+    {
+        static ResultMemoryGovernor governor(
+            qint64(AppRegistry::instance().settingsManager()->resultsMemoryBudgetMb()) * 1024 * 1024);
+        return governor;
+    }
+
+    ResultMemoryGovernor::Usage ResultMemoryGovernor::admit(const void *owner,
+                                                            const MongoDocumentList &documents)
+    {
+        release(owner);
+
+        Usage usage;
+        qint64 const available = _budgetBytes > 0 ? _budgetBytes - _memoryBytes : -1;
+
+        std::vector<MongoDocument *> toSpill;
+        std::vector<mongo::BSONObj> objs;
+        for (auto const& doc : documents) {
+            if (doc->isSpilled()) {
+                usage.spilledBytes += doc->byteSize();
+                ++usage.spilledDocuments;
+                continue;
+            }
+
+            if (available < 0 || (toSpill.empty() && usage.memoryBytes + doc->byteSize() <= available)) {
+                usage.memoryBytes += doc->byteSize();
+                continue;
+            }
+
+            toSpill.push_back(doc.get());
+            objs.push_back(doc->bsonObj());
+        }
+
+        if (!toSpill.empty()) {
+            std::vector<qint64> offsets;
+            std::shared_ptr<const ResultSpillFile> file = ResultSpillFile::create(objs, offsets);
+            objs.clear();
+
+            if (file) {
+                for (size_t i = 0; i < toSpill.size(); ++i) {
+                    usage.spilledBytes += toSpill[i]->byteSize();
+                    toSpill[i]->spill(file, offsets[i]);
+                }
+                usage.spilledDocuments += static_cast<int>(toSpill.size());
+            }
+            else {
+                LOG_MSG("Failed to spill query results to temporary directory, keeping them in memory",
+                        mongo::logger::LogSeverity::Warning());
+                for (auto doc : toSpill)
+                    usage.memoryBytes += doc->byteSize();
+            }
+        }
+
+        _owners[owner] = usage.memoryBytes;
+        _memoryBytes += usage.memoryBytes;
+        return usage;
+    }
+
+    void ResultMemoryGovernor::release(const void *owner)
+    {
+        auto it = _owners.find(owner);
+        if (it == _owners.end())
+            return;
+
+        _memoryBytes -= it->second;
+        _owners.erase(it);
+    }
+}
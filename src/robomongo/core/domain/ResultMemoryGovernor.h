@@ -0,0 +1,86 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QTemporaryFile>
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Temporary file with raw BSON of spilled documents, memory-mapped
+     *        once written. Documents are paged back in by the OS on access.
+     */
+    class ResultSpillFile
+    {
+    public:
+        /**
+         * @brief Writes 'objs' one after another, offsets of them are appended to 'offsets'.
+         * @return nullptr if temporary file cannot be written or mapped
+         */
+        static std::shared_ptr<ResultSpillFile> create(const std::vector<mongo::BSONObj> &objs,
+                                                       std::vector<qint64> &offsets);
+
+        // Owned copy of document at 'offset'
+        mongo::BSONObj at(qint64 offset) const;
+
+        qint64 size() const { return _size; }
+
+    private:
+        ResultSpillFile() : _data(nullptr), _size(0) {}
+
+        QTemporaryFile _file;
+        const uchar *_data;
+        qint64 _size;
+    };
+
+    /**
+     * @brief Global memory budget of documents of query results.
+     *
+     *        Each result set (i.e. tab of query results) is admitted with its
+     *        documents. Documents, which do not fit into what is left of the
+     *        budget, are spilled to a ResultSpillFile of that result set, first
+     *        documents stay in memory. Used from GUI thread only.
+     *
+     *        Sizes are BSON sizes of documents, not exact heap usage.
+     */
+    class ResultMemoryGovernor
+    {
+    public:
+        struct Usage
+        {
+            qint64 memoryBytes = 0;
+            qint64 spilledBytes = 0;
+            int spilledDocuments = 0;
+        };
+
+        // Budget of zero or less is unlimited
+        explicit ResultMemoryGovernor(qint64 budgetBytes);
+
+        // Instance with budget of SettingsManager::resultsMemoryBudgetMb()
+        static ResultMemoryGovernor &instance();
+
+        /**
+         * @brief Accounts 'documents' of 'owner', replacing its previous documents.
+         *        Documents must not be shared with other threads yet.
+         */
+        Usage admit(const void *owner, const MongoDocumentList &documents);
+        void release(const void *owner);
+
+        qint64 budgetBytes() const { return _budgetBytes; }
+        void setBudgetBytes(qint64 budgetBytes) { _budgetBytes = budgetBytes; }
+
+        // Bytes of documents kept in memory by all owners
+        qint64 memoryBytes() const { return _memoryBytes; }
+
+    private:
+        qint64 _budgetBytes;
+        qint64 _memoryBytes;
+        std::map<const void *, qint64> _owners;
+    };
+}
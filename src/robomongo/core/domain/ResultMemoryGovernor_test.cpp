@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "ResultMemoryGovernor.h"
+#include "MongoDocument.h"
+
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    MongoDocumentList makeDocuments(int count)
+    {
+        std::vector<MongoDocumentPtr> docs;
+        for (int i = 0; i < count; ++i)
+            docs.push_back(MongoDocument::fromBsonObj(BSON("_id" << i << "name" << "document")));
+        return MongoDocumentList(std::move(docs));
+    }
+}
+
+TEST(result_memory_governor_tests, spills_documents_over_budget)
+{
+    auto const docs = makeDocuments(10);
+    int const docSize = docs[0]->byteSize();
+
+    ResultMemoryGovernor governor(docSize * 4);
+    auto const usage = governor.admit(&docs, docs);
+
+    EXPECT_EQ(docSize * 4, usage.memoryBytes);
+    EXPECT_EQ(docSize * 6, usage.spilledBytes);
+    EXPECT_EQ(6, usage.spilledDocuments);
+    EXPECT_FALSE(docs[3]->isSpilled());
+    EXPECT_TRUE(docs[4]->isSpilled());
+
+    // Spilled documents are read back from disk
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(BSON("_id" << i << "name" << "document"), docs[i]->bsonObj());
+        EXPECT_EQ(docSize, docs[i]->byteSize());
+    }
+}
+
+TEST(result_memory_governor_tests, budget_is_shared_and_released)
+{
+    auto const first = makeDocuments(3);
+    auto const second = makeDocuments(3);
+    int const docSize = first[0]->byteSize();
+
+    ResultMemoryGovernor governor(docSize * 4);
+    governor.admit(&first, first);
+    EXPECT_EQ(docSize * 3, governor.memoryBytes());
+
+    auto usage = governor.admit(&second, second);
+    EXPECT_EQ(docSize, usage.memoryBytes);
+    EXPECT_EQ(2, usage.spilledDocuments);
+
+    // Admitting again does not count documents twice, spilled ones stay on disk
+    governor.release(&first);
+    usage = governor.admit(&second, second);
+    EXPECT_EQ(docSize, usage.memoryBytes);
+    EXPECT_EQ(docSize, governor.memoryBytes());
+}
+
+TEST(result_memory_governor_tests, unlimited_budget)
+{
+    auto const docs = makeDocuments(5);
+    ResultMemoryGovernor governor(0);
+    auto const usage = governor.admit(&docs, docs);
+    EXPECT_EQ(0, usage.spilledDocuments);
+    EXPECT_EQ(docs[0]->byteSize() * 5, usage.memoryBytes);
+}
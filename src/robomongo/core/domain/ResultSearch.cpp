@@ -0,0 +1,223 @@
+#include "robomongo/core/domain/ResultSearch.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include <QRegularExpression>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/SubstringMatcher.h"
+
+namespace
+{
+    using namespace Robomongo;
+
+    QRegularExpression makeRegex(const ResultSearchOptions &options)
+    {
+        QRegularExpression regex(options.text, options.caseSensitive
+            ? QRegularExpression::NoPatternOption : QRegularExpression::CaseInsensitiveOption);
+        regex.optimize();
+        return regex;
+    }
+
+    /**
+     * @brief Matches values of documents, one instance per thread: QRegularExpression
+     *        copies share compiled pattern, which is not safe to use concurrently.
+     */
+    class DocumentScanner
+    {
+    public:
+        DocumentScanner(const ResultSearchOptions &options, const std::string &text, const std::string &fieldPath) :
+            _matcher(text, options.caseSensitive),
+            _useRegex(options.regex),
+            _fieldPath(fieldPath)
+        {
+            if (_useRegex)
+                _regex = makeRegex(options);
+        }
+
+        void scan(int part, int document, const mongo::BSONObj &obj, std::vector<ResultMatch> &matches, size_t maxMatches)
+        {
+            _part = part;
+            _document = document;
+            _elementPath.clear();
+            _namedPath.clear();
+            _logicalPath.clear();
+            scanObject(obj, false, matches, maxMatches);
+        }
+
+    private:
+        // Path 'logical' is at or below scope
+        bool inScope(const std::string &logical) const
+        {
+            return _fieldPath.empty() || startsWithPath(logical, _fieldPath);
+        }
+
+        // Descending into 'logical' can reach scope
+        bool leadsToScope(const std::string &logical) const
+        {
+            return inScope(logical) || startsWithPath(_fieldPath, logical);
+        }
+
+        static bool startsWithPath(const std::string &path, const std::string &prefix)
+        {
+            return path.compare(0, prefix.size(), prefix) == 0
+                && (path.size() == prefix.size() || path[prefix.size()] == '.');
+        }
+
+        static void appendName(std::string &path, const char *name)
+        {
+            if (!path.empty())
+                path += '.';
+            path += name;
+        }
+
+        bool matches(const char *text, size_t length) const
+        {
+            if (!_useRegex)
+                return _matcher.matches(text, length);
+
+            return _regex.match(QString::fromUtf8(text, static_cast<int>(length))).hasMatch();
+        }
+
+        bool matches(const mongo::BSONElement &elem) const
+        {
+            switch (elem.type()) {
+            case mongo::String:
+            case mongo::Code:
+            case mongo::Symbol:
+                return matches(elem.valuestr(), elem.valuestrsize() - 1);
+            case mongo::jstOID: {
+                std::string const hex = elem.OID().toString();
+                return matches(hex.data(), hex.size());
+            }
+            default:
+                return false;
+            }
+        }
+
+        void scanObject(const mongo::BSONObj &obj, bool isArray, std::vector<ResultMatch> &matches, size_t maxMatches)
+        {
+            int row = 0;
+            for (mongo::BSONObjIterator it(obj); it.more() && matches.size() < maxMatches; ++row) {
+                mongo::BSONElement const elem = it.next();
+
+                size_t const namedSize = _namedPath.size();
+                size_t const logicalSize = _logicalPath.size();
+                appendName(_namedPath, elem.fieldName());
+                if (!isArray)
+                    appendName(_logicalPath, elem.fieldName());
+                _elementPath.push_back(row);
+
+                if (BsonUtils::isDocument(elem)) {
+                    if (leadsToScope(_logicalPath))
+                        scanObject(elem.Obj(), BsonUtils::isArray(elem), matches, maxMatches);
+                } else if (inScope(_logicalPath) && this->matches(elem)) {
+                    ResultMatch match;
+                    match.part = _part;
+                    match.document = _document;
+                    match.elementPath = _elementPath;
+                    match.fieldPath = _namedPath;
+                    matches.push_back(std::move(match));
+                }
+
+                _elementPath.pop_back();
+                _namedPath.resize(namedSize);
+                _logicalPath.resize(logicalSize);
+            }
+        }
+
+        const SubstringMatcher _matcher;
+        const bool _useRegex;
+        QRegularExpression _regex;
+        const std::string &_fieldPath;
+
+        int _part = 0;
+        int _document = 0;
+        std::vector<int> _elementPath;
+        std::string _namedPath;
+        std::string _logicalPath;
+    };
+}
+
+namespace Robomongo
+{
+    ResultSearch::ResultSearch(const ResultSearchOptions &options) :
+        _options(options),
+        _text(options.text.toStdString()),
+        _fieldPath(options.fieldPath.trimmed().toStdString())
+    {
+    }
+
+    bool ResultSearch::isValid() const
+    {
+        if (_text.empty())
+            return false;
+
+        return !_options.regex || makeRegex(_options).isValid();
+    }
+
+    QString ResultSearch::errorString() const
+    {
+        if (_options.regex)
+            return makeRegex(_options).errorString();
+
+        return QString();
+    }
+
+    std::vector<ResultMatch> ResultSearch::find(const std::vector<MongoDocumentList> &parts, size_t maxMatches) const
+    {
+        if (!isValid() || maxMatches == 0)
+            return std::vector<ResultMatch>();
+
+        // Documents of all parts are numbered one after another, partStarts[i] is
+        // number of the first document of part i
+        std::vector<size_t> partStarts;
+        size_t total = 0;
+        for (const MongoDocumentList &documents : parts) {
+            partStarts.push_back(total);
+            total += documents.size();
+        }
+        if (total == 0)
+            return std::vector<ResultMatch>();
+
+        size_t const hardware = std::max(1u, std::thread::hardware_concurrency());
+        size_t const threadCount = std::max<size_t>(1, std::min(hardware, total / MinDocumentsPerThread));
+        size_t const perThread = (total + threadCount - 1) / threadCount;
+        std::vector<std::vector<ResultMatch>> threadMatches(threadCount);
+
+        auto scanRange = [&](size_t thread) {
+            DocumentScanner scanner(_options, _text, _fieldPath);
+            size_t const begin = thread * perThread;
+            size_t const end = std::min(total, begin + perThread);
+            size_t part = std::upper_bound(partStarts.begin(), partStarts.end(), begin) - partStarts.begin() - 1;
+            for (size_t index = begin; index < end && threadMatches[thread].size() < maxMatches; ++index) {
+                while (index >= partStarts[part] + parts[part].size())
+                    ++part;
+
+                size_t const document = index - partStarts[part];
+                scanner.scan(static_cast<int>(part), static_cast<int>(document),
+                             parts[part][document]->bsonObj(), threadMatches[thread], maxMatches);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCount; ++i)
+            threads.emplace_back(scanRange, i);
+        scanRange(0);
+        for (std::thread &thread : threads)
+            thread.join();
+
+        std::vector<ResultMatch> result;
+        for (std::vector<ResultMatch> &matches : threadMatches) {
+            for (ResultMatch &match : matches) {
+                if (result.size() == maxMatches)
+                    return result;
+                result.push_back(std::move(match));
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <QString>
+
+#include "robomongo/core/domain/MongoDocumentList.h"
+
+namespace Robomongo
+{
+    struct ResultSearchOptions
+    {
+        QString text;
+        bool caseSensitive = false;
+        bool regex = false;
+
+        // Only values at this path or below it, i.e. "address" or "address.city",
+        // array indexes are not part of path. Empty for all fields.
+        QString fieldPath;
+    };
+
+    /**
+     * @brief Value, which matches search, at 'elementPath' in 'document' of result 'part':
+     *        positions of elements in BSON order, from top-level field down, i.e.
+     *        rows of BsonTreeModel.
+     */
+    struct ResultMatch
+    {
+        int part = 0;
+        int document = 0;
+        std::vector<int> elementPath;
+        std::string fieldPath;      // Names of elements, array indexes included
+    };
+
+    /**
+     * @brief Finds string values (also JS code, symbols and ObjectIds as hex) in
+     *        raw BSON of documents of all parts of a result, i.e. of all result
+     *        tabs of a query, without formatting them to text.
+     *
+     *        Documents are split between threads. Results are in order of parts,
+     *        documents and fields.
+     */
+    class ResultSearch
+    {
+    public:
+        // Documents per thread, below which threads are not worth starting
+        static const size_t MinDocumentsPerThread = 512;
+
+        explicit ResultSearch(const ResultSearchOptions &options);
+
+        // False if regular expression is invalid, or there is nothing to find
+        bool isValid() const;
+        QString errorString() const;
+
+        /**
+         * @brief Scans 'parts' in parallel and returns the first 'maxMatches' matches.
+         *        Documents must not be spilled concurrently (see ResultMemoryGovernor).
+         */
+        std::vector<ResultMatch> find(const std::vector<MongoDocumentList> &parts, size_t maxMatches) const;
+
+    private:
+        const ResultSearchOptions _options;
+        const std::string _text;
+        const std::string _fieldPath;
+    };
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "ResultSearch.h"
+#include "MongoDocument.h"
+#include "robomongo/core/utils/SubstringMatcher.h"
+
+#include <mongo/db/jsobj.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    MongoDocumentList makeDocuments(int count)
+    {
+        std::vector<MongoDocumentPtr> docs;
+        for (int i = 0; i < count; ++i) {
+            docs.push_back(MongoDocument::fromBsonObj(BSON(
+                "_id" << i <<
+                "name" << (i % 100 == 7 ? "Needle in a haystack" : "plain hay") <<
+                "address" << BSON("city" << "Needleton" << "zip" << "00000") <<
+                "tags" << BSON_ARRAY("x" << BSON("label" << "needle")))));
+        }
+        return MongoDocumentList(std::move(docs));
+    }
+
+    ResultSearchOptions options(const char *text, const char *fieldPath = "")
+    {
+        ResultSearchOptions result;
+        result.text = text;
+        result.fieldPath = fieldPath;
+        return result;
+    }
+}
+
+TEST(result_search_tests, substring_matcher)
+{
+    std::string const text = "0123456789abcdefghijklmnopqrstuvwxyz.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    EXPECT_TRUE(SubstringMatcher("xyz.", true).matches(text));
+    EXPECT_TRUE(SubstringMatcher("XYZ", true).matches(text));
+    EXPECT_FALSE(SubstringMatcher("xyz0", true).matches(text));
+    EXPECT_TRUE(SubstringMatcher("Z.0", false).matches(text));
+    EXPECT_TRUE(SubstringMatcher("tUv", false).matches(text));
+    EXPECT_FALSE(SubstringMatcher("tUv", true).matches(text));
+
+    // Every position of a match, in and after SIMD blocks
+    for (size_t i = 0; i + 3 <= text.size(); ++i)
+        EXPECT_TRUE(SubstringMatcher(text.substr(i, 3), true).matches(text)) << i;
+}
+
+TEST(result_search_tests, finds_values_in_all_parts)
+{
+    std::vector<MongoDocumentList> const parts { makeDocuments(2000), makeDocuments(10), makeDocuments(3000) };
+    std::vector<ResultMatch> const matches = ResultSearch(options("needle in")).find(parts, 1000);
+
+    // Documents 7, 107, ... of each part, in order
+    ASSERT_EQ(20u + 0u + 30u, matches.size());
+    EXPECT_EQ(0, matches[0].part);
+    EXPECT_EQ(7, matches[0].document);
+    EXPECT_EQ(std::vector<int>({ 1 }), matches[0].elementPath);
+    EXPECT_EQ("name", matches[0].fieldPath);
+    EXPECT_EQ(2, matches[20].part);
+    EXPECT_EQ(2907, matches.back().document);
+}
+
+TEST(result_search_tests, field_path_scope)
+{
+    std::vector<MongoDocumentList> const parts { makeDocuments(1) };
+
+    std::vector<ResultMatch> all = ResultSearch(options("needle")).find(parts, 10);
+    ASSERT_EQ(2u, all.size());
+    EXPECT_EQ("address.city", all[0].fieldPath);
+    EXPECT_EQ(std::vector<int>({ 2, 0 }), all[0].elementPath);
+    EXPECT_EQ("tags.1.label", all[1].fieldPath);
+    EXPECT_EQ(std::vector<int>({ 3, 1, 0 }), all[1].elementPath);
+
+    // Array indexes are not part of scope
+    std::vector<ResultMatch> tags = ResultSearch(options("needle", "tags.label")).find(parts, 10);
+    ASSERT_EQ(1u, tags.size());
+    EXPECT_EQ("tags.1.label", tags[0].fieldPath);
+
+    EXPECT_TRUE(ResultSearch(options("needle", "address.zip")).find(parts, 10).empty());
+}
+
+TEST(result_search_tests, regex)
+{
+    std::vector<MongoDocumentList> const parts { makeDocuments(200) };
+
+    ResultSearchOptions regex = options("^needle\\b");
+    regex.regex = true;
+    // Names of documents 7 and 107 and labels of all tags
+    EXPECT_EQ(202u, ResultSearch(regex).find(parts, 1000).size());
+    EXPECT_EQ(10u, ResultSearch(regex).find(parts, 10).size());
+
+    regex.caseSensitive = true;
+    EXPECT_EQ(200u, ResultSearch(regex).find(parts, 1000).size());
+
+    regex.text = "(unclosed";
+    EXPECT_FALSE(ResultSearch(regex).isValid());
+    EXPECT_TRUE(ResultSearch(regex).find(parts, 10).empty());
+}
@@ -28,11 +28,14 @@
 #include <pcrecpp.h>
 
 #include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/WireCompression.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/CredentialSettings.h"
+#include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace
 {
@@ -82,6 +85,14 @@ namespace Robomongo
         auto hostAndPort = serverAddr.empty() ? _connection->hostAndPort().toString() : serverAddr;
         ss << "db = connect('" << hostAndPort << "/" << connectDatabase;
 
+        // Shell connections negotiate compressors of the connection string. Without them
+        // the driver would offer all compressors of the process-wide registry.
+        auto const compressors = WireCompression::parse(_connection->compressors());
+        if (compressors.empty())
+            ss << "?compressors=disabled";
+        for (size_t i = 0; i < compressors.size(); ++i)
+            ss << (i == 0 ? "?compressors=" : ",") << compressors[i];
+
 //        v0.9
 //        ss << "db = connect('" << _connection->serverHost() << ":" << _connection->serverPort() << _connection->sslInfo() << _connection->sshInfo() << "/" << connectDatabase;
 
@@ -133,22 +144,6 @@ namespace Robomongo
         // Enable verbose shell reporting
         _scope->exec("_verboseShell = true;", "(verboseShell)", false, false, false);
 
-        // Save original autocomplete function so it can be restored if overwritten by user preference
-        _scope->exec("DB.autocompleteOriginal = DB.autocomplete;", "(saveOriginalAutocomplete)", false, false, false);
-
-        // Cache result of original "DB.autocomplete"
-        // Cache invalidated by the invalidateDbCollectionsCache() method.
-        std::string const cacheAutocompletion =
-            "__robomongoAutocompletionCache = null;"
-            "DB.autocompleteCached = function(obj) { "
-            "   if (__robomongoAutocompletionCache == null) {"
-            "       __robomongoAutocompletionCache = DB.autocompleteOriginal(obj);"
-            "   }"
-            "   return __robomongoAutocompletionCache;"
-            "}";
-
-        _scope->exec(cacheAutocompletion, "", false, false, false);
-
         // Capture aggregate parameters: pipeline, options
         std::string const aggregateInterceptor =
             "__robomongoAggregateUsed = false;"
@@ -170,6 +165,8 @@ namespace Robomongo
     MongoShellExecResult ScriptEngine::exec(const std::string &originalScript, const std::string &dbName, 
                                             AggrInfo aggrInfo /* = AggrInfo() */)
     {
+        TraceSpan const span("shell", "ScriptEngine::exec");
+
         QMutexLocker lock(&_mutex);
 
         if (!_scope) {
@@ -237,7 +234,7 @@ namespace Robomongo
                     if (failed && !timeoutReached)
                         return MongoShellExecResult(true, answer);
 
-                    std::vector<MongoDocumentPtr> docs = MongoDocument::fromBsonObj(__objects);
+                    MongoDocumentList docs(MongoDocument::fromBsonObj(__objects));
 
                     if (!answer.empty() || docs.size() > 0)
                         results.push_back(
@@ -275,6 +272,15 @@ namespace Robomongo
             // Always allow to read from slave
             ss << "rs.slaveOk();" << std::endl;
 
+            // Route shell reads as configured for the replica set connection
+            ReplicaSetSettings const *repSetSettings = _connection->replicaSetSettings();
+            if (_connection->isReplicaSet() &&
+                repSetSettings->readPreference() != ReplicaSetSettings::ReadPreference::PRIMARY) {
+                ss << "db.getMongo().setReadPref('" 
+                   << ReplicaSetSettings::readPreferenceMode(repSetSettings->readPreference()) << "');" 
+                   << std::endl;
+            }
+
             _scope->exec(ss.str(), "(usedb)", false, true, false);
         }
     }
@@ -298,43 +304,12 @@ namespace Robomongo
         _scope->exec("if (db) { db.runCommand({ping:1}); }", "(ping)", false, false, false, 3000);
     }
 
-    QStringList ScriptEngine::complete(const std::string &prefix, const AutocompletionMode mode)
-    {
-        //if ( prefix.find( '"' ) != string::npos )
-        //    return;
-
-        try {
-            if (mode == AutocompleteAll)
-                _scope->exec("DB.autocomplete = DB.autocompleteCached;", "", false, false, false);
-            else if (mode == AutocompleteNoCollectionNames)
-                _scope->exec("DB.autocomplete = function(obj){return [];}", "", false, false, false);
-
-            QStringList results;
-            mongo::BSONObj args = BSON( "0" << prefix );
-
-            _scope->invokeSafe( "function callShellAutocomplete(x) {shellAutocomplete(x)}", &args, 0, 1000 );
-            mongo::BSONObjBuilder b;
-            _scope->append( b , "" , "__autocomplete__" );
-            mongo::BSONObj res = b.obj();
-            mongo::BSONObj arr = res.firstElement().Obj();
-
-            mongo::BSONObjIterator i( arr );
-            while ( i.more() ) {
-                mongo::BSONElement e = i.next();
-                results.append(QtUtils::toQString(e.String()));
-            }
-            return results;
-        }
-        catch ( ... ) {
-            return QStringList();
-        }
-        return QStringList();
-    }
-
     MongoShellResult ScriptEngine::prepareResult(const std::string &type, const std::string &output,
-                                                 const std::vector<MongoDocumentPtr> &objects, qint64 elapsedms,
+                                                 const MongoDocumentList &objects, qint64 elapsedms,
                                                  const std::string &statement, AggrInfo aggrInfo /*= AggrInfo()*/)
     {
+        TraceSpan const span("shell", "ScriptEngine::prepareResult");
+
         const char *script =
             "__robomongoQuery = false; \n"
             "__robomongoIsAggregate = false; \n"
@@ -443,6 +418,8 @@ namespace Robomongo
     bool ScriptEngine::statementize(
         const std::string &script, std::vector<std::string> &outVec, std::string &outError)
     {
+        TraceSpan const span("shell", "ScriptEngine::statementize");
+
         _scope->setString("__robomongoEsprima", script.c_str());
 
         mongo::StringData const data {
@@ -483,13 +460,6 @@ namespace Robomongo
         return true;
     }
 
-    void ScriptEngine::invalidateDbCollectionsCache() {
-        if (!_initialized)
-            return;
-
-        _scope->exec("__robomongoAutocompletionCache = null;", "", false, false, false);
-    }
-
     std::string ScriptEngine::loadFile(const QString &path, bool throwOnError) {
         QFile file(path);
         if (!file.open(QIODevice::ReadOnly)) {
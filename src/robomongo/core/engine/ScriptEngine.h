@@ -28,10 +28,6 @@ namespace Robomongo
         void use(const std::string &dbName);
         void setBatchSize(int batchSize);
         void ping();
-        QStringList complete(const std::string &prefix, const AutocompletionMode mode);
-
-        void invalidateDbCollectionsCache();
-
         bool failedScope() const { return _failedScope; }
 
         void changeTimeout(int newTimeout) { _timeoutSec = newTimeout; }
@@ -40,7 +36,7 @@ namespace Robomongo
         ConnectionSettings *_connection;
 
         MongoShellResult prepareResult(const std::string &type, const std::string &output, 
-                                       const std::vector<MongoDocumentPtr> &objects, qint64 elapsedms,
+                                       const MongoDocumentList &objects, qint64 elapsedms,
                                        const std::string &statement, AggrInfo aggrInfo = AggrInfo());
 
         MongoShellExecResult prepareExecResult(
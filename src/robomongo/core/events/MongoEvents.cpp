@@ -10,13 +10,18 @@ namespace Robomongo
     R_REGISTER_EVENT(RefreshReplicaSetFolderResponse)
     R_REGISTER_EVENT(ReplicaSetFolderLoading)
     R_REGISTER_EVENT(ReplicaSetFolderRefreshed)
+    R_REGISTER_EVENT(ReplicaSetTopologyUpdated)
     R_REGISTER_EVENT(LoadDatabaseNamesRequest)
     R_REGISTER_EVENT(LoadDatabaseNamesResponse)
     R_REGISTER_EVENT(LoadCollectionNamesRequest)
     R_REGISTER_EVENT(LoadCollectionNamesResponse)
+    R_REGISTER_EVENT(LoadCollectionStatsRequest)
+    R_REGISTER_EVENT(LoadCollectionStatsResponse)
     R_REGISTER_EVENT(LoadUsersRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesResponse)
+    R_REGISTER_EVENT(LoadDatabaseIndexesRequest)
+    R_REGISTER_EVENT(LoadDatabaseIndexesResponse)
     R_REGISTER_EVENT(AddEditIndexRequest)
     R_REGISTER_EVENT(AddEditIndexResponse)
     R_REGISTER_EVENT(DropCollectionIndexRequest)
@@ -32,10 +37,15 @@ namespace Robomongo
     R_REGISTER_EVENT(ExecuteQueryRequest)
     R_REGISTER_EVENT(ExecuteQueryResponse)
     R_REGISTER_EVENT(DocumentListLoadedEvent)
+    R_REGISTER_EVENT(ExplainQueryRequest)
+    R_REGISTER_EVENT(ExplainQueryResponse)
+    R_REGISTER_EVENT(SampleSchemaRequest)
+    R_REGISTER_EVENT(SampleSchemaResponse)
+    R_REGISTER_EVENT(SampleOperationsRequest)
+    R_REGISTER_EVENT(SampleOperationsResponse)
+    R_REGISTER_EVENT(QueryExplainedEvent)
     R_REGISTER_EVENT(ExecuteScriptRequest)
     R_REGISTER_EVENT(ExecuteScriptResponse)
-    R_REGISTER_EVENT(AutocompleteRequest)
-    R_REGISTER_EVENT(AutocompleteResponse)
     R_REGISTER_EVENT(ScriptExecutedEvent)
     R_REGISTER_EVENT(ScriptExecutingEvent)
     R_REGISTER_EVENT(InsertDocumentRequest)
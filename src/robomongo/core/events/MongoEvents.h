@@ -12,9 +12,12 @@
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/CollectionSchema.h"
+#include "robomongo/core/domain/OperationShapes.h"
 #include "robomongo/core/Event.h"
 #include "robomongo/core/Enums.h"
 #include "robomongo/core/mongodb/ReplicaSet.h"
+#include "robomongo/core/mongodb/ReplicaSetTopology.h"
 
 namespace Robomongo
 {
@@ -116,6 +119,17 @@ namespace Robomongo
         bool const expanded = false;
     };
 
+    // Sent periodically by MongoWorker of explorer connection, then published by MongoServer
+    struct ReplicaSetTopologyUpdated : public Event
+    {
+        R_EVENT
+
+        ReplicaSetTopologyUpdated(QObject *sender, std::vector<ReplicaMemberStats> const& members) :
+            Event(sender), members(members) {}
+
+        std::vector<ReplicaMemberStats> const members;
+    };
+
     struct ReplicaSetFolderLoading : public Event
     {
         R_EVENT
@@ -210,6 +224,60 @@ namespace Robomongo
         std::vector<MongoCollectionInfo> _collectionInfos;
     };
 
+    /**
+     * @brief LoadCollectionStats
+     *        Sent separately from LoadCollectionNames in order not to delay
+     *        collection names listing by per-collection "collStats" commands.
+     */
+
+    class LoadCollectionStatsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadCollectionStatsRequest(QObject *sender, const std::string &databaseName,
+                                   const std::vector<std::string> &namespaces) :
+            Event(sender),
+            _databaseName(databaseName),
+            _namespaces(namespaces) {}
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<std::string> namespaces() const { return _namespaces; }
+
+    private:
+        std::string _databaseName;
+        std::vector<std::string> _namespaces;
+    };
+
+    class LoadCollectionStatsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadCollectionStatsResponse(QObject *sender, const std::string &databaseName,
+                                    const std::vector<std::string> &namespaces,
+                                    const std::vector<MongoCollectionInfo> &collectionInfos) :
+            Event(sender),
+            _databaseName(databaseName),
+            _namespaces(namespaces),
+            _collectionInfos(collectionInfos) { }
+
+        LoadCollectionStatsResponse(QObject *sender, const EventError &error,
+                                    const std::vector<std::string> &namespaces) :
+            Event(sender, error),
+            _namespaces(namespaces) {}
+
+        std::string databaseName() const { return _databaseName; }
+        // Requested namespaces, also in case of error
+        std::vector<std::string> namespaces() const { return _namespaces; }
+        std::vector<MongoCollectionInfo> collectionInfos() const { return _collectionInfos; }
+
+    private:
+        std::string _databaseName;
+        std::vector<std::string> _namespaces;
+        std::vector<MongoCollectionInfo> _collectionInfos;
+    };
+
     class LoadCollectionIndexesRequest : public Event
     {
         R_EVENT
@@ -235,6 +303,61 @@ namespace Robomongo
         std::vector<IndexInfo> _indexes;
     };
 
+    /**
+     * @brief LoadDatabaseIndexes
+     *        Loads indexes of given collections of one database in one request,
+     *        instead of one LoadCollectionIndexesRequest per collection.
+     */
+
+    class LoadDatabaseIndexesRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadDatabaseIndexesRequest(QObject *sender, const std::string &databaseName,
+                                   const std::vector<MongoCollectionInfo> &collections) :
+            Event(sender),
+            _databaseName(databaseName),
+            _collections(collections) {}
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<MongoCollectionInfo> collections() const { return _collections; }
+
+    private:
+        std::string _databaseName;
+        std::vector<MongoCollectionInfo> _collections;
+    };
+
+    class LoadDatabaseIndexesResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadDatabaseIndexesResponse(QObject *sender, const std::string &databaseName,
+                                    const std::vector<IndexInfo> &indexes,
+                                    const std::vector<std::string> &failedCollections) :
+            Event(sender),
+            _databaseName(databaseName),
+            _indexes(indexes),
+            _failedCollections(failedCollections) {}
+
+        // All collections of request failed
+        LoadDatabaseIndexesResponse(QObject *sender, const EventError &error,
+                                    const std::vector<std::string> &failedCollections) :
+            Event(sender, error),
+            _failedCollections(failedCollections) {}
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<IndexInfo> indexes() const { return _indexes; }
+        // Names of collections, which failed to list indexes (i.e. not authorized)
+        std::vector<std::string> failedCollections() const { return _failedCollections; }
+
+    private:
+        std::string _databaseName;
+        std::vector<IndexInfo> _indexes;
+        std::vector<std::string> _failedCollections;
+    };
+
     class AddEditIndexRequest : public Event
     {
         R_EVENT
@@ -909,7 +1032,7 @@ namespace Robomongo
     {
         R_EVENT
 
-        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents) :
+        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const MongoDocumentList &documents) :
             Event(sender),
             resultIndex(resultIndex),
             queryInfo(queryInfo),
@@ -920,36 +1043,128 @@ namespace Robomongo
 
         int resultIndex;
         MongoQueryInfo queryInfo;
-        std::vector<MongoDocumentPtr> documents;
+        MongoDocumentList documents;
     };
 
-    class AutocompleteRequest : public Event
+    /**
+     * @brief Re-run query (or aggregation, if 'aggrInfo' is valid) with
+     *        explain("executionStats")
+     */
+    class ExplainQueryRequest : public Event
     {
         R_EVENT
 
-        AutocompleteRequest(QObject *sender, const std::string &prefix, const AutocompletionMode mode) :
+        ExplainQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo,
+                            const AggrInfo &aggrInfo, const std::string &dbName) :
             Event(sender),
-            prefix(prefix),
-            mode(mode) {}
+            resultIndex(resultIndex),
+            queryInfo(queryInfo),
+            aggrInfo(aggrInfo),
+            dbName(dbName) {}
 
-        std::string prefix;
-        AutocompletionMode mode;
+        int resultIndex; //external user data;
+        MongoQueryInfo queryInfo;
+        AggrInfo aggrInfo;
+        std::string dbName;     // database of aggregation
     };
 
-    class AutocompleteResponse : public Event
+    class ExplainQueryResponse : public Event
     {
         R_EVENT
 
-        AutocompleteResponse(QObject *sender, const QStringList &list, const std::string &prefix) :
+        ExplainQueryResponse(QObject *sender, int resultIndex, const mongo::BSONObj &explain) :
             Event(sender),
-            list(list),
-            prefix(prefix) {}
+            resultIndex(resultIndex),
+            explain(explain) {}
 
-        AutocompleteResponse(QObject *sender, const EventError &error) :
-            Event(sender, error) {}
+        ExplainQueryResponse(QObject *sender, int resultIndex, const EventError &error) :
+            Event(sender, error),
+            resultIndex(resultIndex) {}
 
-        QStringList list;
-        std::string prefix;
+        int resultIndex;
+        mongo::BSONObj explain;
+    };
+
+    /**
+     * @brief Build CollectionSchema of collection 'ns' from "$sample" of 'size' documents
+     */
+    class SampleSchemaRequest : public Event
+    {
+        R_EVENT
+
+        SampleSchemaRequest(QObject *sender, const MongoNamespace &ns, int size) :
+            Event(sender),
+            ns(ns),
+            size(size) {}
+
+        MongoNamespace ns;
+        int size;
+    };
+
+    class SampleSchemaResponse : public Event
+    {
+        R_EVENT
+
+        SampleSchemaResponse(QObject *sender, const MongoNamespace &ns, const CollectionSchema &schema) :
+            Event(sender),
+            ns(ns),
+            schema(schema) {}
+
+        SampleSchemaResponse(QObject *sender, const MongoNamespace &ns, const EventError &error) :
+            Event(sender, error),
+            ns(ns) {}
+
+        MongoNamespace ns;
+        CollectionSchema schema;
+    };
+
+    /**
+     * @brief Sample operations of database 'dbName' for operations monitor: running
+     *        ones from "currentOp" and finished ones from "system.profile", logged
+     *        after 'profileSinceMillis' (0 for the latest ones).
+     *        Served by dedicated connection of MongoWorker, one request at a time.
+     */
+    class SampleOperationsRequest : public Event
+    {
+        R_EVENT
+
+        SampleOperationsRequest(QObject *sender, const std::string &dbName, long long profileSinceMillis,
+                                const std::vector<mongo::BSONObj> &profileSeenEntries) :
+            Event(sender),
+            dbName(dbName),
+            profileSinceMillis(profileSinceMillis),
+            profileSeenEntries(profileSeenEntries) {}
+
+        std::string dbName;
+        long long profileSinceMillis;
+        std::vector<mongo::BSONObj> profileSeenEntries;    // Already sampled entries of 'profileSinceMillis'
+    };
+
+    class SampleOperationsResponse : public Event
+    {
+        R_EVENT
+
+        SampleOperationsResponse(QObject *sender, const std::vector<OperationSample> &operations,
+                                 long long profileLastMillis, const std::vector<mongo::BSONObj> &profileLastEntries,
+                                 int profilingLevel, int slowMs) :
+            Event(sender),
+            operations(operations),
+            profileLastMillis(profileLastMillis),
+            profileLastEntries(profileLastEntries),
+            profilingLevel(profilingLevel),
+            slowMs(slowMs) {}
+
+        SampleOperationsResponse(QObject *sender, const EventError &error) :
+            Event(sender, error),
+            profileLastMillis(0),
+            profilingLevel(0),
+            slowMs(0) {}
+
+        std::vector<OperationSample> operations;
+        long long profileLastMillis;    // Time of the last profile entry, for the next request
+        std::vector<mongo::BSONObj> profileLastEntries;    // All sampled entries of 'profileLastMillis'
+        int profilingLevel;
+        int slowMs;
     };
 
 
@@ -1077,7 +1292,7 @@ namespace Robomongo
         R_EVENT
 
     public:
-        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const std::vector<MongoDocumentPtr> &docs) :
+        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const MongoDocumentList &docs) :
             Event(sender),
             _resultIndex(resultIndex),
             _queryInfo(queryInfo),
@@ -1089,16 +1304,38 @@ namespace Robomongo
 
         int resultIndex() const { return _resultIndex; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
-        std::vector<MongoDocumentPtr> documents() const { return _documents; }
+        const MongoDocumentList &documents() const { return _documents; }
         std::string query() const { return _query; }
 
     private:
         int _resultIndex;
         MongoQueryInfo _queryInfo;
-        std::vector<MongoDocumentPtr> _documents;
+        MongoDocumentList _documents;
         std::string _query;
     };
 
+    class QueryExplainedEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        QueryExplainedEvent(QObject *sender, int resultIndex, const mongo::BSONObj &explain) :
+            Event(sender),
+            _resultIndex(resultIndex),
+            _explain(explain) { }
+
+        QueryExplainedEvent(QObject *sender, int resultIndex, const EventError &error) :
+            Event(sender, error),
+            _resultIndex(resultIndex) {}
+
+        int resultIndex() const { return _resultIndex; }
+        mongo::BSONObj explain() const { return _explain; }
+
+    private:
+        int _resultIndex;
+        mongo::BSONObj _explain;
+    };
+
     class ScriptExecutedEvent : public Event
     {
         R_EVENT
@@ -1257,9 +1494,20 @@ namespace Robomongo
 
         LogEvent(QObject *sender, const std::string& message, LogLevel level, 
                  bool const informUser = false) 
-            : Event(sender), message(message), level(level), informUser(informUser)
+            : Event(sender), message(message), level(level), informUser(informUser),
+              source(sourceName(sender))
         {}
 
+        // Class name of sender without namespace, i.e. "MongoWorker".
+        // Computed here, because sender may be deleted before event is handled.
+        static QString sourceName(QObject *sender) {
+            if (!sender)
+                return QString();
+
+            QString const name = sender->metaObject()->className();
+            return name.mid(name.lastIndexOf(':') + 1);
+        }
+
         std::string severity() const {
             switch (level) {
                 case RBM_ERROR : return "Error";
@@ -1293,6 +1541,7 @@ namespace Robomongo
         std::string message;
         LogLevel level;
         bool const informUser = false;
+        QString const source;
     };
 
     class StopScriptRequest : public Event
@@ -15,7 +15,10 @@ namespace Robomongo
         _ttl(expireAfter),
         _defaultLanguage(defaultLanguage),
         _languageOverride(languageOverride),
-        _textWeights(textWeights) {}
+        _textWeights(textWeights),
+        _partial(false),
+        _collation(false),
+        _sizeBytes(-1) {}
 
         ConnectionInfo::ConnectionInfo(std::string const& uuid) :
             _address(),
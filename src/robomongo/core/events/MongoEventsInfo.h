@@ -28,6 +28,13 @@ namespace Robomongo
         std::string _defaultLanguage;
         std::string _languageOverride;
         std::string _textWeights;
+
+        // Has "partialFilterExpression" or "collation": not used by every query on its keys
+        bool _partial;
+        bool _collation;
+
+        // Size of index in bytes, negative if unknown (collection statistics not loaded)
+        double _sizeBytes;
     };
 
     struct ConnectionInfo
@@ -42,5 +49,11 @@ namespace Robomongo
         const std::string _dbVersionStr;
         const std::string _storageEngineType;
         std::string const _uuid;
+
+        // Negotiated network compressor (empty if not compressed) and compressed
+        // traffic of connection establishment, shown by connection diagnostic
+        std::string _compressor;
+        long long _wireBytes = 0;
+        long long _messageBytes = 0;
     };
 }
@@ -1,10 +1,14 @@
 #include "robomongo/core/mongodb/MongoClient.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "mongo/db/namespace_string.h"
 
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/shell/bson/json.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace
 {
@@ -30,6 +34,8 @@ namespace
             info._textWeights = jsonString(weightsObj, mongo::TenGen, 1, Robomongo::DefaultEncoding, 
                                            Robomongo::Utc);
 
+        info._partial = obj.hasField("partialFilterExpression");
+        info._collation = obj.hasField("collation");
         return info;
     }
 }
@@ -184,6 +190,23 @@ namespace Robomongo
         return result;
     }
 
+    std::vector<IndexInfo> MongoClient::getIndexes(const std::vector<MongoCollectionInfo> &collections,
+                                                   std::vector<std::string> &failed) const
+    {
+        std::vector<IndexInfo> result;
+        for (auto const& collection : collections) {
+            try {
+                std::vector<IndexInfo> const& indexes = getIndexes(collection);
+                result.insert(result.end(), indexes.begin(), indexes.end());
+            }
+            catch (const mongo::DBException &) {
+                // Do not fail whole catalog because of one collection
+                failed.push_back(collection.name());
+            }
+        }
+        return result;
+    }
+
     void MongoClient::addEditIndex(const IndexInfo &oldInfo, const IndexInfo &newInfo) const
     {   
         bool const editIndex = !oldInfo._name.empty();
@@ -547,8 +570,10 @@ namespace Robomongo
         checkLastErrorAndThrow(ns.databaseName());
     }
 
-    std::vector<MongoDocumentPtr> MongoClient::query(const MongoQueryInfo &info)
+    MongoDocumentList MongoClient::query(const MongoQueryInfo &info)
     {
+        TraceSpan const span("worker", "MongoClient::query");
+
         MongoNamespace ns(info._info._ns);
 
         //int limit = (info.limit <= 0) ? 50 : info.limit;
@@ -556,7 +581,7 @@ namespace Robomongo
         std::vector<MongoDocumentPtr> docs;
 
         if (info._limit == -1) // it means that we do not need to load any documents
-            return docs;
+            return MongoDocumentList();
 
         std::unique_ptr<mongo::DBClientCursor> cursor = _dbclient->query(
 			mongo::NamespaceString(ns.databaseName(), ns.collectionName()),          
@@ -570,36 +595,210 @@ namespace Robomongo
 
         while (cursor->more()) {
             mongo::BSONObj bsonObj = cursor->next();
-            MongoDocumentPtr doc(new MongoDocument(bsonObj.getOwned()));
-            docs.push_back(doc);
+            docs.push_back(MongoDocumentPtr(new MongoDocument(bsonObj.getOwned())));
+        }
+
+        return MongoDocumentList(std::move(docs));
+    }
+
+    mongo::BSONObj MongoClient::explain(const MongoQueryInfo &info)
+    {
+        MongoNamespace const ns(info._info._ns);
+
+        // { find: "collection", filter: {..}, projection: {..}, sort: {..}, hint: {..}, skip: N, limit: N }
+        mongo::BSONObjBuilder find;
+        find.append("find", ns.collectionName());
+        find.append("filter", info.filter());
+        if (info._fields.nFields())
+            find.append("projection", info._fields);
+
+        mongo::BSONObj const sort = info.sort();
+        if (!sort.isEmpty())
+            find.append("sort", sort);
+
+        mongo::BSONObj const hint = info.hint();
+        if (!hint.isEmpty())
+            find.append("hint", hint);
+
+        if (info._skip > 0)
+            find.append("skip", info._skip);
+
+        if (info._limit > 0)
+            find.append("limit", info._limit);
+
+        // Other special fields of legacy query, renamed as options of "find",
+        // so that explained plan is the plan of the executed query
+        if (info._special) {
+            static const std::pair<const char *, const char *> modifiers[] = {
+                { "$min", "min" }, { "$max", "max" }, { "$comment", "comment" },
+                { "$maxTimeMS", "maxTimeMS" }, { "$returnKey", "returnKey" },
+                { "$showDiskLoc", "showRecordId" }, { "collation", "collation" }, { "$collation", "collation" }
+            };
+            for (auto const& modifier : modifiers) {
+                mongo::BSONElement const elem = info._query.getField(modifier.first);
+                if (!elem.eoo())
+                    find.appendAs(elem, modifier.second);
+            }
+        }
+
+        return runExplainCommand(ns.databaseName(), find.obj());
+    }
+
+    mongo::BSONObj MongoClient::explain(const std::string &dbName, const AggrInfo &info)
+    {
+        // { aggregate: "collection", pipeline: [..], cursor: {}, <options> }
+        mongo::BSONObjBuilder aggregate;
+        aggregate.append("aggregate", info.collectionName);
+        aggregate.appendArray("pipeline", info.pipeline);
+        aggregate.append("cursor", mongo::BSONObj());
+        for (mongo::BSONObjIterator it(info.options); it.more(); ) {
+            mongo::BSONElement const option = it.next();
+            std::string const name = option.fieldName();
+            if (name != "cursor" && name != "explain")
+                aggregate.append(option);
         }
 
+        return runExplainCommand(dbName, aggregate.obj());
+    }
+
+    std::vector<mongo::BSONObj> MongoClient::sampleDocuments(const MongoNamespace &ns, int size)
+    {
+        // { aggregate: "collection", pipeline: [ { $sample: { size: N } } ], cursor: { batchSize: N } }
+        mongo::BSONObjBuilder aggregate;
+        aggregate.append("aggregate", ns.collectionName());
+        aggregate.append("pipeline", BSON_ARRAY(BSON("$sample" << BSON("size" << size))));
+        aggregate.append("cursor", BSON("batchSize" << size));
+
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(ns.databaseName(), aggregate.obj(), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        // Sample is limited to the first batch (16 MB), rest of it is not needed
+        std::vector<mongo::BSONObj> docs;
+        mongo::BSONObj const batch = result.getObjectField("cursor").getObjectField("firstBatch");
+        for (mongo::BSONObjIterator it(batch); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (elem.type() == mongo::Object)
+                docs.push_back(elem.Obj().getOwned());
+        }
         return docs;
     }
 
-    MongoCollectionInfo MongoClient::runCollStatsCommand(const std::string &ns)
+    std::vector<mongo::BSONObj> MongoClient::currentOperations(const std::string &dbName)
     {
-        MongoCollectionInfo info(ns);
-        return info;
+        // Database names can not contain '.', but may contain other regex characters
+        std::string pattern = "^";
+        for (char const c : dbName) {
+            if (std::strchr("\\^$.|?*+()[]{}", c))
+                pattern += '\\';
+            pattern += c;
+        }
+        pattern += "\\.";
+
+        // { currentOp: 1, active: true, ns: { $regex: "^db\.", $ne: "db.system.profile" } }
+        mongo::BSONObjBuilder command;
+        command.append("currentOp", 1);
+        command.append("active", true);
+        command.append("ns", BSON("$regex" << pattern << "$ne" << dbName + ".system.profile"));
+
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand("admin", command.obj(), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        std::vector<mongo::BSONObj> operations;
+        for (mongo::BSONObjIterator it(result.getObjectField("inprog")); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (elem.type() == mongo::Object)
+                operations.push_back(elem.Obj().getOwned());
+        }
+        return operations;
+    }
+
+    std::vector<mongo::BSONObj> MongoClient::profileEntries(const std::string &dbName, long long sinceMillis,
+                                                           int limit)
+    {
+        // Reads of the profile itself are profiled too at level 2
+        mongo::BSONObjBuilder filter;
+        filter.append("ns", BSON("$ne" << dbName + ".system.profile"));
+        if (sinceMillis > 0)
+            filter.append("ts", BSON("$gte" << mongo::Date_t::fromMillisSinceEpoch(sinceMillis)));
+
+        mongo::BSONObjBuilder command;
+        command.append("find", "system.profile");
+        command.append("filter", filter.obj());
+        command.append("sort", BSON("ts" << (sinceMillis > 0 ? 1 : -1)));
+        command.append("limit", limit);
+        command.append("batchSize", limit);
+        command.append("singleBatch", true);
+
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(dbName, command.obj(), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        std::vector<mongo::BSONObj> entries;
+        mongo::BSONObj const batch = result.getObjectField("cursor").getObjectField("firstBatch");
+        for (mongo::BSONObjIterator it(batch); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (elem.type() == mongo::Object)
+                entries.push_back(elem.Obj().getOwned());
+        }
+
+        if (sinceMillis <= 0)
+            std::reverse(entries.begin(), entries.end());
+        return entries;
+    }
+
+    void MongoClient::profilingLevel(const std::string &dbName, int &level, int &slowMs)
+    {
+        // { profile: -1 } only reads the settings
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(dbName, BSON("profile" << -1), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        level = result.getIntField("was");
+        slowMs = result.getIntField("slowms");
+    }
 
-/*      // Commented for now, to speedup load of collection names
+    MongoCollectionInfo MongoClient::runCollStatsCommand(const std::string &ns)
+    {
         MongoNamespace mongons(ns);
 
-        mongo::BSONObjBuilder command; // { collStats: "db.collection", scale : 1 }
+        mongo::BSONObjBuilder command; // { collStats: "collection", scale : 1 }
         command.append("collStats", mongons.collectionName());
         command.append("scale", 1);
 
         mongo::BSONObj result;
-        _dbclient->runCommand(mongons.databaseName(), command.obj(), result);
-        std::string isCV = result.toString();
-        MongoCollectionInfo newInfo(result);
-        return newInfo;
-        */
+        // Views and collections without read access fail here, return info without statistics
+        if (!_dbclient->runCommand(mongons.databaseName(), command.obj(), result))
+            return MongoCollectionInfo(ns);
+
+        return MongoCollectionInfo(ns, result);
     }
 
     std::vector<MongoCollectionInfo> MongoClient::runCollStatsCommand(const std::vector<std::string> &namespaces)
     {
         std::vector<MongoCollectionInfo> infos;
+        infos.reserve(namespaces.size());
         for (auto const& ns : namespaces) {
             MongoCollectionInfo info = runCollStatsCommand(ns);
             if (info.ns().isValid()) 
@@ -614,6 +813,20 @@ namespace Robomongo
         //_scopedConnection->done();
     }
 
+    mongo::BSONObj MongoClient::runExplainCommand(const std::string &dbName, const mongo::BSONObj &command)
+    {
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(dbName, BSON("explain" << command << "verbosity" << "executionStats"), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        return result.getOwned();
+    }
+
     void MongoClient::checkLastErrorAndThrow(const std::string &db)
     {
         std::string const lastError = _dbclient->getLastError(db);        
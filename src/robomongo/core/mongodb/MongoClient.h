@@ -4,7 +4,9 @@
 #include <mongo/bson/bsonobj.h>
 
 #include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
 #include "robomongo/core/domain/MongoQueryInfo.h"
+#include "robomongo/core/domain/MongoAggregateInfo.h"
 #include "robomongo/core/domain/MongoUser.h"
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
@@ -28,6 +30,14 @@ namespace Robomongo
 
         std::vector<MongoFunction> getFunctions(const std::string &dbName) const;
         std::vector<IndexInfo> getIndexes(const MongoCollectionInfo &collection) const;
+
+        /**
+         * @brief Index catalog of several collections (usually of one database).
+         *        Collections, that fail to list indexes (i.e. views, not authorized),
+         *        are skipped and added to 'failed'.
+         */
+        std::vector<IndexInfo> getIndexes(const std::vector<MongoCollectionInfo> &collections,
+                                          std::vector<std::string> &failed) const;
         void dropIndexFromCollection(const MongoCollectionInfo &collection, const std::string &indexName) const;
         void addEditIndex(const IndexInfo &oldInfo, const IndexInfo &newInfo) const;
 
@@ -50,7 +60,31 @@ namespace Robomongo
         void insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
         void removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne = true);
-        std::vector<MongoDocumentPtr> query(const MongoQueryInfo &info);
+        MongoDocumentList query(const MongoQueryInfo &info);
+
+        /**
+         * @brief Re-runs query or aggregation with explain("executionStats")
+         *        and returns raw output of "explain" command.
+         */
+        mongo::BSONObj explain(const MongoQueryInfo &info);
+        mongo::BSONObj explain(const std::string &dbName, const AggrInfo &info);
+
+        // Random documents of collection, by "$sample" aggregation stage
+        std::vector<mongo::BSONObj> sampleDocuments(const MongoNamespace &ns, int size);
+
+        // Active operations on collections of 'dbName', as reported by "currentOp"
+        std::vector<mongo::BSONObj> currentOperations(const std::string &dbName);
+
+        /**
+         * @brief Up to 'limit' entries of "system.profile" of 'dbName', oldest first:
+         *        logged at or after 'sinceMillis' (milliseconds since epoch), or the
+         *        latest ones if 'sinceMillis' is 0. Entries of the same millisecond
+         *        can be split between reads, callers skip the ones they already have.
+         */
+        std::vector<mongo::BSONObj> profileEntries(const std::string &dbName, long long sinceMillis, int limit);
+
+        // Profiling level of 'dbName' (0, 1 or 2) and threshold of slow operations
+        void profilingLevel(const std::string &dbName, int &level, int &slowMs);
 
         MongoCollectionInfo runCollStatsCommand(const std::string &ns);
         std::vector<MongoCollectionInfo> runCollStatsCommand(const std::vector<std::string> &namespaces);
@@ -60,5 +94,6 @@ namespace Robomongo
     private:
         mongo::DBClientBase *const _dbclient;
         void checkLastErrorAndThrow(const std::string &db);
+        mongo::BSONObj runExplainCommand(const std::string &dbName, const mongo::BSONObj &command);
     };
 }
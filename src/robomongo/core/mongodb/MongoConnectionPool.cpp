@@ -0,0 +1,115 @@
+#include "robomongo/core/mongodb/MongoConnectionPool.h"
+
+#include <mongo/client/dbclient_base.h>
+
+namespace Robomongo
+{
+    MongoConnectionPool::Lease::Lease(MongoConnectionPool *pool, std::unique_ptr<mongo::DBClientBase> conn) :
+        _pool(pool), _conn(std::move(conn)), _discarded(false) {}
+
+    MongoConnectionPool::Lease::Lease(Lease &&other) :
+        _pool(other._pool), _conn(std::move(other._conn)), _discarded(other._discarded)
+    {
+        other._pool = nullptr;
+    }
+
+    MongoConnectionPool::Lease::~Lease()
+    {
+        if (_pool)
+            _pool->release(std::move(_conn), _discarded);
+    }
+
+    MongoConnectionPool::MongoConnectionPool(Factory factory, int maxSize) :
+        _factory(factory), _maxSize(maxSize) {}
+
+    MongoConnectionPool::~MongoConnectionPool()
+    {
+        // All leases must be returned at this point (see ~MongoWorker)
+    }
+
+    MongoConnectionPool::Lease MongoConnectionPool::acquire()
+    {
+        QMutexLocker lock(&_mutex);
+
+        QElapsedTimer waitTimer;
+        waitTimer.start();
+        bool waited = false;
+        while (_idle.empty() && _stats.inUse >= _maxSize) {
+            waited = true;
+            ++_stats.waiting;
+            _released.wait(&_mutex);
+            --_stats.waiting;
+        }
+
+        ++_stats.acquired;
+        if (waited) {
+            ++_stats.waited;
+            _stats.waitMs += waitTimer.elapsed();
+        }
+
+        // Reserve a slot, so that connections are checked and created without the lock
+        ++_stats.inUse;
+
+        while (!_idle.empty()) {
+            IdleConnection idle = std::move(_idle.back());
+            _idle.pop_back();
+
+            if (idle.idleTimer.elapsed() < HealthCheckAfterMs)
+                return Lease(this, std::move(idle.conn));
+
+            lock.unlock();
+            bool const healthy = idle.conn->isStillConnected();
+            if (healthy)
+                return Lease(this, std::move(idle.conn));
+
+            idle.conn.reset();
+            lock.relock();
+        }
+
+        lock.unlock();
+        try {
+            return Lease(this, _factory());
+        }
+        catch (...) {
+            release(nullptr, true);
+            throw;
+        }
+    }
+
+    void MongoConnectionPool::release(std::unique_ptr<mongo::DBClientBase> conn, bool discard)
+    {
+        QMutexLocker lock(&_mutex);
+        --_stats.inUse;
+
+        if (conn && !discard && !conn->isFailed()) {
+            IdleConnection idle;
+            idle.conn = std::move(conn);
+            idle.idleTimer.start();
+            _idle.push_back(std::move(idle));
+        }
+
+        _released.wakeOne();
+    }
+
+    void MongoConnectionPool::prune()
+    {
+        std::deque<IdleConnection> expired;
+        {
+            QMutexLocker lock(&_mutex);
+            // The least recently used connections are at the front
+            while (!_idle.empty() && _idle.front().idleTimer.elapsed() > MaxIdleMs) {
+                expired.push_back(std::move(_idle.front()));
+                _idle.pop_front();
+            }
+        }
+        // Connections are closed here, without the lock
+    }
+
+    MongoConnectionPool::Stats MongoConnectionPool::stats() const
+    {
+        QMutexLocker lock(&_mutex);
+        Stats result = _stats;
+        result.idle = static_cast<int>(_idle.size());
+        return result;
+    }
+}
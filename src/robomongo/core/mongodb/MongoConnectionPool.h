@@ -0,0 +1,105 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+namespace mongo
+{
+    class DBClientBase;
+}
+
+namespace Robomongo
+{
+    /**
+     * @brief Small, thread-safe pool of authenticated connections to one server
+     *        (or replica set). Connections are created on demand by 'factory',
+     *        up to 'maxSize' at once; further acquire() calls wait for a release.
+     *
+     *        Pooled connections are not pinged by MongoWorker::keepAlive(), which
+     *        pings only its primary connection (every 60 s). Instead a connection
+     *        idle for more than HealthCheckAfterMs (30 s) is checked when it is
+     *        reused, and prune() (called by keepAlive()) closes connections idle
+     *        for more than MaxIdleMs (5 minutes).
+     */
+    class MongoConnectionPool
+    {
+    public:
+        using Factory = std::function<std::unique_ptr<mongo::DBClientBase>()>;
+
+        struct Stats
+        {
+            int inUse = 0;
+            int idle = 0;
+            int waiting = 0;            // Threads blocked in acquire() right now
+            long long acquired = 0;     // Total number of leases
+            long long waited = 0;       // Leases, which had to wait for a release
+            long long waitMs = 0;       // Total time spent waiting
+        };
+
+        /**
+         * @brief Connection borrowed from the pool, returned when destroyed.
+         */
+        class Lease
+        {
+        public:
+            Lease(Lease &&other);
+            ~Lease();
+
+            mongo::DBClientBase *connection() const { return _conn.get(); }
+
+            // Do not return connection to the pool, i.e. after a network error
+            void discard() { _discarded = true; }
+
+        private:
+            friend class MongoConnectionPool;
+            Lease(MongoConnectionPool *pool, std::unique_ptr<mongo::DBClientBase> conn);
+
+            Lease(const Lease &) = delete;
+            Lease &operator=(const Lease &) = delete;
+
+            MongoConnectionPool *_pool;
+            std::unique_ptr<mongo::DBClientBase> _conn;
+            bool _discarded;
+        };
+
+        MongoConnectionPool(Factory factory, int maxSize);
+        ~MongoConnectionPool();
+
+        /**
+         * @brief Returns idle connection or creates a new one.
+         * @throws exceptions of factory
+         */
+        Lease acquire();
+
+        // Close connections idle for more than MaxIdleMs
+        void prune();
+
+        Stats stats() const;
+
+        // Idle connections are checked with isStillConnected() after this time
+        static const int HealthCheckAfterMs = 30 * 1000;
+        static const int MaxIdleMs = 5 * 60 * 1000;
+
+    private:
+        void release(std::unique_ptr<mongo::DBClientBase> conn, bool discard);
+
+        struct IdleConnection
+        {
+            std::unique_ptr<mongo::DBClientBase> conn;
+            QElapsedTimer idleTimer;
+        };
+
+        const Factory _factory;
+        const int _maxSize;
+
+        mutable QMutex _mutex;
+        QWaitCondition _released;
+        std::deque<IdleConnection> _idle;   // Most recently used at the back
+        Stats _stats;
+    };
+}
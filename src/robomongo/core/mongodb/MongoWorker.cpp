@@ -1,9 +1,13 @@
 #include "robomongo/core/mongodb/MongoWorker.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <exception>
+#include <mutex>
 
 #include <QThread>
+#include <QElapsedTimer>
+#include <QRunnable>
 
 #include <mongo/client/global_conn_pool.h>
 #include <mongo/client/replica_set_monitor.h>
@@ -18,6 +22,7 @@
 #include "robomongo/core/engine/ScriptEngine.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/mongodb/MongoClient.h"
+#include "robomongo/core/mongodb/WireCompression.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/settings/CredentialSettings.h"
@@ -25,7 +30,9 @@
 #include "robomongo/core/settings/SslSettings.h"
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/Metrics.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/Tracer.h"
 #include "robomongo/utils/StringOperations.h"
 
 namespace Robomongo
@@ -33,6 +40,106 @@ namespace Robomongo
     std::string const APP_VERSION = PROJECT_VERSION;
     std::string const APP_NAME_VERSION { "robo3t-" + APP_VERSION };
 
+    namespace
+    {
+        // State shared by replica set member probes. Probes which lose the race are
+        // not waited for, they hold a reference and finish within connect timeout
+        // (MongoWorker waits for them only when destroyed).
+        struct ReplicaSetProbe
+        {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t pending = 0;
+            std::string setName;
+            mongo::HostAndPort member;  // First member which reported the set name
+        };
+
+        void probeMember(std::shared_ptr<ReplicaSetProbe> probe, mongo::HostAndPort node, double timeoutSec)
+        {
+            std::string setName;
+            try {
+                // Any member (primary, secondary or arbiter) reports set name in isMaster
+                // reply, which, unlike rs.status(), does not require authentication.
+                mongo::DBClientConnection conn { false, timeoutSec };
+                if (conn.connect(node, APP_NAME_VERSION).isOK()) {
+                    mongo::BSONObj info;
+                    if (conn.runCommand("admin", BSON("isMaster" << 1), info))
+                        setName = info.getStringField("setName");
+                }
+            }
+            catch (const std::exception &) {
+                // Member is unreachable, others may still respond
+            }
+
+            std::lock_guard<std::mutex> lock(probe->mutex);
+            --probe->pending;
+            if (probe->setName.empty() && !setName.empty()) {
+                probe->setName = setName;
+                probe->member = node;
+            }
+            probe->done.notify_all();
+        }
+
+        // mongo::sslGlobalParams are process-wide: connections of all workers and of their
+        // pool threads set them up right before connecting. Recursive, because
+        // configureSSL() resets params as well.
+        std::recursive_mutex &sslParamsMutex()
+        {
+            static std::recursive_mutex mutex;
+            return mutex;
+        }
+
+        /**
+         * @brief Keeps SSL params locked for one connect outside of MongoWorker thread and
+         *        then restores params of the previous holder, which may still need them
+         *        for reconnects of its replica set connection.
+         */
+        class SslParamsScope
+        {
+        public:
+            SslParamsScope() :
+                _lock(sslParamsMutex()),
+                _mode(mongo::sslGlobalParams.sslMode.load()),
+                _allowInvalidCertificates(mongo::sslGlobalParams.sslAllowInvalidCertificates),
+                _caFile(mongo::sslGlobalParams.sslCAFile),
+                _pemKeyFile(mongo::sslGlobalParams.sslPEMKeyFile),
+                _pemKeyPassword(mongo::sslGlobalParams.sslPEMKeyPassword),
+                _crlFile(mongo::sslGlobalParams.sslCRLFile),
+                _allowInvalidHostnames(mongo::sslGlobalParams.sslAllowInvalidHostnames) {}
+
+            ~SslParamsScope()
+            {
+                mongo::sslGlobalParams.sslMode.store(_mode);
+                mongo::sslGlobalParams.sslAllowInvalidCertificates = _allowInvalidCertificates;
+                mongo::sslGlobalParams.sslCAFile = _caFile;
+                mongo::sslGlobalParams.sslPEMKeyFile = _pemKeyFile;
+                mongo::sslGlobalParams.sslPEMKeyPassword = _pemKeyPassword;
+                mongo::sslGlobalParams.sslCRLFile = _crlFile;
+                mongo::sslGlobalParams.sslAllowInvalidHostnames = _allowInvalidHostnames;
+            }
+
+        private:
+            std::lock_guard<std::recursive_mutex> const _lock;
+            int const _mode;
+            bool const _allowInvalidCertificates;
+            std::string const _caFile;
+            std::string const _pemKeyFile;
+            std::string const _pemKeyPassword;
+            std::string const _crlFile;
+            bool const _allowInvalidHostnames;
+        };
+
+        class FunctionRunnable : public QRunnable
+        {
+        public:
+            explicit FunctionRunnable(std::function<void()> func) : _func(func) {}
+            void run() override { _func(); }
+
+        private:
+            std::function<void()> const _func;
+        };
+    }
+
     MongoWorker::MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize,
                              double mongoTimeoutSec, int shellTimeoutSec, QObject *parent) 
         : QObject(parent),
@@ -40,17 +147,39 @@ namespace Robomongo
         _isLoadMongoRcJs(isLoadMongoRcJs),
         _batchSize(batchSize),
         _timerId(-1),
-        _dbAutocompleteCacheTimerId(-1),
         _mongoTimeoutSec(mongoTimeoutSec),
         _shellTimeoutSec(shellTimeoutSec),
         _isQuiting(0),
         _dbclient(nullptr),
         _dbclientRepSet(nullptr),
-        _connSettings(connection)
+        _connSettings(connection),
+        _connectionPool([this]() { return createPooledConnection(); }, POOL_SIZE)
     {
+        _poolThreads.setMaxThreadCount(POOL_SIZE);
+        _monitorThread.setMaxThreadCount(1);
+        _topologyThread.setMaxThreadCount(1);
+
         // Whitespace removed from the start and the end of host string
         _connSettings->setServerHost(QString::fromStdString(_connSettings->serverHost()).trimmed().toStdString());
+        // Workers of one connection (explorer and shells) share metrics
+        _metricsScope = _connSettings->getReadableName();
+        MetricsRegistry &metrics = MetricsRegistry::instance();
+        _pingRtt = metrics.histogram(_metricsScope, "ping.rtt");
+        _queryTime = metrics.histogram(_metricsScope, "query.time");
+        _queryDocuments = metrics.counter(_metricsScope, "query.documents");
+        _queryBytes = metrics.counter(_metricsScope, "query.bytes", MetricUnit::Bytes);
+        // Compressed messages of queries, ratio is query.uncompressedBytes / query.wireBytes
+        _queryWireBytes = metrics.counter(_metricsScope, "query.wireBytes", MetricUnit::Bytes);
+        _queryUncompressedBytes = metrics.counter(_metricsScope, "query.uncompressedBytes", MetricUnit::Bytes);
+        _scriptTime = metrics.histogram(_metricsScope, "script.time");
+        metrics.addProbe(this, _metricsScope, "pool.inUse", MetricUnit::Count,
+                         [this]() { return _connectionPool.stats().inUse; });
+        metrics.addProbe(this, _metricsScope, "pool.waiting", MetricUnit::Count,
+                         [this]() { return _connectionPool.stats().waiting; });
+
         _thread = new QThread();
+        _thread->setObjectName("MongoWorker");
+        _thread->setProperty("metricsScope", QString::fromStdString(_metricsScope));
         moveToThread(_thread);
         VERIFY(connect( _thread, SIGNAL(finished()), _thread, SLOT(deleteLater()) ));
         VERIFY(connect( _thread, SIGNAL(finished()), this, SLOT(deleteLater()) ));
@@ -64,8 +193,8 @@ namespace Robomongo
             return;
         }
 
-        if (_dbAutocompleteCacheTimerId == event->timerId() && !_scriptEngine) {
-            _scriptEngine->invalidateDbCollectionsCache();
+        if (_topologyTimerId == event->timerId()) {
+            refreshTopology();
             return;
         }
     }
@@ -75,33 +204,32 @@ namespace Robomongo
         if (!_connSettings->hasEnabledPrimaryCredential())
             return;
 
-        CredentialSettings *credentials = _connSettings->primaryCredential();
-        mongo::BSONObj authParams {
-            mongo::BSONObjBuilder()
-            .append("user", credentials->userName())
-            .append("db", credentials->databaseName())
-            .append("pwd", credentials->userPassword())
-            .append("mechanism", credentials->mechanism())
-            .obj()
-        };
-
         _dbclientRepSet.release();
         if(mongo::DBClientBase *conn = getConnection(true).first)
-            conn->auth(authParams);
+            authenticate(conn);
     }
 
     void MongoWorker::keepAlive()
     {
         try {
-            if (_dbclient)
+            QElapsedTimer timer;
+            timer.start();
+            if (_dbclient) {
                 pingDatabase(_dbclient.get());
+                _pingRtt->record(timer.nsecsElapsed() / 1000);
+            }
 
-            if (_dbclientRepSet)
+            timer.restart();
+            if (_dbclientRepSet) {
                 pingDatabase(_dbclientRepSet.get());
+                _pingRtt->record(timer.nsecsElapsed() / 1000);
+            }
 
             if (_scriptEngine)
                 _scriptEngine->ping();
 
+            _connectionPool.prune();
+
         } 
         catch(std::exception &ex) {
             sendLog(this, LogEvent::RBM_WARN, 
@@ -118,7 +246,6 @@ namespace Robomongo
             _scriptEngine->setBatchSize(_batchSize);
             constexpr int PING_INTERVAL_MSEC { 60 * 1000 };  // 60 seconds
             _timerId = startTimer(PING_INTERVAL_MSEC);
-            _dbAutocompleteCacheTimerId = startTimer(30000);
         } catch (const std::exception &ex) {
             auto const msg { "Failed to initialize MongoWorker. Reason: "};
             sendLog(this, LogEvent::RBM_ERROR, msg + std::string(ex.what()));
@@ -142,8 +269,12 @@ namespace Robomongo
         if (_timerId != -1)
             killTimer(_timerId);
 
-        if (_dbAutocompleteCacheTimerId != -1)
-            killTimer(_dbAutocompleteCacheTimerId);
+        // Pooled tasks use connection settings and return leases to the pool
+        _poolThreads.waitForDone();
+        _monitorThread.waitForDone();
+        _probeThreads.waitForDone();
+        _topologyThread.waitForDone();
+        MetricsRegistry::instance().removeProbes(this);
 
         delete _connSettings;
 
@@ -171,6 +302,7 @@ namespace Robomongo
 
         std::unique_ptr<ReplicaSet> repSetInfo(new ReplicaSet);
         auto errorCode = EventError::ErrorCode::Unknown;
+        auto const wireBefore = WireCompression::stats();
 
         try {
             auto const& connAndErrorStr = getConnection(true);
@@ -239,21 +371,7 @@ namespace Robomongo
                 }
             }
 
-            if (_connSettings->hasEnabledPrimaryCredential()) {
-                CredentialSettings const * const credentials = _connSettings->primaryCredential();
-
-                // Building BSON object:
-                mongo::BSONObj const authParams { 
-                    mongo::BSONObjBuilder()
-                    .append("user", credentials->userName())
-                    .append("db", credentials->databaseName())
-                    .append("pwd", credentials->userPassword())
-                    .append("mechanism", credentials->mechanism())
-                    .obj()
-                };
-
-                conn->auth(authParams);
-            }
+            authenticate(conn);
 
             boost::scoped_ptr<MongoClient> client(getClient());
             std::vector<std::string> const dbNames = getDatabaseNamesSafe(event);
@@ -268,12 +386,30 @@ namespace Robomongo
 
             resetGlobalSSLparams();
 
+            // Pool threads are started only after this point, so they see set name unlocked
+            if (_connSettings->isReplicaSet())
+                _poolSetName = _dbclientRepSet->getSetName();
+            _isConnected = true;
+
             auto connInfo = ConnectionInfo(_connSettings->getFullAddress(), dbNames, client->getVersion(), 
                                            client->dbVersionStr(), client->getStorageEngineType(), event->uuid);
+            auto const wire = WireCompression::stats() - wireBefore;
+            connInfo._compressor = _compressor;
+            connInfo._wireBytes = wire.wireBytes;
+            connInfo._messageBytes = wire.messageBytes;
 
             // todo: two ctors for rep.set and single server.
             reply(event->sender(), new EstablishConnectionResponse(this, connInfo, event->connectionType, 
                                                                    *repSetInfo.release()));
+
+            // Live member latencies and lags are shown in explorer only
+            if (_connSettings->isReplicaSet() && event->connectionType == ConnectionPrimary && 
+                _topologyTimerId == -1) {
+                constexpr int TOPOLOGY_INTERVAL_MSEC { 10 * 1000 };  // 10 seconds
+                _topologyListener = event->sender();
+                _topologyTimerId = startTimer(TOPOLOGY_INTERVAL_MSEC);
+                refreshTopology();
+            }
             return true;
         } 
         catch(const std::exception &ex) {
@@ -424,44 +560,84 @@ namespace Robomongo
      */
     void MongoWorker::handle(LoadCollectionNamesRequest *event)
     {
-        try {
-            boost::scoped_ptr<MongoClient> client(getClient());
-            auto const& namespaces = client->getCollectionNamesWithDbname(event->databaseName());
-            std::vector<MongoCollectionInfo> const& collInfos = client->runCollStatsCommand(namespaces);
-            client->done();
-            reply(event->sender(), new LoadCollectionNamesResponse(this, event->databaseName(), collInfos));
-        } catch(const std::exception &ex) {
-            reply(event->sender(), new LoadCollectionNamesResponse(this, EventError(ex.what())));
+        QObject *const sender = event->sender();
+        std::string const dbName = event->databaseName();
+
+        runConcurrently([=](MongoClient &client) {
+            auto const& namespaces = client.getCollectionNamesWithDbname(dbName);
+
+            // Statistics are loaded later by LoadCollectionStatsRequest
+            std::vector<MongoCollectionInfo> collInfos(namespaces.begin(), namespaces.end());
+            reply(sender, new LoadCollectionNamesResponse(this, dbName, collInfos));
+        }, [=](const std::exception &ex) {
+            reply(sender, new LoadCollectionNamesResponse(this, EventError(ex.what())));
             // Logging handled in main thread
-        }
+        });
+    }
+
+    /**
+     * @brief Load size, storage size and count of some collections of one database
+     */
+    void MongoWorker::handle(LoadCollectionStatsRequest *event)
+    {
+        QObject *const sender = event->sender();
+        std::string const dbName = event->databaseName();
+        auto const namespaces = event->namespaces();
+
+        runConcurrently([=](MongoClient &client) {
+            std::vector<MongoCollectionInfo> const& collInfos = client.runCollStatsCommand(namespaces);
+            reply(sender, new LoadCollectionStatsResponse(this, dbName, namespaces, collInfos));
+        }, [=](const std::exception &ex) {
+            reply(sender, new LoadCollectionStatsResponse(this, EventError(ex.what()), namespaces));
+            // Logging handled in main thread
+        });
     }
 
     void MongoWorker::handle(LoadUsersRequest *event)
     {
-        try {
-            boost::scoped_ptr<MongoClient> client(getClient());
-            const std::vector<MongoUser> &users = client->getUsers(event->databaseName());
-            client->done();
+        QObject *const sender = event->sender();
+        std::string const dbName = event->databaseName();
+
+        runConcurrently([=](MongoClient &client) {
+            const std::vector<MongoUser> &users = client.getUsers(dbName);
+            reply(sender, new LoadUsersResponse(this, dbName, users));
+        }, [=](const std::exception &ex) {
+            reply(sender, new LoadUsersResponse(this, EventError(ex.what())));
+            // Logging handled in main thread
+        });
+    }
 
-            reply(event->sender(), new LoadUsersResponse(this, event->databaseName(), users));
-        } catch(const std::exception &ex) {
-            reply(event->sender(), new LoadUsersResponse(this, EventError(ex.what())));
+    void MongoWorker::handle(LoadDatabaseIndexesRequest *event)
+    {
+        QObject *const sender = event->sender();
+        std::string const dbName = event->databaseName();
+        auto const collections = event->collections();
+
+        runConcurrently([=](MongoClient &client) {
+            std::vector<std::string> failed;
+            const std::vector<IndexInfo> &indexes = client.getIndexes(collections, failed);
+            reply(sender, new LoadDatabaseIndexesResponse(this, dbName, indexes, failed));
+        }, [=](const std::exception &ex) {
+            std::vector<std::string> failed;
+            for (auto const& collection : collections)
+                failed.push_back(collection.name());
+            reply(sender, new LoadDatabaseIndexesResponse(this, EventError(ex.what()), failed));
             // Logging handled in main thread
-        }
+        });
     }
 
     void MongoWorker::handle(LoadCollectionIndexesRequest *event)
     {
-        try {
-            boost::scoped_ptr<MongoClient> client(getClient());
-            const std::vector<IndexInfo> &ind = client->getIndexes(event->collection());
-            client->done();
-
-            reply(event->sender(), new LoadCollectionIndexesResponse(this, ind));
-        } catch(const std::exception &ex) {
-            reply(event->sender(), new LoadCollectionIndexesResponse(this, EventError(ex.what())));
+        QObject *const sender = event->sender();
+        auto const collection = event->collection();
+
+        runConcurrently([=](MongoClient &client) {
+            const std::vector<IndexInfo> &ind = client.getIndexes(collection);
+            reply(sender, new LoadCollectionIndexesResponse(this, ind));
+        }, [=](const std::exception &ex) {
+            reply(sender, new LoadCollectionIndexesResponse(this, EventError(ex.what())));
             sendLog(this, LogEvent::RBM_ERROR, ex.what());
-        }
+        });
     }
 
     void MongoWorker::handle(AddEditIndexRequest *event)
@@ -566,9 +742,34 @@ namespace Robomongo
     void MongoWorker::handle(ExecuteQueryRequest *event)
     {
         auto const executeQuery = [&]() {
+            // Replica set driver selects a member according to read preference, 
+            // "nearest" among those within latency window of the fastest one.
+            MongoQueryInfo queryInfo = event->queryInfo();
+            auto const repSetSettings = _connSettings->replicaSetSettings();
+            if (_connSettings->isReplicaSet() && 
+                repSetSettings->readPreference() != ReplicaSetSettings::ReadPreference::PRIMARY)
+                queryInfo = queryInfo.withReadPreference(repSetSettings->readPreferenceDocument());
+
+            auto const wireBefore = WireCompression::stats();
+            QElapsedTimer timer;
+            timer.start();
             boost::scoped_ptr<MongoClient> client { getClient() };
-            std::vector<MongoDocumentPtr> docs = client->query(event->queryInfo());
+            MongoDocumentList docs = client->query(queryInfo);
             client->done();
+
+            _queryTime->record(timer.nsecsElapsed() / 1000);
+            _queryDocuments->add(docs.size());
+            long long bytes = 0;
+            for (auto const &doc : docs)
+                bytes += doc->bsonObj().objsize();
+            _queryBytes->add(bytes);
+
+            // Counters are process-wide, concurrent explorer loads may add up to the numbers
+            auto const wire = WireCompression::stats() - wireBefore;
+            if (wire.wireBytes > 0) {
+                _queryWireBytes->add(wire.wireBytes);
+                _queryUncompressedBytes->add(wire.messageBytes);
+            }
             reply(event->sender(),
                 new ExecuteQueryResponse(this, event->resultIndex(), event->queryInfo(), docs)
             );
@@ -599,6 +800,108 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(ExplainQueryRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client { getClient() };
+            mongo::BSONObj const explain = event->aggrInfo.isValid
+                ? client->explain(event->dbName, event->aggrInfo)
+                : client->explain(event->queryInfo);
+            client->done();
+
+            reply(event->sender(), new ExplainQueryResponse(this, event->resultIndex, explain));
+        } 
+        catch(const std::exception &ex) {
+            reply(event->sender(), 
+                new ExplainQueryResponse(this, event->resultIndex, EventError(ex.what())));
+            // Logging handled in main thread
+        }
+    }
+
+    void MongoWorker::handle(SampleSchemaRequest *event)
+    {
+        QObject *const sender = event->sender();
+        MongoNamespace const ns = event->ns;
+        int const size = event->size;
+
+        // Schema is built here, GUI thread only merges it
+        runConcurrently([=](MongoClient &client) {
+            CollectionSchema schema;
+            for (auto const& doc : client.sampleDocuments(ns, size))
+                schema.addDocument(doc);
+            reply(sender, new SampleSchemaResponse(this, ns, schema));
+        }, [=](const std::exception &ex) {
+            // Views and collections without read access are not sampled
+            reply(sender, new SampleSchemaResponse(this, ns, EventError(ex.what())));
+        });
+    }
+
+    void MongoWorker::handle(SampleOperationsRequest *event)
+    {
+        QObject *const sender = event->sender();
+        std::string const dbName = event->dbName;
+        long long const since = event->profileSinceMillis;
+        std::vector<mongo::BSONObj> const seenEntries = event->profileSeenEntries;
+
+        if (!_isConnected) {
+            reply(sender, new SampleOperationsResponse(this, EventError("Connection is not established")));
+            return;
+        }
+
+        _monitorThread.start(new FunctionRunnable([=]() {
+            TraceSpan const span("worker", "MongoWorker::sampleOperations");
+            QThread::currentThread()->setPriority(QThread::LowPriority);
+            try {
+                if (!_monitorConnection || _monitorConnection->isFailed())
+                    _monitorConnection = createPooledConnection();
+
+                MongoClient client(_monitorConnection.get());
+                int level = 0;
+                int slowMs = 0;
+                client.profilingLevel(dbName, level, slowMs);
+
+                // Profile is read in pages, the rest of entries comes with the next samples.
+                // Profile entries have no _id: the page starts at the millisecond of the
+                // last entry and entries of it, sampled before, are skipped.
+                int const MaxProfileEntries = 1000;
+                std::vector<OperationSample> operations;
+                std::vector<mongo::BSONObj> unseen = seenEntries;
+                std::vector<mongo::BSONObj> lastEntries = seenEntries;
+                long long last = since;
+                int const limit = MaxProfileEntries + static_cast<int>(seenEntries.size());
+                for (auto const &entry : client.profileEntries(dbName, since, limit)) {
+                    mongo::BSONElement const ts = entry.getField("ts");
+                    long long const tsMillis = ts.type() == mongo::Date ? ts.date().toMillisSinceEpoch() : since;
+                    if (tsMillis == since) {
+                        auto const seen = std::find_if(unseen.begin(), unseen.end(),
+                            [&entry](const mongo::BSONObj &obj) { return obj.binaryEqual(entry); });
+                        if (seen != unseen.end()) {
+                            unseen.erase(seen);
+                            continue;
+                        }
+                    }
+
+                    operations.push_back(OperationSample::fromProfile(entry));
+                    if (tsMillis > last) {
+                        last = tsMillis;
+                        lastEntries.clear();
+                    }
+                    if (tsMillis == last)
+                        lastEntries.push_back(entry);
+                }
+
+                for (auto const &op : client.currentOperations(dbName))
+                    operations.push_back(OperationSample::fromCurrentOp(op));
+
+                reply(sender, new SampleOperationsResponse(this, operations, last, lastEntries, level, slowMs));
+            } catch (const std::exception &ex) {
+                if (_monitorConnection && _monitorConnection->isFailed())
+                    _monitorConnection.reset();
+                reply(sender, new SampleOperationsResponse(this, EventError(ex.what())));
+            }
+        }));
+    }
+
     /**
      * @brief Execute javascript
      */
@@ -627,11 +930,14 @@ namespace Robomongo
             }
 
             // todo: should we use dbName from event or _connSettings? 
+            QElapsedTimer timer;
+            timer.start();
             MongoShellExecResult result {
                 _scriptEngine->exec(
                     event->script, _connSettings->defaultDatabase(), event->aggrInfo
                 )
             };
+            _scriptTime->record(timer.nsecsElapsed() / 1000);
 
             // To fix the problem where 'result' comes with old primary address.
             if (_connSettings->isReplicaSet()) 
@@ -699,23 +1005,6 @@ namespace Robomongo
         }
     }
 
-    void MongoWorker::handle(AutocompleteRequest *event)
-    {
-        try {
-            if (!_scriptEngine) {
-                reply(event->sender(), 
-                    new AutocompleteResponse(this, EventError("MongoDB Shell was not initialized")));
-                return;
-            }
-
-            QStringList list = _scriptEngine->complete(event->prefix, event->mode);
-            reply(event->sender(), new AutocompleteResponse(this, list, event->prefix));
-        } catch(const std::exception &ex) {
-            reply(event->sender(), new AutocompleteResponse(this, EventError(ex.what())));
-            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));            
-        }
-    }
-
     void MongoWorker::handle(CreateDatabaseRequest *event)
     {
         std::string dbname = event->database();
@@ -931,6 +1220,8 @@ namespace Robomongo
 
     std::pair<mongo::DBClientBase*, std::string> MongoWorker::getConnection(bool mayReturnNull /* = false */)
     {
+        // Pool threads must not change SSL params while this worker connects
+        std::lock_guard<std::recursive_mutex> const sslLock(sslParamsMutex());
         configureSSL();
 
         // --- Perform connection ---
@@ -959,8 +1250,13 @@ namespace Robomongo
                 
             if (!_dbclientRepSet->connect()) 
                 return { nullptr, "Connect failed" };
-            else 
-                return { _dbclientRepSet.get(), "" };
+
+            std::string error;
+            _compressor = negotiateWithPrimary(_dbclientRepSet.get(), error);
+            if (!error.empty() && !_connSettings->compressors().empty())
+                sendLog(this, LogEvent::RBM_WARN, "Network compression is not negotiated. " + error);
+
+            return { _dbclientRepSet.get(), "" };
         }
         else {  // connection to single server
             if(_dbclient)
@@ -972,8 +1268,11 @@ namespace Robomongo
             mongo::Status const& status = _dbclient->connect(_connSettings->hostAndPort(), APP_NAME_VERSION);
             if (!status.isOK() && mayReturnNull) 
                 return { nullptr, status.reason() };
-            else 
-                return { _dbclient.get(), "" };
+
+            if (status.isOK())
+                _compressor = WireCompression::negotiate(_dbclient.get(), _connSettings->compressors());
+
+            return { _dbclient.get(), "" };
         }
     }
 
@@ -982,8 +1281,105 @@ namespace Robomongo
         return new MongoClient(getConnection().first);
     }
 
-    void MongoWorker::configureSSL()
+    void MongoWorker::runConcurrently(std::function<void(MongoClient &client)> task,
+                                      std::function<void(const std::exception &ex)> onError)
+    {
+        if (!_isConnected) {
+            try {
+                boost::scoped_ptr<MongoClient> client(getClient());
+                task(*client);
+            } catch (const std::exception &ex) {
+                onError(ex);
+            }
+            return;
+        }
+
+        _poolThreads.start(new FunctionRunnable([this, task, onError]() {
+            TraceSpan const span("worker", "MongoWorker::runConcurrently");
+            try {
+                MongoConnectionPool::Lease lease = _connectionPool.acquire();
+                try {
+                    MongoClient client(lease.connection());
+                    task(client);
+                } catch (const std::exception &) {
+                    if (lease.connection()->isFailed())
+                        lease.discard();
+                    throw;
+                }
+            } catch (const std::exception &ex) {
+                onError(ex);
+            }
+        }));
+    }
+
+    std::unique_ptr<mongo::DBClientBase> MongoWorker::createPooledConnection() const
+    {
+        // Global SSL params were reset after the main connection was established
+        SslParamsScope const sslScope;
+        configureSSL();
+
+        std::unique_ptr<mongo::DBClientBase> conn;
+        if (_connSettings->isReplicaSet()) {
+            auto repSet = std::make_unique<mongo::DBClientReplicaSet>(
+                _poolSetName, _connSettings->replicaSetSettings()->membersToHostAndPort(), 
+                APP_NAME_VERSION, _mongoTimeoutSec);
+            if (!repSet->connect())
+                throw std::runtime_error("Connect failed");
+
+            std::string error;
+            negotiateWithPrimary(repSet.get(), error);
+            conn = std::move(repSet);
+        }
+        else {
+            auto single = std::make_unique<mongo::DBClientConnection>(true, _mongoTimeoutSec);
+            mongo::Status const& status = single->connect(_connSettings->hostAndPort(), APP_NAME_VERSION);
+            if (!status.isOK())
+                throw std::runtime_error(status.reason());
+
+            WireCompression::negotiate(single.get(), _connSettings->compressors());
+            conn = std::move(single);
+        }
+
+        authenticate(conn.get());
+        return conn;
+    }
+
+    std::string MongoWorker::negotiateWithPrimary(mongo::DBClientReplicaSet *repSet, std::string &error) const
+    {
+        // Only connection to current primary is renegotiated, see WireCompression.
+        // Replica set connects with secondaries only as well, masterConn() throws then.
+        try {
+            return WireCompression::negotiate(&repSet->masterConn(), _connSettings->compressors());
+        }
+        catch (const std::exception &ex) {
+            error = ex.what();
+            return "";
+        }
+    }
+
+    void MongoWorker::authenticate(mongo::DBClientBase *conn) const
     {
+        if (!_connSettings->hasEnabledPrimaryCredential())
+            return;
+
+        CredentialSettings const * const credentials = _connSettings->primaryCredential();
+
+        // Building BSON object:
+        mongo::BSONObj const authParams { 
+            mongo::BSONObjBuilder()
+            .append("user", credentials->userName())
+            .append("db", credentials->databaseName())
+            .append("pwd", credentials->userPassword())
+            .append("mechanism", credentials->mechanism())
+            .obj()
+        };
+
+        conn->auth(authParams);
+    }
+
+    void MongoWorker::configureSSL() const
+    {
+        std::lock_guard<std::recursive_mutex> const lock(sslParamsMutex());
         // As a precaution reset SSL global params for any kind of connection request (SSL or non-SSL)
         resetGlobalSSLparams();
         // Update global SSL mode and global mongo SSL settings
@@ -1021,6 +1417,7 @@ namespace Robomongo
 
     void MongoWorker::resetGlobalSSLparams() const
     {
+        std::lock_guard<std::recursive_mutex> const lock(sslParamsMutex());
         mongo::sslGlobalParams.sslAllowInvalidCertificates = false;
         mongo::sslGlobalParams.sslCAFile = "";
         mongo::sslGlobalParams.sslPEMKeyFile = "";
@@ -1076,30 +1473,95 @@ namespace Robomongo
         return ReplicaSet(setName, primary, membersAndHealths, primaryStatus.reason());
     }
 
-    std::string MongoWorker::connectAndGetReplicaSetName() const
+    std::string MongoWorker::connectAndGetReplicaSetName()
     {
-        auto const dbclientTemp { std::make_unique<mongo::DBClientConnection>(true, 10) };
-        std::string setName = "";
+        // Probe all members concurrently and take the first answer, so that connection time
+        // is bounded by the fastest healthy member, not by the sum of timeouts of the
+        // unreachable ones listed before it.
+        auto const& members = _connSettings->replicaSetSettings()->membersToHostAndPort();
+        auto const probe = std::make_shared<ReplicaSetProbe>();
+        probe->pending = members.size();
+        _probeThreads.setMaxThreadCount(std::max<int>(_probeThreads.maxThreadCount(), members.size()));
+        double const timeoutSec = _mongoTimeoutSec;
+        for (auto const& node : members)
+            _probeThreads.start(new FunctionRunnable([probe, node, timeoutSec]() {
+                probeMember(probe, node, timeoutSec);
+            }));
+
+        std::unique_lock<std::mutex> lock(probe->mutex);
+        probe->done.wait(lock, [&probe] { return !probe->setName.empty() || probe->pending == 0; });
+        if (probe->setName.empty())
+            return "";
+
+        std::string const setName = probe->setName;
+        mongo::HostAndPort const member = probe->member;
+        lock.unlock();
+
+        _scriptEngine->init(_isLoadMongoRcJs, member.toString());
+        return setName;
+    }
 
-        // Try connecting to the nodes one by one until getting replica set name.
-        for (auto const& node : _connSettings->replicaSetSettings()->membersToHostAndPort())
-        {
-            if (!dbclientTemp->connect(node, APP_NAME_VERSION).isOK())
-                return "";
-
-            _scriptEngine->init(_isLoadMongoRcJs, node.toString());
-            MongoShellExecResult const& result = _scriptEngine->exec("rs.status()", "");
-            if (!result.results().empty()) {
-                auto const& resultDocs = result.results().front().documents();
-                if (!resultDocs.empty()) {
-                    setName = resultDocs.front()->bsonObj().getStringField("set");
-                    if (!setName.empty()) // We get the information, finish the loop
-                        break;
+    void MongoWorker::refreshTopology()
+    {
+        if (!_dbclientRepSet || !_topologyListener)
+            return;
+
+        // Previous refresh still waits for a slow member
+        if (_topologyThread.activeThreadCount() > 0)
+            return;
+
+        std::string const setName = _dbclientRepSet->getSetName();
+        QObject *const listener = _topologyListener;
+
+        // Members are measured off this worker's thread, so that queries do not wait
+        // behind connect or socket timeouts of unreachable members
+        _topologyThread.start(new FunctionRunnable([this, setName, listener]() {
+            TraceSpan const span("worker", "MongoWorker::refreshTopology");
+            auto const repSetMonitor = mongo::globalRSMonitorManager.getMonitor(setName);
+
+            for (auto const& member : _connSettings->replicaSetSettings()->membersToHostAndPort()) {
+                std::string const host = member.toString();
+                auto &conn = _memberConnections[host];
+
+                // Do not wait for connect or socket timeout on members, which
+                // replica set monitor of the driver already knows to be down
+                if (repSetMonitor && !repSetMonitor->isHostUp(member)) {
+                    conn.reset();
+                    _topology.reportFailure(host);
+                    continue;
+                }
+
+                try {
+                    if (!conn) {
+                        SslParamsScope const sslScope;
+                        configureSSL();
+                        conn.reset(new mongo::DBClientConnection { false, _mongoTimeoutSec });
+                        mongo::Status const& status = conn->connect(member, APP_NAME_VERSION);
+                        if (!status.isOK())
+                            throw std::runtime_error(status.reason());
+                    }
+
+                    QElapsedTimer timer;
+                    timer.start();
+                    mongo::BSONObj isMaster;
+                    conn->runCommand("admin", BSON("isMaster" << 1), isMaster);
+                    double const rttMs = timer.nsecsElapsed() / 1000000.0;
+
+                    // Reported by 3.4+ servers
+                    mongo::BSONElement const lastWrite = isMaster.getFieldDotted("lastWrite.lastWriteDate");
+                    long long const lastWriteMs = 
+                        lastWrite.type() == mongo::Date ? lastWrite.date().toMillisSinceEpoch() : -1;
+
+                    _topology.reportReply(host, isMaster.getBoolField("ismaster"), rttMs, lastWriteMs);
+                }
+                catch (const std::exception &) {
+                    conn.reset();
+                    _topology.reportFailure(host);
                 }
             }
-        }
 
-        return setName;
+            reply(listener, new ReplicaSetTopologyUpdated(this, _topology.members()));
+        }));
     }
 
     /**
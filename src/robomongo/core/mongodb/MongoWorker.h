@@ -2,11 +2,16 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QThreadPool>
+#include <functional>
+#include <map>
 #include <unordered_set>
 
 #include <mongo/client/dbclient_rs.h> 
 
 #include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MongoConnectionPool.h"
+#include "robomongo/core/mongodb/ReplicaSetTopology.h"
 
 QT_BEGIN_NAMESPACE
 class QThread;
@@ -18,6 +23,8 @@ namespace Robomongo
     class MongoClient;
     class ScriptEngine;
     class ConnectionSettings;
+    class Counter;
+    class Histogram;
 
     class MongoWorker : public QObject
     {
@@ -37,8 +44,9 @@ namespace Robomongo
         void init();
 
         /**
-         * @brief Every minute we are issuing { ping : 1 } command to every used connection
-         * in order to avoid dropped connections.
+         * @brief Every minute we are issuing { ping : 1 } command to main connection and shell
+         * in order to avoid dropped connections. Pooled connections are checked before reuse
+         * and closed when idle for long.
          */
         void keepAlive();
 
@@ -63,6 +71,11 @@ namespace Robomongo
          */
         void handle(LoadCollectionNamesRequest *event);
 
+        /**
+         * @brief Load statistics (size, storage size, count) of collections
+         */
+        void handle(LoadCollectionStatsRequest *event);
+
         /**
          * @brief Load list of all users
          */
@@ -73,6 +86,11 @@ namespace Robomongo
         */
         void handle(LoadCollectionIndexesRequest *event);
 
+        /**
+        * @brief Load indexes of all collections of one database
+        */
+        void handle(LoadDatabaseIndexesRequest *event);
+
         /**
         * @brief Add/edit indexes in collection
         */
@@ -103,6 +121,17 @@ namespace Robomongo
          */
         void handle(ExecuteQueryRequest *event);
 
+        /**
+         * @brief Explain query or aggregation with "executionStats" verbosity
+         */
+        void handle(ExplainQueryRequest *event);
+
+        /**
+         * @brief Build schema of collection from random sample of its documents
+         */
+        void handle(SampleSchemaRequest *event);
+        void handle(SampleOperationsRequest *event);
+
         /**
          * @brief Execute javascript
          */
@@ -110,7 +139,6 @@ namespace Robomongo
         void retry(ExecuteScriptRequest *event);
         void handle(StopScriptRequest *event);
 
-        void handle(AutocompleteRequest *event);
         void handle(CreateDatabaseRequest *event);
         void handle(DropDatabaseRequest *event);
 
@@ -146,9 +174,33 @@ namespace Robomongo
         MongoClient *getClient();
 
         /**
-        *@brief Reset and update global mongo SSL settings (mongo::sslGlobalParams)
+        *@brief Run read-only 'task' on a pooled connection in one of _poolThreads, so that
+        *       explorer loads do not wait behind queries and writes on the main connection.
+        *       'onError' is called in the same thread if task or connection fails.
+        *       Before connection is established, runs synchronously on the main connection.
         */
-        void configureSSL();
+        void runConcurrently(std::function<void(MongoClient &client)> task,
+                             std::function<void(const std::exception &ex)> onError);
+
+        // Factory of _connectionPool, called in pool threads. Sets up global SSL
+        // params of this connection for the time of connect.
+        std::unique_ptr<mongo::DBClientBase> createPooledConnection() const;
+
+        /**
+        *@brief Negotiates network compression with primary of connected 'repSet'.
+        *       Without reachable primary connection stays uncompressed and 'error' is set.
+        *@return Negotiated compressor, empty if not compressed
+        */
+        std::string negotiateWithPrimary(mongo::DBClientReplicaSet *repSet, std::string &error) const;
+
+        // Authenticate with primary credential, if it is enabled
+        void authenticate(mongo::DBClientBase *conn) const;
+
+        /**
+        *@brief Reset and update global mongo SSL settings (mongo::sslGlobalParams).
+        *       Outside of this worker's thread, call within SslParamsScope (see cpp).
+        */
+        void configureSSL() const;
 
         /**
         *@brief Update global mongo SSL settings (mongo::sslGlobalParams) according to active connection 
@@ -166,7 +218,13 @@ namespace Robomongo
         */
         ReplicaSet getReplicaSetInfo() const;
 
-        std::string connectAndGetReplicaSetName() const;
+        std::string connectAndGetReplicaSetName();
+
+        /**
+        *@brief Measure round trip time and replication lag of replica set members on
+        *       _topologyThread and send ReplicaSetTopologyUpdated to _topologyListener.
+        */
+        void refreshTopology();
 
         /**
          * @brief Send reply event to object 'obj'
@@ -186,8 +244,8 @@ namespace Robomongo
         const bool _isLoadMongoRcJs;
         const int _batchSize;
         int _timerId;
-        int _dbAutocompleteCacheTimerId;
-        double _mongoTimeoutSec;
+        // Read by pool threads, never changed (changeTimeout() changes shell timeout)
+        double const _mongoTimeoutSec;
         int _shellTimeoutSec;
         QAtomicInteger<int> _isQuiting;
 
@@ -196,12 +254,51 @@ namespace Robomongo
 
         ConnectionSettings *_connSettings;
 
+        // Negotiated network compressor of _dbclient/_dbclientRepSet, empty if not compressed
+        std::string _compressor;
+
+        // Connections for concurrent explorer loads, used once _isConnected
+        static const int POOL_SIZE = 3;
+        bool _isConnected = false;
+        std::string _poolSetName;
+        MongoConnectionPool _connectionPool;
+        QThreadPool _poolThreads;
+
+        // Probes of replica set members, see connectAndGetReplicaSetName()
+        QThreadPool _probeThreads;
+
+        // Operations monitor samples on its own low priority thread and connection,
+        // so that it neither waits behind user queries nor takes pooled connections
+        QThreadPool _monitorThread;
+        std::unique_ptr<mongo::DBClientBase> _monitorConnection;
+
+        // Replica set topology monitor, started for explorer connection only.
+        // Members are measured on _topologyThread, which alone uses _topology
+        // and _memberConnections.
+        int _topologyTimerId = -1;
+        QObject *_topologyListener = nullptr;
+        QThreadPool _topologyThread;
+        ReplicaSetTopology _topology;
+        // Dedicated connection per member (host:port), so that samples are not
+        // skewed by connection setup
+        std::map<std::string, std::unique_ptr<mongo::DBClientConnection>> _memberConnections;
+
         // Collection of created databases.
         // Starting from 3.0, MongoDB drops empty databases.
         // It means, we did not find a way to create "empty" database.
         // We save all created databases in this collection and merge with
         // list of real databases returned from MongoDB server.
         std::unordered_set<std::string> _createdDbs;
+
+        // Metrics of this connection, see MetricsRegistry
+        std::string _metricsScope;
+        std::shared_ptr<Histogram> _pingRtt;
+        std::shared_ptr<Histogram> _queryTime;
+        std::shared_ptr<Counter> _queryDocuments;
+        std::shared_ptr<Counter> _queryBytes;
+        std::shared_ptr<Counter> _queryWireBytes;
+        std::shared_ptr<Counter> _queryUncompressedBytes;
+        std::shared_ptr<Histogram> _scriptTime;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "robomongo/core/mongodb/ReplicaSetTopology.h"
+
+#include <algorithm>
+
+namespace Robomongo
+{
+    void ReplicaSetTopology::reportReply(std::string const& host, bool primary, double rttMs,
+                                         long long lastWriteMs)
+    {
+        Member &m = member(host);
+        m.stats.up = true;
+        m.stats.primary = primary;
+        m.stats.rttMs = m.stats.rttMs < 0 ? rttMs : RttWeight * rttMs + (1 - RttWeight) * m.stats.rttMs;
+        m.lastWriteMs = lastWriteMs;
+
+        // There is only one primary, the previous one has stepped down
+        if (primary) {
+            for (auto &other : _members) {
+                if (&other != &m)
+                    other.stats.primary = false;
+            }
+        }
+    }
+
+    void ReplicaSetTopology::reportFailure(std::string const& host)
+    {
+        Member &m = member(host);
+        m.stats.up = false;
+        m.stats.primary = false;
+        m.stats.rttMs = -1;     // Start averaging from scratch when member is back
+        m.lastWriteMs = -1;
+    }
+
+    std::vector<ReplicaMemberStats> ReplicaSetTopology::members() const
+    {
+        // Reference point of lag: primary, or most recent secondary if there is no primary
+        long long latestWriteMs = -1;
+        for (auto const& m : _members) {
+            if (m.stats.up && m.stats.primary && m.lastWriteMs >= 0) {
+                latestWriteMs = m.lastWriteMs;
+                break;
+            }
+            if (m.stats.up)
+                latestWriteMs = std::max(latestWriteMs, m.lastWriteMs);
+        }
+
+        std::vector<ReplicaMemberStats> result;
+        for (auto const& m : _members) {
+            ReplicaMemberStats stats = m.stats;
+            stats.lagSecs = -1;
+            if (stats.up && m.lastWriteMs >= 0 && latestWriteMs >= 0)
+                stats.lagSecs = std::max(0LL, latestWriteMs - m.lastWriteMs) / 1000;
+
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    ReplicaSetTopology::Member &ReplicaSetTopology::member(std::string const& host)
+    {
+        auto it = std::find_if(_members.begin(), _members.end(),
+                               [&host](Member const& m) { return m.stats.host == host; });
+        if (it != _members.end())
+            return *it;
+
+        _members.push_back(Member());
+        _members.back().stats.host = host;
+        return _members.back();
+    }
+}
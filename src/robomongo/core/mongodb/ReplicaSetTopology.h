@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+    * @brief Live round trip time and replication lag of a replica set member.
+    */
+    struct ReplicaMemberStats
+    {
+        std::string host;           // i.e. "localhost:27017"
+        bool up = false;
+        bool primary = false;
+        double rttMs = -1;          // Smoothed round trip time, -1 until the first reply
+        long long lagSecs = -1;     // Behind the most recent write in the set, -1 if unknown
+    };
+
+    /**
+    * @brief Accumulates periodic isMaster replies of replica set members (see MongoWorker).
+    *
+    *        Round trip time is an exponentially weighted moving average, so that
+    *        a single slow reply does not reorder members. Replication lag is
+    *        derived from "lastWrite.lastWriteDate" of isMaster replies (3.4+),
+    *        relative to the primary or, when no primary is known, to the most
+    *        recent secondary.
+    */
+    class ReplicaSetTopology
+    {
+    public:
+        // Weight of a new sample, same as in the server selection spec of MongoDB drivers
+        static constexpr double RttWeight = 0.2;
+
+        /**
+        * @param lastWriteMs: milliseconds since epoch, negative if member did not report it
+        */
+        void reportReply(std::string const& host, bool primary, double rttMs, long long lastWriteMs);
+        void reportFailure(std::string const& host);
+
+        // Members in the order they were first reported
+        std::vector<ReplicaMemberStats> members() const;
+
+    private:
+        struct Member
+        {
+            ReplicaMemberStats stats;
+            long long lastWriteMs = -1;
+        };
+
+        Member &member(std::string const& host);
+
+        std::vector<Member> _members;
+    };
+}
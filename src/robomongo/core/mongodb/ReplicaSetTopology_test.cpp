@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "ReplicaSetTopology.h"
+
+using namespace Robomongo;
+
+TEST(replica_set_topology_tests, rtt_is_smoothed)
+{
+    ReplicaSetTopology topology;
+    topology.reportReply("a:27017", true, 10, -1);
+    EXPECT_DOUBLE_EQ(10, topology.members()[0].rttMs);
+
+    topology.reportReply("a:27017", true, 60, -1);
+    EXPECT_DOUBLE_EQ(20, topology.members()[0].rttMs);
+
+    topology.reportFailure("a:27017");
+    EXPECT_FALSE(topology.members()[0].up);
+    EXPECT_DOUBLE_EQ(-1, topology.members()[0].rttMs);
+
+    topology.reportReply("a:27017", true, 5, -1);
+    EXPECT_DOUBLE_EQ(5, topology.members()[0].rttMs);
+}
+
+TEST(replica_set_topology_tests, lag_relative_to_primary)
+{
+    ReplicaSetTopology topology;
+    topology.reportReply("s1:27017", false, 1, 95000);
+    topology.reportReply("p:27017", true, 1, 100000);
+    topology.reportReply("s2:27017", false, 1, -1);
+    topology.reportFailure("s3:27017");
+
+    auto const members = topology.members();
+    ASSERT_EQ(4u, members.size());
+    EXPECT_EQ("s1:27017", members[0].host);
+    EXPECT_EQ(5, members[0].lagSecs);
+    EXPECT_EQ(0, members[1].lagSecs);
+    EXPECT_EQ(-1, members[2].lagSecs);
+    EXPECT_EQ(-1, members[3].lagSecs);
+}
+
+TEST(replica_set_topology_tests, lag_without_primary)
+{
+    ReplicaSetTopology topology;
+    topology.reportReply("p:27017", true, 1, 100000);
+    topology.reportReply("s1:27017", false, 1, 90000);
+    topology.reportReply("s2:27017", false, 1, 98000);
+    topology.reportFailure("p:27017");
+
+    auto const members = topology.members();
+    EXPECT_FALSE(members[0].primary);
+    EXPECT_EQ(8, members[1].lagSecs);
+    EXPECT_EQ(0, members[2].lagSecs);
+}
+
+TEST(replica_set_topology_tests, single_primary)
+{
+    ReplicaSetTopology topology;
+    topology.reportReply("a:27017", true, 1, -1);
+    topology.reportReply("b:27017", true, 1, -1);
+
+    auto const members = topology.members();
+    EXPECT_FALSE(members[0].primary);
+    EXPECT_TRUE(members[1].primary);
+}
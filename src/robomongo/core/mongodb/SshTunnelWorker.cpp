@@ -18,9 +18,12 @@ namespace Robomongo
     SshTunnelWorker::SshTunnelWorker(ConnectionSettings *settings) : QObject(),
         _settings(settings),
         _sshSession(NULL),
+        _control(std::make_shared<SshTunnelControl>()),
         _configCreator(settings)
     {
         _thread = new QThread();
+        _thread->setObjectName("SshTunnelWorker");
+        _thread->setProperty("metricsScope", QString::fromStdString(settings->getReadableName()));
         moveToThread(_thread);
         VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
         VERIFY(connect(_thread, SIGNAL(finished()), this, SLOT(deleteLater())));
@@ -94,6 +97,18 @@ namespace Robomongo
             if (_sshSession == NULL)
                 return;
 
+            {
+                QMutexLocker lock(&_control->_mutex);
+                if (_control->_stopped) {
+                    // Nobody needs this tunnel anymore
+                    rbm_ssh_session_close(_sshSession);
+                    _sshSession = NULL;
+                    stopAndDelete();
+                    return;
+                }
+                _control->_session = _sshSession;
+            }
+
             // We are running this timer in order to distinguish between two
             // types of errors:
             // 1) SSH tunnel wasn't successfully created
@@ -102,9 +117,18 @@ namespace Robomongo
             QElapsedTimer timer;
             timer.start();
 
-            // This function will block until all TCP connections disconnects.
-            // Initially, it will wait for at least one such connection.
-            if (rbm_ssh_open_tunnel(_sshSession) != 0) {
+            // This function will block until tunnel is stopped via SshTunnelControl
+            int const rc = rbm_ssh_open_tunnel(_sshSession);
+
+            bool stopped = false;
+            {
+                QMutexLocker lock(&_control->_mutex);
+                _control->_session = NULL;
+                stopped = _control->_stopped;
+            }
+
+            // Errors after stop (i.e. during reconnect) are not interesting
+            if (rc != 0 && !stopped) {
 
                 qint64 elapsed = timer.elapsed();
                 bool wasDisconnected = elapsed > 20000; // More than 20 seconds passed
@@ -135,7 +159,12 @@ namespace Robomongo
                 throw std::runtime_error(ss.str());
             }
 
+            rbm_ssh_session_close(_sshSession);
+            _sshSession = NULL;
+
             log("SSH tunnel stopped normally.", false);
+            reply(event->sender(),
+                  new ListenSshConnectionResponse(this, event->serverHandle, _settings, event->connectionType));
 
         } catch (const std::exception& ex) {
             reply(event->sender(),
@@ -171,6 +200,14 @@ namespace Robomongo
         static_cast<SshTunnelWorker*>(context)->log(message, level);
     }
 
+    void SshTunnelControl::stop() {
+        QMutexLocker lock(&_mutex);
+        _stopped = true;
+
+        if (_session)
+            rbm_ssh_session_stop(_session);
+    }
+
     /*
      * SshTunnelConfigCreator
      */
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QObject>
+#include <QMutex>
+#include <memory>
 
 #include <robomongo/ssh/ssh.h>
 #include "robomongo/core/events/MongoEvents.h"
@@ -46,6 +48,37 @@ namespace Robomongo
         rbm_ssh_tunnel_config* _sshConfig;
     };
 
+    /*
+     * Thread-safe handle to stop SSH tunnel, that is running in SshTunnelWorker
+     * thread. Shared by App and worker, so it stays valid after worker is deleted.
+     */
+    class SshTunnelControl
+    {
+    public:
+        SshTunnelControl() : _session(NULL), _stopped(false) {}
+
+        /*
+         * Stops tunnel (or prevents it from starting) and so finishes worker
+         */
+        void stop();
+
+    private:
+        friend class SshTunnelWorker;
+
+        QMutex _mutex;
+        rbm_ssh_session* _session;  // Not NULL only while tunnel is running
+        bool _stopped;
+    };
+
+    /*
+     * Runs SSH tunnel in a separate thread. Tunnel is shared by all servers
+     * of one connection (explorer and every shell tab), each of them talks
+     * to its own direct-tcpip channel of the single SSH session. Tunnel works
+     * until it is stopped via control() (see App::releaseSshTunnel).
+     * Failure of one server's channel closes only its TCP connection, errors
+     * of the SSH session are retried by reconnecting; only when that fails
+     * the tunnel finishes and all its servers lose connection.
+     */
     class SshTunnelWorker : public QObject
     {
     Q_OBJECT
@@ -54,6 +87,8 @@ namespace Robomongo
         explicit SshTunnelWorker(ConnectionSettings *settings);
         ~SshTunnelWorker();
 
+        std::shared_ptr<SshTunnelControl> control() const { return _control; }
+
         static void logCallbackHandler(void* context, char *message, int level);
 
     protected:
@@ -71,6 +106,7 @@ namespace Robomongo
         QAtomicInteger<int> _isQuiting;
         ConnectionSettings* _settings;
         rbm_ssh_session* _sshSession;
+        const std::shared_ptr<SshTunnelControl> _control;
 
         SshTunnelConfigCreator _configCreator;
     };
@@ -0,0 +1,116 @@
+#include "robomongo/core/mongodb/WireCompression.h"
+
+#include <algorithm>
+
+#include <mongo/client/dbclient_connection.h>
+#include <mongo/transport/message_compressor_manager.h>
+#include <mongo/transport/message_compressor_registry.h>
+
+namespace Robomongo
+{
+    namespace WireCompression
+    {
+        std::vector<std::string> const& available()
+        {
+            static std::vector<std::string> const names { "snappy", "zstd", "zlib" };
+            return names;
+        }
+
+        void registerAvailable()
+        {
+            // Registry drops implementations, which are not listed here, during global initialization
+            auto names = available();
+            mongo::MessageCompressorRegistry::get().setSupportedCompressors(std::move(names));
+        }
+
+        std::vector<std::string> parse(std::string const& compressors)
+        {
+            std::vector<std::string> result;
+            std::string::size_type start = 0;
+            while (start <= compressors.size()) {
+                auto end = compressors.find(',', start);
+                if (end == std::string::npos)
+                    end = compressors.size();
+
+                std::string const name = compressors.substr(start, end - start);
+                bool const known = std::find(available().cbegin(), available().cend(), name) 
+                                   != available().cend();
+                if (known && std::find(result.cbegin(), result.cend(), name) == result.cend())
+                    result.push_back(name);
+
+                start = end + 1;
+            }
+            return result;
+        }
+
+        std::string negotiate(mongo::DBClientConnection *conn, std::string const& compressors)
+        {
+            auto const requested = parse(compressors);
+            auto &manager = conn->getCompressorManager();
+            if (requested.empty()) {
+                // No "compression" field in reply: outgoing messages are not compressed,
+                // and server compresses replies only to compressed requests.
+                manager.clientFinish(mongo::BSONObj());
+                return "";
+            }
+
+            // Server replies with compressors it supports out of requested ones (or 
+            // with the ones negotiated during handshake), keep our order of preference.
+            mongo::BSONArrayBuilder requestedArr;
+            for (auto const& name : requested)
+                requestedArr.append(name);
+
+            mongo::BSONObj reply;
+            conn->runCommand("admin", BSON("isMaster" << 1 << "compression" << requestedArr.arr()), reply);
+
+            std::vector<std::string> supported;
+            if (reply["compression"].type() == mongo::Array) {
+                for (auto const& elem : reply["compression"].Array())
+                    supported.push_back(elem.str());
+            }
+
+            mongo::BSONArrayBuilder negotiatedArr;
+            std::string first;
+            for (auto const& name : requested) {
+                if (std::find(supported.cbegin(), supported.cend(), name) == supported.cend())
+                    continue;
+
+                if (first.empty())
+                    first = name;
+                negotiatedArr.append(name);
+            }
+
+            if (first.empty())
+                manager.clientFinish(mongo::BSONObj());
+            else
+                manager.clientFinish(BSON("compression" << negotiatedArr.arr()));
+
+            return first;
+        }
+
+        Stats Stats::operator-(Stats const& other) const
+        {
+            Stats result;
+            result.wireBytes = wireBytes - other.wireBytes;
+            result.messageBytes = messageBytes - other.messageBytes;
+            return result;
+        }
+
+        Stats stats()
+        {
+            Stats result;
+            auto &registry = mongo::MessageCompressorRegistry::get();
+            for (auto const& name : registry.getCompressorNames()) {
+                auto compressor = registry.getCompressor(name);
+                if (!compressor)
+                    continue;
+
+                result.messageBytes += compressor->getCompressorBytesIn() + 
+                                       compressor->getDecompressorBytesOut();
+                result.wireBytes += compressor->getCompressorBytesOut() + 
+                                    compressor->getDecompressorBytesIn();
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace mongo
+{
+    class DBClientConnection;
+}
+
+namespace Robomongo
+{
+    /**
+     * @brief OP_COMPRESSED support of shell and explorer connections.
+     *
+     *        The driver offers compressors of a process-wide registry during
+     *        connection handshake, so all compiled-in compressors are registered
+     *        once at startup (see main.cpp) and every connection then narrows the
+     *        negotiated list down to the one of its ConnectionSettings: explorer
+     *        connections with negotiate(), shell connections with "compressors"
+     *        of connection string ("disabled" when setting is empty).
+     */
+    namespace WireCompression
+    {
+        // Compressors compiled into the driver, in default order of preference
+        std::vector<std::string> const& available();
+
+        // Must be called before mongo::runGlobalInitializersOrDie()
+        void registerAvailable();
+
+        // Known names of comma separated 'compressors' setting, in the same order
+        std::vector<std::string> parse(std::string const& compressors);
+
+        /**
+         * @brief Renegotiates compression of established connection.
+         * @return Compressor used for outgoing messages, empty if compression is disabled
+         *         or none of 'compressors' is supported by server.
+         */
+        std::string negotiate(mongo::DBClientConnection *conn, std::string const& compressors);
+
+        /**
+         * @brief Process-wide byte counters of all compressors, i.e. the
+         *        difference of two samples taken around a query.
+         */
+        struct Stats
+        {
+            long long wireBytes = 0;       // Compressed, as sent and received
+            long long messageBytes = 0;    // Same messages uncompressed
+
+            Stats operator-(Stats const& other) const;
+            double ratio() const { return wireBytes > 0 ? double(messageBytes) / wireBytes : 0; }
+        };
+
+        Stats stats();
+    }
+}
@@ -79,6 +79,7 @@ namespace Robomongo
         setServerHost(QtUtils::toStdString(map.value("serverHost").toString().left(maxLength)));
         setServerPort(map.value("serverPort").toInt());
         setDefaultDatabase(QtUtils::toStdString(map.value("defaultDatabase").toString()));
+        setCompressors(QtUtils::toStdString(map.value("compressors").toString()));
         setReplicaSet(map.value("isReplicaSet").toBool());       
         
         QVariantList list = map.value("credentials").toList();
@@ -140,6 +141,7 @@ namespace Robomongo
         setServerHost(source->serverHost());
         setServerPort(source->serverPort());
         setDefaultDatabase(source->defaultDatabase());
+        setCompressors(source->compressors());
         setImported(source->imported());
         setReplicaSet(source->isReplicaSet());
 
@@ -168,6 +170,7 @@ namespace Robomongo
         map.insert("serverHost", QtUtils::toQString(serverHost()));
         map.insert("serverPort", serverPort());
         map.insert("defaultDatabase", QtUtils::toQString(defaultDatabase()));
+        map.insert("compressors", QtUtils::toQString(compressors()));
         map.insert("isReplicaSet", isReplicaSet());
         if (isReplicaSet())
             map.insert("replicaSet", _replicaSetSettings->toVariant());
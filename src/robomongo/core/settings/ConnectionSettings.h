@@ -80,6 +80,13 @@ namespace Robomongo
         std::string defaultDatabase() const { return _defaultDatabase; }
         void setDefaultDatabase(const std::string &defaultDatabase) { _defaultDatabase = defaultDatabase; }
 
+        /**
+         * @brief Comma separated network compressors in order of preference,
+         *        i.e. "snappy,zstd,zlib". Empty - compression disabled.
+         */
+        std::string compressors() const { return _compressors; }
+        void setCompressors(const std::string &compressors) { _compressors = compressors; }
+
         /**
          * Was this connection imported from somewhere?
          */
@@ -158,6 +165,7 @@ namespace Robomongo
         std::string _host;
         int _port;
         std::string _defaultDatabase;
+        std::string _compressors;
         mutable QList<CredentialSettings *> _credentials;
         std::unique_ptr<SshSettings> _sshSettings;
         std::unique_ptr<SslSettings> _sslSettings;
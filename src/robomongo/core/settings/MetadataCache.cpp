@@ -0,0 +1,208 @@
+#include "robomongo/core/settings/MetadataCache.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/Logger.h"
+
+namespace
+{
+    // 'RMDC' - Robomongo Metadata Cache
+    const quint32 CacheFileMagic = 0x524D4443;
+
+    // Increment when binary layout changes. Files with other version are ignored.
+    const quint16 CacheFileVersion = 1;
+}
+
+namespace Robomongo
+{
+    QString metadataCacheDir()
+    {
+        return CacheDir + "metadata/";
+    }
+
+    MetadataCache::MetadataCache()
+    {
+    }
+
+    MetadataCache::~MetadataCache()
+    {
+        for (auto it = _entries.constBegin(); it != _entries.constEnd(); ++it) {
+            if (it.value().dirty)
+                save(it.key(), it.value());
+        }
+    }
+
+    QStringList MetadataCache::collections(QString const& uuid, QString const& dbName,
+                                           bool *found /* = nullptr */)
+    {
+        Entry const& e = entry(uuid);
+        auto const it = e.collections.constFind(dbName);
+        if (found)
+            *found = (it != e.collections.constEnd());
+
+        return it != e.collections.constEnd() ? it.value() : QStringList();
+    }
+
+    bool MetadataCache::setDatabases(QString const& uuid, QStringList const& names)
+    {
+        Entry &e = entry(uuid);
+        if (e.hasDatabases && e.databases == names)
+            return false;
+
+        e.databases = names;
+        e.hasDatabases = true;
+
+        // Drop collection lists of databases which no longer exist
+        for (auto it = e.collections.begin(); it != e.collections.end(); ) {
+            if (names.contains(it.key()))
+                ++it;
+            else
+                it = e.collections.erase(it);
+        }
+
+        e.updated = QDateTime::currentDateTimeUtc();
+        e.dirty = true;
+        return true;
+    }
+
+    bool MetadataCache::setCollections(QString const& uuid, QString const& dbName, QStringList const& names)
+    {
+        Entry &e = entry(uuid);
+        auto const it = e.collections.constFind(dbName);
+        if (it != e.collections.constEnd() && it.value() == names)
+            return false;
+
+        e.collections.insert(dbName, names);
+        e.updated = QDateTime::currentDateTimeUtc();
+        e.dirty = true;
+        return true;
+    }
+
+    void MetadataCache::addCollection(QString const& uuid, QString const& dbName, QString const& collection)
+    {
+        Entry &e = entry(uuid);
+        auto const it = e.collections.find(dbName);
+        if (it == e.collections.end() || it.value().contains(collection))
+            return;
+
+        it.value().append(collection);
+        it.value().sort();
+        e.dirty = true;
+    }
+
+    void MetadataCache::removeCollection(QString const& uuid, QString const& dbName, QString const& collection)
+    {
+        Entry &e = entry(uuid);
+        auto const it = e.collections.find(dbName);
+        if (it == e.collections.end())
+            return;
+
+        if (it.value().removeAll(collection) > 0)
+            e.dirty = true;
+    }
+
+    void MetadataCache::addDatabase(QString const& uuid, QString const& dbName)
+    {
+        Entry &e = entry(uuid);
+        if (!e.hasDatabases || e.databases.contains(dbName))
+            return;
+
+        e.databases.append(dbName);
+        e.databases.sort();
+        e.dirty = true;
+    }
+
+    void MetadataCache::removeDatabase(QString const& uuid, QString const& dbName)
+    {
+        Entry &e = entry(uuid);
+        if (e.databases.removeAll(dbName) > 0)
+            e.dirty = true;
+
+        if (e.collections.remove(dbName) > 0)
+            e.dirty = true;
+    }
+
+    void MetadataCache::invalidate(QString const& uuid)
+    {
+        Entry &e = entry(uuid);
+        e = Entry();
+        e.loaded = true;    // Do not re-read file we are going to remove
+        QFile::remove(filePath(uuid));
+    }
+
+    void MetadataCache::flush(QString const& uuid)
+    {
+        auto const it = _entries.find(uuid);
+        if (it == _entries.end() || !it.value().dirty)
+            return;
+
+        if (save(uuid, it.value()))
+            it.value().dirty = false;
+    }
+
+    MetadataCache::Entry &MetadataCache::entry(QString const& uuid)
+    {
+        Entry &e = _entries[uuid];
+        if (!e.loaded) {
+            load(uuid, e);
+            e.loaded = true;
+        }
+        return e;
+    }
+
+    bool MetadataCache::load(QString const& uuid, Entry &entry) const
+    {
+        QFile file(filePath(uuid));
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0;
+        quint16 version = 0;
+        in >> magic >> version;
+        if (magic != CacheFileMagic || version != CacheFileVersion)
+            return false;
+
+        Entry loaded;
+        in >> loaded.updated >> loaded.hasDatabases >> loaded.databases >> loaded.collections;
+        if (in.status() != QDataStream::Ok) {
+            LOG_MSG("Metadata cache file is corrupted and will be ignored: " + file.fileName(),
+                    mongo::logger::LogSeverity::Warning());
+            return false;
+        }
+
+        entry.updated = loaded.updated;
+        entry.hasDatabases = loaded.hasDatabases;
+        entry.databases = loaded.databases;
+        entry.collections = loaded.collections;
+        return true;
+    }
+
+    bool MetadataCache::save(QString const& uuid, Entry const& entry) const
+    {
+        if (!QDir().mkpath(metadataCacheDir()))
+            return false;
+
+        // QSaveFile guarantees that we never leave half-written cache on disk
+        QSaveFile file(filePath(uuid));
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_0);
+        out << CacheFileMagic << CacheFileVersion;
+        out << entry.updated << entry.hasDatabases << entry.databases << entry.collections;
+
+        return out.status() == QDataStream::Ok && file.commit();
+    }
+
+    QString MetadataCache::filePath(QString const& uuid)
+    {
+        return metadataCacheDir() + uuid + ".bin";
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QDateTime>
+
+namespace Robomongo
+{
+    // Directory of per-connection metadata cache files
+    QString metadataCacheDir();
+
+/* ------------------------------ MetadataCache ------------------------------- */
+
+    /**
+     * @brief MetadataCache keeps the last known database and collection names
+     *        of every primary connection, so that the explorer can be rendered
+     *        immediately on reconnect and reconciled when the real listings
+     *        arrive from MongoWorker. Database names come with the connection
+     *        handshake, they are kept to drop collections of removed databases.
+     *
+     *        Each connection is stored in its own compact binary file
+     *        (QDataStream) under CacheDir/metadata/<connection uuid>.bin.
+     *        Files are loaded lazily on first access and written back by flush().
+     *
+     *        You can access this cache via:
+     *        AppRegistry::instance().metadataCache()
+     *
+     * @threadsafe no, must be used from the GUI thread only
+     */
+    class MetadataCache
+    {
+    public:
+        MetadataCache();
+
+        /**
+         * @brief Writes all modified entries to disk
+         */
+        ~MetadataCache();
+
+        /**
+         * @brief Returns cached collection names of database 'dbName'.
+         * @param found: set to true if there is a cached entry
+         */
+        QStringList collections(QString const& uuid, QString const& dbName, bool *found = nullptr);
+
+        /**
+         * @brief Replace cached names with fresh server listings.
+         * @return true if cached entry differed from 'names' (or was missing)
+         */
+        bool setDatabases(QString const& uuid, QStringList const& names);
+        bool setCollections(QString const& uuid, QString const& dbName, QStringList const& names);
+
+        /**
+         * @brief Incremental updates, applied after successful DDL operations,
+         *        so that the next render does not show stale names.
+         *        Entries that were never listed are left untouched.
+         */
+        void addCollection(QString const& uuid, QString const& dbName, QString const& collection);
+        void removeCollection(QString const& uuid, QString const& dbName, QString const& collection);
+        void addDatabase(QString const& uuid, QString const& dbName);
+        void removeDatabase(QString const& uuid, QString const& dbName);
+
+        /**
+         * @brief Forget everything cached for connection 'uuid' (also on disk)
+         */
+        void invalidate(QString const& uuid);
+
+        /**
+         * @brief Write cached entry of 'uuid' to disk, if it was modified
+         */
+        void flush(QString const& uuid);
+
+    private:
+        struct Entry
+        {
+            Entry() : hasDatabases(false), loaded(false), dirty(false) {}
+
+            QStringList databases;
+            bool hasDatabases;
+            QHash<QString, QStringList> collections;
+            QDateTime updated;
+            bool loaded;
+            bool dirty;
+        };
+
+        Entry &entry(QString const& uuid);
+        bool load(QString const& uuid, Entry &entry) const;
+        bool save(QString const& uuid, Entry const& entry) const;
+        static QString filePath(QString const& uuid);
+
+        QHash<QString, Entry> _entries;
+    };
+}
@@ -1,5 +1,9 @@
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 
+#include <algorithm>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
 #include "robomongo/core/utils/QtUtils.h"
 
 namespace Robomongo
@@ -16,6 +20,15 @@ namespace Robomongo
         for (auto const& server : uri.getServers()) {
             _members.push_back(server.host() + ":" + std::to_string(server.port()));
         }
+        // i.e. "readPreference=nearest&maxStalenessSeconds=120"
+        auto const readPref = uri.getOption("readPreference").get_value_or("");
+        for (int mode = 0; mode <= static_cast<int>(ReadPreference::NEAREST); ++mode) {
+            auto const readPrefEnum = static_cast<ReadPreference>(mode);
+            if (readPreferenceMode(readPrefEnum) == readPref)
+                _readPreference = readPrefEnum;
+        }
+        auto const maxStaleness = uri.getOption("maxStalenessSeconds").get_value_or("0");
+        _maxStalenessSeconds = std::max(0, QString::fromStdString(maxStaleness).toInt());
     }
 
     ReplicaSetSettings *ReplicaSetSettings::clone() const 
@@ -35,6 +48,7 @@ namespace Robomongo
             ++idx;
         }
         map.insert("readPreference", static_cast<int>(readPreference()));
+        map.insert("maxStalenessSeconds", _maxStalenessSeconds);
         return map;
     }
 
@@ -56,6 +70,30 @@ namespace Robomongo
         setMembers(vec);
         // Extract and set read reference
         setReadPreference(static_cast<ReadPreference>(map.value("readPreference").toInt()));
+        setMaxStalenessSeconds(map.value("maxStalenessSeconds").toInt());
+    }
+
+    mongo::BSONObj ReplicaSetSettings::readPreferenceDocument() const
+    {
+        mongo::BSONObjBuilder builder;
+        builder.append("mode", readPreferenceMode(_readPreference));
+        // Not allowed with primary mode
+        if (_readPreference != ReadPreference::PRIMARY && _maxStalenessSeconds > 0) {
+            builder.append("maxStalenessSeconds", _maxStalenessSeconds < MinMaxStalenessSeconds ?
+                                                  MinMaxStalenessSeconds : _maxStalenessSeconds);
+        }
+
+        return builder.obj();
+    }
+
+    std::string ReplicaSetSettings::readPreferenceMode(ReadPreference readPreference)
+    {
+        switch (readPreference) {
+            case ReadPreference::PRIMARY_PREFERRED:     return "primaryPreferred";
+            case ReadPreference::SECONDARY_PREFERRED:   return "secondaryPreferred";
+            case ReadPreference::NEAREST:               return "nearest";
+            default:                                    return "primary";
+        }
     }
     
     void ReplicaSetSettings::setMembers(const std::vector<std::string>& members)
@@ -6,6 +6,7 @@
 
 #include <mongo/util/net/hostandport.h>
 #include <mongo/client/mongo_uri.h>
+#include <mongo/bson/bsonobj.h>
 
 namespace Robomongo
 {
@@ -15,10 +16,14 @@ namespace Robomongo
         enum class ReadPreference
         {
             PRIMARY             = 0,
-            PRIMARY_PREFERRED   = 1
-            // todo: Add all supported read preferences
+            PRIMARY_PREFERRED   = 1,
+            SECONDARY_PREFERRED = 2,
+            NEAREST             = 3
         };
 
+        // Smallest max staleness accepted by MongoDB servers
+        static int const MinMaxStalenessSeconds = 90;
+
         ReplicaSetSettings();
         
         ReplicaSetSettings(const mongo::MongoURI& uri);
@@ -47,6 +52,17 @@ namespace Robomongo
         }
         
         ReadPreference readPreference() const { return _readPreference; }
+        int maxStalenessSeconds() const { return _maxStalenessSeconds; }
+
+        /**
+         * Read preference document of queries, i.e. { mode: "nearest", maxStalenessSeconds: 120 }
+         */
+        mongo::BSONObj readPreferenceDocument() const;
+
+        /**
+         * Read preference mode as named in MongoDB, i.e. "secondaryPreferred"
+         */
+        static std::string readPreferenceMode(ReadPreference readPreference);
 
         // Setters
         void setSetNameUserEntered(const std::string& setName) { _setNameUserEntered = setName; }
@@ -55,6 +71,8 @@ namespace Robomongo
         void setMembers(const std::vector<std::pair<std::string,bool>>& membersAndHealts);
         void deleteAllMembers() { _members.clear(); }
         void setReadPreference(ReadPreference readPreference) { _readPreference = readPreference; }
+        // 0 means no bound
+        void setMaxStalenessSeconds(int seconds) { _maxStalenessSeconds = seconds; }
 
 
     private:
@@ -62,5 +80,6 @@ namespace Robomongo
         std::string _cachedSetName;
         std::vector<std::string> _members;
         ReadPreference _readPreference = ReadPreference::PRIMARY;
+        int _maxStalenessSeconds = 0;
     };
 }
@@ -5,18 +5,18 @@
 #include <QVariantList>
 #include <QUuid>
 #include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QXmlStreamReader>
 #include <QDirIterator>
 
-#include <parser.h>
-#include <serializer.h>
-
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/CredentialSettings.h"
 #include "robomongo/core/settings/SshSettings.h"
 #include "robomongo/core/settings/SslSettings.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/StartupTrace.h"
 #include "robomongo/core/utils/StdUtils.h"
 #include "robomongo/gui/AppStyle.h"
 #include "robomongo/utils/common.h"
@@ -53,6 +53,9 @@ namespace Robomongo
     // Extract "anonymousID" from a config file
     QString extractAnonymousID(QString const& configFile);
 
+    // Parse top level JSON object of a config file
+    bool parseJson(QByteArray const& data, QVariantMap &map);
+
     /**
         * @brief Version of schema
     */
@@ -92,6 +95,16 @@ namespace Robomongo
     };
 
     std::vector<ConnectionSettings*>  SettingsManager::_connections;
+
+    QString configFilePath()
+    {
+        return QString("%1/.3T/robo-3t/%2/robo3t.json").arg(QDir::homePath()).arg(PROJECT_VERSION);
+    }
+
+    QString configDir()
+    {
+        return QString("%1/.3T/robo-3t/%2/").arg(QDir::homePath()).arg(PROJECT_VERSION);
+    }
     
     /**
      * Creates SettingsManager for config file in default location
@@ -112,18 +125,22 @@ namespace Robomongo
         _textFontPointSize(-1),
         _mongoTimeoutSec(10),
         _shellTimeoutSec(15),
+        _autoExplainThresholdMs(1000),
         _imported(false)        
     {
-        if (!QDir().mkpath(ConfigDir))
-            LOG_MSG("ERROR: Could not create settings path: " + ConfigDir, mongo::logger::LogSeverity::Error());
+        if (!QDir().mkpath(configDir()))
+            LOG_MSG("ERROR: Could not create settings path: " + configDir(), mongo::logger::LogSeverity::Error());
 
         RoboCrypt::initKey();
+        StartupTrace::instance().mark("Settings: encryption key");
+
         if (!load()) {  // if load fails (probably due to non-existing config. file or directory)
             save();     // create empty settings file
-            load();     // try loading again for the purpose of import from previous Robomongo versions
+            load();     // try loading again, i.e. to create anonymous ID
         }
+        StartupTrace::instance().mark("Settings: load");
 
-        LOG_MSG("SettingsManager initialized in " + ConfigFilePath, mongo::logger::LogSeverity::Info(), false);
+        LOG_MSG("SettingsManager initialized in " + configFilePath(), mongo::logger::LogSeverity::Info(), false);
     }
 
     SettingsManager::~SettingsManager()
@@ -137,17 +154,15 @@ namespace Robomongo
      */
     bool SettingsManager::load()
     {
-        if (!QFile::exists(ConfigFilePath))
+        if (!QFile::exists(configFilePath()))
             return false;
 
-        QFile f(ConfigFilePath);
+        QFile f(configFilePath());
         if (!f.open(QIODevice::ReadOnly))
             return false;
 
-        bool ok;
-        QJson::Parser parser;
-        QVariantMap map = parser.parse(f.readAll(), &ok).toMap();
-        if (!ok)
+        QVariantMap map;
+        if (!parseJson(f.readAll(), map))
             return false;
 
         loadFromMap(map);
@@ -163,18 +178,15 @@ namespace Robomongo
     {
         QVariantMap const& map = convertToMap();
 
-        QFile f(ConfigFilePath);
+        QFile f(configFilePath());
         if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-            LOG_MSG("ERROR: Could not write settings to: " + ConfigFilePath, mongo::logger::LogSeverity::Error());
+            LOG_MSG("ERROR: Could not write settings to: " + configFilePath(), mongo::logger::LogSeverity::Error());
             return false;
         }
 
-        bool ok;
-        QJson::Serializer s;
-        s.setIndentMode(QJson::IndentFull);
-        s.serialize(map, &f, &ok);
+        bool const ok = f.write(QJsonDocument::fromVariant(map).toJson(QJsonDocument::Indented)) >= 0;
 
-        LOG_MSG("Settings saved to: " + ConfigFilePath, mongo::logger::LogSeverity::Info());
+        LOG_MSG("Settings saved to: " + configFilePath(), mongo::logger::LogSeverity::Info());
 
         return ok;
     }
@@ -192,10 +204,8 @@ namespace Robomongo
             return false;
         }
 
-        bool ok;
-        QJson::Parser parser;
-        QVariantMap configMap = parser.parse(configFile.readAll(), &ok).toMap();
-        if (!ok) {
+        QVariantMap configMap;
+        if (!parseJson(configFile.readAll(), configMap)) {
             LOG_MSG("ERROR: Failed to parse config file: " + configFilePath, mongo::logger::LogSeverity::Error());
             return false;
         }
@@ -336,6 +346,7 @@ namespace Robomongo
                                 map.value("disableHttpsFeatures").toBool() : false;
 
         _debugMode = map.contains("debugMode") ? map.value("debugMode").toBool() : false;
+        _logToFile = map.contains("logToFile") ? map.value("logToFile").toBool() : false;
 
         // 4. Load TimeZone
         int timeZone = map.value("timeZone").toInt();
@@ -391,6 +402,18 @@ namespace Robomongo
             _shellTimeoutSec = map.value("shellTimeoutSec").toInt();
         }
 
+        if (map.contains("autoExplainThresholdMs")) {
+            _autoExplainThresholdMs = map.value("autoExplainThresholdMs").toInt();
+        }
+
+        if (map.contains("resultsMemoryBudgetMb")) {
+            _resultsMemoryBudgetMb = map.value("resultsMemoryBudgetMb").toInt();
+        }
+
+        if (map.contains("largeTextThresholdMb")) {
+            _largeTextThresholdMb = map.value("largeTextThresholdMb").toInt();
+        }
+
         // 5. Load connections
         _connections.clear();
 
@@ -423,9 +446,6 @@ namespace Robomongo
             _toolbars["logs"] = false;
 
         _cacheData = map.value("cacheData").toMap();
-
-        // Load connection settings from previous versions of Robomongo
-        importFromOldVersion();
     }
 
     /**
@@ -477,6 +497,9 @@ namespace Robomongo
         map.insert("checkForUpdates", _checkForUpdates);
         map.insert("mongoTimeoutSec", _mongoTimeoutSec);
         map.insert("shellTimeoutSec", _shellTimeoutSec);
+        map.insert("autoExplainThresholdMs", _autoExplainThresholdMs);
+        map.insert("resultsMemoryBudgetMb", _resultsMemoryBudgetMb);
+        map.insert("largeTextThresholdMb", _largeTextThresholdMb);
 
         // 10. Save style
         map.insert("style", _currentStyle);
@@ -500,6 +523,7 @@ namespace Robomongo
         map.insert("programExitedNormally", _programExitedNormally);
         map.insert("disableHttpsFeatures", _disableHttpsFeatures);
         map.insert("debugMode", _debugMode);
+        map.insert("logToFile", _logToFile);
         
         return map;
     }
@@ -634,19 +658,22 @@ namespace Robomongo
         _toolbars[toolbarName] = visible;
     }
 
-    void SettingsManager::importFromOldVersion()
+    bool SettingsManager::importFromOldVersion()
     {
-        if (_imported)
-            return;
+        if (_imported || _importChecked)
+            return false;
+
+        _importChecked = true;
 
         // Import only from the latest version
         for (auto const& configFile : _configFilesOfOldVersions) {
             if (QFile::exists(configFile)) {
                 importFromFile(configFile);
                 setImported(true);
-                return;
+                return true;
             }
         }
+        return false;
     }
 
     bool SettingsManager::importConnectionsFrom_0_8_5()
@@ -660,10 +687,8 @@ namespace Robomongo
         if (!oldConfigFile.open(QIODevice::ReadOnly))
             return false;
 
-        bool ok;
-        QJson::Parser parser;
-        QVariantMap vmap = parser.parse(oldConfigFile.readAll(), &ok).toMap();
-        if (!ok)
+        QVariantMap vmap;
+        if (!parseJson(oldConfigFile.readAll(), vmap))
             return false;
 
         QVariantList vconns = vmap.value("connections").toList();
@@ -772,10 +797,8 @@ namespace Robomongo
         if (!oldConfigFile.open(QIODevice::ReadOnly))
             return false;
 
-        bool ok;
-        QJson::Parser parser;
-        QVariantMap vmap = parser.parse(oldConfigFile.readAll(), &ok).toMap();
-        if (!ok)
+        QVariantMap vmap;
+        if (!parseJson(oldConfigFile.readAll(), vmap))
             return false;
 
         //// Import keys
@@ -823,6 +846,17 @@ namespace Robomongo
         return QString("");
     }
 
+    bool parseJson(QByteArray const& data, QVariantMap &map)
+    {
+        QJsonParseError error;
+        QJsonDocument const doc = QJsonDocument::fromJson(data, &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject())
+            return false;
+
+        map = doc.object().toVariantMap();
+        return true;
+    }
+
     QString extractAnonymousID(QString const& configFilePath)
     {
         if (!QFile::exists(configFilePath))
@@ -832,10 +866,8 @@ namespace Robomongo
         if (!oldConfigFile.open(QIODevice::ReadOnly))
             return QString("");
 
-        bool ok = false;
-        QJson::Parser parser;
-        QVariantMap const& map = parser.parse(oldConfigFile.readAll(), &ok).toMap();
-        if (!ok)
+        QVariantMap map;
+        if (!parseJson(oldConfigFile.readAll(), map))
             return QString("");
 
         QString anonymousID;
@@ -18,12 +18,11 @@ namespace Robomongo
     // Current cache directory
     auto const CacheDir = QString("%1/.3T/robo-3t/%2/cache/").arg(QDir::homePath())
                                                              .arg(PROJECT_VERSION);
-    // Current config file
-    auto const ConfigFilePath = QString("%1/.3T/robo-3t/%2/robo3t.json").arg(QDir::homePath())
-                                                                        .arg(PROJECT_VERSION);  
+    // Current config file. Home directory is read on each call, so that tools
+    // (i.e. robo_bench) can redirect settings before SettingsManager is created.
+    QString configFilePath();
     // Current config file directory
-    auto const ConfigDir = QString("%1/.3T/robo-3t/%2/").arg(QDir::homePath())
-                                                        .arg(PROJECT_VERSION);  
+    QString configDir();
 
 /* ----------------------------- SettingsManager ------------------------------ */
 
@@ -163,10 +162,33 @@ namespace Robomongo
 
         void setShellTimeoutSec(int newValue) { _shellTimeoutSec = std::abs(newValue); }
 
+        // Find queries running longer are explained automatically, 0 disables
+        int autoExplainThresholdMs() const { return _autoExplainThresholdMs; }
+        void setAutoExplainThresholdMs(int newValue) { _autoExplainThresholdMs = std::abs(newValue); }
+
+        // Query results over this budget are spilled to disk (see ResultMemoryGovernor), 0 - unlimited
+        int resultsMemoryBudgetMb() const { return _resultsMemoryBudgetMb; }
+        void setResultsMemoryBudgetMb(int newValue) { _resultsMemoryBudgetMb = std::abs(newValue); }
+
+        // Text mode of larger results uses LargeTextView instead of QScintilla, 0 - never
+        int largeTextThresholdMb() const { return _largeTextThresholdMb; }
+        void setLargeTextThresholdMb(int newValue) { _largeTextThresholdMb = std::abs(newValue); }
+
+        // Write log records also to a rotating file (see Logger)
+        bool logToFile() const { return _logToFile; }
+        void setLogToFile(bool logToFile) { _logToFile = logToFile; }
+
         // True when settings from previous versions of Robomongo are imported
         void setImported(bool imported) { _imported = imported; }
         bool imported() const { return _imported; }
 
+        /**
+         * Load connection settings from previous versions of Robomongo. Deferred
+         * until connections are needed, since it probes several config paths.
+         * @return true if connections were imported (settings should be saved)
+         */
+        bool importFromOldVersion();
+
         QString anonymousID() const { return _anonymousID; }
 
         void addCacheData(QString const& key, QVariant const& value);
@@ -200,11 +222,6 @@ namespace Robomongo
         // a new anonymousID.
         QString getOrCreateAnonymousID(QVariantMap const& map) const;
 
-        /**
-         * Load connection settings from previous versions of Robomongo
-         */
-        void importFromOldVersion();
-
         // Imports connections from oldConfigFilePath into current config file
         bool importFromFile(QString const& oldConfigFilePath);
         
@@ -228,6 +245,7 @@ namespace Robomongo
         bool _programExitedNormally = true;
         bool _disableHttpsFeatures = false;
         bool _debugMode = false;
+        bool _logToFile = false;
         QSet<QString> _acceptedEulaVersions;
         QSet<QString> _dbVersionsConnected;
         int _batchSize;
@@ -238,9 +256,15 @@ namespace Robomongo
 
         int _mongoTimeoutSec;
         int _shellTimeoutSec;
+        int _autoExplainThresholdMs;
+        int _resultsMemoryBudgetMb = 1024;
+        int _largeTextThresholdMb = 16;
 
         // True when settings from previous versions of Robomongo are imported
         bool _imported;
+
+        // Old config files are probed once per run
+        bool _importChecked = false;
         
         /**
         * @brief This is an anonymous string taken from QUuid that is generated when Robomongo 
@@ -0,0 +1,127 @@
+#include "robomongo/core/utils/CompletionTrie.h"
+
+#include <algorithm>
+
+namespace
+{
+    char foldCase(char ch)
+    {
+        return ch >= 'A' && ch <= 'Z' ? ch + ('a' - 'A') : ch;
+    }
+
+    bool keyLess(const std::pair<char, int> &child, char key)
+    {
+        return child.first < key;
+    }
+}
+
+namespace Robomongo
+{
+    CompletionTrie::CompletionTrie() :
+        _nodes(1),
+        _size(0)
+    {
+    }
+
+    void CompletionTrie::insert(const std::string &word)
+    {
+        int node = 0;
+        for (char ch : word)
+            node = addChild(node, foldCase(ch));
+
+        std::vector<std::string> &words = _nodes[node].words;
+        if (std::find(words.begin(), words.end(), word) != words.end())
+            return;
+
+        words.push_back(word);
+        ++_size;
+    }
+
+    bool CompletionTrie::remove(const std::string &word)
+    {
+        int const node = find(word);
+        if (node < 0)
+            return false;
+
+        // Node stays, it is reused if word is added again
+        std::vector<std::string> &words = _nodes[node].words;
+        auto const it = std::find(words.begin(), words.end(), word);
+        if (it == words.end())
+            return false;
+
+        words.erase(it);
+        --_size;
+        return true;
+    }
+
+    void CompletionTrie::clear()
+    {
+        _nodes.assign(1, Node());
+        _size = 0;
+    }
+
+    bool CompletionTrie::contains(const std::string &word) const
+    {
+        int const node = find(word);
+        if (node < 0)
+            return false;
+
+        std::vector<std::string> const &words = _nodes[node].words;
+        return std::find(words.begin(), words.end(), word) != words.end();
+    }
+
+    void CompletionTrie::complete(const std::string &prefix, size_t max, std::vector<std::string> &words) const
+    {
+        int const node = find(prefix);
+        if (node >= 0)
+            collect(node, words.size() + max, words);
+    }
+
+    int CompletionTrie::find(const std::string &word) const
+    {
+        int node = 0;
+        for (char ch : word) {
+            node = child(node, foldCase(ch));
+            if (node < 0)
+                return -1;
+        }
+        return node;
+    }
+
+    int CompletionTrie::child(int node, char key) const
+    {
+        auto const &children = _nodes[node].children;
+        auto const it = std::lower_bound(children.begin(), children.end(), key, keyLess);
+        return it != children.end() && it->first == key ? it->second : -1;
+    }
+
+    int CompletionTrie::addChild(int node, char key)
+    {
+        int const existing = child(node, key);
+        if (existing >= 0)
+            return existing;
+
+        int const added = static_cast<int>(_nodes.size());
+        _nodes.emplace_back();    // Invalidates references to nodes
+
+        auto &children = _nodes[node].children;
+        children.insert(std::lower_bound(children.begin(), children.end(), key, keyLess),
+                        std::make_pair(key, added));
+        return added;
+    }
+
+    void CompletionTrie::collect(int node, size_t max, std::vector<std::string> &words) const
+    {
+        for (std::string const &word : _nodes[node].words) {
+            if (words.size() >= max)
+                return;
+            words.push_back(word);
+        }
+
+        for (auto const &child : _nodes[node].children) {
+            if (words.size() >= max)
+                return;
+            collect(child.second, max, words);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief Set of words, looked up by prefix, ignoring case of ASCII letters.
+     *        Nodes are kept in one vector, children of a node are sorted, so
+     *        words come out in alphabetical order and lookup stops right after
+     *        'max' words, no matter how many words have the prefix.
+     */
+    class CompletionTrie
+    {
+    public:
+        CompletionTrie();
+
+        // Duplicates are ignored
+        void insert(const std::string &word);
+        bool remove(const std::string &word);
+        void clear();
+
+        bool contains(const std::string &word) const;
+        size_t size() const { return _size; }
+
+        // Appends up to 'max' words starting with 'prefix' to 'words'
+        void complete(const std::string &prefix, size_t max, std::vector<std::string> &words) const;
+
+    private:
+        struct Node
+        {
+            std::vector<std::pair<char, int>> children;   // Sorted by key
+            std::vector<std::string> words;               // Words ending here, differing in case
+        };
+
+        // Node of 'word', -1 if there is none
+        int find(const std::string &word) const;
+        int child(int node, char key) const;
+        int addChild(int node, char key);
+        void collect(int node, size_t max, std::vector<std::string> &words) const;
+
+        std::vector<Node> _nodes;
+        size_t _size;
+    };
+}
@@ -0,0 +1,136 @@
+#include "robomongo/core/utils/LargeTextBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QMutexLocker>
+
+namespace Robomongo
+{
+    LargeTextBuffer::LargeTextBuffer() :
+        _chunks(1),
+        _checkpoints(1, Checkpoint{0, 0}),
+        _lineCount(1),
+        _size(0),
+        _lineLength(0),
+        _maxLineLength(0)
+    {
+        _chunks.back().reserve(ChunkSize);
+    }
+
+    void LargeTextBuffer::append(const QString &text)
+    {
+        QByteArray const utf8 = text.toUtf8();
+        append(utf8.constData(), utf8.size());
+    }
+
+    void LargeTextBuffer::append(const char *utf8, int size)
+    {
+        QMutexLocker lock(&_mutex);
+        appendToChunk(utf8, size);
+        _size += size;
+    }
+
+    void LargeTextBuffer::appendToChunk(const char *utf8, int size)
+    {
+        const char *pos = utf8;
+        const char *const end = utf8 + size;
+        while (pos < end) {
+            const char *const newLine = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+            const char *const next = newLine ? newLine + 1 : end;
+            _chunks.back().append(pos, static_cast<int>(next - pos));
+            _lineLength += static_cast<int>((newLine ? newLine : end) - pos);
+            pos = next;
+
+            if (!newLine)
+                break;
+
+            _maxLineLength = std::max(_maxLineLength, _lineLength);
+            _lineLength = 0;
+
+            // Chunks are switched only here, at line boundary
+            startChunkIfFull();
+            if (_lineCount % LineCheckpoint == 0)
+                _checkpoints.push_back(Checkpoint{static_cast<int>(_chunks.size()) - 1, _chunks.back().size()});
+
+            ++_lineCount;
+        }
+        _maxLineLength = std::max(_maxLineLength, _lineLength);
+    }
+
+    void LargeTextBuffer::startChunkIfFull()
+    {
+        if (_chunks.back().size() < ChunkSize)
+            return;
+
+        _chunks.push_back(QByteArray());
+        _chunks.back().reserve(ChunkSize);
+    }
+
+    qint64 LargeTextBuffer::lineCount() const
+    {
+        QMutexLocker lock(&_mutex);
+        return _lineCount;
+    }
+
+    qint64 LargeTextBuffer::size() const
+    {
+        QMutexLocker lock(&_mutex);
+        return _size;
+    }
+
+    int LargeTextBuffer::maxLineLength() const
+    {
+        QMutexLocker lock(&_mutex);
+        return _maxLineLength;
+    }
+
+    LargeTextBuffer::Checkpoint LargeTextBuffer::lineStart(qint64 index) const
+    {
+        Checkpoint pos = _checkpoints[index / LineCheckpoint];
+        for (int rest = index % LineCheckpoint; rest > 0; --rest) {
+            QByteArray const& chunk = _chunks[pos.chunk];
+            pos.offset = chunk.indexOf('\n', pos.offset) + 1;
+            // Closed chunks end with a new line, next line is in the next chunk
+            if (pos.offset == chunk.size() && pos.chunk + 1 < static_cast<int>(_chunks.size())) {
+                ++pos.chunk;
+                pos.offset = 0;
+            }
+        }
+        return pos;
+    }
+
+    QStringList LargeTextBuffer::lines(qint64 first, int count) const
+    {
+        QMutexLocker lock(&_mutex);
+        QStringList result;
+        if (first < 0 || first >= _lineCount)
+            return result;
+
+        count = static_cast<int>(std::min<qint64>(count, _lineCount - first));
+        result.reserve(count);
+
+        Checkpoint pos = lineStart(first);
+        for (int i = 0; i < count; ++i) {
+            QByteArray const& chunk = _chunks[pos.chunk];
+            int end = chunk.indexOf('\n', pos.offset);
+            if (end < 0)
+                end = chunk.size();
+
+            result.append(QString::fromUtf8(chunk.constData() + pos.offset, end - pos.offset));
+
+            pos.offset = end + 1;
+            if (pos.offset >= chunk.size() && pos.chunk + 1 < static_cast<int>(_chunks.size())) {
+                ++pos.chunk;
+                pos.offset = 0;
+            }
+        }
+        return result;
+    }
+
+    QString LargeTextBuffer::line(qint64 index) const
+    {
+        QStringList const result = lines(index, 1);
+        return result.isEmpty() ? QString() : result.front();
+    }
+}
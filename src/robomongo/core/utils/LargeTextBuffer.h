@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+namespace Robomongo
+{
+    /**
+     * @brief Append-only, read-only UTF-8 text of a large output (see LargeTextView).
+     *
+     *        Text is kept in chunks of about ChunkSize bytes, so that growing it
+     *        never reallocates (and copies) the whole text, and a line never
+     *        spans two chunks. Lines are indexed sparsely while appending: start
+     *        of every LineCheckpoint-th line is remembered, the rest is found by
+     *        scanning at most LineCheckpoint - 1 lines of one chunk.
+     *
+     *        Text is appended by one (background) thread and read by another.
+     */
+    class LargeTextBuffer
+    {
+    public:
+        static const int ChunkSize = 4 * 1024 * 1024;
+        static const int LineCheckpoint = 64;
+
+        LargeTextBuffer();
+
+        void append(const QString &text);
+        void append(const char *utf8, int size);
+
+        // At least one, empty text has one empty line
+        qint64 lineCount() const;
+
+        // Size of text in bytes
+        qint64 size() const;
+
+        // Length of the longest line in bytes
+        int maxLineLength() const;
+
+        // Lines [first, first + count), lines past the end are omitted
+        QStringList lines(qint64 first, int count) const;
+        QString line(qint64 index) const;
+
+    private:
+        struct Checkpoint
+        {
+            int chunk;
+            int offset;
+        };
+
+        void appendToChunk(const char *utf8, int size);
+        void startChunkIfFull();
+
+        // Chunk and offset of start of line 'index', lock must be held
+        Checkpoint lineStart(qint64 index) const;
+
+        mutable QMutex _mutex;
+        std::vector<QByteArray> _chunks;
+        std::vector<Checkpoint> _checkpoints;
+        qint64 _lineCount;
+        qint64 _size;
+        int _lineLength;    // Length of the last (incomplete) line
+        int _maxLineLength;
+    };
+}
@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include "LargeTextBuffer.h"
+
+using namespace Robomongo;
+
+TEST(large_text_buffer_tests, lines_of_parts)
+{
+    LargeTextBuffer buffer;
+    EXPECT_EQ(1, buffer.lineCount());
+    EXPECT_EQ(QString(), buffer.line(0));
+
+    buffer.append(QString("/* 1 */\n{\n    \"a\" : 1"));
+    buffer.append(QString("\n}"));
+    buffer.append(QString("\n\n/* 2 */\n{}"));
+
+    QStringList const expected = { "/* 1 */", "{", "    \"a\" : 1", "}", "", "/* 2 */", "{}" };
+    EXPECT_EQ(expected.size(), buffer.lineCount());
+    EXPECT_EQ(expected, buffer.lines(0, 100));
+    EXPECT_EQ(QStringList({ "}", "" }), buffer.lines(3, 2));
+    EXPECT_EQ(11, buffer.maxLineLength());
+    EXPECT_TRUE(buffer.lines(7, 1).isEmpty());
+}
+
+TEST(large_text_buffer_tests, lines_across_chunks)
+{
+    // Enough lines for several chunks and many checkpoints
+    int const lineCount = 3 * LargeTextBuffer::ChunkSize / 100;
+    QString const padding(90, QChar('x'));
+
+    LargeTextBuffer buffer;
+    for (int i = 0; i < lineCount; ++i)
+        buffer.append(QString("%1 %2\n").arg(i, 7, 10, QChar('0')).arg(padding));
+
+    EXPECT_EQ(lineCount + 1, buffer.lineCount());
+    QStringList const all = buffer.lines(0, lineCount);
+    ASSERT_EQ(lineCount, all.size());
+    for (int i = 0; i < lineCount; ++i)
+        ASSERT_EQ(QString("%1 %2").arg(i, 7, 10, QChar('0')).arg(padding), all[i]);
+
+    for (int i : { 63, 64, 65, lineCount / 3, lineCount / 2, lineCount - 1 })
+        EXPECT_EQ(all[i], buffer.line(i));
+
+    QStringList const tail = buffer.lines(lineCount - 2, 10);
+    ASSERT_EQ(3, tail.size());
+    EXPECT_EQ(QString(), tail.back());
+}
@@ -0,0 +1,43 @@
+#include "robomongo/core/utils/LogRing.h"
+
+#include <algorithm>
+
+namespace Robomongo
+{
+    LogRing::LogRing(int capacity) :
+        _records(std::max(capacity, 1)), _first(0), _end(0) {}
+
+    bool LogRing::append(const LogRecord &record)
+    {
+        if (_end > _first) {
+            LogRecord &last = slot(_end - 1);
+            if (last.severity == record.severity && last.source == record.source &&
+                last.message == record.message) {
+                last.repeats += record.repeats;
+                last.time = record.time;
+                return true;
+            }
+        }
+
+        if (size() == capacity())
+            ++_first;
+
+        slot(_end) = record;
+        ++_end;
+        return false;
+    }
+
+    void LogRing::clear()
+    {
+        // Sequence numbers are not reused
+        for (quint64 seq = _first; seq < _end; ++seq)
+            slot(seq) = LogRecord();
+
+        _first = _end;
+    }
+
+    const LogRecord &LogRing::at(quint64 sequence) const
+    {
+        return _records[sequence % _records.size()];
+    }
+}
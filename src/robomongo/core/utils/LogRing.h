@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <QString>
+#include <QDateTime>
+#include <mongo/logger/log_severity.h>
+
+namespace Robomongo
+{
+    struct LogRecord
+    {
+        LogRecord() : severity(mongo::logger::LogSeverity::Info()), repeats(1) {}
+
+        QDateTime time;                         // Time of the last repeat
+        mongo::logger::LogSeverity severity;
+        QString source;                         // i.e. "MongoWorker", empty for application
+        QString message;
+        int repeats;                            // Number of identical messages in a row
+    };
+
+    /**
+     * @brief Fixed capacity FIFO of log records. When full, new record replaces
+     *        the oldest one, so memory used by log does not grow with uptime.
+     *
+     *        Records are addressed by sequence numbers that never repeat:
+     *        [firstSequence(), endSequence()) are currently stored. Views keep
+     *        sequence numbers instead of positions, so eviction does not
+     *        invalidate them silently.
+     *
+     *        Lock-free by design: all messages are funneled into the GUI thread
+     *        (Logger::print queues messages of other threads, sendLog posts
+     *        LogEvent), which is the only writer and reader.
+     */
+    class LogRing
+    {
+    public:
+        explicit LogRing(int capacity);
+
+        /**
+         * @brief Adds record, or merges it into the last one when severity,
+         *        source and message are the same.
+         * @return true if record was merged (no new sequence number)
+         */
+        bool append(const LogRecord &record);
+
+        void clear();
+
+        const LogRecord &at(quint64 sequence) const;
+        bool contains(quint64 sequence) const { return sequence >= _first && sequence < _end; }
+
+        quint64 firstSequence() const { return _first; }
+        quint64 endSequence() const { return _end; }
+        int size() const { return static_cast<int>(_end - _first); }
+        int capacity() const { return static_cast<int>(_records.size()); }
+
+    private:
+        LogRecord &slot(quint64 sequence) { return _records[sequence % _records.size()]; }
+
+        std::vector<LogRecord> _records;
+        quint64 _first;
+        quint64 _end;
+    };
+}
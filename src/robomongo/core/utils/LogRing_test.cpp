@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include "LogRing.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    LogRecord record(const QString &message,
+                     mongo::logger::LogSeverity severity = mongo::logger::LogSeverity::Info())
+    {
+        LogRecord rec;
+        rec.severity = severity;
+        rec.message = message;
+        return rec;
+    }
+}
+
+TEST(log_ring_tests, evicts_oldest_when_full)
+{
+    LogRing ring(3);
+    for (int i = 0; i < 5; ++i)
+        ring.append(record(QString::number(i)));
+
+    EXPECT_EQ(3, ring.size());
+    EXPECT_EQ(2u, ring.firstSequence());
+    EXPECT_EQ(5u, ring.endSequence());
+    EXPECT_FALSE(ring.contains(1));
+    EXPECT_EQ(QString("2"), ring.at(2).message);
+    EXPECT_EQ(QString("4"), ring.at(4).message);
+}
+
+TEST(log_ring_tests, coalesces_repeated_messages)
+{
+    LogRing ring(10);
+    EXPECT_FALSE(ring.append(record("refresh")));
+    EXPECT_TRUE(ring.append(record("refresh")));
+    EXPECT_TRUE(ring.append(record("refresh")));
+    EXPECT_FALSE(ring.append(record("refresh", mongo::logger::LogSeverity::Error())));
+
+    EXPECT_EQ(2, ring.size());
+    EXPECT_EQ(3, ring.at(0).repeats);
+    EXPECT_EQ(1, ring.at(1).repeats);
+}
+
+TEST(log_ring_tests, clear_keeps_sequence_numbers)
+{
+    LogRing ring(4);
+    ring.append(record("a"));
+    ring.append(record("b"));
+    ring.clear();
+
+    EXPECT_EQ(0, ring.size());
+    EXPECT_EQ(2u, ring.firstSequence());
+
+    // Identical message after clear is a new record
+    EXPECT_FALSE(ring.append(record("b")));
+    EXPECT_EQ(2u, ring.firstSequence());
+    EXPECT_EQ(3u, ring.endSequence());
+}
@@ -2,6 +2,7 @@
 
 #include <QDir>
 #include <QMetaType>
+#include <QThread>
 
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/domain/App.h"
@@ -9,45 +10,127 @@
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 
+namespace
+{
+    // Records kept in memory for the log panel
+    const int LogCapacity = 5000;
+
+    // Longer messages are truncated in the log panel, but written to file in full
+    const int MaxMessageLength = 500;
+
+    const qint64 MaxLogFileSize = 5 * 1024 * 1024;
+    const int LogFileBackups = 3;
+}
+
 namespace Robomongo
 {
-    Logger::Logger()
+    Logger::Logger() :
+        _records(LogCapacity)
     {
-        QFile file {
-            QString("%1/" PROJECT_NAME_LOWERCASE ".log").arg(QDir::tempPath()) 
-        }; 
-        //delete file if it size more than 5mb
-        if (file.exists() && file.size() > 5 * 1024 * 1024)
-            file.remove();      
     }
 
     Logger::~Logger()
     {   
     }
 
-    void Logger::print(const char *mess, mongo::logger::LogSeverity level, bool notify)
+    void Logger::print(const char *mess, mongo::logger::LogSeverity level, bool notify,
+                       const QString &source /* = QString() */)
     {
-        print(std::string(mess), level, notify);
+        print(std::string(mess), level, notify, source);
     }
 
-    void Logger::print(const std::string &mess, mongo::logger::LogSeverity level, bool notify)
+    void Logger::print(const std::string &mess, mongo::logger::LogSeverity level, bool notify,
+                       const QString &source /* = QString() */)
     {       
-        print(QtUtils::toQString(mess), level, notify);
+        print(QtUtils::toQString(mess), level, notify, source);
     }
 
-    void Logger::print(const QString &msg, mongo::logger::LogSeverity level, bool notify)
+    void Logger::print(const QString &msg, mongo::logger::LogSeverity level, bool notify,
+                       const QString &source /* = QString() */)
     {
         if (!notify)
             return;
 
-        // Make uniform log level strings e.g "Error: ", "Info: " etc...
-        auto logLevelStr = QString::fromStdString(level.toStringData().toString());
-        if (!logLevelStr.isEmpty()) {
-            logLevelStr = logLevelStr.toLower();
-            logLevelStr[0] = logLevelStr[0].toUpper();
-            logLevelStr += ": ";
+        // Records and file are used only on the thread of Logger (GUI thread),
+        // messages of other threads (i.e. JsonPrepareThread) are queued to it
+        if (QThread::currentThread() != thread()) {
+            QMetaObject::invokeMethod(this, [this, msg, level, source]() {
+                print(msg, level, true, source);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        LogRecord record;
+        record.time = QDateTime::currentDateTime();
+        record.severity = level;
+        record.source = source;
+        record.message = msg.simplified();
+
+        if (_file.isOpen())
+            writeToFile(record);
+
+        if (record.message.length() > MaxMessageLength)
+            record.message = QString("(truncated) ") + record.message.left(MaxMessageLength) + "...";
+
+        if (_records.append(record))
+            emit updated(_records.endSequence() - 1);
+        else
+            emit appended();
+    }
+
+    void Logger::clear()
+    {
+        _records.clear();
+        emit cleared();
+    }
+
+    QString Logger::filePath() const
+    {
+        return QString("%1/" PROJECT_NAME_LOWERCASE ".log").arg(QDir::tempPath());
+    }
+
+    void Logger::setFileEnabled(bool enabled)
+    {
+        if (enabled == _file.isOpen())
+            return;
+
+        if (!enabled) {
+            _file.close();
+            return;
         }
-        emit printed(logLevelStr + msg.simplified(), level);
+
+        _file.setFileName(filePath());
+        if (!_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            print("Failed to open log file " + filePath(), mongo::logger::LogSeverity::Warning(), true);
+    }
+
+    void Logger::writeToFile(const LogRecord &record)
+    {
+        if (_file.size() > MaxLogFileSize)
+            rotateFile();
+
+        auto severity = QString::fromStdString(record.severity.toStringData().toString());
+        QString line = record.time.toString("yyyy-MM-ddTHH:mm:ss.zzz") + ' ' + severity.toUpper();
+        if (!record.source.isEmpty())
+            line += " [" + record.source + ']';
+        line += ' ' + record.message + '\n';
+
+        _file.write(line.toUtf8());
+        _file.flush();
+    }
+
+    // robo3t.log -> robo3t.log.1 -> ... -> robo3t.log.<LogFileBackups> (removed)
+    void Logger::rotateFile()
+    {
+        QString const path = filePath();
+        _file.close();
+
+        QFile::remove(QString("%1.%2").arg(path).arg(LogFileBackups));
+        for (int i = LogFileBackups - 1; i >= 1; --i)
+            QFile::rename(QString("%1.%2").arg(path).arg(i), QString("%1.%2").arg(path).arg(i + 1));
+        QFile::rename(path, path + ".1");
+
+        _file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
     }
 
     void sendLog(
@@ -2,34 +2,66 @@
 
 #include <QObject>
 #include <QString>
+#include <QFile>
 #include <string>
 
 #include <mongo/logger/log_severity.h>
 
 #include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/utils/LogRing.h"
 #include "robomongo/core/utils/SingletonPattern.hpp"
 
 namespace Robomongo
 {  
+    /**
+     * @brief Application log. Keeps the last records in a bounded ring
+     *        (see LogRing), which is rendered by LogWidget, and optionally
+     *        writes every record to a rotating file in temp directory.
+     */
     class Logger : public QObject, public Patterns::LazySingleton<Logger>
     {
         Q_OBJECT
         friend class Patterns::LazySingleton<Logger>;
 
     public:
-        void print(const char *msg, mongo::logger::LogSeverity level, bool notify);
-        void print(const std::string &msg, mongo::logger::LogSeverity level, bool notify);
-        void print(const QString &msg, mongo::logger::LogSeverity level, bool notify);
+        // Thread-safe: called on other threads, record is added on the thread of Logger
+        void print(const char *msg, mongo::logger::LogSeverity level, bool notify,
+                   const QString &source = QString());
+        void print(const std::string &msg, mongo::logger::LogSeverity level, bool notify,
+                   const QString &source = QString());
+        void print(const QString &msg, mongo::logger::LogSeverity level, bool notify,
+                   const QString &source = QString());
+
+        const LogRing &records() const { return _records; }
+        void clear();
+
+        /**
+         * @brief Write records also to PROJECT_NAME_LOWERCASE.log in temp
+         *        directory. File is rotated when it grows over 5 MB.
+         */
+        void setFileEnabled(bool enabled);
+        bool fileEnabled() const { return _file.isOpen(); }
+        QString filePath() const;
 
     Q_SIGNALS:
-        void printed(const QString &msg, mongo::logger::LogSeverity level);
+        // New record was added to the end of records() (the oldest one may be evicted)
+        void appended();
+        // Repeat counter of record 'sequence' was incremented
+        void updated(quint64 sequence);
+        void cleared();
 
     private:
         Logger();
         ~Logger();
+
+        void writeToFile(const LogRecord &record);
+        void rotateFile();
+
+        LogRing _records;
+        QFile _file;
     };
 
-    // Use in main thread
+    // Use in main thread, messages of other threads are added to the log asynchronously
     template<typename T>
     inline void LOG_MSG(const T &msg, mongo::logger::LogSeverity level, bool notify = true)
     {
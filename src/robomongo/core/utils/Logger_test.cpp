@@ -0,0 +1,33 @@
+#include "gtest/gtest.h"
+#include "Logger.h"
+
+#include <thread>
+
+#include <QCoreApplication>
+
+using namespace Robomongo;
+
+TEST(logger_tests, print_from_other_thread_is_queued)
+{
+    int argc = 1;
+    char name[] = "robo_unit_tests";
+    char *argv[] = { name, nullptr };
+    QCoreApplication app(argc, argv);
+
+    Logger &logger = Logger::instance();
+    quint64 const end = logger.records().endSequence();
+
+    std::thread worker([]() {
+        for (int i = 0; i < 100; ++i)
+            Logger::instance().print(QString("worker %1").arg(i), mongo::logger::LogSeverity::Info(), true);
+    });
+    worker.join();
+
+    // Ring is changed only on the thread of Logger
+    EXPECT_EQ(end, logger.records().endSequence());
+
+    QCoreApplication::sendPostedEvents(&logger);
+    ASSERT_EQ(end + 100, logger.records().endSequence());
+    EXPECT_EQ(QString("worker 0"), logger.records().at(end).message);
+    EXPECT_EQ(QString("worker 99"), logger.records().at(end + 99).message);
+}
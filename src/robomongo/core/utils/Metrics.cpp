@@ -0,0 +1,243 @@
+#include "robomongo/core/utils/Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace
+{
+    // Index of the highest set bit, 'value' is positive
+    int highestBit(long long value)
+    {
+        int bit = 0;
+        while (value >>= 1)
+            ++bit;
+        return bit;
+    }
+
+    const char *kindName(Robomongo::MetricKind kind)
+    {
+        switch (kind) {
+        case Robomongo::MetricKind::Counter: return "counter";
+        case Robomongo::MetricKind::Gauge: return "gauge";
+        case Robomongo::MetricKind::Histogram: return "histogram";
+        }
+        return "";
+    }
+
+    const char *unitName(Robomongo::MetricUnit unit)
+    {
+        switch (unit) {
+        case Robomongo::MetricUnit::Count: return "count";
+        case Robomongo::MetricUnit::Bytes: return "bytes";
+        case Robomongo::MetricUnit::Micros: return "us";
+        }
+        return "";
+    }
+}
+
+namespace Robomongo
+{
+    Histogram::Histogram() :
+        _buckets(BucketCount),
+        _count(0),
+        _sum(0),
+        _max(0)
+    {
+        clear();
+    }
+
+    void Histogram::record(long long value)
+    {
+        value = std::min(std::max(value, 0LL), MaxValue);
+        _buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+
+        long long max = _max.load(std::memory_order_relaxed);
+        while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    void Histogram::clear()
+    {
+        for (auto &bucket : _buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        _count.store(0);
+        _sum.store(0);
+        _max.store(0);
+    }
+
+    double Histogram::mean() const
+    {
+        long long const count = _count.load(std::memory_order_relaxed);
+        return count > 0 ? double(_sum.load(std::memory_order_relaxed)) / count : 0;
+    }
+
+    long long Histogram::percentile(double percentile) const
+    {
+        // Counts may move on while walking, buckets are the source of truth
+        long long total = 0;
+        for (auto const &bucket : _buckets)
+            total += bucket.load(std::memory_order_relaxed);
+        if (total == 0)
+            return 0;
+
+        long long const target = std::max(1LL, static_cast<long long>(
+            std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100 * total)));
+        long long seen = 0;
+        for (int index = 0; index < BucketCount; ++index) {
+            seen += _buckets[index].load(std::memory_order_relaxed);
+            if (seen >= total)  // The last bucket holds maximum, that is exact
+                return max();
+            if (seen >= target)
+                return std::min(bucketValue(index), max());
+        }
+        return max();
+    }
+
+    int Histogram::bucketIndex(long long value)
+    {
+        if (value < 2 * SubBuckets)
+            return static_cast<int>(value);
+
+        // Shift, that brings 'value' into [SubBuckets, 2 * SubBuckets)
+        int const shift = highestBit(value) - highestBit(SubBuckets);
+        return 2 * SubBuckets + (shift - 1) * SubBuckets + static_cast<int>((value >> shift) - SubBuckets);
+    }
+
+    long long Histogram::bucketValue(int index)
+    {
+        if (index < 2 * SubBuckets)
+            return index;
+
+        int const shift = (index - 2 * SubBuckets) / SubBuckets + 1;
+        long long const subBucket = (index - 2 * SubBuckets) % SubBuckets + SubBuckets;
+        long long const low = subBucket << shift;
+        long long const high = ((subBucket + 1) << shift) - 1;
+        return low + (high - low) / 2;
+    }
+
+    const char *const MetricsRegistry::ApplicationScope = "Application";
+
+    std::shared_ptr<Counter> MetricsRegistry::counter(const std::string &scope, const std::string &name,
+                                                      MetricUnit unit)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Entry &e = entry(Key(scope, name), MetricKind::Counter, unit);
+        if (!e.counter)
+            e.counter = std::make_shared<Counter>();
+        return e.counter;
+    }
+
+    std::shared_ptr<Gauge> MetricsRegistry::gauge(const std::string &scope, const std::string &name,
+                                                  MetricUnit unit)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Entry &e = entry(Key(scope, name), MetricKind::Gauge, unit);
+        if (!e.gauge)
+            e.gauge = std::make_shared<Gauge>();
+        return e.gauge;
+    }
+
+    std::shared_ptr<Histogram> MetricsRegistry::histogram(const std::string &scope, const std::string &name,
+                                                          MetricUnit unit)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Entry &e = entry(Key(scope, name), MetricKind::Histogram, unit);
+        if (!e.histogram)
+            e.histogram = std::make_shared<Histogram>();
+        return e.histogram;
+    }
+
+    void MetricsRegistry::addProbe(const void *owner, const std::string &scope, const std::string &name,
+                                   MetricUnit unit, std::function<long long()> probe)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _probes.push_back({ owner, scope, name, unit, probe });
+    }
+
+    void MetricsRegistry::removeProbes(const void *owner)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _probes.erase(std::remove_if(_probes.begin(), _probes.end(),
+                                     [owner](const Probe &probe) { return probe.owner == owner; }),
+                      _probes.end());
+    }
+
+    std::vector<MetricSnapshot> MetricsRegistry::snapshot() const
+    {
+        std::map<Key, MetricSnapshot> metrics;
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto const &item : _entries) {
+            Entry const &e = item.second;
+            MetricSnapshot s { item.first.first, item.first.second, e.kind, e.unit, 0, 0, 0, 0, 0, 0 };
+            if (e.kind == MetricKind::Counter && e.counter)
+                s.value = e.counter->value();
+            else if (e.kind == MetricKind::Gauge && e.gauge)
+                s.value = e.gauge->value();
+            else if (e.kind == MetricKind::Histogram && e.histogram) {
+                s.value = e.histogram->count();
+                s.mean = e.histogram->mean();
+                s.p50 = e.histogram->percentile(50);
+                s.p95 = e.histogram->percentile(95);
+                s.p99 = e.histogram->percentile(99);
+                s.max = e.histogram->max();
+            }
+            metrics[item.first] = s;
+        }
+
+        for (auto const &probe : _probes) {
+            Key const key(probe.scope, probe.name);
+            auto it = metrics.find(key);
+            if (it == metrics.end()) {
+                MetricSnapshot const s { probe.scope, probe.name, MetricKind::Gauge, probe.unit, 0, 0, 0, 0, 0, 0 };
+                it = metrics.insert(std::make_pair(key, s)).first;
+            }
+            it->second.value += probe.probe();
+        }
+
+        std::vector<MetricSnapshot> result;
+        result.reserve(metrics.size());
+        for (auto const &item : metrics)
+            result.push_back(item.second);
+        return result;
+    }
+
+    QByteArray MetricsRegistry::toJson(const std::vector<MetricSnapshot> &snapshot)
+    {
+        QJsonArray metrics;
+        for (auto const &s : snapshot) {
+            QJsonObject item;
+            item["scope"] = QString::fromStdString(s.scope);
+            item["name"] = QString::fromStdString(s.name);
+            item["kind"] = kindName(s.kind);
+            item["unit"] = unitName(s.unit);
+            item["value"] = static_cast<double>(s.value);
+            if (s.kind == MetricKind::Histogram) {
+                item["mean"] = s.mean;
+                item["p50"] = static_cast<double>(s.p50);
+                item["p95"] = static_cast<double>(s.p95);
+                item["p99"] = static_cast<double>(s.p99);
+                item["max"] = static_cast<double>(s.max);
+            }
+            metrics.append(item);
+        }
+
+        QJsonObject root;
+        root["time"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        root["metrics"] = metrics;
+        return QJsonDocument(root).toJson();
+    }
+
+    MetricsRegistry::Entry &MetricsRegistry::entry(const Key &key, MetricKind kind, MetricUnit unit)
+    {
+        auto it = _entries.find(key);
+        if (it == _entries.end())
+            it = _entries.insert(std::make_pair(key, Entry { kind, unit, nullptr, nullptr, nullptr })).first;
+        return it->second;
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+
+#include "robomongo/core/utils/SingletonPattern.hpp"
+
+namespace Robomongo
+{
+    enum class MetricKind { Counter, Gauge, Histogram };
+    enum class MetricUnit { Count, Bytes, Micros };
+
+    // Monotonic total, i.e. bytes received. Rates are derived from snapshots.
+    class Counter
+    {
+    public:
+        Counter() : _value(0) {}
+        void add(long long delta = 1) { _value.fetch_add(delta, std::memory_order_relaxed); }
+        long long value() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<long long> _value;
+    };
+
+    // Current level, i.e. events waiting in a queue
+    class Gauge
+    {
+    public:
+        Gauge() : _value(0) {}
+        void set(long long value) { _value.store(value, std::memory_order_relaxed); }
+        void add(long long delta) { _value.fetch_add(delta, std::memory_order_relaxed); }
+        long long value() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<long long> _value;
+    };
+
+    /**
+     * @brief Distribution of non-negative values with bounded relative error,
+     *        in the manner of HdrHistogram: values below 2 * SubBuckets are exact,
+     *        larger ones fall into log-linear buckets of about 1.5% width.
+     *        Recording is lock-free, values above MaxValue are clamped.
+     */
+    class Histogram
+    {
+    public:
+        static constexpr int SubBuckets = 64;
+        static constexpr int MaxExponent = 40;
+        static constexpr long long MaxValue = (1LL << MaxExponent) - 1;
+        static constexpr int BucketCount = 2 * SubBuckets + (MaxExponent - 7) * SubBuckets;
+
+        Histogram();
+
+        void record(long long value);
+        void clear();
+
+        long long count() const { return _count.load(std::memory_order_relaxed); }
+        long long max() const { return _max.load(std::memory_order_relaxed); }
+        double mean() const;
+
+        // Value at 'percentile' (0..100), 0 if empty
+        long long percentile(double percentile) const;
+
+        static int bucketIndex(long long value);
+
+        // Middle of the range of values, falling into bucket 'index'
+        static long long bucketValue(int index);
+
+    private:
+        std::vector<std::atomic<long long>> _buckets;
+        std::atomic<long long> _count;
+        std::atomic<long long> _sum;
+        std::atomic<long long> _max;
+    };
+
+    struct MetricSnapshot
+    {
+        std::string scope;
+        std::string name;
+        MetricKind kind;
+        MetricUnit unit;
+        long long value;            // Counter and gauge value, count of histogram
+        double mean;                // Histogram only, from here on
+        long long p50;
+        long long p95;
+        long long p99;
+        long long max;
+    };
+
+    /**
+     * @brief Named metrics, grouped by scope: readable name of connection (as in
+     *        Explorer) or ApplicationScope for GUI-wide ones.
+     *
+     *        Lookups take a lock, so hot paths keep the returned pointer. Updates
+     *        of metrics are atomic and may happen on any thread.
+     *
+     *        Probes are gauges, computed by callback at snapshot (i.e. sizes of
+     *        pools), so owners do not have to push values. Probes of the same
+     *        scope and name (i.e. of several workers of one connection) add up.
+     */
+    class MetricsRegistry : public Patterns::LazySingleton<MetricsRegistry>
+    {
+        friend class Patterns::LazySingleton<MetricsRegistry>;
+
+    public:
+        static const char *const ApplicationScope;
+
+        std::shared_ptr<Counter> counter(const std::string &scope, const std::string &name,
+                                         MetricUnit unit = MetricUnit::Count);
+        std::shared_ptr<Gauge> gauge(const std::string &scope, const std::string &name,
+                                     MetricUnit unit = MetricUnit::Count);
+        std::shared_ptr<Histogram> histogram(const std::string &scope, const std::string &name,
+                                             MetricUnit unit = MetricUnit::Micros);
+
+        /**
+         * @brief 'probe' is called under the lock of registry, from the thread that
+         *        takes snapshot, until removeProbes('owner') returns.
+         */
+        void addProbe(const void *owner, const std::string &scope, const std::string &name,
+                      MetricUnit unit, std::function<long long()> probe);
+        void removeProbes(const void *owner);
+
+        // All metrics, ordered by scope and name
+        std::vector<MetricSnapshot> snapshot() const;
+
+        // { "time": ..., "metrics": [ { "scope": ..., "name": ..., ... } ] }
+        static QByteArray toJson(const std::vector<MetricSnapshot> &snapshot);
+
+    private:
+        MetricsRegistry() {}
+
+        struct Entry
+        {
+            MetricKind kind;
+            MetricUnit unit;
+            std::shared_ptr<Counter> counter;
+            std::shared_ptr<Gauge> gauge;
+            std::shared_ptr<Histogram> histogram;
+        };
+
+        struct Probe
+        {
+            const void *owner;
+            std::string scope;
+            std::string name;
+            MetricUnit unit;
+            std::function<long long()> probe;
+        };
+
+        typedef std::pair<std::string, std::string> Key;    // Scope and name
+        Entry &entry(const Key &key, MetricKind kind, MetricUnit unit);
+
+        mutable std::mutex _mutex;
+        std::map<Key, Entry> _entries;
+        std::vector<Probe> _probes;
+    };
+}
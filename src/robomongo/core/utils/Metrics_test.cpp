@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "Metrics.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace Robomongo;
+
+namespace
+{
+    const MetricSnapshot *find(const std::vector<MetricSnapshot> &snapshot, const std::string &scope,
+                               const std::string &name)
+    {
+        for (auto const &metric : snapshot) {
+            if (metric.scope == scope && metric.name == name)
+                return &metric;
+        }
+        return nullptr;
+    }
+}
+
+TEST(metrics_tests, histogram_keeps_small_values_exact)
+{
+    for (long long value = 0; value < 2 * Histogram::SubBuckets; ++value)
+        EXPECT_EQ(value, Histogram::bucketValue(Histogram::bucketIndex(value)));
+
+    EXPECT_EQ(Histogram::BucketCount - 1, Histogram::bucketIndex(Histogram::MaxValue));
+    EXPECT_EQ(Histogram::BucketCount - 1, Histogram::bucketIndex(Histogram::MaxValue + 1));
+}
+
+TEST(metrics_tests, histogram_percentiles_within_bucket_precision)
+{
+    Histogram histogram;
+    EXPECT_EQ(0, histogram.percentile(50));
+
+    for (long long value = 1; value <= 100000; ++value)
+        histogram.record(value);
+
+    EXPECT_EQ(100000, histogram.count());
+    EXPECT_EQ(100000, histogram.max());
+    EXPECT_DOUBLE_EQ(50000.5, histogram.mean());
+    EXPECT_NEAR(50000, histogram.percentile(50), 50000 / 64);
+    EXPECT_NEAR(99000, histogram.percentile(99), 99000 / 64);
+    EXPECT_EQ(100000, histogram.percentile(100));
+
+    histogram.clear();
+    EXPECT_EQ(0, histogram.count());
+    EXPECT_EQ(0, histogram.percentile(99));
+}
+
+TEST(metrics_tests, registry_shares_metrics_and_sums_probes)
+{
+    MetricsRegistry &registry = MetricsRegistry::instance();
+    registry.counter("metrics_tests", "counter")->add(3);
+    registry.counter("metrics_tests", "counter")->add(4);
+    registry.histogram("metrics_tests", "histogram")->record(42);
+
+    int first = 1, second = 2;
+    registry.addProbe(&first, "metrics_tests", "probe", MetricUnit::Bytes, [&first]() { return first; });
+    registry.addProbe(&second, "metrics_tests", "probe", MetricUnit::Bytes, [&second]() { return second; });
+
+    auto snapshot = registry.snapshot();
+    ASSERT_TRUE(find(snapshot, "metrics_tests", "counter"));
+    EXPECT_EQ(7, find(snapshot, "metrics_tests", "counter")->value);
+    ASSERT_TRUE(find(snapshot, "metrics_tests", "histogram"));
+    EXPECT_EQ(42, find(snapshot, "metrics_tests", "histogram")->p99);
+    ASSERT_TRUE(find(snapshot, "metrics_tests", "probe"));
+    EXPECT_EQ(3, find(snapshot, "metrics_tests", "probe")->value);
+    EXPECT_EQ(MetricUnit::Bytes, find(snapshot, "metrics_tests", "probe")->unit);
+
+    registry.removeProbes(&first);
+    registry.removeProbes(&second);
+    snapshot = registry.snapshot();
+    EXPECT_FALSE(find(snapshot, "metrics_tests", "probe"));
+
+    auto const root = QJsonDocument::fromJson(MetricsRegistry::toJson(snapshot)).object();
+    EXPECT_FALSE(root["metrics"].toArray().isEmpty());
+}
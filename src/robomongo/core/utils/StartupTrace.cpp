@@ -0,0 +1,44 @@
+#include "robomongo/core/utils/StartupTrace.h"
+
+#include <cstdio>
+
+#include "robomongo/core/utils/Logger.h"
+
+namespace Robomongo
+{
+    StartupTrace::StartupTrace() :
+        _lastMarkMs(0),
+        _enabled(false),
+        _finished(false)
+    {
+        _timer.start();
+    }
+
+    void StartupTrace::mark(const QString &phase)
+    {
+        if (_finished)
+            return;
+
+        qint64 const now = _timer.elapsed();
+        _phases.push_back({ phase, now - _lastMarkMs });
+        _lastMarkMs = now;
+    }
+
+    void StartupTrace::finish()
+    {
+        if (_finished)
+            return;
+
+        _finished = true;
+        if (!_enabled)
+            return;
+
+        QString report = "Startup trace:\n";
+        for (auto const& phase : _phases)
+            report += QString("%1 ms  %2\n").arg(phase.elapsedMs, 7).arg(phase.name);
+        report += QString("%1 ms  Total").arg(_lastMarkMs, 7);
+
+        fprintf(stderr, "%s\n", qPrintable(report));
+        LOG_MSG(report, mongo::logger::LogSeverity::Info(), false);
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+
+#include "robomongo/core/utils/SingletonPattern.hpp"
+
+namespace Robomongo
+{
+    /**
+     * @brief Wall clock time of startup phases. Phases are always recorded
+     *        (it is cheap), the breakdown is written to stderr and to the log
+     *        only when started with --trace-startup.
+     *
+     *        Clock starts at the first call of instance(), at the top of main().
+     */
+    class StartupTrace : public Patterns::LazySingleton<StartupTrace>
+    {
+        friend class Patterns::LazySingleton<StartupTrace>;
+
+    public:
+        // Ends the current phase, named 'phase', and starts the next one
+        void mark(const QString &phase);
+
+        void setEnabled(bool enabled) { _enabled = enabled; }
+
+        // Writes the breakdown (if enabled). Later marks are ignored.
+        void finish();
+
+    private:
+        StartupTrace();
+
+        struct Phase
+        {
+            QString name;
+            qint64 elapsedMs;
+        };
+
+        QElapsedTimer _timer;
+        qint64 _lastMarkMs;
+        QVector<Phase> _phases;
+        bool _enabled;
+        bool _finished;
+    };
+}
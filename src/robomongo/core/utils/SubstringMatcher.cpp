@@ -0,0 +1,102 @@
+#include "robomongo/core/utils/SubstringMatcher.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROBO_SUBSTRING_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    char toLowerAscii(char ch)
+    {
+        return ch >= 'A' && ch <= 'Z' ? ch + ('a' - 'A') : ch;
+    }
+
+    bool isAsciiLetter(char ch)
+    {
+        ch = toLowerAscii(ch);
+        return ch >= 'a' && ch <= 'z';
+    }
+
+#ifdef ROBO_SUBSTRING_SSE2
+    // Bytes of 'block' equal to 'ch'; letters of any case, if 'fold' is set
+    __m128i equalBytes(__m128i block, char ch, bool fold)
+    {
+        if (fold && isAsciiLetter(ch)) {
+            // Setting 0x20 turns upper case letters to lower case, candidates, which are
+            // not letters, are sorted out by full comparison
+            block = _mm_or_si128(block, _mm_set1_epi8(0x20));
+        }
+        return _mm_cmpeq_epi8(block, _mm_set1_epi8(ch));
+    }
+#endif
+}
+
+namespace Robomongo
+{
+    SubstringMatcher::SubstringMatcher(const std::string &needle, bool caseSensitive) :
+        _needle(needle),
+        _caseSensitive(caseSensitive)
+    {
+        if (!_caseSensitive) {
+            for (char &ch : _needle)
+                ch = toLowerAscii(ch);
+        }
+    }
+
+    bool SubstringMatcher::equalsAt(const char *text) const
+    {
+        if (_caseSensitive)
+            return std::memcmp(text, _needle.data(), _needle.size()) == 0;
+
+        for (size_t i = 0; i < _needle.size(); ++i) {
+            if (toLowerAscii(text[i]) != _needle[i])
+                return false;
+        }
+        return true;
+    }
+
+    bool SubstringMatcher::matchesScalar(const char *text, size_t length, size_t from) const
+    {
+        for (size_t pos = from; pos + _needle.size() <= length; ++pos) {
+            if (equalsAt(text + pos))
+                return true;
+        }
+        return false;
+    }
+
+    bool SubstringMatcher::matches(const char *text, size_t length) const
+    {
+        size_t const size = _needle.size();
+        if (size == 0)
+            return true;
+        if (length < size)
+            return false;
+
+        size_t pos = 0;
+#ifdef ROBO_SUBSTRING_SSE2
+        bool const fold = !_caseSensitive;
+        char const first = _needle.front();
+        char const last = _needle.back();
+        for (; pos + size - 1 + 16 <= length; pos += 16) {
+            __m128i const firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos));
+            __m128i const lastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos + size - 1));
+            unsigned mask = _mm_movemask_epi8(_mm_and_si128(equalBytes(firstBlock, first, fold),
+                                                            equalBytes(lastBlock, last, fold)));
+            while (mask) {
+                unsigned bit = 0;
+                while (!(mask & (1u << bit)))
+                    ++bit;
+
+                if (equalsAt(text + pos + bit))
+                    return true;
+
+                mask &= mask - 1;
+            }
+        }
+#endif
+        return matchesScalar(text, length, pos);
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+namespace Robomongo
+{
+    /**
+     * @brief Finds a fixed substring in UTF-8 text, 16 bytes at a time with SSE2
+     *        (scalar elsewhere): candidates are positions where both the first
+     *        and the last byte of needle match, only they are compared fully.
+     *
+     *        Case-insensitive matching folds ASCII letters only.
+     */
+    class SubstringMatcher
+    {
+    public:
+        SubstringMatcher(const std::string &needle, bool caseSensitive);
+
+        bool matches(const char *text, size_t length) const;
+        bool matches(const std::string &text) const { return matches(text.data(), text.size()); }
+
+    private:
+        bool equalsAt(const char *text) const;
+        bool matchesScalar(const char *text, size_t length, size_t from) const;
+
+        std::string _needle;    // Lower case, if not case sensitive
+        const bool _caseSensitive;
+    };
+}
@@ -0,0 +1,218 @@
+#include "robomongo/core/utils/Tracer.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+namespace Robomongo
+{
+    struct TraceEvent
+    {
+        char phase;                 // 'X' complete span, 's'/'f' start/end of flow
+        const char *category;
+        const char *name;
+        const char *detail;
+        long long startUs;
+        long long durationUs;
+        unsigned long long flowId;
+    };
+
+    /**
+     * @brief Ring of events of one thread. The owning thread is the only writer,
+     *        snapshot() may be called from any thread.
+     */
+    class TraceBuffer
+    {
+    public:
+        TraceBuffer(int id, const QString &name) :
+            id(id), name(name), finished(false), _events(Tracer::EventsPerThread), _end(0), _cleared(0) {}
+
+        void append(const TraceEvent &event)
+        {
+            unsigned long long const end = _end.load(std::memory_order_relaxed);
+            _events[end % _events.size()] = event;
+            _end.store(end + 1, std::memory_order_release);
+        }
+
+        std::vector<TraceEvent> snapshot() const
+        {
+            unsigned long long const size = _events.size();
+            unsigned long long const end = _end.load(std::memory_order_acquire);
+            unsigned long long first = std::max(end > size ? end - size : 0, _cleared.load());
+
+            std::vector<TraceEvent> events;
+            events.reserve(end - first);
+            for (unsigned long long sequence = first; sequence < end; ++sequence)
+                events.push_back(_events[sequence % size]);
+
+            // Writer went on while copying: the oldest slots may hold newer events now
+            unsigned long long const endAfter = _end.load(std::memory_order_acquire);
+            unsigned long long const valid = endAfter > size ? endAfter - size : 0;
+            if (valid > first)
+                events.erase(events.begin(), events.begin() + std::min<size_t>(valid - first, events.size()));
+            return events;
+        }
+
+        void clear() { _cleared.store(_end.load(std::memory_order_acquire)); }
+
+        int const id;
+        QString const name;
+        std::atomic<bool> finished;
+
+    private:
+        std::vector<TraceEvent> _events;
+        std::atomic<unsigned long long> _end;
+        std::atomic<unsigned long long> _cleared;
+    };
+
+    namespace
+    {
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point const Origin = Clock::now();
+
+        // Marks buffer of the thread as finished, when thread exits
+        struct BufferHolder
+        {
+            ~BufferHolder()
+            {
+                if (buffer)
+                    buffer->finished = true;
+            }
+
+            std::shared_ptr<TraceBuffer> buffer;
+        };
+
+        thread_local BufferHolder CurrentBuffer;
+    }
+
+    std::atomic<bool> Tracer::_enabled(false);
+
+    Tracer::Tracer() :
+        _lastFlowId(0),
+        _lastThreadId(0)
+    {
+    }
+
+    void Tracer::setEnabled(bool enabled)
+    {
+        _enabled.store(enabled);
+    }
+
+    long long Tracer::nowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - Origin).count();
+    }
+
+    void Tracer::addSpan(const char *category, const char *name, const char *detail, long long startUs, long long endUs)
+    {
+        currentBuffer().append({ 'X', category, name, detail, startUs, endUs - startUs, 0 });
+    }
+
+    unsigned long long Tracer::beginFlow(const char *name)
+    {
+        if (!isEnabled())
+            return 0;
+
+        unsigned long long const id = ++_lastFlowId;
+        currentBuffer().append({ 's', "flow", name, nullptr, nowUs(), 0, id });
+        return id;
+    }
+
+    void Tracer::endFlow(const char *name, unsigned long long id)
+    {
+        if (id == 0 || !isEnabled())
+            return;
+
+        currentBuffer().append({ 'f', "flow", name, nullptr, nowUs(), 0, id });
+    }
+
+    QByteArray Tracer::toChromeJson() const
+    {
+        std::vector<std::shared_ptr<TraceBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            buffers = _buffers;
+        }
+
+        qint64 const pid = QCoreApplication::applicationPid();
+        QJsonArray traceEvents;
+        for (auto const &buffer : buffers) {
+            QJsonObject threadName;
+            threadName["name"] = "thread_name";
+            threadName["ph"] = "M";
+            threadName["pid"] = pid;
+            threadName["tid"] = buffer->id;
+            threadName["args"] = QJsonObject { { "name", buffer->name } };
+            traceEvents.append(threadName);
+
+            for (auto const &event : buffer->snapshot()) {
+                QJsonObject item;
+                item["name"] = event.name;
+                item["cat"] = event.category;
+                item["ph"] = QString(QLatin1Char(event.phase));
+                item["ts"] = static_cast<double>(event.startUs);
+                item["pid"] = pid;
+                item["tid"] = buffer->id;
+                if (event.phase == 'X')
+                    item["dur"] = static_cast<double>(event.durationUs);
+                else {
+                    item["id"] = static_cast<double>(event.flowId);
+                    if (event.phase == 'f')
+                        item["bp"] = "e";   // Bind to the enclosing span, not to the next one
+                }
+                if (event.detail)
+                    item["args"] = QJsonObject { { "detail", event.detail } };
+                traceEvents.append(item);
+            }
+        }
+
+        QJsonObject root;
+        root["traceEvents"] = traceEvents;
+        root["displayTimeUnit"] = "ms";
+        return QJsonDocument(root).toJson(QJsonDocument::Compact);
+    }
+
+    void Tracer::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto const &buffer : _buffers)
+            buffer->clear();
+    }
+
+    TraceBuffer &Tracer::currentBuffer()
+    {
+        if (CurrentBuffer.buffer)
+            return *CurrentBuffer.buffer;
+
+        QThread *const thread = QThread::currentThread();
+        QCoreApplication *const app = QCoreApplication::instance();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        int const id = ++_lastThreadId;
+        QString name = thread->objectName();
+        if (name.isEmpty())
+            name = app && app->thread() == thread ? QString("GUI") : QString("Thread %1").arg(id);
+
+        // Threads of connections come and go, keep only the latest exited ones
+        int finished = std::count_if(_buffers.begin(), _buffers.end(),
+                                     [](const std::shared_ptr<TraceBuffer> &buffer) { return buffer->finished.load(); });
+        for (auto it = _buffers.begin(); it != _buffers.end() && finished >= MaxFinishedThreads; ) {
+            if ((*it)->finished) {
+                it = _buffers.erase(it);
+                --finished;
+            }
+            else {
+                ++it;
+            }
+        }
+
+        CurrentBuffer.buffer = std::make_shared<TraceBuffer>(id, name);
+        _buffers.push_back(CurrentBuffer.buffer);
+        return *CurrentBuffer.buffer;
+    }
+}
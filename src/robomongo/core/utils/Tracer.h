@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QByteArray>
+
+#include "robomongo/core/utils/SingletonPattern.hpp"
+
+namespace Robomongo
+{
+    class TraceBuffer;
+
+    /**
+     * @brief Collects trace spans of all threads (GUI, MongoWorker, pooled
+     *        connections, SSH tunnels) and exports them in Chrome trace-event
+     *        format, for chrome://tracing or ui.perfetto.dev.
+     *
+     *        Each thread writes into its own ring of the last EventsPerThread
+     *        events, without locks. Export copies rings while threads keep
+     *        writing and drops events overwritten meanwhile.
+     *
+     *        Recording is off by default (see Help > Debug and --trace), then
+     *        TraceSpan costs one relaxed atomic load.
+     */
+    class Tracer : public Patterns::LazySingleton<Tracer>
+    {
+        friend class Patterns::LazySingleton<Tracer>;
+
+    public:
+        static constexpr int EventsPerThread = 16384;
+        static constexpr int MaxFinishedThreads = 64;   // Buffers of exited threads kept for export
+
+        static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+        static void setEnabled(bool enabled);
+
+        // Microseconds since the first use of tracer
+        static long long nowUs();
+
+        /**
+         * @brief Adds complete span of the current thread. Strings are stored as
+         *        pointers: they must be literals (or outlive the tracer).
+         *        'detail' may be null.
+         */
+        void addSpan(const char *category, const char *name, const char *detail, long long startUs, long long endUs);
+
+        /**
+         * @brief Arrow from the enclosing span of this thread to the enclosing span
+         *        of the thread, that calls endFlow() with the returned id.
+         *        Returns 0 (and endFlow() ignores it) when recording is off.
+         */
+        unsigned long long beginFlow(const char *name);
+        void endFlow(const char *name, unsigned long long id);
+
+        // { "traceEvents": [ ... ], "displayTimeUnit": "ms" }
+        QByteArray toChromeJson() const;
+
+        // Drops recorded events, buffers stay registered
+        void clear();
+
+    private:
+        Tracer();
+        TraceBuffer &currentBuffer();
+
+        static std::atomic<bool> _enabled;
+        std::atomic<unsigned long long> _lastFlowId;
+
+        mutable std::mutex _mutex;      // Guards list of buffers, not their contents
+        std::vector<std::shared_ptr<TraceBuffer>> _buffers;
+        int _lastThreadId;
+    };
+
+    /**
+     * @brief Scoped span: from construction to destruction, on the current thread.
+     *
+     *        TraceSpan const span("worker", "MongoClient::query");
+     */
+    class TraceSpan
+    {
+    public:
+        TraceSpan(const char *category, const char *name, const char *detail = nullptr) :
+            _category(category),
+            _name(name),
+            _detail(detail),
+            _startUs(Tracer::isEnabled() ? Tracer::nowUs() : -1) {}
+
+        ~TraceSpan()
+        {
+            if (_startUs >= 0)
+                Tracer::instance().addSpan(_category, _name, _detail, _startUs, Tracer::nowUs());
+        }
+
+        TraceSpan(const TraceSpan &) = delete;
+        TraceSpan &operator=(const TraceSpan &) = delete;
+
+    private:
+        const char *const _category;
+        const char *const _name;
+        const char *const _detail;
+        long long const _startUs;
+    };
+}
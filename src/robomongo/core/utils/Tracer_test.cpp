@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include "Tracer.h"
+
+#include <thread>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace Robomongo;
+
+namespace
+{
+    // Events of 'phase' and 'name', as exported
+    QList<QJsonObject> exported(const char *phase, const QString &name)
+    {
+        QList<QJsonObject> events;
+        auto const root = QJsonDocument::fromJson(Tracer::instance().toChromeJson()).object();
+        for (auto const &value : root["traceEvents"].toArray()) {
+            QJsonObject const event = value.toObject();
+            if (event["ph"].toString() == phase && event["name"].toString() == name)
+                events.append(event);
+        }
+        return events;
+    }
+}
+
+TEST(tracer_tests, records_spans_of_each_thread_only_when_enabled)
+{
+    Tracer::instance().clear();
+    Tracer::setEnabled(false);
+    { TraceSpan const span("test", "disabled"); }
+
+    Tracer::setEnabled(true);
+    { TraceSpan const span("test", "enabled", "main"); }
+    std::thread([]() { TraceSpan const span("test", "enabled", "other"); }).join();
+    Tracer::setEnabled(false);
+
+    EXPECT_TRUE(exported("X", "disabled").isEmpty());
+
+    auto const spans = exported("X", "enabled");
+    ASSERT_EQ(2, spans.size());
+    EXPECT_NE(spans[0]["tid"].toInt(), spans[1]["tid"].toInt());
+    EXPECT_EQ("test", spans[0]["cat"].toString());
+    EXPECT_GE(spans[0]["dur"].toDouble(), 0);
+    EXPECT_EQ("main", spans[0]["args"].toObject()["detail"].toString());
+    EXPECT_FALSE(exported("M", "thread_name").isEmpty());
+}
+
+TEST(tracer_tests, keeps_latest_events_of_thread)
+{
+    Tracer::instance().clear();
+    Tracer::setEnabled(true);
+    for (int i = 0; i < Tracer::EventsPerThread + 10; ++i)
+        Tracer::instance().addSpan("test", "ring", nullptr, i, i + 1);
+    Tracer::setEnabled(false);
+
+    auto const spans = exported("X", "ring");
+    ASSERT_EQ(Tracer::EventsPerThread, spans.size());
+    EXPECT_EQ(10, spans.front()["ts"].toInt());
+
+    Tracer::instance().clear();
+    EXPECT_TRUE(exported("X", "ring").isEmpty());
+}
+
+TEST(tracer_tests, links_flow_across_threads)
+{
+    Tracer::instance().clear();
+    Tracer::setEnabled(true);
+    unsigned long long const id = Tracer::instance().beginFlow("flow");
+    std::thread([id]() { Tracer::instance().endFlow("flow", id); }).join();
+    Tracer::setEnabled(false);
+
+    EXPECT_NE(0u, id);
+    auto const starts = exported("s", "flow");
+    auto const ends = exported("f", "flow");
+    ASSERT_EQ(1, starts.size());
+    ASSERT_EQ(1, ends.size());
+    EXPECT_EQ(starts[0]["id"].toDouble(), ends[0]["id"].toDouble());
+    EXPECT_EQ(0u, Tracer::instance().beginFlow("flow"));
+}
@@ -23,6 +23,8 @@
 #include <QNetworkReply>
 #include <QUrl>
 #include <QTextDocument>
+#include <QFileDialog>
+#include <QFile>
 
 #include <mongo/logger/log_severity.h>
 #include "robomongo/core/settings/SettingsManager.h"
@@ -33,8 +35,10 @@
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/Tracer.h"
 
 #include "robomongo/gui/widgets/LogWidget.h"
+#include "robomongo/gui/widgets/MetricsWidget.h"
 #include "robomongo/gui/widgets/explorer/ExplorerWidget.h"
 #include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerTreeWidget.h"
@@ -125,10 +129,11 @@ namespace Robomongo
 
     MainWindow::MainWindow()
         : BaseClass(),
-        _logDock(nullptr), _workArea(nullptr), _explorer(nullptr), _app(AppRegistry::instance().app()), 
+        _logDock(nullptr), _metricsDock(nullptr), _workArea(nullptr), _explorer(nullptr), _app(AppRegistry::instance().app()), 
         _connectionsMenu(nullptr), _connectButton(nullptr), _viewMenu(nullptr), _toolbarsMenu(nullptr), 
         _connectAction(nullptr), _openAction(nullptr), _saveAction(nullptr), _saveAsAction(nullptr),
         _executeAction(nullptr), _stopAction(nullptr), _orientationAction(nullptr), _execToolBar(nullptr),
+        _networkAccessManager(nullptr),
 #if defined(Q_OS_WIN)
         _trayIcon(nullptr),
 #endif
@@ -541,6 +546,19 @@ namespace Robomongo
         QMenu *helpMenu = menuBar()->addMenu("Help");
         helpMenu->addAction(aboutRobomongoAction);
 
+        // Trace of GUI, worker and tunnel threads, for chrome://tracing
+        QAction *recordTraceAction = new QAction(tr("Record Trace"), this);
+        recordTraceAction->setCheckable(true);
+        recordTraceAction->setChecked(Tracer::isEnabled());
+        VERIFY(connect(recordTraceAction, SIGNAL(toggled(bool)), this, SLOT(toggleTraceRecording(bool))));
+
+        QAction *exportTraceAction = new QAction(tr("Export Trace..."), this);
+        VERIFY(connect(exportTraceAction, SIGNAL(triggered()), this, SLOT(exportTrace())));
+
+        QMenu *debugMenu = helpMenu->addMenu(tr("Debug"));
+        debugMenu->addAction(recordTraceAction);
+        debugMenu->addAction(exportTraceAction);
+
         // Toolbar
         QToolBar *connectToolBar = new QToolBar(tr("Connections Toolbar"), this);
         connectToolBar->setToolButtonStyle(Qt::ToolButtonIconOnly);
@@ -629,10 +647,6 @@ namespace Robomongo
         // Catch application windows focus changes
         VERIFY(connect(qApp, SIGNAL(focusChanged(QWidget*, QWidget*)), this, SLOT(on_focusChanged())));
 
-        _networkAccessManager = new QNetworkAccessManager;
-        VERIFY(connect(_networkAccessManager, SIGNAL(finished(QNetworkReply*)),
-               this, SLOT(on_networkReply(QNetworkReply*))));
-
         if (!settings->disableHttpsFeatures() && settings->checkForUpdates()) {
             // First check for updates THIRTY_SECONDS after program start            
             QTimer::singleShot(THIRTY_SECONDS, this, SLOT(checkUpdates()));
@@ -852,6 +866,10 @@ namespace Robomongo
         _trayIcon->hide(); // hide the tray icon so the main window can't be hidden behind the connections dialog
     #endif
 
+        // Connections of previous versions are imported when they are needed the first time
+        if (AppRegistry::instance().settingsManager()->importFromOldVersion())
+            AppRegistry::instance().settingsManager()->save();
+
         static bool checkForImported = true;
         ConnectionsDialog dialog(AppRegistry::instance().settingsManager(), checkForImported, this);
         int result = dialog.exec();
@@ -1028,6 +1046,30 @@ namespace Robomongo
         dlg.exec();
     }
 
+    void MainWindow::toggleTraceRecording(bool enabled)
+    {
+        // Keep earlier spans: the slow interaction may be recorded already
+        Tracer::setEnabled(enabled);
+    }
+
+    void MainWindow::exportTrace()
+    {
+        QString const path = QFileDialog::getSaveFileName(this, tr("Export Trace"), "robo3t-trace.json",
+                                                          tr("Chrome trace (*.json)"));
+        if (path.isEmpty())
+            return;
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(Tracer::instance().toChromeJson()) < 0) {
+            QMessageBox::information(this, "Error", QString("Cannot write trace to %1:\n%2")
+                                     .arg(path).arg(file.errorString()));
+            return;
+        }
+
+        LOG_MSG(QString("Trace exported to %1, open it in chrome://tracing or ui.perfetto.dev").arg(path),
+                mongo::logger::LogSeverity::Info());
+    }
+
     void MainWindow::openPreferences()
     {
         PreferencesDialog dlg(this);
@@ -1274,14 +1316,13 @@ namespace Robomongo
 
         addDockWidget(Qt::LeftDockWidgetArea, explorerDock);
 
-        LogWidget *log = new LogWidget(this);        
-        VERIFY(connect(&Logger::instance(), SIGNAL(printed(const QString&, mongo::logger::LogSeverity)), 
-            log, SLOT(addMessage(const QString&, mongo::logger::LogSeverity))));
+        // Log widget is created when the panel is shown for the first time,
+        // records logged before are kept by Logger anyway
         _logDock = new QDockWidget(tr("Logs"));
         _logDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
-        _logDock->setWidget(log);
         _logDock->setFeatures(QDockWidget::DockWidgetClosable);
         _logDock->setVisible(false);
+        VERIFY(connect(_logDock, SIGNAL(visibilityChanged(bool)), this, SLOT(onLogVisibilityChanged(bool))));
 
         QAction *action = _logDock->toggleViewAction();
         action->setText(QString("&Logs"));
@@ -1292,6 +1333,33 @@ namespace Robomongo
         _viewMenu->addAction(action);
         
         addDockWidget(Qt::BottomDockWidgetArea, _logDock);
+
+        // Metrics are collected all the time, the panel only shows them
+        _metricsDock = new QDockWidget(tr("Metrics"));
+        _metricsDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
+        _metricsDock->setFeatures(QDockWidget::DockWidgetClosable);
+        _metricsDock->setVisible(false);
+        VERIFY(connect(_metricsDock, SIGNAL(visibilityChanged(bool)), this, SLOT(onMetricsVisibilityChanged(bool))));
+
+        QAction *metricsAction = _metricsDock->toggleViewAction();
+        metricsAction->setText(QString("&Metrics"));
+        metricsAction->setChecked(_metricsDock->isVisible());
+        _viewMenu->addAction(metricsAction);
+
+        addDockWidget(Qt::BottomDockWidgetArea, _metricsDock);
+        tabifyDockWidget(_logDock, _metricsDock);
+    }
+
+    void MainWindow::onLogVisibilityChanged(bool isVisible)
+    {
+        if (isVisible && !_logDock->widget())
+            _logDock->setWidget(new LogWidget(this));
+    }
+
+    void MainWindow::onMetricsVisibilityChanged(bool isVisible)
+    {
+        if (isVisible && !_metricsDock->widget())
+            _metricsDock->setWidget(new MetricsWidget(this));
     }
 
     void MainWindow::updateMenus()
@@ -1452,6 +1520,13 @@ namespace Robomongo
                   QString(PROJECT_VERSION) + "&licenseInfo=FREE&setup=" + settings->anonymousID() + 
                   "&dbVersionsConnected=" + dbVersionsConnected + "&notify=true#");
 
+        // Created on first use, network stack initialization is not free
+        if (!_networkAccessManager) {
+            _networkAccessManager = new QNetworkAccessManager(this);
+            VERIFY(connect(_networkAccessManager, SIGNAL(finished(QNetworkReply*)),
+                   this, SLOT(on_networkReply(QNetworkReply*))));
+        }
+
         _networkAccessManager->get(QNetworkRequest(url));
     }
 }
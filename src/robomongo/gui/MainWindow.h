@@ -101,6 +101,8 @@ namespace Robomongo
         void onOpenSaveToolbarVisibilityChanged(bool isVisisble);
         void onExecToolbarVisibilityChanged(bool isVisisble);
         void onExplorerVisibilityChanged(bool isVisisble);
+        void onLogVisibilityChanged(bool isVisible);
+        void onMetricsVisibilityChanged(bool isVisible);
         void on_tabChange();
 
         void toggleMinimize();
@@ -116,6 +118,8 @@ namespace Robomongo
         void checkUpdates();
         void toggleCheckUpdates();
         void openShellTimeoutDialog();
+        void toggleTraceRecording(bool enabled);
+        void exportTrace();
 
     private:
         void updateConnectionsMenu();
@@ -128,6 +132,7 @@ namespace Robomongo
         void adjustUpdatesBarHeight();
 
         QDockWidget *_logDock;
+        QDockWidget *_metricsDock;
 
         WorkAreaTabWidget *_workArea;
 
@@ -69,15 +69,29 @@ namespace Robomongo
         defaultDbLabel->setMaximumWidth(140); // Linux
 #endif
 
+        auto compressorsDescriptionLabel = new QLabel(
+            "Comma separated list of network compressors (<code>snappy</code>, <code>zstd</code>, "
+            "<code>zlib</code>) in order of preference. The first one supported by server is used "
+            "for shell and explorer connections. Leave this field empty to disable compression.");
+        compressorsDescriptionLabel->setWordWrap(true);
+        compressorsDescriptionLabel->setContentsMargins(0, -2, 0, 20);
+        _compressors = new QLineEdit(QtUtils::toQString(_settings->compressors()));
+        _compressors->setPlaceholderText("snappy,zstd,zlib");
+        auto compressorsLabel = new QLabel("Compression:");
+        compressorsLabel->setMaximumWidth(defaultDbLabel->maximumWidth());
+
         auto mainLayout = new QGridLayout;
         mainLayout->setAlignment(Qt::AlignTop);
         mainLayout->addWidget(defaultDbLabel,                           1, 0);
         mainLayout->addWidget(_defaultDatabaseName,                     1, 1, 1, 2);
         mainLayout->addWidget(defaultDatabaseDescriptionLabel,          2, 1, 1, 2);
+        mainLayout->addWidget(compressorsLabel,                         3, 0);
+        mainLayout->addWidget(_compressors,                             3, 1, 1, 2);
+        mainLayout->addWidget(compressorsDescriptionLabel,              4, 1, 1, 2);
         /* --- Disabling unfinished export URI connection string feature
-        mainLayout->addWidget(new QLabel{ "URI Connection String:" },   3, 0);
-        mainLayout->addWidget(_uriString,                               3, 1);
-        mainLayout->addLayout(hlay,                                     4, 1);
+        mainLayout->addWidget(new QLabel{ "URI Connection String:" },   5, 0);
+        mainLayout->addWidget(_uriString,                               5, 1);
+        mainLayout->addLayout(hlay,                                     6, 1);
         */
         setLayout(mainLayout);
     }
@@ -85,6 +99,7 @@ namespace Robomongo
     void ConnectionAdvancedTab::accept()
     {
         _settings->setDefaultDatabase(QtUtils::toStdString(_defaultDatabaseName->text()));
+        _settings->setCompressors(QtUtils::toStdString(_compressors->text().remove(' ')));
     }
 
     void ConnectionAdvancedTab::setDefaultDb(const QString& defaultDb)
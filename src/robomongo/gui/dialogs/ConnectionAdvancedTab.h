@@ -30,6 +30,7 @@ namespace Robomongo
 
     private:
         QLineEdit *_defaultDatabaseName;
+        QLineEdit *_compressors;
 
         /* --- Disabling unfinished export URI connection string feature
         QLineEdit *_uriString;
@@ -8,6 +8,7 @@
 #include <QPushButton>
 #include <QFileDialog>
 #include <QComboBox>
+#include <QSpinBox>
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
 #include <QMessageBox>
@@ -15,6 +16,8 @@
 #include <QApplication>
 #include <QDesktopWidget>
 
+#include <algorithm>
+
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
@@ -107,6 +110,26 @@ namespace Robomongo
         _setNameLabel = new QLabel("Set Name:");
         _setNameEdit = new QLineEdit(QString::fromStdString(_settings->replicaSetSettings()->setNameUserEntered()));
 
+        _readPrefLabel = new QLabel("Read Preference:");
+        _readPreference = new QComboBox;
+        _readPreference->addItem("Primary");
+        _readPreference->addItem("Primary Preferred");
+        _readPreference->addItem("Secondary Preferred");
+        _readPreference->addItem("Nearest");
+        _readPreference->setToolTip("Where queries from collection views and shells are sent. "
+                                    "\"Nearest\" picks the member with the lowest network latency.");
+        _readPreference->setCurrentIndex(static_cast<int>(_settings->replicaSetSettings()->readPreference()));
+        _maxStaleness = new QSpinBox;
+        _maxStaleness->setRange(0, 24 * 60 * 60);
+        _maxStaleness->setSuffix(" s");
+        _maxStaleness->setSpecialValueText("Any lag");
+        _maxStaleness->setFixedWidth(80);
+        _maxStaleness->setToolTip(QString("Max replication lag of secondaries to read from, at least %1 seconds")
+                                  .arg(ReplicaSetSettings::MinMaxStalenessSeconds));
+        _maxStaleness->setValue(_settings->replicaSetSettings()->maxStalenessSeconds());
+        VERIFY(connect(_readPreference, SIGNAL(currentIndexChanged(int)), this, SLOT(on_readPreferenceChange(int))));
+        on_readPreferenceChange(_readPreference->currentIndex());
+
         auto fakeSpacer = new QLabel("");
         auto hline = new QFrame();
         hline->setFrameShape(QFrame::HLine);
@@ -140,14 +163,17 @@ namespace Robomongo
         connLayout->addWidget(_minusPlusButtonBox,            8, 3, Qt::AlignRight | Qt::AlignTop);
         connLayout->addWidget(_setNameLabel,                  9, 0);
         connLayout->addWidget(_setNameEdit,                   9, 1, 1, 3, Qt::AlignTop);
-        connLayout->addWidget(fakeSpacer,                    10, 0);
-        connLayout->addWidget(hline,                         11, 0, 1, 4);
-        connLayout->addWidget(_uriButton,                    13, 0);
-        connLayout->addWidget(_uriEdit,                      13, 1, 1, 3);
-
-        connLayout->setRowStretch(10, 1);        
+        connLayout->addWidget(_readPrefLabel,                10, 0);
+        connLayout->addWidget(_readPreference,               10, 1);
+        connLayout->addWidget(_maxStaleness,                 10, 3);
+        connLayout->addWidget(fakeSpacer,                    11, 0);
+        connLayout->addWidget(hline,                         12, 0, 1, 4);
+        connLayout->addWidget(_uriButton,                    14, 0);
+        connLayout->addWidget(_uriEdit,                      14, 1, 1, 3);
+
+        connLayout->setRowStretch(11, 1);        
 #ifdef __APPLE__
-        connLayout->setRowMinimumHeight(11, 20);
+        connLayout->setRowMinimumHeight(12, 20);
 #endif
 
         auto mainLayout = new QVBoxLayout;
@@ -220,6 +246,9 @@ namespace Robomongo
             _settings->replicaSetSettings()->setSetNameUserEntered(_setNameEdit->text().toStdString());
             // Clear cached set name
             _settings->replicaSetSettings()->setCachedSetName("");
+            _settings->replicaSetSettings()->setReadPreference(
+                static_cast<ReplicaSetSettings::ReadPreference>(_readPreference->currentIndex()));
+            _settings->replicaSetSettings()->setMaxStalenessSeconds(_maxStaleness->value());
         }
 
         return true;
@@ -233,6 +262,8 @@ namespace Robomongo
         _serverPort->clear();
         _members->clear();
         _setNameEdit->clear();
+        _readPreference->setCurrentIndex(0);
+        _maxStaleness->setValue(0);
     }
 
     void ConnectionBasicTab::on_ConnectionTypeChange(int index)
@@ -247,6 +278,9 @@ namespace Robomongo
         _minusPlusButtonBox->setVisible(isReplica);
         _setNameLabel->setVisible(isReplica);
         _setNameEdit->setVisible(isReplica);
+        _readPrefLabel->setVisible(isReplica);
+        _readPreference->setVisible(isReplica);
+        _maxStaleness->setVisible(isReplica);
             
         // Direct Connection
         _addressLabel->setVisible(!isReplica);
@@ -363,6 +397,16 @@ namespace Robomongo
                 _members->addTopLevelItem(item);
             }
             _setNameEdit->setText(QString::fromStdString(mongoUri.getSetName()));
+
+            // i.e. "readPreference=nearest&maxStalenessSeconds=120"
+            auto const readPref = mongoUri.getOption("readPreference").get_value_or("");
+            for (int mode = 0; mode < _readPreference->count(); ++mode) {
+                auto const readPrefEnum = static_cast<ReplicaSetSettings::ReadPreference>(mode);
+                if (ReplicaSetSettings::readPreferenceMode(readPrefEnum) == readPref)
+                    _readPreference->setCurrentIndex(mode);
+            }
+            auto const maxStaleness = mongoUri.getOption("maxStalenessSeconds").get_value_or("0");
+            _maxStaleness->setValue(std::max(0, QString::fromStdString(maxStaleness).toInt()));
         }
         else {  // Standalone
             _connectionType->setCurrentIndex(0);
@@ -395,4 +439,11 @@ namespace Robomongo
         // Advanced Tab
         _connectionDialog->setDefaultDb(QString::fromStdString(mongoUri.getDatabase()));
     }
-}
\ No newline at end of file
+
+    void ConnectionBasicTab::on_readPreferenceChange(int index)
+    {
+        // Max staleness is not allowed with primary read preference
+        _maxStaleness->setEnabled(
+            static_cast<ReplicaSetSettings::ReadPreference>(index) != ReplicaSetSettings::ReadPreference::PRIMARY);
+    }
+}
@@ -7,6 +7,7 @@ class QLabel;
 class QCheckBox;
 class QPushButton;
 class QComboBox;
+class QSpinBox;
 class QTreeWidget;
 class QTreeWidgetItem;
 class QDialogButtonBox;
@@ -33,6 +34,7 @@ namespace Robomongo
         void on_removeButton_clicked();
         void on_replicaMemberItemEdit(QTreeWidgetItem* item, int column);
         void on_uriButton_clicked();
+        void on_readPreferenceChange(int index);
 
     private:
         QLabel *_typeLabel;
@@ -57,6 +59,7 @@ namespace Robomongo
         QPushButton *_discoverButton;
         QLabel *_readPrefLabel;
         QComboBox *_readPreference;
+        QSpinBox *_maxStaleness;
 
         ConnectionSettings *const _settings;
         ConnectionDialog *_connectionDialog;
@@ -52,6 +52,8 @@ namespace Robomongo
         _sshLabel = new QLabel;
         _listIconLabel = new QLabel;
         _listLabel = new QLabel;
+        _compressionIconLabel = new QLabel;
+        _compressionLabel = new QLabel;
 
         _viewErrorLink = new QLabel("<a href='error' style='color: #777777;'>Show error details</a>");
         VERIFY(connect(_viewErrorLink, SIGNAL(linkActivated(QString)), this, SLOT(errorLinkActivated(QString))));
@@ -64,6 +66,7 @@ namespace Robomongo
         _sshIconLabel->setMovie(_loadingMovie);
         _authIconLabel->setMovie(_loadingMovie);
         _listIconLabel->setMovie(_loadingMovie);
+        _compressionIconLabel->setMovie(_loadingMovie);
 
         QGridLayout *layout = new QGridLayout();
         layout->setContentsMargins(20, 20, 20, 10);
@@ -75,6 +78,8 @@ namespace Robomongo
         layout->addWidget(_authLabel,           2, 1, Qt::AlignLeft);
         layout->addWidget(_listIconLabel,       3, 0);
         layout->addWidget(_listLabel,           3, 1, Qt::AlignLeft);
+        layout->addWidget(_compressionIconLabel, 4, 0);
+        layout->addWidget(_compressionLabel,    4, 1, Qt::AlignLeft);
         layout->setColumnStretch(0, 0) ; // Give column 0 no stretch ability
         layout->setColumnStretch(1, 1) ; // Give column 1 stretch ability of ratio 1
 
@@ -93,6 +98,7 @@ namespace Robomongo
         connectionStatus(InitialState);
         authStatus(InitialState);
         listStatus(InitialState);
+        compressionStatus(InitialState);
 
         _viewErrorLink->hide();
 
@@ -234,6 +240,39 @@ namespace Robomongo
         }
     }
 
+    void ConnectionDiagnosticDialog::compressionStatus(State state, const std::string &compressor,
+                                                       long long wireBytes, long long messageBytes)
+    {
+        if (_connSettings->compressors().empty()) {
+            _compressionIconLabel->setVisible(false);
+            _compressionLabel->setVisible(false);
+            return;
+        }
+
+        if (state == InitialState) {
+            _compressionIconLabel->setMovie(_loadingMovie);
+            _compressionLabel->setText(QString("Negotiating network compression (<b>%1</b>)...")
+                .arg(QtUtils::toQString(_connSettings->compressors())));
+        } else if (state == CompletedState && !compressor.empty()) {
+            double const ratio = wireBytes > 0 ? double(messageBytes) / wireBytes : 0;
+            _compressionIconLabel->setPixmap(_yesPixmap);
+            _compressionLabel->setText(QString("Compressed with <b>%1</b>: %2 bytes on the wire, "
+                                               "%3 uncompressed (ratio %4)")
+                .arg(QtUtils::toQString(compressor))
+                .arg(wireBytes)
+                .arg(messageBytes)
+                .arg(ratio, 0, 'f', 2));
+        } else if (state == CompletedState) {
+            _compressionIconLabel->setPixmap(_noPixmap);
+            _compressionLabel->setText(QString("Server supports none of <b>%1</b>, network traffic "
+                                               "is not compressed")
+                .arg(QtUtils::toQString(_connSettings->compressors())));
+        } else if (state == NotPerformedState) {
+            _compressionIconLabel->setPixmap(_questionPixmap);
+            _compressionLabel->setText(QString("No chance to negotiate network compression"));
+        }
+    }
+
     void ConnectionDiagnosticDialog::handle(ConnectionEstablishedEvent *event) {
         if (event->connectionType != ConnectionTest)
             return;
@@ -242,6 +281,8 @@ namespace Robomongo
         connectionStatus(CompletedState);
         authStatus(CompletedState);
         listStatus(CompletedState);
+        compressionStatus(CompletedState, event->connInfo._compressor, event->connInfo._wireBytes,
+                          event->connInfo._messageBytes);
 
         // Remember in order to delete on dialog close
         _server = static_cast<MongoServer*>(event->sender());
@@ -255,6 +296,7 @@ namespace Robomongo
         connectionStatus(CompletedState);
         authStatus(CompletedState);
         listStatus(CompletedState);
+        compressionStatus(NotPerformedState);
 
         switch (event->reason) {
         case ConnectionFailedEvent::SshConnection:
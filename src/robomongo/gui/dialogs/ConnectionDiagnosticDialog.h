@@ -41,6 +41,8 @@ namespace Robomongo
         void connectionStatus(State state);
         void authStatus(State state);
         void listStatus(State state);
+        void compressionStatus(State state, const std::string &compressor = std::string(),
+                               long long wireBytes = 0, long long messageBytes = 0);
 
         ConnectionSettings *_connSettings;
         QIcon _yesIcon;
@@ -60,6 +62,8 @@ namespace Robomongo
         QLabel *_authLabel;
         QLabel *_listIconLabel;  // List database names
         QLabel *_listLabel;
+        QLabel *_compressionIconLabel;
+        QLabel *_compressionLabel;
 
         QLabel *_viewErrorLink;
         std::string _lastErrorMessage;
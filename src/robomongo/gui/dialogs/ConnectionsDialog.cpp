@@ -1,5 +1,7 @@
 #include "robomongo/gui/dialogs/ConnectionsDialog.h"
 
+#include <tuple>
+
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QAction>
@@ -15,6 +17,7 @@
 
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/settings/MetadataCache.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/settings/SslSettings.h"
@@ -305,6 +308,15 @@ namespace Robomongo
             return;
         }
 
+        // Cached database and collection names belong to the old server
+        auto const server = [](ConnectionSettings *conn) {
+            return std::make_tuple(conn->serverHost(), conn->serverPort(), conn->isReplicaSet(),
+                                   conn->replicaSetSettings()->members(),
+                                   conn->replicaSetSettings()->setNameUserEntered());
+        };
+        if (server(connection) != server(editDialog.connection()))
+            AppRegistry::instance().metadataCache()->invalidate(connection->uuid());
+
         connection->apply(editDialog.connection());       
 
         // on linux focus is lost - we need to activate connections dialog
@@ -353,6 +365,7 @@ namespace Robomongo
         }
         */
 
+        AppRegistry::instance().metadataCache()->invalidate(connSettings->uuid());
         _settingsManager->removeConnection(connSettings);
 
         delete currentItem;
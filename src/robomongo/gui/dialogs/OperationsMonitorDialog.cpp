@@ -0,0 +1,330 @@
+#include "robomongo/gui/dialogs/OperationsMonitorDialog.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QTime>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/App.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    using namespace Robomongo;
+
+    enum Columns
+    {
+        NamespaceColumn, OperationColumn, ShapeColumn, CountColumn, TotalColumn, AverageColumn, MaxColumn,
+        ExaminedColumn, PlanColumn, IndexColumn, ColumnCount
+    };
+
+    QString milliseconds(double micros)
+    {
+        return QString("%1 ms").arg(micros / 1000, 0, 'f', micros < 10000 ? 1 : 0);
+    }
+
+    QTableWidgetItem *cell(const QString &text, bool number = false)
+    {
+        QTableWidgetItem *item = new QTableWidgetItem(text);
+        if (number)
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    }
+
+    std::string json(const mongo::BSONObj &obj, bool isArray = false)
+    {
+        return BsonUtils::jsonString(obj, mongo::TenGen, 0, DefaultEncoding, Utc, isArray);
+    }
+
+    std::string collectionName(const std::string &ns)
+    {
+        size_t const dot = ns.find('.');
+        return dot == std::string::npos ? ns : ns.substr(dot + 1);
+    }
+}
+
+namespace Robomongo
+{
+    OperationsMonitorDialog::OperationsMonitorDialog(MongoDatabase *database, QWidget *parent) :
+        QDialog(parent),
+        _database(database),
+        _profileSinceMillis(0),
+        _sampling(false),
+        _closed(false),
+        _disconnected(false)
+    {
+        setWindowTitle(QString("Operations Monitor: %1").arg(QtUtils::toQString(_database->name())));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _intervalBox = new QSpinBox;
+        _intervalBox->setRange(1, 300);
+        _intervalBox->setValue(DefaultIntervalSec);
+        _intervalBox->setSuffix(" sec");
+
+        _pauseButton = new QPushButton("&Pause");
+        _pauseButton->setCheckable(true);
+        VERIFY(connect(_pauseButton, SIGNAL(toggled(bool)), this, SLOT(setPaused(bool))));
+
+        QPushButton *clearButton = new QPushButton("C&lear");
+        VERIFY(connect(clearButton, SIGNAL(clicked()), this, SLOT(clear())));
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+
+        _shapesTable = new QTableWidget(0, ColumnCount);
+        _shapesTable->setHorizontalHeaderLabels({ "Namespace", "Operation", "Query Shape", "Count", "Total",
+                                                  "Average", "Max", "Examined / Returned", "Plan",
+                                                  "Suggested Index" });
+        _shapesTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+        _shapesTable->horizontalHeader()->setStretchLastSection(true);
+        _shapesTable->verticalHeader()->hide();
+        _shapesTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        _shapesTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+        _shapesTable->setSelectionMode(QAbstractItemView::SingleSelection);
+        _shapesTable->setWordWrap(false);
+        VERIFY(connect(_shapesTable, SIGNAL(itemSelectionChanged()), this, SLOT(updateButtons())));
+
+        _explainButton = new QPushButton("&Explain");
+        _explainButton->setToolTip("Open shell with explain of the latest operation of selected shape");
+        VERIFY(connect(_explainButton, SIGNAL(clicked()), this, SLOT(explainSelected())));
+
+        _createIndexButton = new QPushButton("Create &Index...");
+        _createIndexButton->setToolTip("Open shell with creation of suggested index, to review and run");
+        VERIFY(connect(_createIndexButton, SIGNAL(clicked()), this, SLOT(createIndexSelected())));
+
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(close())));
+
+        _timer = new QTimer(this);
+        _timer->setSingleShot(true);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(sample())));
+        VERIFY(connect(_database->server()->worker(), SIGNAL(destroyed()), this, SLOT(workerDestroyed())));
+
+        QHBoxLayout *toolsLayout = new QHBoxLayout;
+        toolsLayout->addWidget(new QLabel("Sample every"));
+        toolsLayout->addWidget(_intervalBox);
+        toolsLayout->addWidget(_pauseButton);
+        toolsLayout->addWidget(clearButton);
+        toolsLayout->addStretch(1);
+
+        QHBoxLayout *buttonsLayout = new QHBoxLayout;
+        buttonsLayout->addWidget(_explainButton);
+        buttonsLayout->addWidget(_createIndexButton);
+        buttonsLayout->addStretch(1);
+        buttonsLayout->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(toolsLayout);
+        layout->addWidget(_statusLabel);
+        layout->addWidget(_shapesTable, 1);
+        layout->addLayout(buttonsLayout);
+        setLayout(layout);
+
+        resize(1000, 500);
+        updateButtons();
+        sample();
+    }
+
+    void OperationsMonitorDialog::handle(SampleOperationsResponse *event)
+    {
+        _sampling = false;
+        if (_closed) {
+            deleteLater();
+            return;
+        }
+
+        if (!_pauseButton->isChecked())
+            _timer->start(_intervalBox->value() * 1000);
+
+        QString const time = QTime::currentTime().toString("HH:mm:ss");
+        if (event->isError()) {
+            _statusLabel->setText(QString("%1: failed to sample operations. %2")
+                                  .arg(time).arg(QtUtils::toQString(event->error().errorMessage())));
+            return;
+        }
+
+        _table.addSample(event->operations);
+        _profileSinceMillis = event->profileLastMillis;
+        _profileSeenEntries = event->profileLastEntries;
+
+        // Without profiler only operations, running at the moments of sampling, are seen
+        QString status = QString("%1: %2 shapes.").arg(time).arg(_table.size());
+        if (event->profilingLevel == 0)
+            status += " Profiler is off, only running operations are sampled. "
+                      "Enable it with db.setProfilingLevel(1) to see finished slow operations.";
+        else
+            status += QString(" Profiler level %1, slow operations take over %2 ms.")
+                      .arg(event->profilingLevel).arg(event->slowMs);
+        _statusLabel->setText(status);
+
+        refreshTable();
+    }
+
+    void OperationsMonitorDialog::done(int result)
+    {
+        // Close button, Esc and close() of dialog end here
+        _timer->stop();
+        _closed = true;
+
+        // Deleted in handle(SampleOperationsResponse *), reply is sent to this dialog
+        if (_sampling)
+            setAttribute(Qt::WA_DeleteOnClose, false);
+
+        QDialog::done(result);
+    }
+
+    void OperationsMonitorDialog::workerDestroyed()
+    {
+        // Disconnected, pending sample is never replied
+        _timer->stop();
+        _disconnected = true;
+        _sampling = false;
+        if (_closed)
+            deleteLater();
+        else
+            _statusLabel->setText("Disconnected from server.");
+    }
+
+    void OperationsMonitorDialog::sample()
+    {
+        if (_sampling || _disconnected)
+            return;
+
+        _sampling = true;
+        AppRegistry::instance().bus()->send(_database->server()->worker(),
+            new SampleOperationsRequest(this, _database->name(), _profileSinceMillis,
+                                        _profileSeenEntries));
+    }
+
+    void OperationsMonitorDialog::setPaused(bool paused)
+    {
+        _pauseButton->setText(paused ? "&Resume" : "&Pause");
+        if (paused)
+            _timer->stop();
+        else
+            sample();
+    }
+
+    void OperationsMonitorDialog::clear()
+    {
+        // Profile is not read again, only new entries
+        _table.clear();
+        refreshTable();
+    }
+
+    void OperationsMonitorDialog::explainSelected()
+    {
+        const OperationShape *shape = selectedShape();
+        if (!shape)
+            return;
+
+        // Explain does not execute writes, update and delete are explained as find with their filter
+        std::string const collection = "db.getCollection('" + collectionName(shape->ns) + "')";
+        std::string script;
+        if (shape->command == "aggregate") {
+            script = collection + ".explain('executionStats').aggregate(" + json(shape->filter, true) + ")";
+        }
+        else {
+            script = collection + ".find(" + json(shape->filter) + ")";
+            if (!shape->sort.isEmpty())
+                script += ".sort(" + json(shape->sort) + ")";
+            script += ".explain('executionStats')";
+        }
+
+        AppRegistry::instance().app()->openShell(_database, QtUtils::toQString(script), true,
+                                                 QtUtils::toQString(collectionName(shape->ns)));
+    }
+
+    void OperationsMonitorDialog::createIndexSelected()
+    {
+        const OperationShape *shape = selectedShape();
+        if (!shape)
+            return;
+
+        mongo::BSONObj const keys = OperationShapeTable::suggestIndex(shape->filter, shape->sort);
+        if (keys.isEmpty())
+            return;
+
+        // Not executed: building index on a busy collection is a decision of the user
+        std::string const script = "db.getCollection('" + collectionName(shape->ns) + "').createIndex(" +
+                                   json(keys) + ")";
+        AppRegistry::instance().app()->openShell(_database, QtUtils::toQString(script), false,
+                                                 QtUtils::toQString(collectionName(shape->ns)),
+                                                 CursorPosition(0, -1));
+    }
+
+    void OperationsMonitorDialog::updateButtons()
+    {
+        const OperationShape *shape = selectedShape();
+        _explainButton->setEnabled(shape && shape->ns != _database->name() + ".$cmd");
+        _createIndexButton->setEnabled(shape && !OperationShapeTable::suggestIndex(shape->filter, shape->sort).isEmpty());
+    }
+
+    void OperationsMonitorDialog::refreshTable()
+    {
+        // Keep selection on the same shape, rows are reordered by total time
+        const OperationShape *selected = selectedShape();
+        std::string const selectedKey = selected ? selected->ns + selected->op + selected->shape : std::string();
+
+        _top = _table.top(TopShapes);
+        _shapesTable->setRowCount(static_cast<int>(_top.size()));
+        int selectedRow = -1;
+        for (int row = 0; row < static_cast<int>(_top.size()); ++row) {
+            OperationShape const &shape = _top[row];
+            long long const count = shape.count();
+            mongo::BSONObj const index = OperationShapeTable::suggestIndex(shape.filter, shape.sort);
+
+            QString operation = QtUtils::toQString(shape.op);
+            if (!shape.command.empty() && shape.command != shape.op)
+                operation += QString(" (%1)").arg(QtUtils::toQString(shape.command));
+
+            _shapesTable->setItem(row, NamespaceColumn, cell(QtUtils::toQString(shape.ns)));
+            _shapesTable->setItem(row, OperationColumn, cell(operation));
+            _shapesTable->setItem(row, ShapeColumn, cell(QtUtils::toQString(shape.shape)));
+            _shapesTable->item(row, ShapeColumn)->setToolTip(QtUtils::toQString(shape.shape));
+            _shapesTable->setItem(row, CountColumn, cell(QString::number(count), true));
+            _shapesTable->setItem(row, TotalColumn, cell(milliseconds(shape.totalMicros()), true));
+            _shapesTable->setItem(row, AverageColumn,
+                                  cell(milliseconds(count > 0 ? double(shape.totalMicros()) / count : 0), true));
+            _shapesTable->setItem(row, MaxColumn, cell(milliseconds(shape.maxMicros), true));
+            _shapesTable->setItem(row, ExaminedColumn, cell(shape.profiledCount > 0
+                ? QString("%1 / %2").arg(shape.docsExamined).arg(shape.returned) : QString(), true));
+            _shapesTable->setItem(row, PlanColumn, cell(QtUtils::toQString(shape.planSummary)));
+            _shapesTable->setItem(row, IndexColumn,
+                                  cell(shape.isInefficient() && !index.isEmpty() ? QtUtils::toQString(json(index))
+                                                                                 : QString()));
+
+            if (shape.ns + shape.op + shape.shape == selectedKey)
+                selectedRow = row;
+        }
+
+        if (selectedRow >= 0)
+            _shapesTable->selectRow(selectedRow);
+        else
+            _shapesTable->clearSelection();
+        updateButtons();
+    }
+
+    const OperationShape *OperationsMonitorDialog::selectedShape() const
+    {
+        QList<QTableWidgetItem *> const items = _shapesTable->selectedItems();
+        if (items.isEmpty())
+            return nullptr;
+
+        int const row = items.front()->row();
+        return row < static_cast<int>(_top.size()) ? &_top[row] : nullptr;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+
+#include <QDialog>
+
+#include "robomongo/core/domain/OperationShapes.h"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QSpinBox;
+class QTableWidget;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoDatabase;
+    class SampleOperationsResponse;
+
+    /**
+     * @brief Samples "currentOp" and "system.profile" of database on interval,
+     *        aggregates operations by query shape and shows the most expensive
+     *        shapes, with explain and suggested index of each.
+     */
+    class OperationsMonitorDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        static const int TopShapes = 50;
+        static const int DefaultIntervalSec = 5;
+
+        explicit OperationsMonitorDialog(MongoDatabase *database, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        void handle(SampleOperationsResponse *event);
+        void done(int result) override;
+
+    private Q_SLOTS:
+        void sample();
+        void setPaused(bool paused);
+        void clear();
+        void explainSelected();
+        void createIndexSelected();
+        void updateButtons();
+        void workerDestroyed();
+
+    private:
+        void refreshTable();
+        const OperationShape *selectedShape() const;
+
+        MongoDatabase *const _database;
+        OperationShapeTable _table;
+        std::vector<OperationShape> _top;
+
+        // Profile entries before this time (milliseconds since epoch) and
+        // _profileSeenEntries of this time are already sampled
+        long long _profileSinceMillis;
+        std::vector<mongo::BSONObj> _profileSeenEntries;
+        bool _sampling;
+        // Worker replies to this dialog, so it is not deleted on close until
+        // pending sample comes back, or worker is gone
+        bool _closed;
+        bool _disconnected;
+
+        QSpinBox *_intervalBox;
+        QPushButton *_pauseButton;
+        QPushButton *_explainButton;
+        QPushButton *_createIndexButton;
+        QLabel *_statusLabel;
+        QTableWidget *_shapesTable;
+        QTimer *_timer;
+    };
+}
@@ -7,7 +7,6 @@
 #include <QCheckBox>
 #include <QToolButton>
 #include <Qsci/qsciscintilla.h>
-#include <QMessageBox>
 #include <QKeyEvent>
 
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
@@ -60,6 +59,7 @@ namespace Robomongo
         VERIFY(connect(_close, SIGNAL(clicked()), _findPanel, SLOT(hide())));
         VERIFY(connect(_next, SIGNAL(clicked()), this, SLOT(goToNextElement())));
         VERIFY(connect(_prev, SIGNAL(clicked()), this, SLOT(goToPrevElement())));
+        VERIFY(connect(_findLine, SIGNAL(textChanged(const QString&)), this, SLOT(clearNotFound())));
     }
 
     void FindFrame::wheelEvent(QWheelEvent *e)
@@ -125,11 +125,16 @@ namespace Robomongo
             if (isFounded) {
                 _scin->ensureCursorVisible(); 
             }
-            else {
-                QMessageBox::warning(this, tr("Search"), tr("The specified text was not found."));
-            }            
+
+            // Not modal, so that search text can be corrected right away
+            _findLine->setStyleSheet(isFounded ? "" : "QLineEdit { background-color: #FFC7C7; }");
         }
     }
+
+    void FindFrame::clearNotFound()
+    {
+        _findLine->setStyleSheet("");
+    }
     
     void FindFrame::toggleComments()
     {
@@ -38,6 +38,7 @@ namespace Robomongo
     private Q_SLOTS:
         void goToNextElement();
         void goToPrevElement();
+        void clearNotFound();
 
     private:
         void findElement(bool forward);
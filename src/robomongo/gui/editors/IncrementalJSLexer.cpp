@@ -0,0 +1,235 @@
+#include "robomongo/gui/editors/IncrementalJSLexer.h"
+
+#include <algorithm>
+
+#include <Qsci/qsciscintilla.h>
+
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/editors/JSLexer.h"
+
+namespace
+{
+    // Start of 'line', or length of text if it is past the last line
+    int positionFromLine(QsciScintilla *editor, int line)
+    {
+        int const pos = editor->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE, line);
+        return pos < 0 ? editor->SendScintilla(QsciScintillaBase::SCI_GETLENGTH) : pos;
+    }
+
+    QByteArray textRange(QsciScintilla *editor, int start, int end)
+    {
+        // Scintilla appends terminating zero
+        QByteArray text(end - start + 1, 0);
+        editor->SendScintilla(QsciScintillaBase::SCI_GETTEXTRANGE, start, end, text.data());
+        text.resize(end - start);
+        return text;
+    }
+}
+
+namespace Robomongo
+{
+    JSRelexThread::JSRelexThread(const JSLineLexer &lexer, const QByteArray &text, int state, QObject *parent) :
+        QThread(parent),
+        _lexer(lexer),
+        _text(text),
+        _state(state),
+        _stop(false),
+        _completed(false)
+    {
+    }
+
+    void JSRelexThread::run()
+    {
+        _styles.resize(_text.size());
+        _completed = _lexer.lex(_text.constData(), _text.size(), _state, _styles.data(), _lineStates, &_stop);
+    }
+
+    IncrementalJSLexer::IncrementalJSLexer(QObject *parent) :
+        QsciLexerCustom(parent),
+        _colors(new JSLexer(this)),
+        _lineLexer(_colors->keywords(1)),
+        _threadStart(0),
+        _threadFirstLine(0),
+        _threadRevision(0),
+        _revision(0)
+    {
+    }
+
+    IncrementalJSLexer::~IncrementalJSLexer()
+    {
+        stopBackgroundLex();
+    }
+
+    const char *IncrementalJSLexer::language() const
+    {
+        return "JavaScript";
+    }
+
+    QString IncrementalJSLexer::description(int style) const
+    {
+        // Styles without description are not configured (i.e. by setFont())
+        switch (style) {
+        case JSLineLexer::Default: return "Default";
+        case JSLineLexer::Comment: return "Comment";
+        case JSLineLexer::CommentLine: return "Line comment";
+        case JSLineLexer::Number: return "Number";
+        case JSLineLexer::Keyword: return "Keyword";
+        case JSLineLexer::DoubleQuotedString: return "Double-quoted string";
+        case JSLineLexer::SingleQuotedString: return "Single-quoted string";
+        case JSLineLexer::Operator: return "Operator";
+        case JSLineLexer::Identifier: return "Identifier";
+        case JSLineLexer::UnclosedString: return "Unclosed string";
+        case JSLineLexer::Regex: return "Regular expression";
+        case JSLineLexer::TemplateString: return "Template string";
+        }
+        return QString();
+    }
+
+    QColor IncrementalJSLexer::defaultColor(int style) const
+    {
+        return _colors->defaultColor(style);
+    }
+
+    QColor IncrementalJSLexer::defaultPaper(int style) const
+    {
+        return _colors->defaultPaper(style);
+    }
+
+    const char *IncrementalJSLexer::keywords(int set) const
+    {
+        return _colors->keywords(set);
+    }
+
+    void IncrementalJSLexer::setEditor(QsciScintilla *newEditor)
+    {
+        stopBackgroundLex();
+        if (editor())
+            disconnect(editor(), SIGNAL(textChanged()), this, SLOT(onTextChanged()));
+
+        QsciLexerCustom::setEditor(newEditor);
+
+        if (editor())
+            VERIFY(connect(editor(), SIGNAL(textChanged()), this, SLOT(onTextChanged())));
+    }
+
+    void IncrementalJSLexer::onTextChanged()
+    {
+        ++_revision;
+    }
+
+    int IncrementalJSLexer::lineState(int line) const
+    {
+        if (line < 0)
+            return JSLineLexer::InCode;
+
+        return editor()->SendScintilla(QsciScintillaBase::SCI_GETLINESTATE, line);
+    }
+
+    void IncrementalJSLexer::styleText(int start, int end)
+    {
+        QsciScintilla *const ed = editor();
+        if (!ed || end <= start)
+            return;
+
+        // Scintilla always asks from start of the first line, which is not styled yet
+        int const firstLine = ed->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, start);
+        int const lastLine = ed->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, end - 1);
+        if (lastLine - firstLine < BackgroundLexLines) {
+            styleLines(firstLine, lastLine);
+            return;
+        }
+
+        // Visible lines are styled now, starting with state they had before change (which is
+        // most likely right), the rest stays unstyled until background lexing is done
+        int const topLine = ed->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE,
+                                              ed->SendScintilla(QsciScintillaBase::SCI_GETFIRSTVISIBLELINE));
+        int const firstVisible = std::min(std::max(firstLine, topLine), lastLine);
+        int const lastVisible = std::min(lastLine,
+            firstVisible + static_cast<int>(ed->SendScintilla(QsciScintillaBase::SCI_LINESONSCREEN)));
+
+        int const visibleStart = positionFromLine(ed, firstVisible);
+        int const visibleEnd = positionFromLine(ed, lastVisible + 1);
+        startStyling(start);
+        setStyling(visibleStart - start, JSLineLexer::Default);
+        styleLines(firstVisible, lastVisible);
+        if (visibleEnd < end) {
+            startStyling(visibleEnd);
+            setStyling(end - visibleEnd, JSLineLexer::Default);
+        }
+
+        startBackgroundLex(firstLine);
+    }
+
+    void IncrementalJSLexer::styleLines(int first, int last)
+    {
+        QsciScintilla *const ed = editor();
+        int const start = positionFromLine(ed, first);
+        int const end = positionFromLine(ed, last + 1);
+        if (end <= start)
+            return;
+
+        QByteArray const text = textRange(ed, start, end);
+        QByteArray styles(text.size(), 0);
+        std::vector<int> states;
+        _lineLexer.lex(text.constData(), text.size(), lineState(first - 1), styles.data(), states);
+
+        startStyling(start);
+        ed->SendScintilla(QsciScintillaBase::SCI_SETSTYLINGEX, static_cast<unsigned long>(styles.size()), styles.constData());
+        for (size_t i = 0; i < states.size(); ++i)
+            ed->SendScintilla(QsciScintillaBase::SCI_SETLINESTATE, static_cast<unsigned long>(first + i),
+                              static_cast<long>(states[i]));
+    }
+
+    void IncrementalJSLexer::startBackgroundLex(int firstLine)
+    {
+        stopBackgroundLex();
+
+        QsciScintilla *const ed = editor();
+        _threadStart = positionFromLine(ed, firstLine);
+        _threadFirstLine = firstLine;
+        _threadRevision = _revision;
+
+        QByteArray const text = textRange(ed, _threadStart, ed->SendScintilla(QsciScintillaBase::SCI_GETLENGTH));
+        _thread = new JSRelexThread(_lineLexer, text, lineState(firstLine - 1));
+        VERIFY(connect(_thread, SIGNAL(finished()), this, SLOT(applyBackgroundLex())));
+        VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
+        _thread->start(QThread::LowPriority);
+    }
+
+    void IncrementalJSLexer::stopBackgroundLex()
+    {
+        if (!_thread)
+            return;
+
+        disconnect(_thread, SIGNAL(finished()), this, SLOT(applyBackgroundLex()));
+        _thread->stop();
+        _thread = nullptr;
+    }
+
+    void IncrementalJSLexer::applyBackgroundLex()
+    {
+        JSRelexThread *thread = qobject_cast<JSRelexThread *>(sender());
+        QsciScintilla *const ed = editor();
+        if (!thread || thread != _thread || !ed)
+            return;
+
+        _thread = nullptr;
+        if (!thread->completed())
+            return;
+
+        if (_threadRevision != _revision) {
+            // Text changed while lexing, style everything from the same line again
+            ed->recolor(std::min(_threadStart, static_cast<int>(ed->SendScintilla(QsciScintillaBase::SCI_GETLENGTH))));
+            return;
+        }
+
+        QByteArray const& styles = thread->styles();
+        startStyling(_threadStart);
+        ed->SendScintilla(QsciScintillaBase::SCI_SETSTYLINGEX, static_cast<unsigned long>(styles.size()), styles.constData());
+
+        std::vector<int> const& states = thread->lineStates();
+        for (size_t i = 0; i < states.size(); ++i)
+            ed->SendScintilla(QsciScintillaBase::SCI_SETLINESTATE, static_cast<unsigned long>(_threadFirstLine + i),
+                              static_cast<long>(states[i]));
+    }
+}
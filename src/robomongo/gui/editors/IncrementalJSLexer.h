@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+
+#include <QPointer>
+#include <QThread>
+#include <Qsci/qscilexercustom.h>
+
+#include "robomongo/gui/editors/JSLineLexer.h"
+
+namespace Robomongo
+{
+    class JSLexer;
+
+    /**
+     * @brief Lexes text of an editor in background (see IncrementalJSLexer).
+     *        Deletes itself when finished.
+     */
+    class JSRelexThread : public QThread
+    {
+        Q_OBJECT
+
+    public:
+        JSRelexThread(const JSLineLexer &lexer, const QByteArray &text, int state, QObject *parent = nullptr);
+
+        void stop() { _stop = true; }
+
+        const QByteArray &styles() const { return _styles; }
+        const std::vector<int> &lineStates() const { return _lineStates; }
+        bool completed() const { return _completed; }
+
+    protected:
+        void run() override;
+
+    private:
+        const JSLineLexer _lexer;   // Copy, thread may outlive the lexer after stop()
+        const QByteArray _text;
+        const int _state;
+        QByteArray _styles;
+        std::vector<int> _lineStates;
+        volatile bool _stop;
+        bool _completed;
+    };
+
+    /**
+     * @brief JavaScript lexer of script editor, with colors of JSLexer, which
+     *        stays responsive in scripts of tens of thousands of lines.
+     *
+     *        Scintilla asks to style only from the first modified line to the
+     *        end of what is visible. State of JSLineLexer at the end of each
+     *        line is kept as Scintilla line state, so lexing starts right at
+     *        the modified line. Ranges longer than BackgroundLexLines (i.e. a
+     *        pasted script, or jump to its end) are styled immediately only
+     *        where visible, while the whole rest is lexed in JSRelexThread and
+     *        applied at once, if the text did not change in the meantime.
+     */
+    class IncrementalJSLexer : public QsciLexerCustom
+    {
+        Q_OBJECT
+
+    public:
+        static const int BackgroundLexLines = 5000;
+
+        explicit IncrementalJSLexer(QObject *parent = nullptr);
+        ~IncrementalJSLexer();
+
+        const char *language() const override;
+        QString description(int style) const override;
+        QColor defaultColor(int style) const override;
+        QColor defaultPaper(int style) const override;
+        const char *keywords(int set) const override;
+
+        void setEditor(QsciScintilla *editor) override;
+        void styleText(int start, int end) override;
+
+    private Q_SLOTS:
+        void onTextChanged();
+        void applyBackgroundLex();
+
+    private:
+        // Styles lines [first, last] synchronously
+        void styleLines(int first, int last);
+        void startBackgroundLex(int firstLine);
+        void stopBackgroundLex();
+
+        // State at the end of 'line', InCode before the first line
+        int lineState(int line) const;
+
+        JSLexer *const _colors;
+        const JSLineLexer _lineLexer;
+        QPointer<JSRelexThread> _thread;
+        int _threadStart;           // Position, from which text is lexed by _thread
+        int _threadFirstLine;
+        quint64 _threadRevision;
+        quint64 _revision;          // Incremented on every change of text
+    };
+}
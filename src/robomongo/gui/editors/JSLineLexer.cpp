@@ -0,0 +1,209 @@
+#include "robomongo/gui/editors/JSLineLexer.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+    bool isIdentifierStart(unsigned char ch)
+    {
+        // Non-ASCII bytes are parts of UTF-8 letters
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_' || ch == '$' || ch >= 0x80;
+    }
+
+    bool isDigit(unsigned char ch)
+    {
+        return ch >= '0' && ch <= '9';
+    }
+
+    bool isIdentifierChar(unsigned char ch)
+    {
+        return isIdentifierStart(ch) || isDigit(ch);
+    }
+
+    bool isEndOfLine(char ch)
+    {
+        return ch == '\n' || ch == '\r';
+    }
+
+    // Position after closing 'quote' or -1 if not closed on this line
+    int skipQuoted(const char *line, int pos, int length, char quote, bool multiLine)
+    {
+        while (pos < length) {
+            char const ch = line[pos];
+            if (ch == '\\') {
+                pos += 2;
+                continue;
+            }
+            if (ch == quote)
+                return pos + 1;
+            if (!multiLine && isEndOfLine(ch))
+                return -1;
+            ++pos;
+        }
+        return -1;
+    }
+
+    // Position after "*/" or -1 if comment is not closed on this line
+    int skipBlockComment(const char *line, int pos, int length)
+    {
+        for (; pos + 1 < length; ++pos) {
+            if (line[pos] == '*' && line[pos + 1] == '/')
+                return pos + 2;
+        }
+        return -1;
+    }
+
+    // Position after regex literal with flags, or -1 if it is not one
+    int skipRegex(const char *line, int pos, int length)
+    {
+        bool inClass = false;
+        for (++pos; pos < length && !isEndOfLine(line[pos]); ++pos) {
+            char const ch = line[pos];
+            if (ch == '\\')
+                ++pos;
+            else if (ch == '[')
+                inClass = true;
+            else if (ch == ']')
+                inClass = false;
+            else if (ch == '/' && !inClass) {
+                for (++pos; pos < length && isIdentifierChar(line[pos]); ++pos) {}
+                return pos;
+            }
+        }
+        return -1;
+    }
+}
+
+namespace Robomongo
+{
+    JSLineLexer::JSLineLexer(const char *keywords)
+    {
+        std::istringstream stream(keywords ? keywords : "");
+        std::string keyword;
+        while (stream >> keyword)
+            _keywords.insert(keyword);
+    }
+
+    bool JSLineLexer::isKeyword(const char *word, int length) const
+    {
+        return _keywords.count(std::string(word, length)) > 0;
+    }
+
+    bool JSLineLexer::allowsRegex(const char *word, int length) const
+    {
+        static std::unordered_set<std::string> const before = {
+            "return", "typeof", "instanceof", "in", "of", "new", "delete", "void",
+            "throw", "case", "do", "else"
+        };
+        return before.count(std::string(word, length)) > 0;
+    }
+
+    int JSLineLexer::lexLine(const char *line, int length, int state, char *styles) const
+    {
+        int pos = 0;
+        if (state == InBlockComment || state == InTemplateString) {
+            int const end = state == InBlockComment ? skipBlockComment(line, 0, length)
+                                                    : skipQuoted(line, 0, length, '`', true);
+            if (end < 0) {
+                std::memset(styles, state == InBlockComment ? Comment : TemplateString, length);
+                return state;
+            }
+            std::memset(styles, state == InBlockComment ? Comment : TemplateString, end);
+            pos = end;
+        }
+
+        bool regexAllowed = true;
+        while (pos < length) {
+            int const start = pos;
+            unsigned char const ch = line[pos];
+            char const next = pos + 1 < length ? line[pos + 1] : 0;
+            int style = Default;
+
+            if (ch == '/' && next == '*') {
+                int const end = skipBlockComment(line, pos + 2, length);
+                if (end < 0) {
+                    std::memset(styles + start, Comment, length - start);
+                    return InBlockComment;
+                }
+                pos = end;
+                style = Comment;
+            }
+            else if (ch == '/' && next == '/') {
+                pos = length;
+                style = CommentLine;
+            }
+            else if (ch == '`') {
+                int const end = skipQuoted(line, pos + 1, length, '`', true);
+                if (end < 0) {
+                    std::memset(styles + start, TemplateString, length - start);
+                    return InTemplateString;
+                }
+                pos = end;
+                style = TemplateString;
+            }
+            else if (ch == '"' || ch == '\'') {
+                int end = skipQuoted(line, pos + 1, length, ch, false);
+                style = ch == '"' ? DoubleQuotedString : SingleQuotedString;
+                if (end < 0) {
+                    for (end = pos + 1; end < length && !isEndOfLine(line[end]); ++end) {}
+                    style = UnclosedString;
+                }
+                pos = end;
+            }
+            else if (isDigit(ch) || (ch == '.' && isDigit(next))) {
+                for (++pos; pos < length; ++pos) {
+                    unsigned char const c = line[pos];
+                    bool const exponentSign = (c == '+' || c == '-') && (line[pos - 1] == 'e' || line[pos - 1] == 'E')
+                                              && !(line[start] == '0' && (line[start + 1] == 'x' || line[start + 1] == 'X'));
+                    if (!isIdentifierChar(c) && c != '.' && !exponentSign)
+                        break;
+                }
+                style = Number;
+            }
+            else if (isIdentifierStart(ch)) {
+                for (++pos; pos < length && isIdentifierChar(line[pos]); ++pos) {}
+                style = isKeyword(line + start, pos - start) ? Keyword : Identifier;
+            }
+            else if (ch == '/' && regexAllowed && skipRegex(line, pos, length) > 0) {
+                pos = skipRegex(line, pos, length);
+                style = Regex;
+            }
+            else if (std::strchr("{}[]().,;:?!~%^&*+-=<>|/", ch) && ch) {
+                ++pos;
+                style = Operator;
+            }
+            else {
+                ++pos;
+            }
+
+            std::memset(styles + start, style, pos - start);
+
+            // Slash after a value is division, after an operator or some keywords it starts regex
+            if (style == Operator)
+                regexAllowed = !std::strchr(")]}", ch);
+            else if (style == Identifier || style == Keyword)
+                regexAllowed = allowsRegex(line + start, pos - start);
+            else if (style != Default && style != Comment)
+                regexAllowed = false;
+        }
+        return InCode;
+    }
+
+    bool JSLineLexer::lex(const char *text, int length, int state, char *styles,
+                          std::vector<int> &lineStates, const volatile bool *cancel) const
+    {
+        int pos = 0;
+        while (pos < length) {
+            if (cancel && *cancel)
+                return false;
+
+            const char *const newLine = static_cast<const char *>(std::memchr(text + pos, '\n', length - pos));
+            int const end = newLine ? static_cast<int>(newLine - text) + 1 : length;
+            state = lexLine(text + pos, end - pos, state, styles + pos);
+            lineStates.push_back(state);
+            pos = end;
+        }
+        return true;
+    }
+}
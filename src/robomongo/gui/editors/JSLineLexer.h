@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief JavaScript lexer working line by line, with the state carried from
+     *        one line to the next reduced to a single int. Used by
+     *        IncrementalJSLexer, which keeps this state per line of editor as a
+     *        checkpoint, so that any line can be lexed without lexing lines
+     *        above it. Has no dependencies on Qt, lexes UTF-8 bytes.
+     */
+    class JSLineLexer
+    {
+    public:
+        // Same numbers as styles of QsciLexerJavaScript, so that colors of JSLexer apply
+        enum Style
+        {
+            Default = 0,
+            Comment = 1,
+            CommentLine = 2,
+            Number = 4,
+            Keyword = 5,
+            DoubleQuotedString = 6,
+            SingleQuotedString = 7,
+            Operator = 10,
+            Identifier = 11,
+            UnclosedString = 12,
+            Regex = 14,
+            TemplateString = 20     // RawString
+        };
+
+        // State at the end of line
+        enum State
+        {
+            InCode = 0,
+            InBlockComment = 1,
+            InTemplateString = 2
+        };
+
+        // Space separated list of keywords, i.e. JSLexer::keywords(1)
+        explicit JSLineLexer(const char *keywords);
+
+        /**
+         * @brief Lexes one line, including end of line characters.
+         * @param styles: receives one style per byte of line
+         * @return state at the end of line
+         */
+        int lexLine(const char *line, int length, int state, char *styles) const;
+
+        /**
+         * @brief Lexes whole lines of 'text' starting in 'state'. States at the end
+         *        of each line are appended to 'lineStates'. Stops early (with
+         *        'styles' partially filled) when 'cancel' becomes true.
+         * @return false if cancelled
+         */
+        bool lex(const char *text, int length, int state, char *styles,
+                 std::vector<int> &lineStates, const volatile bool *cancel = nullptr) const;
+
+    private:
+        bool isKeyword(const char *word, int length) const;
+        bool allowsRegex(const char *word, int length) const;
+
+        std::unordered_set<std::string> _keywords;
+    };
+}
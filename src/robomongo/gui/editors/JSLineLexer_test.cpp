@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "JSLineLexer.h"
+
+#include <chrono>
+#include <cstring>
+
+using namespace Robomongo;
+
+namespace
+{
+    JSLineLexer const lexer("var return true ObjectId");
+
+    // One letter per byte: style of it
+    std::string styles(const std::string &line, int state = JSLineLexer::InCode, int *endState = nullptr)
+    {
+        std::string result(line.size(), 0);
+        int const end = lexer.lexLine(line.data(), static_cast<int>(line.size()), state, &result[0]);
+        if (endState)
+            *endState = end;
+
+        for (char &ch : result) {
+            switch (ch) {
+            case JSLineLexer::Comment: case JSLineLexer::CommentLine: ch = 'c'; break;
+            case JSLineLexer::Number: ch = 'n'; break;
+            case JSLineLexer::Keyword: ch = 'k'; break;
+            case JSLineLexer::DoubleQuotedString: case JSLineLexer::SingleQuotedString: ch = 's'; break;
+            case JSLineLexer::Operator: ch = 'o'; break;
+            case JSLineLexer::Identifier: ch = 'i'; break;
+            case JSLineLexer::UnclosedString: ch = 'u'; break;
+            case JSLineLexer::Regex: ch = 'r'; break;
+            case JSLineLexer::TemplateString: ch = 't'; break;
+            default: ch = ' ';
+            }
+        }
+        return result;
+    }
+
+    std::string script(int lines)
+    {
+        std::string result;
+        for (int i = 0; i < lines; ++i) {
+            result += "db.items.update({ _id: ObjectId(\"5a0000000000000000000001\") }, "
+                      "{ $set: { n: " + std::to_string(i) + ", s: 'text' } }); // fix\n";
+        }
+        return result;
+    }
+}
+
+TEST(js_line_lexer_tests, tokens)
+{
+    EXPECT_EQ("kkk i o sssss o sss o cccc", styles("var x = \"a\\\"\" + 'b' ; // c"));
+    EXPECT_EQ("i o i o n o i", styles("a = b / 2 / c"));
+    EXPECT_EQ("kkkkkk rrrrrrrrroiiiio", styles("return /a[/]b/gi.test;"));
+    EXPECT_EQ("nnnnnn o nnnn", styles("1.5e-3 + 0x1F"));
+    EXPECT_EQ("i o uuuu", styles("s = \"abc"));
+}
+
+TEST(js_line_lexer_tests, state_spans_lines)
+{
+    int state = -1;
+    EXPECT_EQ("i cccccc", styles("a /* b \n", JSLineLexer::InCode, &state));
+    EXPECT_EQ(JSLineLexer::InBlockComment, state);
+
+    EXPECT_EQ("cccc i", styles("b */ c", state, &state));
+    EXPECT_EQ(JSLineLexer::InCode, state);
+
+    EXPECT_EQ("i o tttt", styles("s = `abc", JSLineLexer::InCode, &state));
+    EXPECT_EQ(JSLineLexer::InTemplateString, state);
+    EXPECT_EQ("tttto", styles("def`;", state, &state));
+    EXPECT_EQ(JSLineLexer::InCode, state);
+}
+
+TEST(js_line_lexer_tests, keystroke_relexes_one_line)
+{
+    // Large data-fix script, lexed once in full, as background lexing does
+    int const lineCount = 50000;
+    std::string text = script(lineCount);
+    std::string styleBytes(text.size(), 0);
+    std::vector<int> lineStates;
+
+    auto const start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(lexer.lex(text.data(), static_cast<int>(text.size()), JSLineLexer::InCode, &styleBytes[0], lineStates));
+    auto const lexed = std::chrono::steady_clock::now();
+    ASSERT_EQ(static_cast<size_t>(lineCount), lineStates.size());
+
+    // Typing in the middle: only the edited line is lexed again, starting from
+    // state of the line above, and lexing stops as its end state is unchanged
+    size_t lineStart = 0;
+    for (int i = 0; i < lineCount / 2; ++i)
+        lineStart = text.find('\n', lineStart) + 1;
+
+    text.insert(lineStart + 3, "x");
+    size_t const lineEnd = text.find('\n', lineStart) + 1;
+    std::string lineStyles(lineEnd - lineStart, 0);
+
+    auto const typed = std::chrono::steady_clock::now();
+    int const state = lexer.lexLine(text.data() + lineStart, static_cast<int>(lineStyles.size()),
+                                    lineStates[lineCount / 2 - 1], &lineStyles[0]);
+    auto const relexed = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(lineStates[lineCount / 2], state);
+
+    using std::chrono::microseconds;
+    RecordProperty("fullLexUs", static_cast<int>(std::chrono::duration_cast<microseconds>(lexed - start).count()));
+    RecordProperty("keystrokeLexUs", static_cast<int>(std::chrono::duration_cast<microseconds>(relexed - typed).count()));
+}
+
+TEST(js_line_lexer_tests, cancel)
+{
+    std::string const text = script(100);
+    std::string styleBytes(text.size(), 0);
+    std::vector<int> lineStates;
+    volatile bool cancel = true;
+    EXPECT_FALSE(lexer.lex(text.data(), static_cast<int>(text.size()), JSLineLexer::InCode, &styleBytes[0],
+                           lineStates, &cancel));
+    EXPECT_TRUE(lineStates.empty());
+}
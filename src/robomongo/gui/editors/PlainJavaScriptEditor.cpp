@@ -55,7 +55,9 @@ namespace Robomongo
         _ignoreEnterKey(false),
         _ignoreTabKey(false),
         _lineNumberDigitWidth(0),
-        _lineNumberMarginWidth(0)
+        _lineNumberMarginWidth(0),
+        _lineNumberDigits(0),
+        _braceMatching(QsciScintilla::NoBraceMatch)
     {
         setAutoIndent(true);
         setIndentationsUseTabs(false);
@@ -90,7 +92,7 @@ namespace Robomongo
 
         setLineNumbers(AppRegistry::instance().settingsManager()->lineNumbers());
         setUtf8(true);
-        VERIFY(connect(this, SIGNAL(linesChanged()), this, SLOT(updateLineNumbersMarginWidth())));
+        VERIFY(connect(this, SIGNAL(linesChanged()), this, SLOT(onLinesChanged())));
     }
 
     int RoboScintilla::lineNumberMarginWidth() const
@@ -172,9 +174,20 @@ namespace Robomongo
         }
     }
 
+    void RoboScintilla::onLinesChanged()
+    {
+        updateLineNumbersMarginWidth();
+        updateBraceMatching();
+    }
+
     void RoboScintilla::updateLineNumbersMarginWidth()
     {
+        // Margin is resized (and editor relayouted) only when number of digits changes
         int numberOfDigits = getNumberOfDigits(lines());
+        if (numberOfDigits == _lineNumberDigits)
+            return;
+
+        _lineNumberDigits = numberOfDigits;
         _lineNumberMarginWidth = numberOfDigits * _lineNumberDigitWidth + rowNumberWidth;
 
         // If line numbers margin already displayed, update its width
@@ -189,10 +202,18 @@ namespace Robomongo
         // will blink when you move cursor to some brace or
         // when inside braces. This behaviour is not fully fixed
         // in QScintilla 2.9.1 and 2.8.4
-        setBraceMatching(QsciScintilla::NoBraceMatch);
+        _braceMatching = QsciScintilla::NoBraceMatch;
 #else
-        setBraceMatching(QsciScintilla::StrictBraceMatch);
+        _braceMatching = QsciScintilla::StrictBraceMatch;
 #endif
+        updateBraceMatching();
+    }
+
+    void RoboScintilla::updateBraceMatching()
+    {
+        BraceMatch const mode = lines() > braceMatchingMaxLines ? QsciScintilla::NoBraceMatch : _braceMatching;
+        if (mode != braceMatching())
+            setBraceMatching(mode);
     }
 
 
@@ -10,6 +10,9 @@ namespace Robomongo
     public:
         typedef QsciScintilla BaseClass;
         enum { rowNumberWidth = 6, indentationWidth = 4 };
+
+        // Brace matching scans the whole text on caret moves, it is off in longer scripts
+        enum { braceMatchingMaxLines = 20000 };
         static const QColor marginsBackgroundColor;
         static const QColor caretForegroundColor;
         static const QColor matchedBraceForegroundColor;
@@ -26,14 +29,18 @@ namespace Robomongo
         void keyPressEvent(QKeyEvent *e);
 
     private Q_SLOTS:
-        void updateLineNumbersMarginWidth();
+        void onLinesChanged();
 
     private:
         void setLineNumbers(bool displayNumbers);
         void toggleLineNumbers();
+        void updateLineNumbersMarginWidth();
+        void updateBraceMatching();
         bool _ignoreEnterKey;
         bool _ignoreTabKey;
         int _lineNumberMarginWidth;
         int _lineNumberDigitWidth;
+        int _lineNumberDigits;
+        BraceMatch _braceMatching;  // Mode, when script is not too long
     };
 }
@@ -1,72 +1,300 @@
 #include "robomongo/gui/widgets/LogWidget.h"
 
 #include <QHBoxLayout>
+#include <QVBoxLayout>
 #include <QScrollBar>
 #include <QMenu>
-#include <QTime>
 #include <QAction>
-#include <QPlainTextEdit>
+#include <QListView>
+#include <QComboBox>
+#include <QClipboard>
+#include <QApplication>
+#include <QColor>
+
+#include <limits>
+#include <algorithm>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
 
+namespace
+{
+    // Uniform log level strings e.g "Error: ", "Info: " etc...
+    QString severityLabel(const mongo::logger::LogSeverity &severity)
+    {
+        auto label = QString::fromStdString(severity.toStringData().toString());
+        if (label.isEmpty())
+            return label;
+
+        label = label.toLower();
+        label[0] = label[0].toUpper();
+        return label + ": ";
+    }
+}
+
 namespace Robomongo
 {
-    LogWidget::LogWidget(QWidget* parent) 
-        : BaseClass(parent), _logTextEdit(new QTextEdit(this))
-    {
-        _logTextEdit->setReadOnly(true);
-        _logTextEdit->setContextMenuPolicy(Qt::CustomContextMenu);
-        VERIFY(connect(_logTextEdit, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(showContextMenu(const QPoint &))));
-        QHBoxLayout *hlayout = new QHBoxLayout;
-        hlayout->setContentsMargins(0, 0, 0, 0);
-        hlayout->addWidget(_logTextEdit);
+    LogModel::LogModel(const LogRing &records, QObject *parent) :
+        QAbstractListModel(parent),
+        _records(records),
+        _first(records.firstSequence()),
+        _end(records.firstSequence())
+    {
+        // Records logged before this model was created
+        sync();
+    }
+
+    int LogModel::rowCount(const QModelIndex &parent) const
+    {
+        return parent.isValid() ? 0 : static_cast<int>(_end - _first);
+    }
+
+    QVariant LogModel::data(const QModelIndex &index, int role) const
+    {
+        quint64 const sequence = _first + index.row();
+        if (!index.isValid() || !_records.contains(sequence))
+            return QVariant();
+
+        LogRecord const& record = _records.at(sequence);
+        switch (role) {
+        case Qt::DisplayRole: {
+            QString text = record.time.toString("h:mm:ss AP") + "\t" + severityLabel(record.severity);
+            if (!record.source.isEmpty())
+                text += "[" + record.source + "] ";
+            text += record.message;
+            if (record.repeats > 1)
+                text += QString("  (x%1)").arg(record.repeats);
+            return text;
+        }
+        case Qt::ToolTipRole:
+            return record.time.toString(Qt::DefaultLocaleLongDate);
+        case Qt::ForegroundRole:
+            if (record.severity == mongo::logger::LogSeverity::Error())
+                return QColor("#CD0000");
+            if (record.severity == mongo::logger::LogSeverity::Log())
+                return QColor("#777777");
+            if (record.severity == mongo::logger::LogSeverity::Warning())
+                return QColor("#CD9800");
+            return QVariant();
+        case SeverityRole:
+            return record.severity.toInt();
+        case SourceRole:
+            return record.source;
+        default:
+            return QVariant();
+        }
+    }
+
+    void LogModel::sync()
+    {
+        quint64 const first = _records.firstSequence();
+        quint64 const end = _records.endSequence();
+
+        // Evicted (or cleared) records are always at the top
+        if (first > _first) {
+            int const evicted = static_cast<int>(std::min(first, _end) - _first);
+            if (evicted > 0) {
+                beginRemoveRows(QModelIndex(), 0, evicted - 1);
+                _first += evicted;
+                endRemoveRows();
+            }
+            _first = first;
+            _end = std::max(_end, first);
+        }
+
+        if (end > _end) {
+            beginInsertRows(QModelIndex(), rowCount(), rowCount() + static_cast<int>(end - _end) - 1);
+            quint64 const added = _end;
+            _end = end;
+            endInsertRows();
+
+            for (quint64 sequence = added; sequence < end; ++sequence) {
+                QString const& source = _records.at(sequence).source;
+                if (!source.isEmpty() && !_sources.contains(source)) {
+                    _sources.insert(source);
+                    emit sourceAdded(source);
+                }
+            }
+        }
+    }
+
+    void LogModel::update(quint64 sequence)
+    {
+        if (sequence < _first || sequence >= _end)
+            return;
+
+        QModelIndex const changed = index(static_cast<int>(sequence - _first));
+        emit dataChanged(changed, changed);
+    }
+
+    LogFilterModel::LogFilterModel(QObject *parent) :
+        QSortFilterProxyModel(parent),
+        _maxSeverity(std::numeric_limits<int>::max()) {}
+
+    void LogFilterModel::setMaxSeverity(int severity)
+    {
+        _maxSeverity = severity;
+        invalidateFilter();
+    }
+
+    void LogFilterModel::setSource(const QString &source)
+    {
+        _source = source;
+        invalidateFilter();
+    }
+
+    bool LogFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+    {
+        QModelIndex const index = sourceModel()->index(sourceRow, 0, sourceParent);
+        if (index.data(LogModel::SeverityRole).toInt() > _maxSeverity)
+            return false;
+
+        return _source.isNull() || index.data(LogModel::SourceRole).toString() == _source;
+    }
+
+    LogWidget::LogWidget(QWidget* parent)
+        : BaseClass(parent),
+        _model(new LogModel(Logger::instance().records(), this)),
+        _filterModel(new LogFilterModel(this)),
+        _logView(new QListView(this)),
+        _scrolledToBottom(true)
+    {
+        Logger *logger = &Logger::instance();
+        VERIFY(connect(logger, SIGNAL(appended()), _model, SLOT(sync())));
+        VERIFY(connect(logger, SIGNAL(cleared()), _model, SLOT(sync())));
+        VERIFY(connect(logger, SIGNAL(updated(quint64)), _model, SLOT(update(quint64))));
+
+        _filterModel->setSourceModel(_model);
+        _filterModel->setDynamicSortFilter(true);
+
+        _logView->setModel(_filterModel);
+        _logView->setUniformItemSizes(true);
+        _logView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+        _logView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        _logView->setContextMenuPolicy(Qt::CustomContextMenu);
+        VERIFY(connect(_logView, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(showContextMenu(const QPoint &))));
+
+        // Keep following new records only when user did not scroll up
+        VERIFY(connect(_filterModel, SIGNAL(rowsAboutToBeInserted(const QModelIndex&, int, int)), this, SLOT(rememberScrollPosition())));
+        VERIFY(connect(_filterModel, SIGNAL(rowsInserted(const QModelIndex&, int, int)), this, SLOT(restoreScrollPosition())));
+
+        _levelBox = new QComboBox;
+        _levelBox->addItem("All levels", std::numeric_limits<int>::max());
+        _levelBox->addItem("Info", mongo::logger::LogSeverity::Info().toInt());
+        _levelBox->addItem("Warnings", mongo::logger::LogSeverity::Warning().toInt());
+        _levelBox->addItem("Errors", mongo::logger::LogSeverity::Error().toInt());
+        VERIFY(connect(_levelBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onLevelChanged(int))));
+
+        _sourceBox = new QComboBox;
+        _sourceBox->addItem("All sources");
+        _sourceBox->addItem("Application", QString(""));
+        VERIFY(connect(_sourceBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onSourceChanged(int))));
+        VERIFY(connect(_model, SIGNAL(sourceAdded(const QString&)), this, SLOT(addSource(const QString&))));
+        for (quint64 seq = logger->records().firstSequence(); seq < logger->records().endSequence(); ++seq) {
+            QString const& source = logger->records().at(seq).source;
+            if (!source.isEmpty())
+                addSource(source);
+        }
+
+        _copy = new QAction("Copy", this);
+        _copy->setShortcut(QKeySequence::Copy);
+        _copy->setShortcutContext(Qt::WidgetShortcut);
+        _logView->addAction(_copy);
+        VERIFY(connect(_copy, SIGNAL(triggered()), this, SLOT(copySelected())));
+
         _clear = new QAction("Clear All", this);
-        VERIFY(connect(_clear, SIGNAL(triggered()), _logTextEdit, SLOT(clear())));
-        setLayout(hlayout);      
+        VERIFY(connect(_clear, SIGNAL(triggered()), this, SLOT(clear())));
+
+        _writeToFile = new QAction("Write to File", this);
+        _writeToFile->setCheckable(true);
+        _writeToFile->setChecked(logger->fileEnabled());
+        _writeToFile->setToolTip(logger->filePath());
+        VERIFY(connect(_writeToFile, SIGNAL(toggled(bool)), this, SLOT(setFileEnabled(bool))));
+
+        QHBoxLayout *filterLayout = new QHBoxLayout;
+        filterLayout->setContentsMargins(0, 0, 0, 0);
+        filterLayout->addWidget(_levelBox);
+        filterLayout->addWidget(_sourceBox);
+        filterLayout->addStretch(1);
+
+        QVBoxLayout *vlayout = new QVBoxLayout;
+        vlayout->setContentsMargins(0, 0, 0, 0);
+        vlayout->setSpacing(2);
+        vlayout->addLayout(filterLayout);
+        vlayout->addWidget(_logView);
+        setLayout(vlayout);
+
+        _logView->scrollToBottom();
     }
 
     void LogWidget::showContextMenu(const QPoint &pt)
     {
-        QMenu *menu = _logTextEdit->createStandardContextMenu();
-        menu->addAction(_clear);
-        _clear->setEnabled(!_logTextEdit->toPlainText().isEmpty());
+        QMenu menu(this);
+        menu.addAction(_copy);
+        menu.addAction(_clear);
+        menu.addSeparator();
+        menu.addAction(_writeToFile);
+        _copy->setEnabled(_logView->selectionModel()->hasSelection());
+        _clear->setEnabled(_model->rowCount() > 0);
 
-        menu->exec(_logTextEdit->mapToGlobal(pt));
-        delete menu;
+        menu.exec(_logView->viewport()->mapToGlobal(pt));
     }
 
-    void LogWidget::addMessage(const QString &message, mongo::logger::LogSeverity level)
+    void LogWidget::copySelected()
     {
-        // Print time
-        QTime time = QTime::currentTime();
-        _logTextEdit->moveCursor (QTextCursor::End);
-        _logTextEdit->setTextColor(QColor("#aaaaaa"));
-        _logTextEdit->insertPlainText(time.toString("h:mm:ss AP") + "\t");
+        QModelIndexList rows = _logView->selectionModel()->selectedRows();
+        std::sort(rows.begin(), rows.end());
 
-        // Print message
-        _logTextEdit->moveCursor (QTextCursor::End);
+        QStringList lines;
+        for (auto const& index : rows)
+            lines.append(index.data().toString());
 
-        // Nice color for the future: "#CD9800" :)
+        if (!lines.isEmpty())
+            QApplication::clipboard()->setText(lines.join("\n"));
+    }
 
-        QColor textColor = QColor(Qt::black);
+    void LogWidget::clear()
+    {
+        Logger::instance().clear();
+    }
 
-        if (level == mongo::logger::LogSeverity::Error())
-            textColor = QColor("#CD0000");
-        else if (level == mongo::logger::LogSeverity::Log())
-            textColor = QColor("#777777");
-        else if (level == mongo::logger::LogSeverity::Warning())
-            textColor = QColor("#CD9800");
+    void LogWidget::setFileEnabled(bool enabled)
+    {
+        Logger::instance().setFileEnabled(enabled);
 
-        _logTextEdit->setTextColor(textColor);
+        auto const settings = AppRegistry::instance().settingsManager();
+        settings->setLogToFile(enabled);
+        settings->save();
+    }
 
-        const int maxLength = 500;
-        if (message.length() <= maxLength) {
-            _logTextEdit->insertPlainText(message.trimmed() + "\n");
-        } else {
-            _logTextEdit->insertPlainText(QString("(truncated) ") + message.left(maxLength).trimmed() + "...\n");
-        }
+    void LogWidget::onLevelChanged(int index)
+    {
+        _filterModel->setMaxSeverity(_levelBox->itemData(index).toInt());
+    }
+
+    void LogWidget::onSourceChanged(int index)
+    {
+        // Item data of "All sources" is invalid and converts to null string
+        _filterModel->setSource(_sourceBox->itemData(index).toString());
+    }
+
+    void LogWidget::addSource(const QString &source)
+    {
+        if (_sourceBox->findData(source) < 0)
+            _sourceBox->addItem(source, source);
+    }
 
-        // Scroll to the bottom
-        QScrollBar *sb = _logTextEdit->verticalScrollBar();
-        sb->setValue(sb->maximum());
+    void LogWidget::rememberScrollPosition()
+    {
+        QScrollBar *sb = _logView->verticalScrollBar();
+        _scrolledToBottom = sb->value() == sb->maximum();
+    }
+
+    void LogWidget::restoreScrollPosition()
+    {
+        if (_scrolledToBottom)
+            _logView->scrollToBottom();
     }
 }
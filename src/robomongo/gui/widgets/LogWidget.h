@@ -1,32 +1,106 @@
 #pragma once
 
-
 #include <QWidget>
-#include <mongo/logger/log_severity.h>
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QSet>
 QT_BEGIN_NAMESPACE
-class QTextEdit;
+class QListView;
+class QComboBox;
 class QAction;
 QT_END_NAMESPACE
 
 namespace Robomongo
 {
-    class LogWidget : public QWidget
+    class LogRing;
+
+    /**
+     * @brief Exposes records of Logger as list rows. View asks only for rows
+     *        it shows, so rendering cost does not depend on the log size.
+     */
+    class LogModel : public QAbstractListModel
     {
         Q_OBJECT
 
     public:
-        typedef QWidget BaseClass;
-        LogWidget(QWidget* parent = 0);        
+        enum Roles {
+            SeverityRole = Qt::UserRole + 1,    // mongo::logger::LogSeverity::toInt()
+            SourceRole
+        };
+
+        explicit LogModel(const LogRing &records, QObject *parent = 0);
+
+        int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    Q_SIGNALS:
+        void sourceAdded(const QString &source);
 
     public Q_SLOTS:
-        void addMessage(const QString &message, mongo::logger::LogSeverity level);
+        // Reflects appended and evicted records
+        void sync();
+        void update(quint64 sequence);
+
+    private:
+        const LogRing &_records;
+
+        // Sequence numbers of records, currently exposed as rows
+        quint64 _first;
+        quint64 _end;
+
+        QSet<QString> _sources;
+    };
+
+    class LogFilterModel : public QSortFilterProxyModel
+    {
+        Q_OBJECT
+
+    public:
+        explicit LogFilterModel(QObject *parent = 0);
+
+        // Show records with LogSeverity::toInt() not greater than 'severity'
+        void setMaxSeverity(int severity);
+
+        // Null string shows records of all sources
+        void setSource(const QString &source);
+
+    protected:
+        bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+    private:
+        int _maxSeverity;
+        QString _source;
+    };
+
+    class LogWidget : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        typedef QWidget BaseClass;
+        LogWidget(QWidget* parent = 0);
 
     private Q_SLOTS:
         void showContextMenu(const QPoint &pt);
+        void copySelected();
+        void clear();
+        void setFileEnabled(bool enabled);
+        void onLevelChanged(int index);
+        void onSourceChanged(int index);
+        void addSource(const QString &source);
+        void rememberScrollPosition();
+        void restoreScrollPosition();
 
-    private:        
-        QTextEdit *const _logTextEdit;
+    private:
+        LogModel *const _model;
+        LogFilterModel *const _filterModel;
+        QListView *const _logView;
+        QComboBox *_levelBox;
+        QComboBox *_sourceBox;
+        QAction *_copy;
         QAction *_clear;
+        QAction *_writeToFile;
+        bool _scrolledToBottom;
     };
 
 }
@@ -0,0 +1,177 @@
+#include "robomongo/gui/widgets/MetricsWidget.h"
+
+#include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "robomongo/core/domain/ResultMemoryGovernor.h"
+#include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/Metrics.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    using namespace Robomongo;
+
+    enum Columns { ScopeColumn, NameColumn, ValueColumn, RateColumn, P50Column, P95Column, P99Column, MaxColumn };
+
+    QString format(long long value, MetricUnit unit)
+    {
+        switch (unit) {
+        case MetricUnit::Bytes:
+            if (value >= 1024 * 1024)
+                return QString("%1 MB").arg(value / (1024.0 * 1024), 0, 'f', 1);
+            if (value >= 1024)
+                return QString("%1 KB").arg(value / 1024.0, 0, 'f', 1);
+            return QString("%1 B").arg(value);
+        case MetricUnit::Micros:
+            return QString("%1 ms").arg(value / 1000.0, 0, 'f', 2);
+        case MetricUnit::Count:
+            break;
+        }
+        return QString::number(value);
+    }
+
+    QTableWidgetItem *cell(const QString &text, bool number = true)
+    {
+        QTableWidgetItem *item = new QTableWidgetItem(text);
+        if (number)
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    }
+}
+
+namespace Robomongo
+{
+    MetricsWidget::MetricsWidget(QWidget *parent)
+        : BaseClass(parent),
+        _scopeBox(new QComboBox(this)),
+        _table(new QTableWidget(0, MaxColumn + 1, this)),
+        _timer(new QTimer(this))
+    {
+        // Result memory lives in GUI thread, so does the snapshot of this widget
+        MetricsRegistry::instance().addProbe(this, MetricsRegistry::ApplicationScope, "results.memory",
+                                             MetricUnit::Bytes,
+                                             []() { return ResultMemoryGovernor::instance().memoryBytes(); });
+
+        _scopeBox->addItem("All connections");
+        VERIFY(connect(_scopeBox, SIGNAL(currentIndexChanged(int)), this, SLOT(refresh())));
+
+        _table->setHorizontalHeaderLabels({ "Scope", "Metric", "Value", "Rate/s", "p50", "p95", "p99", "Max" });
+        _table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        _table->horizontalHeader()->setStretchLastSection(true);
+        _table->verticalHeader()->hide();
+        _table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        _table->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+        QPushButton *exportButton = new QPushButton("Export Snapshot...", this);
+        VERIFY(connect(exportButton, SIGNAL(clicked()), this, SLOT(exportSnapshot())));
+
+        _timer->setInterval(1000);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(refresh())));
+
+        QHBoxLayout *toolsLayout = new QHBoxLayout;
+        toolsLayout->setContentsMargins(0, 0, 0, 0);
+        toolsLayout->addWidget(_scopeBox);
+        toolsLayout->addStretch(1);
+        toolsLayout->addWidget(exportButton);
+
+        QVBoxLayout *vlayout = new QVBoxLayout;
+        vlayout->setContentsMargins(0, 0, 0, 0);
+        vlayout->setSpacing(2);
+        vlayout->addLayout(toolsLayout);
+        vlayout->addWidget(_table);
+        setLayout(vlayout);
+    }
+
+    MetricsWidget::~MetricsWidget()
+    {
+        MetricsRegistry::instance().removeProbes(this);
+    }
+
+    void MetricsWidget::showEvent(QShowEvent *event)
+    {
+        BaseClass::showEvent(event);
+        refresh();
+        _timer->start();
+    }
+
+    void MetricsWidget::hideEvent(QHideEvent *event)
+    {
+        BaseClass::hideEvent(event);
+        _timer->stop();
+    }
+
+    void MetricsWidget::refresh()
+    {
+        auto const snapshot = MetricsRegistry::instance().snapshot();
+        double const seconds = _sincePrevious.isValid() ? _sincePrevious.restart() / 1000.0 : 0;
+        if (!_sincePrevious.isValid())
+            _sincePrevious.start();
+
+        // Connections come and go, keep the box in sync with scopes of the registry
+        for (auto const &metric : snapshot) {
+            QString const scope = QtUtils::toQString(metric.scope);
+            if (_scopeBox->findData(scope) < 0)
+                _scopeBox->addItem(scope, scope);
+        }
+
+        QString const selected = _scopeBox->currentData().toString();
+        _table->setRowCount(0);
+        for (auto const &metric : snapshot) {
+            auto const key = std::make_pair(metric.scope, metric.name);
+            long long const previous = _previous.count(key) ? _previous[key] : metric.value;
+            if (metric.kind == MetricKind::Counter)
+                _previous[key] = metric.value;
+
+            QString const scope = QtUtils::toQString(metric.scope);
+            if (!selected.isEmpty() && scope != selected)
+                continue;
+
+            int const row = _table->rowCount();
+            _table->insertRow(row);
+            _table->setItem(row, ScopeColumn, cell(scope, false));
+            _table->setItem(row, NameColumn, cell(QtUtils::toQString(metric.name), false));
+
+            if (metric.kind == MetricKind::Histogram) {
+                _table->setItem(row, ValueColumn, cell(QString::number(metric.value)));
+                _table->setItem(row, P50Column, cell(format(metric.p50, metric.unit)));
+                _table->setItem(row, P95Column, cell(format(metric.p95, metric.unit)));
+                _table->setItem(row, P99Column, cell(format(metric.p99, metric.unit)));
+                _table->setItem(row, MaxColumn, cell(format(metric.max, metric.unit)));
+                continue;
+            }
+
+            _table->setItem(row, ValueColumn, cell(format(metric.value, metric.unit)));
+            if (metric.kind == MetricKind::Counter && seconds > 0) {
+                long long const rate = static_cast<long long>((metric.value - previous) / seconds);
+                _table->setItem(row, RateColumn, cell(format(rate, metric.unit)));
+            }
+        }
+    }
+
+    void MetricsWidget::exportSnapshot()
+    {
+        QString const path = QFileDialog::getSaveFileName(this, tr("Export Metrics"), "robo3t-metrics.json",
+                                                          tr("JSON (*.json)"));
+        if (path.isEmpty())
+            return;
+
+        QFile file(path);
+        QByteArray const json = MetricsRegistry::toJson(MetricsRegistry::instance().snapshot());
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) < 0) {
+            QMessageBox::information(this, "Error", QString("Cannot write metrics to %1:\n%2")
+                                     .arg(path).arg(file.errorString()));
+            return;
+        }
+
+        LOG_MSG(QString("Metrics exported to %1").arg(path), mongo::logger::LogSeverity::Info());
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <QElapsedTimer>
+#include <QWidget>
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QTableWidget;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    /**
+     * @brief Live view of MetricsRegistry, one row per metric of the selected
+     *        connection. Refreshed every second while visible; rates of
+     *        counters are derived from the difference of two refreshes.
+     */
+    class MetricsWidget : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        typedef QWidget BaseClass;
+        explicit MetricsWidget(QWidget *parent = 0);
+        ~MetricsWidget();
+
+    protected:
+        void showEvent(QShowEvent *event) override;
+        void hideEvent(QHideEvent *event) override;
+
+    private Q_SLOTS:
+        void refresh();
+        void exportSnapshot();
+
+    private:
+        QComboBox *_scopeBox;
+        QTableWidget *_table;
+        QTimer *_timer;
+
+        // Counter values of the previous refresh, by scope and name
+        std::map<std::pair<std::string, std::string>, long long> _previous;
+        QElapsedTimer _sincePrevious;
+    };
+}
@@ -4,6 +4,7 @@
 #include <QMenu>
 
 #include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoUtils.h"
 #include "robomongo/core/utils/QtUtils.h"
 
 #include "robomongo/gui/GuiRegistry.h"
@@ -29,6 +30,9 @@ namespace Robomongo
 
         setText(0, QtUtils::toQString(_info._name));
         setIcon(0, Robomongo::GuiRegistry::instance().indexIcon());
+        if (_info._sizeBytes >= 0)
+            setToolTip(0, QString("%1 (%2)").arg(QtUtils::toQString(_info._name))
+                                            .arg(MongoUtils::buildNiceSizeString(_info._sizeBytes)));
     }
 
     void ExplorerCollectionIndexItem::ui_dropIndex()
@@ -3,6 +3,7 @@
 #include <QAction>
 #include <QMenu>
 
+#include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/utils/QtUtils.h"
 
@@ -60,8 +61,13 @@ namespace Robomongo
     void ExplorerCollectionIndexesDir::ui_refreshIndex()
     {
         auto const par = dynamic_cast<ExplorerCollectionTreeItem *>(parent());
-        if (par)
-            par->expand();
+        if (!par)
+            return;
+
+        // Explicit refresh asks the server, not the index catalog of the database
+        if (par->databaseItem())
+            par->databaseItem()->database()->invalidateIndexCatalog();
+        par->expand();
     }
 
     void ExplorerCollectionIndexesDir::ui_addIndex()
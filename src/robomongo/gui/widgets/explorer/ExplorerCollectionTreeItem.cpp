@@ -16,6 +16,7 @@
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/domain/MongoCollection.h"
 #include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoUtils.h"
 #include "robomongo/core/domain/App.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/utils/Logger.h"
@@ -25,10 +26,13 @@
 namespace
 {
     const char *tooltipTemplate =
-        "%s "
+        "%1 "
         "<table>"
-        "<tr><td>Count:</td> <td><b>&nbsp;&nbsp;%lld</b></td></tr>"
-        "<tr><td>Size:</td><td><b>&nbsp;&nbsp;%s</b></td></tr>"
+        "<tr><td>Count:</td> <td><b>&nbsp;&nbsp;%2</b></td></tr>"
+        "<tr><td>Size:</td><td><b>&nbsp;&nbsp;%3</b></td></tr>"
+        "<tr><td>Storage Size:</td><td><b>&nbsp;&nbsp;%4</b></td></tr>"
+        "<tr><td>Indexes:</td><td><b>&nbsp;&nbsp;%5</b></td></tr>"
+        "<tr><td>Total Index Size:</td><td><b>&nbsp;&nbsp;%6</b></td></tr>"
         "</table>"
         ;
 }
@@ -109,6 +113,7 @@ namespace Robomongo
 
         setText(0, QtUtils::toQString(_collection->name()));
         setIcon(0, GuiRegistry::instance().collectionIcon());
+        updateToolTip();
 
         _indexDir = new ExplorerCollectionIndexesDir(this);
         addChild(_indexDir);
@@ -212,12 +217,42 @@ namespace Robomongo
         _databaseItem->dropIndexFromCollection(this, QtUtils::toStdString(ind->text(0)));
     }
 
+    void ExplorerCollectionTreeItem::updateToolTip()
+    {
+        setToolTip(0, buildToolTip(_collection));
+    }
+
     QString ExplorerCollectionTreeItem::buildToolTip(MongoCollection *collection)
     {
-        // This function does not used now
-        char buff[2048] = {0};
-//        sprintf(buff,tooltipTemplate,collection->name().c_str(),collection->info().count(),collection->sizeString().c_str());
-        return buff;
+        if (!collection->info().hasStats())
+            return QtUtils::toQString(collection->name());
+
+        return QString(tooltipTemplate).arg(QtUtils::toQString(collection->name()))
+                                       .arg(collection->info().count())
+                                       .arg(QtUtils::toQString(collection->sizeString()))
+                                       .arg(collection->storageSizeString())
+                                       .arg(collection->info().indexCount())
+                                       .arg(MongoUtils::buildNiceSizeString(collection->info().totalIndexSizeBytes()));
+    }
+
+    bool ExplorerCollectionTreeItem::operator<(const QTreeWidgetItem &other) const
+    {
+        auto const otherItem = dynamic_cast<const ExplorerCollectionTreeItem *>(&other);
+        if (!otherItem)
+            return BaseClass::operator<(other);
+
+        MongoCollectionInfo const& l = _collection->info();
+        MongoCollectionInfo const& r = otherItem->collection()->info();
+        switch (_databaseItem->collectionSortOrder()) {
+        case SortCollectionsBySize:  return l.sizeBytes() > r.sizeBytes();
+        case SortCollectionsByCount: return l.count() > r.count();
+        default:                     return l.name() < r.name();
+        }
+    }
+
+    void ExplorerCollectionTreeItem::setIndexCount(int count)
+    {
+        _indexDir->setText(0, detail::buildName("Indexes", count));
     }
 
     void ExplorerCollectionTreeItem::ui_addDocument()
@@ -33,6 +33,22 @@ namespace Robomongo
         void openCurrentCollectionShell(const QString &script, bool execute = true, const CursorPosition &cursor = CursorPosition());
         ExplorerDatabaseTreeItem *const databaseItem() const { return _databaseItem; }
 
+        /**
+         * @brief Shows collection statistics (if loaded) in tooltip
+         */
+        void updateToolTip();
+
+        /**
+         * @brief Shows number of indexes without loading them into "Indexes" folder
+         */
+        void setIndexCount(int count);
+
+        /**
+         * @brief Orders collection items by sort order of the database item,
+         *        see ExplorerDatabaseTreeItem::sortCollections()
+         */
+        bool operator<(const QTreeWidgetItem &other) const override;
+
     public Q_SLOTS:
         void handle(LoadCollectionIndexesResponse *event);
         void handle(AddEditIndexResponse *event);
@@ -1,6 +1,7 @@
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 
 #include <QAction>
+#include <QActionGroup>
 #include <QMenu>
 
 #include "robomongo/gui/dialogs/FunctionTextEditor.h"
@@ -41,8 +42,23 @@ namespace Robomongo
             QAction *refreshCollections = new QAction("Refresh", this);
             VERIFY(connect(refreshCollections, SIGNAL(triggered()), SLOT(ui_refreshCollections())));
 
+            QMenu *sortCollections = new QMenu("Sort Collections By", BaseClass::_contextMenu);
+            QActionGroup *sortGroup = new QActionGroup(this);
+            auto addSortAction = [sortCollections, sortGroup](const QString &text, CollectionSortOrder order) {
+                QAction *action = sortCollections->addAction(text);
+                action->setCheckable(true);
+                action->setChecked(order == SortCollectionsByName);
+                action->setData(order);
+                sortGroup->addAction(action);
+            };
+            addSortAction("Name", SortCollectionsByName);
+            addSortAction("Size", SortCollectionsBySize);
+            addSortAction("Document Count", SortCollectionsByCount);
+            VERIFY(connect(sortGroup, SIGNAL(triggered(QAction*)), SLOT(ui_sortCollections(QAction*))));
+
             BaseClass::_contextMenu->addAction(dbCollectionsStats);
             BaseClass::_contextMenu->addAction(createCollection);
+            BaseClass::_contextMenu->addMenu(sortCollections);
             BaseClass::_contextMenu->addSeparator();
             BaseClass::_contextMenu->addAction(refreshCollections);
         }
@@ -219,6 +235,13 @@ namespace Robomongo
         databaseItem->database()->createFunction(function);
     }
 
+    void ExplorerDatabaseCategoryTreeItem::ui_sortCollections(QAction *action)
+    {
+        ExplorerDatabaseTreeItem *databaseItem = ExplorerDatabaseCategoryTreeItem::databaseItem();
+        if (databaseItem) 
+            databaseItem->sortCollections(static_cast<CollectionSortOrder>(action->data().toInt()));
+    }
+
     void ExplorerDatabaseCategoryTreeItem::ui_refreshCollections()
     {
         ExplorerDatabaseTreeItem *databaseItem = ExplorerDatabaseCategoryTreeItem::databaseItem();
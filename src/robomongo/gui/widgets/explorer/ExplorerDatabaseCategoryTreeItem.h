@@ -2,6 +2,8 @@
 
 #include "robomongo/gui/widgets/explorer/ExplorerTreeItem.h"
 
+class QAction;
+
 namespace Robomongo
 {
     class ExplorerDatabaseTreeItem;
@@ -30,6 +32,7 @@ namespace Robomongo
         void ui_addUser();
         void ui_addFunction();
         void ui_refreshCollections();    
+        void ui_sortCollections(QAction *action);
         void ui_dbCollectionsStatistics();
         void ui_refreshUsers();
         void ui_refreshFunctions();
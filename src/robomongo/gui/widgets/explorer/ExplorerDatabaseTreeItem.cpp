@@ -19,6 +19,7 @@
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerUserTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerFunctionTreeItem.h"
+#include "robomongo/gui/dialogs/OperationsMonitorDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 
 
@@ -48,7 +49,8 @@ namespace Robomongo
         BaseClass(parent),
         _database(database),
         _bus(AppRegistry::instance().bus()),
-        _collectionSystemFolderItem(NULL)
+        _collectionSystemFolderItem(NULL),
+        _collectionSortOrder(SortCollectionsByName)
     {
         auto openDbShellAction = new QAction("Open Shell", this);
 #ifdef __APPLE__
@@ -64,6 +66,9 @@ namespace Robomongo
         QAction *dbCurrOps = new QAction("Current Operations", this);
         VERIFY(connect(dbCurrOps, SIGNAL(triggered()), SLOT(ui_dbCurrentOps())));
 
+        QAction *dbOpsMonitor = new QAction("Operations Monitor...", this);
+        VERIFY(connect(dbOpsMonitor, SIGNAL(triggered()), SLOT(ui_dbOperationsMonitor())));
+
         QAction *dbKillOp = new QAction("Kill Operation...", this);
         VERIFY(connect(dbKillOp, SIGNAL(triggered()), SLOT(ui_dbKillOp())));
 
@@ -82,12 +87,15 @@ namespace Robomongo
         BaseClass::_contextMenu->addAction(dbStats);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbCurrOps);
+        BaseClass::_contextMenu->addAction(dbOpsMonitor);
         BaseClass::_contextMenu->addAction(dbKillOp);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbRepair);
         BaseClass::_contextMenu->addAction(dbDrop);
 
         _bus->subscribe(this, MongoDatabaseCollectionListLoadedEvent::Type, _database);
+        _bus->subscribe(this, MongoDatabaseCollectionStatsLoadedEvent::Type, _database);
+        _bus->subscribe(this, MongoDatabaseIndexCatalogLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseUsersLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseFunctionsLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseCollectionsLoadingEvent::Type, _database);
@@ -123,17 +131,26 @@ namespace Robomongo
 
     void ExplorerDatabaseTreeItem::expandColection(ExplorerCollectionTreeItem *const item)
     {        
-         _bus->send(_database->server()->worker(), new LoadCollectionIndexesRequest(item, item->collection()->info()));
+        // Index catalog of the whole database is usually already loaded, no need to ask server
+        std::vector<IndexInfo> indexes;
+        if (_database->cachedIndexes(item->collection()->name(), indexes)) {
+            _bus->send(item, new LoadCollectionIndexesResponse(_database, indexes));
+            return;
+        }
+
+        _bus->send(_database->server()->worker(), new LoadCollectionIndexesRequest(item, item->collection()->info()));
     }
 
     void ExplorerDatabaseTreeItem::dropIndexFromCollection(ExplorerCollectionTreeItem *const item, const std::string &indexName)
     {
+        _database->invalidateIndexCatalog();
         _bus->send(_database->server()->worker(), new DropCollectionIndexRequest(item, item->collection()->info(), indexName));
     }
 
     void ExplorerDatabaseTreeItem::addEditIndex(
         ExplorerCollectionTreeItem *const item, const IndexInfo &oldInfo, const IndexInfo &newInfo) const
     {
+        _database->invalidateIndexCatalog();
         _bus->send(_database->server()->worker(), new AddEditIndexRequest(item, oldInfo, newInfo));
     }
 
@@ -177,6 +194,81 @@ namespace Robomongo
         }
 
         showCollectionSystemFolderIfNeeded();
+        sortCollectionItems();
+    }
+
+    void ExplorerDatabaseTreeItem::handle(MongoDatabaseCollectionStatsLoadedEvent *event)
+    {
+        for (auto collectionItem : collectionItems())
+            collectionItem->updateToolTip();
+
+        sortCollectionItems();
+    }
+
+    void ExplorerDatabaseTreeItem::handle(MongoDatabaseIndexCatalogLoadedEvent *event)
+    {
+        std::vector<IndexInfo> indexes;
+        for (auto collectionItem : collectionItems()) {
+            if (_database->cachedIndexes(collectionItem->collection()->name(), indexes))
+                collectionItem->setIndexCount(indexes.size());
+        }
+    }
+
+    QList<ExplorerCollectionTreeItem *> ExplorerDatabaseTreeItem::collectionItems() const
+    {
+        QList<ExplorerCollectionTreeItem *> items;
+        for (int i = 0; i < _collectionFolderItem->childCount(); ++i) {
+            auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(_collectionFolderItem->child(i));
+            if (collectionItem)
+                items.append(collectionItem);
+        }
+
+        if (_collectionSystemFolderItem) {
+            for (int i = 0; i < _collectionSystemFolderItem->childCount(); ++i) {
+                auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(_collectionSystemFolderItem->child(i));
+                if (collectionItem)
+                    items.append(collectionItem);
+            }
+        }
+        return items;
+    }
+
+    void ExplorerDatabaseTreeItem::sortCollections(CollectionSortOrder order)
+    {
+        _collectionSortOrder = order;
+        sortCollectionItems();
+
+        if (order != SortCollectionsByName)
+            loadCollectionStats(collectionItems());
+    }
+
+    void ExplorerDatabaseTreeItem::loadCollectionStats(const QList<ExplorerCollectionTreeItem *> &visibleItems)
+    {
+        auto const& items = _collectionSortOrder == SortCollectionsByName ? visibleItems : collectionItems();
+
+        std::vector<std::string> names;
+        for (auto collectionItem : items)
+            names.push_back(collectionItem->collection()->name());
+
+        _database->loadCollectionStats(names);
+    }
+
+    void ExplorerDatabaseTreeItem::sortCollectionItems()
+    {
+        // "System" folder always stays first: it is taken out while collection items
+        // are sorted in place, see ExplorerCollectionTreeItem::operator<
+        int const systemIndex = _collectionFolderItem->indexOfChild(_collectionSystemFolderItem);
+        bool const systemExpanded = systemIndex >= 0 && _collectionSystemFolderItem->isExpanded();
+        if (systemIndex >= 0)
+            _collectionFolderItem->takeChild(systemIndex);
+
+        _collectionFolderItem->sortChildren(0, Qt::AscendingOrder);
+
+        if (systemIndex >= 0) {
+            _collectionFolderItem->insertChild(0, _collectionSystemFolderItem);
+            _collectionSystemFolderItem->setExpanded(systemExpanded);
+            showCollectionSystemFolderIfNeeded();
+        }
     }
 
     void ExplorerDatabaseTreeItem::handle(MongoDatabaseUsersLoadedEvent *event)
@@ -285,6 +377,15 @@ namespace Robomongo
         openCurrentDatabaseShell(_database, "db.currentOp()");
     }
 
+    void ExplorerDatabaseTreeItem::ui_dbOperationsMonitor()
+    {
+        auto dialog = new OperationsMonitorDialog(_database, treeWidget());
+
+        // Database is deleted on disconnect, monitor goes away with it
+        VERIFY(connect(this, SIGNAL(destroyed()), dialog, SLOT(close())));
+        dialog->show();
+    }
+
     void ExplorerDatabaseTreeItem::ui_dbKillOp()
     {
         openCurrentDatabaseShell(_database, "db.killOp()", false, CursorPosition(0, -1));
@@ -13,6 +13,8 @@ namespace Robomongo
     class ExplorerDatabaseCategoryTreeItem;
     class EventBus;
     class MongoDatabaseCollectionListLoadedEvent;
+    class MongoDatabaseCollectionStatsLoadedEvent;
+    class MongoDatabaseIndexCatalogLoadedEvent;
     class MongoDatabaseUsersLoadedEvent;
     class MongoDatabaseFunctionsLoadedEvent;
     class MongoDatabaseCollectionsLoadingEvent;
@@ -24,6 +26,16 @@ namespace Robomongo
     class MongoCollection;
     struct IndexInfo;
 
+    /**
+     * @brief Order of collections inside of "Collections" folder
+     */
+    enum CollectionSortOrder
+    {
+        SortCollectionsByName,
+        SortCollectionsBySize,
+        SortCollectionsByCount
+    };
+
     class ExplorerDatabaseTreeItem : public ExplorerTreeItem
     {
         Q_OBJECT
@@ -41,8 +53,20 @@ namespace Robomongo
         void addEditIndex(ExplorerCollectionTreeItem *const item, 
                           const IndexInfo &oldInfo, const IndexInfo &newInfo) const;
 
+        CollectionSortOrder collectionSortOrder() const { return _collectionSortOrder; }
+        void sortCollections(CollectionSortOrder order);
+
+        /**
+         * @brief Requests statistics of collections, shown in viewport of explorer
+         *        (see ExplorerTreeWidget), or of all collections when they are
+         *        sorted by size or count.
+         */
+        void loadCollectionStats(const QList<ExplorerCollectionTreeItem *> &visibleItems);
+
     public Q_SLOTS:
         void handle(MongoDatabaseCollectionListLoadedEvent *event);
+        void handle(MongoDatabaseCollectionStatsLoadedEvent *event);
+        void handle(MongoDatabaseIndexCatalogLoadedEvent *event);
         void handle(MongoDatabaseUsersLoadedEvent *event);
         void handle(MongoDatabaseFunctionsLoadedEvent *event);
         void handle(MongoDatabaseCollectionsLoadingEvent *event);
@@ -52,6 +76,7 @@ namespace Robomongo
     private Q_SLOTS:
         void ui_dbStatistics();
         void ui_dbCurrentOps();
+        void ui_dbOperationsMonitor();
         void ui_dbKillOp();
         void ui_dbDrop();
         void ui_dbRepair();
@@ -62,6 +87,8 @@ namespace Robomongo
         void addCollectionItem(MongoCollection *collection);
         void addSystemCollectionItem(MongoCollection *collection);
         void showCollectionSystemFolderIfNeeded();
+        void sortCollectionItems();
+        QList<ExplorerCollectionTreeItem *> collectionItems() const;
 
         void addUserItem(MongoDatabase *database, const MongoUser &user);
         void addFunctionItem(MongoDatabase *database, const MongoFunction &function);
@@ -72,5 +99,6 @@ namespace Robomongo
         ExplorerDatabaseCategoryTreeItem *_usersFolderItem;
         ExplorerTreeItem *_collectionSystemFolderItem;
         MongoDatabase *const _database;
+        CollectionSortOrder _collectionSortOrder;
     };
 }
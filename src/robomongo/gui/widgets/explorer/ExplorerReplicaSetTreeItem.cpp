@@ -99,11 +99,26 @@ namespace Robomongo
             stateStr = "[Not Reachable]";
 
         setDisabled(_isUp ? false : true);
-        setText(0, QString::fromStdString(_repMemberHostAndPort.toString()) + " " + stateStr);
+        setText(0, QString::fromStdString(_repMemberHostAndPort.toString()) + " " + stateStr + 
+                   (_statsStr.isEmpty() ? "" : "  (" + _statsStr + ")"));
         setIcon(0, _isPrimary ? GuiRegistry::instance().serverPrimaryIcon()                               
                               : GuiRegistry::instance().serverSecondaryIcon());
     }
 
+    void ExplorerReplicaSetTreeItem::updateStats(ReplicaMemberStats const& stats)
+    {
+        _statsStr.clear();
+        if (stats.up && stats.rttMs >= 0) {
+            _statsStr = QString("%1 ms").arg(stats.rttMs, 0, 'f', 1);
+            if (!stats.primary && stats.lagSecs >= 0)
+                _statsStr += QString(", lag %1 s").arg(stats.lagSecs);
+        }
+
+        setToolTip(0, _statsStr.isEmpty() ? QString() : 
+                      "Average round trip time and replication lag, refreshed every 10 seconds");
+        updateTextAndIcon(_isUp, _isPrimary);
+    }
+
     void ExplorerReplicaSetTreeItem::ui_serverHostInfo()
     {
         openCurrentServerShell(_server, _connSettings.get(), "db.hostInfo()");
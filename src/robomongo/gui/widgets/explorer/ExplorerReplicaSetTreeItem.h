@@ -28,9 +28,15 @@ namespace Robomongo
         */
         void updateTextAndIcon(bool isUp, bool isPrimary);
 
+        /**
+        * @brief Shows round trip time and replication lag measured by topology monitor
+        */
+        void updateStats(ReplicaMemberStats const& stats);
+
         // Getters
         ConnectionSettings* connectionSettings() { return _connSettings.get(); }
         bool isUp() const { return _isUp; }
+        mongo::HostAndPort const& hostAndPort() const { return _repMemberHostAndPort; }
         MongoServer* server() const { return _server; }
 
     private Q_SLOTS:
@@ -46,6 +52,7 @@ namespace Robomongo
         
         bool _isPrimary;    // true if this set member is primary, false otherwise
         bool _isUp;         // true if this set member is reachable, false otherwise
+        QString _statsStr;  // i.e. "2.1 ms, lag 0 s"
 
         MongoServer *const _server;
         std::unique_ptr<ConnectionSettings> _connSettings;
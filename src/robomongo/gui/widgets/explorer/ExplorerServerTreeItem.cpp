@@ -80,6 +80,7 @@ namespace Robomongo
         _bus->subscribe(this, DatabaseListLoadedEvent::Type, _server);
         _bus->subscribe(this, MongoServerLoadingDatabasesEvent::Type, _server);
         _bus->subscribe(this, ReplicaSetFolderRefreshed::Type, _server);
+        _bus->subscribe(this, ReplicaSetTopologyUpdated::Type, _server);
         _bus->subscribe(this, ConnectionEstablishedEvent::Type, _server);
         _bus->subscribe(this, ConnectionFailedEvent::Type, _server);
 
@@ -210,6 +211,11 @@ namespace Robomongo
         replicaSetPrimaryReachable();
     }
 
+    void ExplorerServerTreeItem::handle(ReplicaSetTopologyUpdated *event)
+    {
+        updateReplicaSetMemberStats();
+    }
+
     void ExplorerServerTreeItem::handle(ConnectionEstablishedEvent *event)
     {
         if (!_server->connectionRecord()->isReplicaSet() || 
@@ -360,11 +366,32 @@ namespace Robomongo
                                                                         isPrimary, memberAndHealth.second));
         }
 
+        updateReplicaSetMemberStats();
+
         _replicaSetFolder->setRefreshFlag(false);
         _replicaSetFolder->setExpanded(expanded);
         _replicaSetFolder->setRefreshFlag(true);
     }
 
+    void ExplorerServerTreeItem::updateReplicaSetMemberStats()
+    {
+        if (!_replicaSetFolder)
+            return;
+
+        for (int i = 0; i < _replicaSetFolder->childCount(); ++i) {
+            auto member = dynamic_cast<ExplorerReplicaSetTreeItem *>(_replicaSetFolder->child(i));
+            if (!member)
+                continue;
+
+            for (auto const& stats : _server->replicaSetTopology()) {
+                if (stats.host == member->hostAndPort().toString()) {
+                    member->updateStats(stats);
+                    break;
+                }
+            }
+        }
+    }
+
     void ExplorerServerTreeItem::buildDatabaseItems()
     {
         int dbCount = _server->databases().count();
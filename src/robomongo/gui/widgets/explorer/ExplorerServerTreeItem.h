@@ -36,6 +36,7 @@ namespace Robomongo
         void handle(DatabaseListLoadedEvent *event);
         void handle(MongoServerLoadingDatabasesEvent *event);
         void handle(ReplicaSetFolderRefreshed *event);
+        void handle(ReplicaSetTopologyUpdated *event);
 
         // Special handle for server refresh events for replica set connections only
         void handle(ConnectionEstablishedEvent *event);
@@ -62,6 +63,9 @@ namespace Robomongo
         // Build only replica set folder and member items
         void buildReplicaSetFolder(bool expanded);
 
+        // Show latest round trip times and lags in replica set member items
+        void updateReplicaSetMemberStats();
+
         // This function assumes there is no existing db items (system folder and other db tree items), 
         // so existing db items should be deleted before calling this function.
         void buildDatabaseItems();  
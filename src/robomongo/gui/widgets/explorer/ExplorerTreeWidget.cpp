@@ -1,11 +1,22 @@
 #include "robomongo/gui/widgets/explorer/ExplorerTreeWidget.h"
 
+#include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/widgets/explorer/ExplorerTreeItem.h"
+#include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetTreeItem.h"
 #include <QContextMenuEvent>
+#include <QHash>
+#include <QScrollBar>
+#include <QTimer>
 #include <robomongo/gui/GuiRegistry.h>
 
+namespace
+{
+    // Delay of statistics request after the last change of viewport
+    const int CollectionStatsDelayMsec = 200;
+}
+
 namespace Robomongo
 {
     ExplorerTreeWidget::ExplorerTreeWidget(QWidget *parent) : QTreeWidget(parent)
@@ -22,6 +33,44 @@ namespace Robomongo
         setHeaderHidden(true);
         setSelectionMode(QAbstractItemView::SingleSelection);
         setExpandsOnDoubleClick(false);
+
+        // Statistics (collStats) are loaded only for collections, that user can see
+        _collectionStatsTimer = new QTimer(this);
+        _collectionStatsTimer->setSingleShot(true);
+        _collectionStatsTimer->setInterval(CollectionStatsDelayMsec);
+        VERIFY(connect(_collectionStatsTimer, SIGNAL(timeout()), this, SLOT(loadVisibleCollectionStats())));
+        VERIFY(connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(scheduleCollectionStats())));
+        VERIFY(connect(this, SIGNAL(itemExpanded(QTreeWidgetItem *)), this, SLOT(scheduleCollectionStats())));
+        VERIFY(connect(this, SIGNAL(itemCollapsed(QTreeWidgetItem *)), this, SLOT(scheduleCollectionStats())));
+        VERIFY(connect(model(), SIGNAL(rowsInserted(const QModelIndex &, int, int)), 
+                       this, SLOT(scheduleCollectionStats())));
+        VERIFY(connect(model(), SIGNAL(layoutChanged()), this, SLOT(scheduleCollectionStats())));
+    }
+
+    void ExplorerTreeWidget::resizeEvent(QResizeEvent *event)
+    {
+        QTreeWidget::resizeEvent(event);
+        scheduleCollectionStats();
+    }
+
+    void ExplorerTreeWidget::scheduleCollectionStats()
+    {
+        _collectionStatsTimer->start();
+    }
+
+    void ExplorerTreeWidget::loadVisibleCollectionStats()
+    {
+        QHash<ExplorerDatabaseTreeItem *, QList<ExplorerCollectionTreeItem *>> visibleItems;
+        int const bottom = viewport()->height();
+        for (QTreeWidgetItem *item = itemAt(0, 0); item && visualItemRect(item).top() < bottom; 
+             item = itemBelow(item)) {
+            auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(item);
+            if (collectionItem)
+                visibleItems[collectionItem->databaseItem()].append(collectionItem);
+        }
+
+        for (auto it = visibleItems.constBegin(); it != visibleItems.constEnd(); ++it)
+            it.key()->loadCollectionStats(it.value());
     }
 
     void ExplorerTreeWidget::contextMenuEvent(QContextMenuEvent *event)
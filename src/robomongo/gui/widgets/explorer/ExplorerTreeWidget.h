@@ -1,6 +1,9 @@
 #pragma once
 
 #include <QTreeWidget>
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
 
 namespace Robomongo
 {
@@ -11,5 +14,14 @@ namespace Robomongo
         explicit ExplorerTreeWidget(QWidget *parent = 0);
     protected:
         virtual void contextMenuEvent(QContextMenuEvent *event);
+        void resizeEvent(QResizeEvent *event) override;
+
+    private Q_SLOTS:
+        void scheduleCollectionStats();
+        void loadVisibleCollectionStats();
+
+    private:
+        // Collects changes of viewport (scroll, expand, new items) into one request
+        QTimer *_collectionStatsTimer;
     };
 }
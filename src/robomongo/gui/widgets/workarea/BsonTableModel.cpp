@@ -1,11 +1,13 @@
 #include "robomongo/gui/widgets/workarea/BsonTableModel.h"
 
 #include <QBrush>
+#include <QHash>
 #include <QIcon>
 
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace Robomongo
 {
@@ -84,19 +86,45 @@ namespace Robomongo
 
     void BsonTableModelProxy::setSourceModel( QAbstractItemModel* model )
     {
+        TraceSpan const span("model", "BsonTableModelProxy::setSourceModel");
+
+        _columns.clear();
         if (model) {
             BsonTreeItem *child = QtUtils::item<BsonTreeItem *>(model->index(0, 0));
             if (child) {
                 _root = qobject_cast<BsonTreeItem *>(child->parent());
                 if (_root) {
+                    // Fields in order of appearance, looked up by hash: documents
+                    // with hundreds of fields made linear lookup quadratic
+                    ColumnsValuesType fields;
+                    QHash<QString, size_t> indexes;
                     int count = _root->childrenCount();
                     for (int i = 0; i < count; ++i) {
                         BsonTreeItem *child = _root->child(i);
                         int countc = child->childrenCount();
                         for (int j = 0; j < countc; ++j) {
-                            addColumn(child->child(j)->key());
+                            QString const& key = child->child(j)->key();
+                            if (!indexes.contains(key)) {
+                                indexes.insert(key, fields.size());
+                                fields.push_back(key);
+                            }
+                        }
+                    }
+
+                    _columns.reserve(fields.size());
+                    std::vector<bool> placed(fields.size(), false);
+                    for (auto const& column : _columnsOrder) {
+                        auto const it = indexes.constFind(column);
+                        if (it != indexes.constEnd() && !placed[it.value()]) {
+                            placed[it.value()] = true;
+                            _columns.push_back(column);
                         }
                     }
+
+                    for (size_t i = 0; i < fields.size(); ++i) {
+                        if (!placed[i])
+                            _columns.push_back(fields[i]);
+                    }
                 }
             }
         }
@@ -151,23 +179,4 @@ namespace Robomongo
     {
         return _columns[col];
     }
-
-    size_t BsonTableModelProxy::findIndexColumn(const QString &col) const
-    {
-        for (int i = 0; i < _columns.size(); ++i) {
-            if (_columns[i] == col) {
-                return i;
-            }
-        }
-        return _columns.size();
-    }
-
-    size_t BsonTableModelProxy::addColumn(const QString &col)
-    {
-        size_t column = findIndexColumn(col);
-        if (column == _columns.size()) {
-            _columns.push_back(col);
-        }
-        return column;
-    }
 }
@@ -26,14 +26,20 @@ namespace Robomongo
         virtual QModelIndex mapFromSource( const QModelIndex & sourceIndex ) const;
         virtual QModelIndex mapToSource( const QModelIndex &proxyIndex ) const;
         virtual void setSourceModel( QAbstractItemModel* model );
+
+        /**
+         * @brief Expected order of columns (i.e. top-level fields of sampled CollectionSchema),
+         *        applied by next setSourceModel(). Fields, that no document has, get no column,
+         *        fields missing in 'columns' are appended in order of appearance.
+         */
+        void setColumnsOrder(const ColumnsValuesType &columns) { _columnsOrder = columns; }
         virtual QModelIndex parent( const QModelIndex& index ) const;
         virtual QModelIndex sibling(int row, int column, const QModelIndex &idx) const;
     private:
         QString column(int col) const;
-        size_t addColumn(const QString &col);
-        size_t findIndexColumn(const QString &col) const;
 
         ColumnsValuesType _columns;
+        ColumnsValuesType _columnsOrder;
         BsonTreeItem *_root;
     };
 }
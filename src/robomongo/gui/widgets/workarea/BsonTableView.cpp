@@ -4,6 +4,7 @@
 #include <QAction>
 #include <QMenu>
 #include <QKeyEvent>
+#include <QInputDialog>
 
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/gui/GuiRegistry.h"
@@ -12,7 +13,9 @@
 namespace Robomongo
 {
     BsonTableView::BsonTableView(MongoShell *shell, const MongoQueryInfo &queryInfo, QWidget *parent) 
-        :BaseClass(parent), _notifier(this, shell, queryInfo)
+        :BaseClass(parent), _notifier(this, shell, queryInfo),
+        _isServerSortSupported(queryInfo._info.isValid()),
+        _sortOrder(Qt::AscendingOrder)
     {
 #if defined(Q_OS_MAC)
         setAttribute(Qt::WA_MacShowFocusRect, false);
@@ -27,6 +30,86 @@ namespace Robomongo
         setSelectionBehavior(QAbstractItemView::SelectItems);
         setContextMenuPolicy(Qt::CustomContextMenu);
         VERIFY(connect(this, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(showContextMenu(const QPoint&))));
+
+        if (_isServerSortSupported) {
+            horizontalHeader()->setSectionsClickable(true);
+            horizontalHeader()->setSortIndicatorShown(false);
+            horizontalHeader()->setContextMenuPolicy(Qt::CustomContextMenu);
+            VERIFY(connect(horizontalHeader(), SIGNAL(sectionClicked(int)), this, SLOT(header_sectionClicked(int))));
+            VERIFY(connect(horizontalHeader(), SIGNAL(customContextMenuRequested(const QPoint&)), 
+                           this, SLOT(header_showContextMenu(const QPoint&))));
+        }
+    }
+
+    void BsonTableView::setSortIndicator(const QString &column, Qt::SortOrder order)
+    {
+        _sortColumn = column;
+        _sortOrder = order;
+
+        if (!model() || column.isEmpty()) {
+            horizontalHeader()->setSortIndicatorShown(false);
+            return;
+        }
+
+        for (int section = 0; section < model()->columnCount(); ++section) {
+            if (columnName(section) == column) {
+                horizontalHeader()->setSortIndicatorShown(true);
+                horizontalHeader()->setSortIndicator(section, order);
+                return;
+            }
+        }
+        horizontalHeader()->setSortIndicatorShown(false);
+    }
+
+    QString BsonTableView::columnName(int section) const
+    {
+        return model()->headerData(section, Qt::Horizontal).toString();
+    }
+
+    void BsonTableView::header_sectionClicked(int section)
+    {
+        QString const column = columnName(section);
+        if (column.isEmpty())
+            return;
+
+        // First click sorts ascending, next clicks toggle order
+        Qt::SortOrder const order = (column == _sortColumn && _sortOrder == Qt::AscendingOrder) ? 
+                                    Qt::DescendingOrder : Qt::AscendingOrder;
+        setSortIndicator(column, order);
+        emit sortRequested(column, order);
+    }
+
+    void BsonTableView::header_showContextMenu(const QPoint &point)
+    {
+        QString const column = columnName(horizontalHeader()->logicalIndexAt(point));
+        if (column.isEmpty())
+            return;
+
+        QMenu menu(this);
+        QAction *sortAscending = menu.addAction("Sort Ascending");
+        QAction *sortDescending = menu.addAction("Sort Descending");
+        menu.addSeparator();
+        QAction *filter = menu.addAction("Filter by Value...");
+        QAction *reset = menu.addAction("Reset Sort and Filters");
+
+        QAction *selected = menu.exec(horizontalHeader()->mapToGlobal(point));
+        if (selected == sortAscending || selected == sortDescending) {
+            Qt::SortOrder const order = selected == sortAscending ? Qt::AscendingOrder : Qt::DescendingOrder;
+            setSortIndicator(column, order);
+            emit sortRequested(column, order);
+        }
+        else if (selected == filter) {
+            bool ok = false;
+            QString const value = QInputDialog::getText(this, "Filter by Value", 
+                QString("Show documents where '%1' equals (JSON value, i.e. 42, \"text\", true):").arg(column),
+                QLineEdit::Normal, QString(), &ok);
+            if (ok && !value.trimmed().isEmpty())
+                emit filterRequested(column, value.trimmed());
+        }
+        else if (selected == reset) {
+            setSortIndicator(QString(), Qt::AscendingOrder);
+            emit resetSortAndFilterRequested();
+        }
     }
 
     void BsonTableView::keyPressEvent(QKeyEvent *event)
@@ -14,13 +14,38 @@ namespace Robomongo
         virtual QModelIndex selectedIndex() const;
         virtual QModelIndexList selectedIndexes() const;
 
+        /**
+         * @brief Shows sort indicator on column with header 'column' (if exists)
+         */
+        void setSortIndicator(const QString &column, Qt::SortOrder order);
+
+    Q_SIGNALS:
+        /**
+         * @brief Emitted when user asks to sort or filter by column. Sorting and
+         *        filtering is done by server, table itself never reorders rows.
+         */
+        void sortRequested(const QString &column, Qt::SortOrder order);
+        void filterRequested(const QString &column, const QString &value);
+        void resetSortAndFilterRequested();
+
     public Q_SLOTS:
         void showContextMenu(const QPoint &point);
 
+    private Q_SLOTS:
+        void header_sectionClicked(int section);
+        void header_showContextMenu(const QPoint &point);
+
     protected:
         virtual void keyPressEvent(QKeyEvent *event);
 
     private:
+        QString columnName(int section) const;
+
         Notifier _notifier;
+
+        // Sorting and filtering is available only for results of find() queries
+        const bool _isServerSortSupported;
+        QString _sortColumn;
+        Qt::SortOrder _sortOrder;
     };
 }
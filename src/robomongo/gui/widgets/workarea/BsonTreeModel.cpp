@@ -1,5 +1,6 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 
+#include <QElapsedTimer>
 #include <mongo/client/dbclient_base.h>
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/AppRegistry.h"
@@ -8,6 +9,8 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
+#include "robomongo/core/utils/Metrics.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace
 {
@@ -67,10 +70,14 @@ namespace
 
 namespace Robomongo
 {
-    BsonTreeModel::BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent) :
+    BsonTreeModel::BsonTreeModel(const MongoDocumentList &documents, QObject *parent) :
         BaseClass(parent),
         _root(new BsonTreeItem(this))
     {
+        TraceSpan const span("model", "BsonTreeModel");
+        QElapsedTimer timer;
+        timer.start();
+
         for (int i = 0; i < documents.size(); ++i) {
             MongoDocumentPtr doc = documents[i]; 
             BsonTreeItem *child = new BsonTreeItem(doc->bsonObj(), _root);
@@ -95,6 +102,10 @@ namespace Robomongo
             }
             _root->addChild(child);
         }
+
+        static auto const buildTime =
+            MetricsRegistry::instance().histogram(MetricsRegistry::ApplicationScope, "model.tree.build");
+        buildTime->record(timer.nsecsElapsed() / 1000);
     }
 
     void BsonTreeModel::fetchMore(const QModelIndex &parent)
@@ -2,6 +2,7 @@
 #include <vector>
 #include <QAbstractItemModel>
 #include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
 
 namespace Robomongo
 {
@@ -14,7 +15,7 @@ namespace Robomongo
     public:
         typedef QAbstractItemModel BaseClass;
         static const QIcon &getIcon(BsonTreeItem *item);
-        explicit BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent = 0);
+        explicit BsonTreeModel(const MongoDocumentList &documents, QObject *parent = 0);
         QVariant data(const QModelIndex &index, int role) const;
 
         int rowCount(const QModelIndex &parent = QModelIndex()) const;
@@ -7,7 +7,7 @@
 namespace Robomongo
 {
 
-    CollectionStatsTreeWidget::CollectionStatsTreeWidget(const std::vector<MongoDocumentPtr> &documents, QWidget *parent) 
+    CollectionStatsTreeWidget::CollectionStatsTreeWidget(const MongoDocumentList &documents, QWidget *parent) 
         : QTreeWidget(parent)
     {
         QStringList colums;
@@ -3,6 +3,7 @@
 #include <QTreeWidget>
 
 #include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
 
 namespace Robomongo
 {
@@ -10,6 +11,6 @@ namespace Robomongo
     {
         Q_OBJECT
     public:
-        CollectionStatsTreeWidget(const std::vector<MongoDocumentPtr> &documents, QWidget *parent = NULL);
+        CollectionStatsTreeWidget(const MongoDocumentList &documents, QWidget *parent = NULL);
     };
 }
@@ -0,0 +1,117 @@
+#include "robomongo/gui/widgets/workarea/ExplainPlanWidget.h"
+
+#include <QHeaderView>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/domain/MongoExplainPlan.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    enum Columns { StageColumn, IndexColumn, ReturnedColumn, DocsColumn, KeysColumn, TimeColumn };
+
+    QString counter(long long value)
+    {
+        return value < 0 ? QString() : QString::number(value);
+    }
+}
+
+namespace Robomongo
+{
+    ExplainPlanWidget::ExplainPlanWidget(QWidget *parent) :
+        QWidget(parent)
+    {
+        _summary = new QLabel;
+        _summary->setContentsMargins(6, 4, 6, 4);
+        _summary->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _tree = new QTreeWidget;
+        _tree->setHeaderLabels(QStringList() << "Stage" << "Index" << "Returned" 
+                                             << "Docs Examined" << "Keys Examined" << "Time (ms)");
+        _tree->setStyleSheet(
+            "QTreeWidget { border-left: 1px solid #c7c5c4; border-top: 1px solid #c7c5c4; }"
+        );
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->setContentsMargins(0, 0, 0, 0);
+        layout->setSpacing(0);
+        layout->addWidget(_summary);
+        layout->addWidget(_tree, 1);
+        setLayout(layout);
+    }
+
+    void ExplainPlanWidget::setLoading()
+    {
+        _tree->clear();
+        _summary->setText("Loading execution plan...");
+    }
+
+    void ExplainPlanWidget::setError(const QString &error)
+    {
+        _tree->clear();
+        _summary->setText(QString("Failed to explain query: %1").arg(error));
+    }
+
+    void ExplainPlanWidget::setPlan(const MongoExplainPlan &plan)
+    {
+        _tree->clear();
+        if (!plan.isValid()) {
+            _summary->setText("Server returned no execution plan for this query.");
+            return;
+        }
+
+        _summary->setText(summary(plan));
+        _tree->addTopLevelItem(createItem(plan.root()));
+        _tree->expandAll();
+        _tree->header()->resizeSections(QHeaderView::ResizeToContents);
+    }
+
+    QString ExplainPlanWidget::summary(const MongoExplainPlan &plan)
+    {
+        QStringList indexes;
+        for (auto const& index : plan.indexesUsed())
+            indexes.append(QtUtils::toQString(index));
+
+        QString text = QString("Returned: %1, Docs examined: %2, Keys examined: %3, Index: %4")
+            .arg(plan.nReturned() < 0 ? "?" : counter(plan.nReturned()))
+            .arg(plan.totalDocsExamined() < 0 ? "?" : counter(plan.totalDocsExamined()))
+            .arg(plan.totalKeysExamined() < 0 ? "?" : counter(plan.totalKeysExamined()))
+            .arg(indexes.isEmpty() ? "none" : indexes.join(", "));
+
+        if (plan.executionTimeMillis() >= 0)
+            text += QString(", Time: %1 ms").arg(plan.executionTimeMillis());
+
+        if (plan.hasCollectionScan())
+            text += " (COLLSCAN)";
+
+        return text;
+    }
+
+    QTreeWidgetItem *ExplainPlanWidget::createItem(const ExplainStage &stage) const
+    {
+        QTreeWidgetItem *item = new QTreeWidgetItem;
+        item->setText(StageColumn, QtUtils::toQString(stage.name));
+        item->setText(IndexColumn, QtUtils::toQString(stage.indexName));
+        item->setText(ReturnedColumn, counter(stage.nReturned));
+        item->setText(DocsColumn, counter(stage.docsExamined));
+        item->setText(KeysColumn, counter(stage.keysExamined));
+        item->setText(TimeColumn, counter(stage.executionTimeMillis));
+
+        if (!stage.indexName.empty())
+            item->setIcon(StageColumn, GuiRegistry::instance().indexIcon());
+
+        if (stage.isCollectionScan()) {
+            for (int column = StageColumn; column <= TimeColumn; ++column)
+                item->setForeground(column, QColor(200, 0, 0));
+            item->setToolTip(StageColumn, "Collection scan: every document of collection is examined");
+        }
+
+        for (auto const& child : stage.children)
+            item->addChild(createItem(child));
+
+        return item;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QWidget>
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QTreeWidget;
+class QTreeWidgetItem;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoExplainPlan;
+    struct ExplainStage;
+
+    /**
+     * @brief Shows execution plan of query: summary line (documents returned
+     *        vs examined, indexes used, time) and tree of plan stages.
+     *        Collection scans are highlighted.
+     */
+    class ExplainPlanWidget : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        explicit ExplainPlanWidget(QWidget *parent = nullptr);
+
+        void setLoading();
+        void setPlan(const MongoExplainPlan &plan);
+        void setError(const QString &error);
+
+        /**
+         * @brief One line description of plan, i.e. for tooltips
+         */
+        static QString summary(const MongoExplainPlan &plan);
+
+    private:
+        QTreeWidgetItem *createItem(const ExplainStage &stage) const;
+
+        QLabel *_summary;
+        QTreeWidget *_tree;
+    };
+}
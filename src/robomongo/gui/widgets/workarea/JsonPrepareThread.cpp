@@ -4,14 +4,23 @@
 
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/LargeTextBuffer.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace Robomongo
 {
-    JsonPrepareThread::JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+    JsonPrepareThread::JsonPrepareThread(const MongoDocumentList &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+        :JsonPrepareThread(bsonObjects, uuidEncoding, timeZone, nullptr)
+    {
+    }
+
+    JsonPrepareThread::JsonPrepareThread(const MongoDocumentList &bsonObjects, UUIDEncoding uuidEncoding,
+                                         SupportedTimes timeZone, std::shared_ptr<LargeTextBuffer> target)
         :_bsonObjects(bsonObjects),
         _uuidEncoding(uuidEncoding),
         _timeZone(timeZone),
+        _target(target),
         _stop(false)
     {
     }
@@ -23,8 +32,10 @@ namespace Robomongo
 
     void JsonPrepareThread::run()
     {
+        TraceSpan const span("render", "JsonPrepareThread::run");
+
         int position = 1; // 1-based numbering to match tree & table views
-        for (std::vector<MongoDocumentPtr>::const_iterator it = _bsonObjects.begin(); it != _bsonObjects.end(); ++it)
+        for (MongoDocumentList::const_iterator it = _bsonObjects.begin(); it != _bsonObjects.end(); ++it)
         {
             MongoDocumentPtr doc = *it;
             mongo::StringBuilder sb;
@@ -40,6 +51,16 @@ namespace Robomongo
                 break;
 
             sb << stdJson;
+            if (_target) {
+                if (_target.use_count() == 1)
+                    break;
+
+                std::string const part = sb.str();
+                _target->append(part.c_str(), static_cast<int>(part.size()));
+                position++;
+                continue;
+            }
+
             QString json = QtUtils::toQString(sb.str());
 
             if (_stop)
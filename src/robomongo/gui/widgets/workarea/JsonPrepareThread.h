@@ -1,14 +1,18 @@
 #pragma once
 
 #include <QThread>
+#include <memory>
 #include <vector>
 
 #include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
 
 #include "robomongo/core/Enums.h"
 
 namespace Robomongo
 {
+    class LargeTextBuffer;
+
     /*
     ** In this thread we are running task to prepare JSON string from list of BSON objects
     */
@@ -20,7 +24,14 @@ namespace Robomongo
         /*
         ** Constructor
         */
-        JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+        JsonPrepareThread(const MongoDocumentList &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+
+        /*
+        ** Appends JSON to 'target' instead of emitting partReady(). Stops when
+        ** nobody else holds 'target' (i.e. its view was closed).
+        */
+        JsonPrepareThread(const MongoDocumentList &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone,
+                          std::shared_ptr<LargeTextBuffer> target);
         void stop();
    Q_SIGNALS:
         /**
@@ -43,9 +54,10 @@ namespace Robomongo
         /*
         ** List of documents
         */
-        const std::vector<MongoDocumentPtr> _bsonObjects;
+        const MongoDocumentList _bsonObjects;
         const UUIDEncoding _uuidEncoding;
         const SupportedTimes _timeZone;
+        const std::shared_ptr<LargeTextBuffer> _target;
         volatile bool _stop;
     };
 }
@@ -0,0 +1,275 @@
+#include "robomongo/gui/widgets/workarea/LargeTextView.h"
+
+#include <algorithm>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QPainter>
+#include <QScrollBar>
+#include <QSet>
+#include <QTimer>
+
+#include "robomongo/core/utils/LargeTextBuffer.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/editors/JSLexer.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    const int RefreshIntervalMs = 100;
+    const int Margin = 4;
+
+    bool isIdentifierChar(QChar ch)
+    {
+        return ch.isLetterOrNumber() || ch == '_' || ch == '$';
+    }
+
+    bool isOperator(QChar ch)
+    {
+        static QString const operators = "{}[]():,";
+        return operators.contains(ch);
+    }
+}
+
+namespace Robomongo
+{
+    LargeTextView::LargeTextView(std::shared_ptr<LargeTextBuffer> buffer, QWidget *parent) :
+        BaseClass(parent),
+        _buffer(buffer),
+        _lexer(new JSLexer(this)),
+        _refreshTimer(new QTimer(this)),
+        _selectionStart(-1),
+        _selectionEnd(-1)
+    {
+        setFont(GuiRegistry::instance().font());
+        setFocusPolicy(Qt::StrongFocus);
+        setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+        setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+        setStyleSheet("QAbstractScrollArea {background-color: rgb(73, 76, 78); border: 1px solid #c7c5c4; border-radius: 0px; margin: 0px; padding: 0px;}");
+
+        _refreshTimer->setInterval(RefreshIntervalMs);
+        VERIFY(connect(_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh())));
+        updateScrollBars();
+    }
+
+    void LargeTextView::startLoading()
+    {
+        _refreshTimer->start();
+    }
+
+    void LargeTextView::stopLoading()
+    {
+        _refreshTimer->stop();
+        refresh();
+    }
+
+    void LargeTextView::refresh()
+    {
+        updateScrollBars();
+        viewport()->update();
+    }
+
+    void LargeTextView::copy()
+    {
+        if (_selectionStart < 0)
+            return;
+
+        qint64 const first = std::min(_selectionStart, _selectionEnd);
+        qint64 const last = std::max(_selectionStart, _selectionEnd);
+        QStringList const lines = _buffer->lines(first, static_cast<int>(last - first + 1));
+        QApplication::clipboard()->setText(lines.join('\n'));
+    }
+
+    void LargeTextView::selectAll()
+    {
+        _selectionStart = 0;
+        _selectionEnd = _buffer->lineCount() - 1;
+        viewport()->update();
+    }
+
+    void LargeTextView::updateScrollBars()
+    {
+        qint64 const lines = _buffer->lineCount();
+        verticalScrollBar()->setRange(0, static_cast<int>(std::max<qint64>(0, lines - visibleLines())));
+        verticalScrollBar()->setPageStep(visibleLines());
+        verticalScrollBar()->setSingleStep(1);
+
+        int const charWidth = fontMetrics().averageCharWidth();
+        int const maxLength = std::min(_buffer->maxLineLength(), static_cast<int>(MaxPaintedLineLength));
+        horizontalScrollBar()->setRange(0, std::max(0, maxLength * charWidth + 2 * Margin - viewport()->width()));
+        horizontalScrollBar()->setPageStep(viewport()->width());
+        horizontalScrollBar()->setSingleStep(charWidth);
+    }
+
+    int LargeTextView::lineHeight() const
+    {
+        return fontMetrics().height();
+    }
+
+    int LargeTextView::visibleLines() const
+    {
+        return std::max(1, viewport()->height() / lineHeight());
+    }
+
+    qint64 LargeTextView::lineAt(int y) const
+    {
+        qint64 const line = verticalScrollBar()->value() + y / lineHeight();
+        return std::max<qint64>(0, std::min(line, _buffer->lineCount() - 1));
+    }
+
+    void LargeTextView::paintEvent(QPaintEvent *)
+    {
+        QPainter painter(viewport());
+        painter.fillRect(viewport()->rect(), _lexer->defaultPaper(QsciLexerJavaScript::Default));
+        painter.setFont(font());
+
+        qint64 const first = verticalScrollBar()->value();
+        // Partially visible line at the bottom
+        QStringList const lines = _buffer->lines(first, visibleLines() + 1);
+
+        qint64 const selectionFirst = std::min(_selectionStart, _selectionEnd);
+        qint64 const selectionLast = std::max(_selectionStart, _selectionEnd);
+        int const x = Margin - horizontalScrollBar()->value();
+        int const height = lineHeight();
+        for (int i = 0; i < lines.size(); ++i) {
+            int const y = i * height;
+            qint64 const line = first + i;
+            if (_selectionStart >= 0 && line >= selectionFirst && line <= selectionLast)
+                painter.fillRect(0, y, viewport()->width(), height, palette().highlight());
+
+            paintLine(painter, lines[i], x, y);
+        }
+    }
+
+    void LargeTextView::paintLine(QPainter &painter, const QString &line, int x, int y)
+    {
+        static QSet<QString> keywords;
+        if (keywords.isEmpty()) {
+            for (QString const& keyword : QString(_lexer->keywords(1)).split(' ', QString::SkipEmptyParts))
+                keywords.insert(keyword);
+        }
+
+        QString const text = line.size() > MaxPaintedLineLength ?
+            line.left(MaxPaintedLineLength) + QChar(0x2026) : line;
+        int const baseline = y + fontMetrics().ascent();
+
+        // Only lines of formatted JSON are lexed here: strings and comments never span lines
+        int pos = 0;
+        while (pos < text.size()) {
+            int end = pos + 1;
+            int style = QsciLexerJavaScript::Default;
+            QChar const ch = text[pos];
+            if (ch == '/' && pos + 1 < text.size() && text[pos + 1] == '*') {
+                end = text.indexOf("*/", pos + 2);
+                end = end < 0 ? text.size() : end + 2;
+                style = QsciLexerJavaScript::Comment;
+            }
+            else if (ch == '"') {
+                while (end < text.size() && text[end] != '"')
+                    end += text[end] == '\\' ? 2 : 1;
+                end = std::min(end + 1, text.size());
+                style = QsciLexerJavaScript::DoubleQuotedString;
+            }
+            else if (ch.isDigit() || (ch == '-' && pos + 1 < text.size() && text[pos + 1].isDigit())) {
+                while (end < text.size() && (text[end].isLetterOrNumber() || text[end] == '.' ||
+                                             ((text[end] == '-' || text[end] == '+') && text[end - 1].toLower() == 'e')))
+                    ++end;
+                style = QsciLexerJavaScript::Number;
+            }
+            else if (isIdentifierChar(ch)) {
+                while (end < text.size() && isIdentifierChar(text[end]))
+                    ++end;
+                if (keywords.contains(text.mid(pos, end - pos)))
+                    style = QsciLexerJavaScript::Keyword;
+            }
+            else if (isOperator(ch)) {
+                style = QsciLexerJavaScript::Operator;
+            }
+            else {
+                while (end < text.size() && text[end].isSpace())
+                    ++end;
+            }
+
+            QString const token = text.mid(pos, end - pos);
+            painter.setPen(_lexer->defaultColor(style));
+            painter.drawText(x, baseline, token);
+            x += fontMetrics().width(token);
+            pos = end;
+
+            // The rest is to the right of viewport
+            if (x > viewport()->width())
+                break;
+        }
+    }
+
+    void LargeTextView::resizeEvent(QResizeEvent *event)
+    {
+        BaseClass::resizeEvent(event);
+        updateScrollBars();
+    }
+
+    void LargeTextView::keyPressEvent(QKeyEvent *event)
+    {
+        if (event->matches(QKeySequence::Copy)) {
+            copy();
+            return;
+        }
+
+        if (event->matches(QKeySequence::SelectAll)) {
+            selectAll();
+            return;
+        }
+
+        QScrollBar *const bar = verticalScrollBar();
+        switch (event->key()) {
+        case Qt::Key_Up: bar->triggerAction(QAbstractSlider::SliderSingleStepSub); break;
+        case Qt::Key_Down: bar->triggerAction(QAbstractSlider::SliderSingleStepAdd); break;
+        case Qt::Key_PageUp: bar->triggerAction(QAbstractSlider::SliderPageStepSub); break;
+        case Qt::Key_PageDown: bar->triggerAction(QAbstractSlider::SliderPageStepAdd); break;
+        case Qt::Key_Home: bar->triggerAction(QAbstractSlider::SliderToMinimum); break;
+        case Qt::Key_End: bar->triggerAction(QAbstractSlider::SliderToMaximum); break;
+        default:
+            BaseClass::keyPressEvent(event);
+        }
+    }
+
+    void LargeTextView::mousePressEvent(QMouseEvent *event)
+    {
+        if (event->button() != Qt::LeftButton)
+            return BaseClass::mousePressEvent(event);
+
+        qint64 const line = lineAt(event->pos().y());
+        if (event->modifiers() & Qt::ShiftModifier && _selectionStart >= 0)
+            _selectionEnd = line;
+        else
+            _selectionStart = _selectionEnd = line;
+
+        viewport()->update();
+    }
+
+    void LargeTextView::mouseMoveEvent(QMouseEvent *event)
+    {
+        if (!(event->buttons() & Qt::LeftButton) || _selectionStart < 0)
+            return BaseClass::mouseMoveEvent(event);
+
+        // Scroll, when dragged out of viewport
+        if (event->pos().y() < 0)
+            verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+        else if (event->pos().y() > viewport()->height())
+            verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+
+        _selectionEnd = lineAt(event->pos().y());
+        viewport()->update();
+    }
+
+    void LargeTextView::contextMenuEvent(QContextMenuEvent *event)
+    {
+        QMenu menu(this);
+        QAction *copyAction = menu.addAction(tr("Copy"), this, SLOT(copy()), QKeySequence::Copy);
+        copyAction->setEnabled(_selectionStart >= 0);
+        menu.addAction(tr("Select All"), this, SLOT(selectAll()), QKeySequence::SelectAll);
+        menu.exec(event->globalPos());
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+
+#include <QAbstractScrollArea>
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class JSLexer;
+    class LargeTextBuffer;
+
+    /**
+     * @brief Read-only viewer of a LargeTextBuffer, used by text mode of
+     *        results too large for QScintilla (which styles and lays out
+     *        the whole text and keeps it twice, as UTF-16 and with styles).
+     *
+     *        Only visible lines are fetched, lexed and painted. Buffer may
+     *        grow in background (see JsonPrepareThread), scroll bars follow
+     *        it while loading. Selection is by whole lines.
+     */
+    class LargeTextView : public QAbstractScrollArea
+    {
+        Q_OBJECT
+
+    public:
+        typedef QAbstractScrollArea BaseClass;
+
+        // Longer lines are cut when painted (but not when copied)
+        static const int MaxPaintedLineLength = 4096;
+
+        LargeTextView(std::shared_ptr<LargeTextBuffer> buffer, QWidget *parent = nullptr);
+
+    public Q_SLOTS:
+        // Buffer is growing, refresh periodically until stopLoading()
+        void startLoading();
+        void stopLoading();
+        void refresh();
+        void copy();
+        void selectAll();
+
+    protected:
+        void paintEvent(QPaintEvent *event) override;
+        void resizeEvent(QResizeEvent *event) override;
+        void keyPressEvent(QKeyEvent *event) override;
+        void mousePressEvent(QMouseEvent *event) override;
+        void mouseMoveEvent(QMouseEvent *event) override;
+        void contextMenuEvent(QContextMenuEvent *event) override;
+
+    private:
+        void updateScrollBars();
+        qint64 lineAt(int y) const;
+        int lineHeight() const;
+        int visibleLines() const;
+        void paintLine(QPainter &painter, const QString &line, int x, int y);
+
+        std::shared_ptr<LargeTextBuffer> const _buffer;
+        JSLexer *const _lexer;   // Source of colors, same as in QScintilla text mode
+        QTimer *const _refreshTimer;
+        qint64 _selectionStart;
+        qint64 _selectionEnd;
+    };
+}
@@ -1,26 +1,40 @@
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 
 #include <QVBoxLayout>
+#include <QTimer>
 #include <Qsci/qscilexerjavascript.h>
 
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/domain/MongoShell.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/ResultMemoryGovernor.h"
+#include "robomongo/core/domain/ResultSearch.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/App.h"
+#include "robomongo/core/domain/CollectionSchema.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/utils/LargeTextBuffer.h"
+#include "robomongo/shell/bson/json.h"
 
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemHeaderWidget.h"
 #include "robomongo/gui/widgets/workarea/JsonPrepareThread.h"
+#include "robomongo/gui/widgets/workarea/LargeTextView.h"
 #include "robomongo/gui/widgets/workarea/BsonTreeView.h"
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/widgets/workarea/BsonTableView.h"
 #include "robomongo/gui/widgets/workarea/BsonTableModel.h"
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
 #include "robomongo/gui/widgets/workarea/CollectionStatsTreeWidget.h"
+#include "robomongo/gui/widgets/workarea/ExplainPlanWidget.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/editors/JSLexer.h"
 #include "robomongo/gui/editors/FindFrame.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace Robomongo
 {
@@ -30,9 +44,11 @@ namespace Robomongo
                                                      AggrInfo aggrInfo, QWidget *parent) :
         BaseClass(parent),
         _textView(NULL),
+        _largeTextView(NULL),
         _bsonTreeview(NULL),
         _thread(NULL),
         _bsonTable(NULL),
+        _explainView(NULL),
         _isTextModeSupported(true),
         _isTreeModeSupported(false),
         _isTableModeSupported(false),
@@ -41,6 +57,9 @@ namespace Robomongo
         _isTreeModeInitialized(false),
         _isCustomModeInitialized(false),
         _isTableModeInitialized(false),
+        _isExplainModeSupported(false),
+        _isExplainLoaded(false),
+        _isExplainLoading(false),
         _isFirstPartRendered(false),
         _text(text),
         _shell(shell),
@@ -49,23 +68,26 @@ namespace Robomongo
         _initialLimit(0),
         _mod(NULL),
         _viewMode(viewMode),
-        _aggrInfo(aggrInfo)
+        _aggrInfo(aggrInfo),
+        _sortOrder(Qt::AscendingOrder)
     {
         setup(secs, multipleResults, tabbedResults, firstItem, lastItem);
     }
 
     OutputItemContentWidget::OutputItemContentWidget(ViewMode viewMode, MongoShell *shell, 
                                                      const QString &type, 
-                                                     const std::vector<MongoDocumentPtr> &documents, 
+                                                     const MongoDocumentList &documents, 
                                                      const MongoQueryInfo &queryInfo, double secs, 
                                                      bool multipleResults, bool tabbedResults,
                                                      bool firstItem, bool lastItem, AggrInfo aggrInfo,
                                                      QWidget *parent) :
         BaseClass(parent),
         _textView(NULL),
+        _largeTextView(NULL),
         _bsonTreeview(NULL),
         _thread(NULL),
         _bsonTable(NULL),
+        _explainView(NULL),
         _isTextModeSupported(true),
         _isTreeModeSupported(true),
         _isTableModeSupported(true),
@@ -74,6 +96,9 @@ namespace Robomongo
         _isTreeModeInitialized(false),
         _isCustomModeInitialized(false),
         _isTableModeInitialized(false),
+        _isExplainModeSupported(false),
+        _isExplainLoaded(false),
+        _isExplainLoading(false),
         _isFirstPartRendered(false),
         _documents(documents),
         _queryInfo(queryInfo),
@@ -84,7 +109,9 @@ namespace Robomongo
         _outputWidget(dynamic_cast<OutputWidget*>(parentWidget())),
         _mod(NULL),
         _viewMode(viewMode),
-        _aggrInfo(aggrInfo)
+        _aggrInfo(aggrInfo),
+        _originalQueryInfo(queryInfo),
+        _sortOrder(Qt::AscendingOrder)
     {
         setup(secs, multipleResults, tabbedResults, firstItem, lastItem);
     }
@@ -93,7 +120,9 @@ namespace Robomongo
                                         bool firstItem, bool lastItem)
     {      
         setContentsMargins(0, 0, 0, 0);
+        _isExplainModeSupported = _queryInfo._info.isValid() || _aggrInfo.isValid;
         _header = new OutputItemHeaderWidget(this, multipleResults, tabbedResults, firstItem, lastItem);
+        admitDocuments();
 
         if (_queryInfo._info.isValid()) {
             _header->setCollection(QtUtils::toQString(_queryInfo._info._ns.collectionName()));
@@ -128,6 +157,12 @@ namespace Robomongo
         VERIFY(connect(_header, SIGNAL(restoredSize()), this, SIGNAL(restoredSize())));
 
         refreshOutputItem();
+
+        // Slow find queries are explained right away, so that collection scans are
+        // visible in header. Deferred until this widget is added to OutputWidget.
+        int const autoExplainMs = AppRegistry::instance().settingsManager()->autoExplainThresholdMs();
+        if (_queryInfo._info.isValid() && autoExplainMs > 0 && secs * 1000 >= autoExplainMs)
+            QTimer::singleShot(0, this, SLOT(requestExplain()));
     }
 
     void OutputItemContentWidget::paging_leftClicked(int skip, int limit)
@@ -214,20 +249,32 @@ namespace Robomongo
     }
 
     void OutputItemContentWidget::updateWithInfo(const MongoQueryInfo &inf, 
-                                                 const std::vector<MongoDocumentPtr> &documents)
+                                                 const MongoDocumentList &documents)
     {
         update(documents, inf._skip, inf._batchSize);
     }
 
     void OutputItemContentWidget::updateWithInfo(const AggrInfo &aggrInfo, 
-                                                 const std::vector<MongoDocumentPtr> &documents)
+                                                 const MongoDocumentList &documents)
     {
         update(documents, aggrInfo.skip, aggrInfo.batchSize);
     }
 
-    void OutputItemContentWidget::update(const std::vector<MongoDocumentPtr> &documents, int skip, int batchSize)
+    OutputItemContentWidget::~OutputItemContentWidget()
+    {
+        ResultMemoryGovernor::instance().release(this);
+    }
+
+    void OutputItemContentWidget::admitDocuments()
+    {
+        auto const usage = ResultMemoryGovernor::instance().admit(this, _documents);
+        _header->setMemoryUsage(usage.memoryBytes, usage.spilledBytes, usage.spilledDocuments);
+    }
+
+    void OutputItemContentWidget::update(const MongoDocumentList &documents, int skip, int batchSize)
     {
         _documents = documents;
+        admitDocuments();
 
         _header->paging()->setSkip(skip);
         _header->paging()->setBatchSize(batchSize);
@@ -253,16 +300,46 @@ namespace Robomongo
             delete _textView;
             _textView = NULL;
         }
+
+        if (_largeTextView) {
+            _stack->removeWidget(_largeTextView);
+            delete _largeTextView;
+            _largeTextView = NULL;
+        }
+
+        // Execution plan depends on skip, limit, sort and filters of reloaded query
+        _isExplainLoaded = false;
+        _isExplainLoading = false;
+        _header->setExplainSummary(QString(), false);
+        if (_explainView) {
+            _stack->removeWidget(_explainView);
+            delete _explainView;
+            _explainView = NULL;
+        }
         configureModel();
     }
 
     void OutputItemContentWidget::showText()
     {
+        TraceSpan const span("render", "OutputItemContentWidget::showText");
+
         _viewMode = Text;
         _header->showText();
         if (!_isTextModeSupported)
             return;
 
+        if (!_isTextModeInitialized && isLargeText())
+        {
+            _largeTextView = configureLargeText();
+            _stack->addWidget(_largeTextView);
+            _isTextModeInitialized = true;
+        }
+
+        if (_largeTextView) {
+            _stack->setCurrentWidget(_largeTextView);
+            return;
+        }
+
         if (!_isTextModeInitialized)
         {
             _textView = configureLogText();
@@ -287,6 +364,8 @@ namespace Robomongo
 
     void OutputItemContentWidget::showTree()
     {
+        TraceSpan const span("render", "OutputItemContentWidget::showTree");
+
         _viewMode = Tree;
         _header->showTree();
         if (!_isTreeModeSupported) {
@@ -339,6 +418,8 @@ namespace Robomongo
 
     void OutputItemContentWidget::showTable()
     {
+        TraceSpan const span("render", "OutputItemContentWidget::showTable");
+
         _viewMode = Table;
         _header->showTable();
         if (!_isTableModeSupported) {
@@ -351,8 +432,26 @@ namespace Robomongo
         if (!_isTableModeInitialized) {
             _bsonTable = new BsonTableView(_shell, _queryInfo);
             BsonTableModelProxy *modp = new BsonTableModelProxy(_bsonTable);
+            // Same columns order for every page, as sampled from the whole collection
+            if (_queryInfo._info.isValid()) {
+                CollectionSchema const* schema = AppRegistry::instance().app()->findCollectionSchema(
+                    _shell->server()->connectionRecord()->uuid(), _queryInfo._info._ns.toString());
+                if (schema) {
+                    BsonTableModelProxy::ColumnsValuesType columns;
+                    for (auto const& field : schema->topLevelFields())
+                        columns.push_back(QtUtils::toQString(field));
+                    modp->setColumnsOrder(columns);
+                }
+            }
             modp->setSourceModel(_mod);
             _bsonTable->setModel(modp);
+            _bsonTable->setSortIndicator(_sortColumn, _sortOrder);
+            VERIFY(connect(_bsonTable, SIGNAL(sortRequested(const QString&, Qt::SortOrder)), 
+                           this, SLOT(table_sortRequested(const QString&, Qt::SortOrder))));
+            VERIFY(connect(_bsonTable, SIGNAL(filterRequested(const QString&, const QString&)), 
+                           this, SLOT(table_filterRequested(const QString&, const QString&))));
+            VERIFY(connect(_bsonTable, SIGNAL(resetSortAndFilterRequested()), 
+                           this, SLOT(table_resetSortAndFilterRequested())));
             _stack->addWidget(_bsonTable);
             _isTableModeInitialized = true;
         }
@@ -360,6 +459,206 @@ namespace Robomongo
         _stack->setCurrentWidget(_bsonTable);
     }
 
+    void OutputItemContentWidget::showExplain()
+    {
+        _header->showExplain();
+        if (!_isExplainModeSupported)
+            return;
+
+        if (!_explainView) {
+            _explainView = new ExplainPlanWidget;
+            _stack->addWidget(_explainView);
+            if (_isExplainLoaded)
+                _explainView->setPlan(_explainPlan);
+            else if (_isExplainLoading)
+                _explainView->setLoading();
+        }
+
+        if (!_isExplainLoaded)
+            requestExplain();
+
+        _stack->setCurrentWidget(_explainView);
+    }
+
+    void OutputItemContentWidget::requestExplain()
+    {
+        if (_isExplainLoading)
+            return;
+
+        _isExplainLoading = true;
+        if (_explainView)
+            _explainView->setLoading();
+
+        _shell->explain(_outputWidget->partIndex(this), _queryInfo, _aggrInfo);
+    }
+
+    void OutputItemContentWidget::setExplainPlan(const MongoExplainPlan &plan)
+    {
+        // Results were reloaded while explain was running, plan is outdated
+        if (!_isExplainLoading)
+            return;
+
+        _isExplainLoading = false;
+        _isExplainLoaded = true;
+        _explainPlan = plan;
+        _header->setExplainSummary(ExplainPlanWidget::summary(plan), plan.hasCollectionScan());
+
+        if (_explainView)
+            _explainView->setPlan(plan);
+    }
+
+    void OutputItemContentWidget::setExplainError(const QString &error)
+    {
+        if (!_isExplainLoading)
+            return;
+
+        _isExplainLoading = false;
+        if (_explainView)
+            _explainView->setError(error);
+    }
+
+    void OutputItemContentWidget::showMatch(const ResultMatch &match)
+    {
+        if (!_isTreeModeSupported || match.elementPath.empty())
+            return;
+
+        if (_viewMode == Table) {
+            // Columns are top-level fields, rows are documents
+            showTable();
+            QAbstractItemModel *model = _bsonTable->model();
+            QString const column = QtUtils::toQString(match.fieldPath.substr(0, match.fieldPath.find('.')));
+            for (int col = 0; col < model->columnCount(); ++col) {
+                if (model->headerData(col, Qt::Horizontal).toString() != column)
+                    continue;
+
+                QModelIndex const index = model->index(match.document, col);
+                _bsonTable->setCurrentIndex(index);
+                _bsonTable->scrollTo(index);
+                break;
+            }
+            return;
+        }
+
+        showTree();
+        // Children of tree items are created on expand, elementPath rows are in BSON order too
+        QModelIndex index = _mod->index(match.document, 0);
+        for (int row : match.elementPath) {
+            if (_mod->canFetchMore(index))
+                _mod->fetchMore(index);
+            index = _mod->index(row, 0, index);
+        }
+
+        _bsonTreeview->setCurrentIndex(index);
+        _bsonTreeview->scrollTo(index);
+    }
+
+    void OutputItemContentWidget::table_sortRequested(const QString &column, Qt::SortOrder order)
+    {
+        _sortColumn = column;
+        _sortOrder = order;
+        applySortAndFilters();
+    }
+
+    void OutputItemContentWidget::table_filterRequested(const QString &column, const QString &value)
+    {
+        mongo::BSONObj predicate;
+        try {
+            // Value is parsed as JSON, so that numbers, booleans, ObjectIds etc. can be matched
+            mongo::BSONObj const wrapped = mongo::Robomongo::fromjson("{\"v\": " + value.toStdString() + "}");
+            mongo::BSONObjBuilder builder;
+            builder.appendAs(wrapped.firstElement(), column.toStdString());
+            predicate = builder.obj();
+        }
+        catch (const std::exception &) {
+            // Not a JSON value, compare as string
+            predicate = BSON(column.toStdString() << value.toStdString());
+        }
+
+        _columnFilters.push_back(predicate);
+        applySortAndFilters();
+    }
+
+    void OutputItemContentWidget::table_resetSortAndFilterRequested()
+    {
+        _sortColumn.clear();
+        _columnFilters.clear();
+        applySortAndFilters();
+    }
+
+    void OutputItemContentWidget::applySortAndFilters()
+    {
+        if (!_originalQueryInfo._info.isValid())
+            return;
+
+        if (_sortColumn.isEmpty() && _columnFilters.empty()) {
+            _queryInfo = _originalQueryInfo;
+        }
+        else {
+            mongo::BSONObj sort;
+            mongo::BSONObj hint;
+            if (!_sortColumn.isEmpty()) {
+                std::string const field = _sortColumn.toStdString();
+                sort = BSON(field << (_sortOrder == Qt::AscendingOrder ? 1 : -1));
+                hint = indexHint(field);
+            }
+
+            mongo::BSONObj predicate;
+            if (_columnFilters.size() == 1) {
+                predicate = _columnFilters.front();
+            }
+            else if (_columnFilters.size() > 1) {
+                mongo::BSONArrayBuilder filters;
+                for (auto const& filter : _columnFilters)
+                    filters.append(filter);
+                predicate = BSON("$and" << filters.arr());
+            }
+
+            _queryInfo = _originalQueryInfo.rewritten(sort, predicate, hint);
+        }
+
+        // Sort or filter changes the whole result set, start from the first page
+        refresh(_initialSkip, _queryInfo._batchSize);
+    }
+
+    mongo::BSONObj OutputItemContentWidget::indexHint(const std::string &field) const
+    {
+        // With a filter, query planner knows better which index to use
+        if (!_columnFilters.empty() || !_originalQueryInfo.filter().isEmpty())
+            return mongo::BSONObj();
+
+        // Index catalog is kept by explorer's (primary) server of this connection
+        QString const& uuid = _shell->server()->connectionRecord()->uuid();
+        MongoNamespace const& ns = _originalQueryInfo._info._ns;
+        for (auto const& server : AppRegistry::instance().app()->getServers()) {
+            if (server->connectionRecord()->uuid() != uuid)
+                continue;
+
+            MongoDatabase *database = server->findDatabaseByName(ns.databaseName());
+            std::vector<IndexInfo> indexes;
+            if (!database || !database->cachedIndexes(ns.collectionName(), indexes))
+                continue;
+
+            for (auto const& index : indexes) {
+                // Sparse and partial indexes do not have every document, hint would drop
+                // documents from the result. Collation of index may differ from the query.
+                if (index._sparse || index._partial || index._collation)
+                    continue;
+
+                try {
+                    mongo::BSONObj const keys = mongo::Robomongo::fromjson(index._keys);
+                    mongo::BSONElement const first = keys.firstElement();
+                    // Only regular ascending/descending indexes can serve sort (not hashed, text etc.)
+                    if (field == first.fieldName() && first.isNumber())
+                        return keys;
+                }
+                catch (const std::exception &) {
+                    continue;
+                }
+            }
+        }
+        return mongo::BSONObj();
+    }
+
     void OutputItemContentWidget::markUninitialized()
     {
         _isTextModeInitialized = false;
@@ -408,6 +707,45 @@ namespace Robomongo
         return _mod;
     }
 
+    bool OutputItemContentWidget::isLargeText() const
+    {
+        qint64 const threshold = qint64(AppRegistry::instance().settingsManager()->largeTextThresholdMb()) * 1024 * 1024;
+        if (threshold <= 0)
+            return false;
+
+        if (!_text.isEmpty())
+            return _text.size() * 2 > threshold;
+
+        // Formatted JSON is larger than BSON, so this is a lower estimate
+        qint64 bsonSize = 0;
+        for (auto const& doc : _documents) {
+            bsonSize += doc->byteSize();
+            if (bsonSize > threshold)
+                return true;
+        }
+        return false;
+    }
+
+    LargeTextView *OutputItemContentWidget::configureLargeText()
+    {
+        auto buffer = std::make_shared<LargeTextBuffer>();
+        LargeTextView *view = new LargeTextView(buffer, this);
+        if (!_text.isEmpty()) {
+            buffer->append(_text);
+            view->refresh();
+            return view;
+        }
+
+        // Lines are indexed in background as JSON is appended, view shows what is ready
+        JsonPrepareThread *thread = new JsonPrepareThread(_documents, AppRegistry::instance().settingsManager()->uuidEncoding(),
+                                                          AppRegistry::instance().settingsManager()->timeZone(), buffer);
+        VERIFY(connect(thread, SIGNAL(done()), view, SLOT(stopLoading())));
+        VERIFY(connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater())));
+        view->startLoading();
+        thread->start();
+        return view;
+    }
+
     FindFrame *Robomongo::OutputItemContentWidget::configureLogText()
     {
         const QFont &textFont = GuiRegistry::instance().font();
@@ -3,8 +3,10 @@
 #include <QStackedWidget>
 
 #include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoDocumentList.h"
 #include "robomongo/core/domain/MongoQueryInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/MongoExplainPlan.h"
 #include "robomongo/core/Enums.h"
 #include <vector>
 
@@ -15,10 +17,13 @@ namespace Robomongo
     class BsonTableView;
     class BsonTreeModel;
     class JsonPrepareThread;
+    class LargeTextView;
     class CollectionStatsTreeWidget;
+    class ExplainPlanWidget;
     class MongoShell;
     class OutputItemHeaderWidget;
     class OutputWidget;
+    struct ResultMatch;
 
     class OutputItemContentWidget : public QWidget
     {
@@ -31,20 +36,29 @@ namespace Robomongo
                                 AggrInfo aggrInfo, QWidget *parent);
 
         OutputItemContentWidget(ViewMode viewMode, MongoShell *shell, const QString &type,
-                                const std::vector<MongoDocumentPtr> &documents, 
+                                const MongoDocumentList &documents, 
                                 const MongoQueryInfo &queryInfo, double secs, bool multipleResults,
                                 bool tabbedResults, bool firstItem, bool lastItem, AggrInfo aggrInfo,
                                 QWidget *parent);
+        ~OutputItemContentWidget();
         int _initialSkip;
         int _initialLimit;
-        void updateWithInfo(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents);
-        void updateWithInfo(const AggrInfo &aggrInfo, const std::vector<MongoDocumentPtr> &documents);
-        void update(const std::vector<MongoDocumentPtr> &documents, int skip, int batchSize);
+        void updateWithInfo(const MongoQueryInfo &inf, const MongoDocumentList &documents);
+        void updateWithInfo(const AggrInfo &aggrInfo, const MongoDocumentList &documents);
+        void update(const MongoDocumentList &documents, int skip, int batchSize);
         bool isTextModeSupported() const { return _isTextModeSupported; }
         bool isTreeModeSupported() const { return _isTreeModeSupported; }
         bool isCustomModeSupported() const { return _isCustomModeSupported; }
         bool isTableModeSupported() const { return _isTableModeSupported; }
+        bool isExplainModeSupported() const { return _isExplainModeSupported; }
         ViewMode viewMode() const { return _viewMode; }
+        const MongoDocumentList &documents() const { return _documents; }
+
+        /**
+         * @brief Selects matched value in tree or table view. Text and custom
+         *        views show no BSON elements, so they are switched to tree view.
+         */
+        void showMatch(const ResultMatch &match);
 
         void refreshOutputItem();
         void markUninitialized();
@@ -54,6 +68,12 @@ namespace Robomongo
 
         const OutputWidget* outputWidget() const { return _outputWidget; }
 
+        /**
+         * @brief Called when execution plan requested by this widget is loaded
+         */
+        void setExplainPlan(const MongoExplainPlan &plan);
+        void setExplainError(const QString &error);
+
     Q_SIGNALS:
         void restoredSize();
         void maximizedPart();
@@ -64,29 +84,70 @@ namespace Robomongo
         void showTable();
         void showCustom();
 
+        /**
+         * @brief Shows execution plan of query. Explain view is not a ViewMode,
+         *        so that it is never saved as default mode or applied to other results.
+         */
+        void showExplain();
+
     private Q_SLOTS:
+        void requestExplain();
         void jsonPartReady(const QString &json);
         void refresh(int skip, int batchSize);
         void paging_rightClicked(int skip, int batchSize);
         void paging_leftClicked(int skip, int limit);      
+        void table_sortRequested(const QString &column, Qt::SortOrder order);
+        void table_filterRequested(const QString &column, const QString &value);
+        void table_resetSortAndFilterRequested();
 
     private:
         void setup(double secs, bool multipleResults, bool tabbedResults, bool firstItem, bool lastItem);
+
+        // Accounts _documents in memory budget of results, shows usage in header
+        void admitDocuments();
         FindFrame *configureLogText();
+
+        // Result is too large for QScintilla (see SettingsManager::largeTextThresholdMb())
+        bool isLargeText() const;
+        LargeTextView *configureLargeText();
         BsonTreeModel *configureModel();
 
+        /**
+         * @brief Rebuilds _queryInfo from original query, current sort column and
+         *        column filters, and re-runs it from the first page.
+         */
+        void applySortAndFilters();
+
+        /**
+         * @brief Returns key pattern of index, that can serve sort by 'field',
+         *        or empty object if index catalog has no such index.
+         */
+        mongo::BSONObj indexHint(const std::string &field) const;
+
         FindFrame *_textView;
+        LargeTextView *_largeTextView;
         BsonTreeView *_bsonTreeview;
         BsonTableView *_bsonTable;
         BsonTreeModel *_mod;
         CollectionStatsTreeWidget *_collectionStats;
+        ExplainPlanWidget *_explainView;
 
         QString _text;
         QString _type; // type of request
-        std::vector<MongoDocumentPtr> _documents;
+        MongoDocumentList _documents;
         MongoQueryInfo _queryInfo;
         AggrInfo _aggrInfo;
 
+        // Query as it was executed by user, before table header sort and filters
+        MongoQueryInfo _originalQueryInfo;
+        QString _sortColumn;
+        Qt::SortOrder _sortOrder;
+        std::vector<mongo::BSONObj> _columnFilters;
+
+        MongoExplainPlan _explainPlan;
+        bool _isExplainLoaded;
+        bool _isExplainLoading;
+
         QStackedWidget *_stack;
         JsonPrepareThread *_thread;
 
@@ -97,6 +158,7 @@ namespace Robomongo
         bool _isTreeModeSupported;
         bool _isTableModeSupported;
         bool _isCustomModeSupported;
+        bool _isExplainModeSupported;
 
         bool _isTextModeInitialized;
         bool _isTreeModeInitialized;
@@ -79,6 +79,15 @@ namespace Robomongo
         _customButton->setFlat(true);
         _customButton->setCheckable(true);
 
+        // Explain mode button
+        _explainButton = new QPushButton(this);
+        _explainButton->hide();
+        _explainButton->setIcon(GuiRegistry::instance().indexIcon());
+        _explainButton->setToolTip("View execution plan of query");
+        _explainButton->setFixedSize(24, 24);
+        _explainButton->setFlat(true);
+        _explainButton->setCheckable(true);
+
         // Create maximize button only if there are multiple results
         if (_multipleResults && !tabbedResults) {
             _maxButton = new QPushButton;
@@ -103,13 +112,17 @@ namespace Robomongo
         VERIFY(connect(_treeButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showTree())));
         VERIFY(connect(_tableButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showTable())));
         VERIFY(connect(_customButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showCustom())));
+        VERIFY(connect(_explainButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showExplain())));
 
         _collectionIndicator = new Indicator(GuiRegistry::instance().collectionIcon());
         _timeIndicator = new Indicator(GuiRegistry::instance().timeIcon());
         _paging = new PagingWidget();
+        _memoryLabel = new QLabel;
+        _memoryLabel->setStyleSheet("color: #777777;");
 
         _collectionIndicator->hide();
         _timeIndicator->hide();
+        _memoryLabel->hide();
         _paging->hide();
 
         QHBoxLayout *layout = new QHBoxLayout();
@@ -121,6 +134,7 @@ namespace Robomongo
         layout->setSpacing(0);
         layout->addWidget(_collectionIndicator);
         layout->addWidget(_timeIndicator);
+        layout->addWidget(_memoryLabel);
         QSpacerItem *hSpacer = new QSpacerItem(2000, 24, QSizePolicy::Preferred, QSizePolicy::Minimum);
         layout->addSpacerItem(hSpacer);
         layout->addWidget(_paging);
@@ -145,6 +159,11 @@ namespace Robomongo
         if (outputItemContentWidget->isTextModeSupported())
             layout->addWidget(_textButton, 0, Qt::AlignRight);
 
+        if (outputItemContentWidget->isExplainModeSupported()) {
+            layout->addWidget(_explainButton, 0, Qt::AlignRight);
+            _explainButton->show();
+        }
+
         if (_multipleResults)
             layout->addWidget(_maxButton, 0, Qt::AlignRight);
 
@@ -183,6 +202,7 @@ namespace Robomongo
         _tableButton->setChecked(false);
         _customButton->setIcon(GuiRegistry::instance().customIcon());
         _customButton->setChecked(false);
+        _explainButton->setChecked(false);
     }
 
     void OutputItemHeaderWidget::showTree()
@@ -195,6 +215,7 @@ namespace Robomongo
         _tableButton->setChecked(false);
         _customButton->setIcon(GuiRegistry::instance().customIcon());
         _customButton->setChecked(false);
+        _explainButton->setChecked(false);
     }
 
     void OutputItemHeaderWidget::showTable()
@@ -207,6 +228,7 @@ namespace Robomongo
         _tableButton->setChecked(true);
         _customButton->setIcon(GuiRegistry::instance().customIcon());
         _customButton->setChecked(false);
+        _explainButton->setChecked(false);
     }
 
     void OutputItemHeaderWidget::showCustom()
@@ -219,6 +241,26 @@ namespace Robomongo
         _tableButton->setChecked(false);
         _customButton->setIcon(GuiRegistry::instance().customHighlightedIcon());
         _customButton->setChecked(true);
+        _explainButton->setChecked(false);
+    }
+
+    void OutputItemHeaderWidget::showExplain()
+    {
+        _textButton->setIcon(GuiRegistry::instance().textIcon());
+        _textButton->setChecked(false);
+        _treeButton->setIcon(GuiRegistry::instance().treeIcon());
+        _treeButton->setChecked(false);
+        _tableButton->setIcon(GuiRegistry::instance().tableIcon());
+        _tableButton->setChecked(false);
+        _customButton->setIcon(GuiRegistry::instance().customIcon());
+        _customButton->setChecked(false);
+        _explainButton->setChecked(true);
+    }
+
+    void OutputItemHeaderWidget::setExplainSummary(const QString &summary, bool warning)
+    {
+        _explainButton->setToolTip(summary.isEmpty() ? "View execution plan of query" : summary);
+        _explainButton->setStyleSheet(warning ? "QPushButton { background-color: #f9d6d5; }" : "");
     }
 
     void OutputItemHeaderWidget::applyDockUndockSettings(bool isDocking)
@@ -248,6 +290,22 @@ namespace Robomongo
         _timeIndicator->setText(time);
     }
 
+    void OutputItemHeaderWidget::setMemoryUsage(qint64 memoryBytes, qint64 spilledBytes, int spilledDocuments)
+    {
+        auto const toMb = [](qint64 bytes) { return QString::number(bytes / (1024.0 * 1024.0), 'f', 1); };
+
+        _memoryLabel->setVisible(memoryBytes + spilledBytes > 0);
+        if (spilledBytes == 0) {
+            _memoryLabel->setText(QString("%1 MB").arg(toMb(memoryBytes)));
+            _memoryLabel->setToolTip("Size of documents of this result in memory");
+            return;
+        }
+
+        _memoryLabel->setText(QString("%1 MB + %2 MB on disk").arg(toMb(memoryBytes), toMb(spilledBytes)));
+        _memoryLabel->setToolTip(QString("%1 documents over memory budget of query results are kept in "
+                                         "a temporary file and read back when viewed").arg(spilledDocuments));
+    }
+
     void OutputItemHeaderWidget::setCollection(const QString &collection)
     {
         _collectionIndicator->setVisible(!collection.isEmpty());
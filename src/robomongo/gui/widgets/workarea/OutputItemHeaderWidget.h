@@ -3,6 +3,7 @@
 #include <QWidget>
 QT_BEGIN_NAMESPACE
 class QPushButton;
+class QLabel;
 QT_END_NAMESPACE
 
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
@@ -26,6 +27,16 @@ namespace Robomongo
         void showTree();
         void showTable();
         void showCustom();
+        void showExplain();
+
+        /**
+         * @brief Shows summary of execution plan in tooltip of explain button,
+         *        'warning' marks plans with collection scan.
+         */
+        void setExplainSummary(const QString &summary, bool warning);
+
+        // Bytes of documents in memory and spilled to disk (see ResultMemoryGovernor)
+        void setMemoryUsage(qint64 memoryBytes, qint64 spilledBytes, int spilledDocuments);
         void applyDockUndockSettings(bool docking);
         void toggleOrientation(Qt::Orientation orientation);
 
@@ -48,11 +59,13 @@ namespace Robomongo
         QPushButton *_treeButton;
         QPushButton *_tableButton;
         QPushButton *_customButton;
+        QPushButton *_explainButton;
         QPushButton *_maxButton;
         QFrame *_verticalLine;
         QPushButton *_dockUndockButton;
         Indicator *_collectionIndicator;
         Indicator *_timeIndicator;
+        QLabel *_memoryLabel;
         PagingWidget *_paging;
 
         bool _maximized;
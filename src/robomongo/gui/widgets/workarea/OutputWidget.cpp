@@ -1,5 +1,6 @@
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 
+#include <algorithm>
 #include <QHBoxLayout>
 #include <QSplitter>
 #include <QWidget>
@@ -7,12 +8,14 @@
 
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/domain/MongoShell.h"
+#include "robomongo/core/domain/ResultSearch.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 #include "robomongo/gui/widgets/workarea/ProgressBarPopup.h"
 #include "robomongo/gui/widgets/workarea/WorkAreaTabBar.h"
+#include "robomongo/core/utils/Tracer.h"
 
 namespace Robomongo
 {
@@ -45,6 +48,8 @@ namespace Robomongo
 
     void OutputWidget::present(MongoShell *shell, const std::vector<MongoShellResult> &results)
     {
+        TraceSpan const span("render", "OutputWidget::present");
+
         if (_prevResultsCount > 0)
             clearAllParts();
         
@@ -58,7 +63,7 @@ namespace Robomongo
             removeTab(count()-1);
 
         for (int i = 0; i < RESULTS_SIZE; ++i) {
-            MongoShellResult shellResult = results[i];
+            MongoShellResult const& shellResult = results[i];
             double secs = shellResult.elapsedMs() / 1000.f;
             ViewMode viewMode = AppRegistry::instance().settingsManager()->viewMode();
             if (_prevViewModes.size()) {
@@ -97,7 +102,7 @@ namespace Robomongo
     }
 
     void OutputWidget::updatePart(int partIndex, const MongoQueryInfo &queryInfo, 
-                                  const std::vector<MongoDocumentPtr> &documents)
+                                  const MongoDocumentList &documents)
     {
         if (!_tabbedResults && partIndex >= _splitter->count())
             return;
@@ -113,7 +118,7 @@ namespace Robomongo
     }
 
     void OutputWidget::updatePart(int partIndex, const AggrInfo &agrrInfo, 
-                                  const std::vector<MongoDocumentPtr> &documents)
+                                  const MongoDocumentList &documents)
     {
         if (partIndex >= _splitter->count())
             return;
@@ -123,6 +128,22 @@ namespace Robomongo
         outputItemContentWidget->refreshOutputItem();
     }
 
+    void OutputWidget::updateExplainPlan(int partIndex, const MongoExplainPlan &plan)
+    {
+        if (partIndex < 0 || partIndex >= _outputItemContentWidgets.size())
+            return;
+
+        _outputItemContentWidgets[partIndex]->setExplainPlan(plan);
+    }
+
+    void OutputWidget::updateExplainError(int partIndex, const QString &error)
+    {
+        if (partIndex < 0 || partIndex >= _outputItemContentWidgets.size())
+            return;
+
+        _outputItemContentWidgets[partIndex]->setExplainError(error);
+    }
+
     void OutputWidget::toggleOrientation()
     {
         bool const horizontal = _splitter->orientation() == Qt::Horizontal;
@@ -203,6 +224,38 @@ namespace Robomongo
         return _splitter->indexOf(result);
     }
 
+    int OutputWidget::partIndex(OutputItemContentWidget *result) const
+    {
+        auto const it = std::find(_outputItemContentWidgets.begin(), _outputItemContentWidgets.end(), result);
+        return it == _outputItemContentWidgets.end() ? -1 : it - _outputItemContentWidgets.begin();
+    }
+
+    std::vector<MongoDocumentList> OutputWidget::documentLists() const
+    {
+        std::vector<MongoDocumentList> lists;
+        for (auto const& item : _outputItemContentWidgets)
+            lists.push_back(item->documents());
+        return lists;
+    }
+
+    void OutputWidget::showMatch(const ResultMatch &match)
+    {
+        if (match.part < 0 || match.part >= _outputItemContentWidgets.size())
+            return;
+
+        OutputItemContentWidget *item = _outputItemContentWidgets[match.part];
+        if (_tabbedResults) {
+            if (indexOf(item) < 0)  // Tab was closed
+                return;
+            setCurrentWidget(item);
+        }
+        else if (item->isHidden()) {
+            restoreSize();
+        }
+
+        item->showMatch(match);
+    }
+
     void OutputWidget::showProgress()
     {
         QSize siz = size();
@@ -13,6 +13,8 @@ namespace Robomongo
     class OutputItemContentWidget;
     class ProgressBarPopup;
     class MongoShell;
+    class MongoExplainPlan;
+    struct ResultMatch;
 
     class OutputWidget : public QTabWidget
     {
@@ -23,9 +25,11 @@ namespace Robomongo
 
         void present(MongoShell *shell, const std::vector<MongoShellResult> &documents);
         void updatePart(int partIndex, const MongoQueryInfo &queryInfo, 
-                        const std::vector<MongoDocumentPtr> &documents);
+                        const MongoDocumentList &documents);
         void updatePart(int partIndex, const AggrInfo &agrrInfo,
-                        const std::vector<MongoDocumentPtr> &documents);
+                        const MongoDocumentList &documents);
+        void updateExplainPlan(int partIndex, const MongoExplainPlan &plan);
+        void updateExplainError(int partIndex, const QString &error);
         void toggleOrientation();
 
         void switchMode(std::function<void(OutputItemContentWidget*)> modeFunc);
@@ -36,6 +40,18 @@ namespace Robomongo
 
         int resultIndex(OutputItemContentWidget *result);
 
+        /**
+         * @brief Position of 'result' among all results. Unlike resultIndex(),
+         *        valid in tabbed mode too.
+         */
+        int partIndex(OutputItemContentWidget *result) const;
+
+        // Documents of all results, currently loaded page of each
+        std::vector<MongoDocumentList> documentLists() const;
+
+        // Brings result of 'match' to front and selects matched value in it
+        void showMatch(const ResultMatch &match);
+
         void showProgress();
         void hideProgress();
         bool progressBarActive() const;
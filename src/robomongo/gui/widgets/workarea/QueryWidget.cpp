@@ -9,6 +9,7 @@
 #include <QMessageBox>
 #include <QMainWindow>
 #include <QDockWidget>
+#include <QKeyEvent>
 #include <Qsci/qsciscintilla.h>
 #include <Qsci/qscilexerjavascript.h>
 #include <mongo/client/dbclient_base.h>
@@ -21,6 +22,7 @@
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoShell.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/MongoExplainPlan.h"
 #include "robomongo/core/events/MongoEvents.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/SettingsManager.h"
@@ -32,6 +34,7 @@
 #include "robomongo/gui/widgets/workarea/ScriptWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemHeaderWidget.h"
+#include "robomongo/gui/widgets/workarea/ResultFindBar.h"
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
 #include "robomongo/gui/editors/JSLexer.h"
 #include "robomongo/gui/dialogs/ChangeShellTimeoutDialog.h"
@@ -44,12 +47,14 @@ namespace Robomongo
         QWidget(parent),
         _shell(shell),
         _viewer(nullptr),
+        _findBar(nullptr),
+        _outputPane(nullptr),
         _dock(nullptr),
         _isTextChanged(false)
     {
         AppRegistry::instance().bus()->subscribe(this, DocumentListLoadedEvent::Type, shell);
+        AppRegistry::instance().bus()->subscribe(this, QueryExplainedEvent::Type, shell);
         AppRegistry::instance().bus()->subscribe(this, ScriptExecutedEvent::Type, shell);
-        AppRegistry::instance().bus()->subscribe(this, AutocompleteResponse::Type, shell);
 
         // Make QMessageBox text selectable
         // setStyleSheet("QMessageBox { messagebox-text-interaction-flags: 5; }");
@@ -60,11 +65,22 @@ namespace Robomongo
         // Need to use QMainWindow in order to make use of all features of docking.
         // (Note: Qt full support for dock windows implemented only for QMainWindow)
         _viewer = new OutputWidget(this);
+        _findBar = new ResultFindBar(_viewer);
+        _outputPane = new QWidget;
+        QVBoxLayout *outputLayout = new QVBoxLayout;
+        outputLayout->setSpacing(0);
+        outputLayout->setContentsMargins(0, 0, 0, 0);
+        outputLayout->addWidget(_viewer, 1);
+        outputLayout->addWidget(_findBar);
+        _outputPane->setLayout(outputLayout);
+        // Key presses not handled by result views propagate up to _outputPane
+        _outputPane->installEventFilter(this);
+
         _outputWindow = new QMainWindow;
         _dock = new CustomDockWidget(this);
         _dock->setAllowedAreas(Qt::NoDockWidgetArea);
         _dock->setFeatures(QDockWidget::DockWidgetFloatable);
-        _dock->setWidget(_viewer);
+        _dock->setWidget(_outputPane);
         _dock->setTitleBarWidget(new QWidget);
         VERIFY(connect(_dock, SIGNAL(topLevelChanged(bool)), this, SLOT(on_dock_undock())));
         _outputWindow->addDockWidget(Qt::BottomDockWidgetArea, _dock);
@@ -261,6 +277,18 @@ namespace Robomongo
 
         // this should be in viewer, subscribed to ScriptExecutedEvent
         _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); 
+        _findBar->invalidate();
+    }
+
+    void QueryWidget::handle(QueryExplainedEvent *event)
+    {
+        if (event->isError()) {
+            _viewer->updateExplainError(event->resultIndex(), 
+                                        QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        _viewer->updateExplainPlan(event->resultIndex(), MongoExplainPlan(event->explain()));
     }
 
     void QueryWidget::handle(ScriptExecutedEvent *event)
@@ -273,6 +301,7 @@ namespace Robomongo
             AggrInfo const& aggrInfo = result.aggrInfo();
             if (aggrInfo.isValid && aggrInfo.resultIndex > -1) {
                 _viewer->updatePart(aggrInfo.resultIndex, aggrInfo, _currentResult.results().front().documents());
+                _findBar->invalidate();
                 return;
             }
         }
@@ -323,16 +352,6 @@ namespace Robomongo
         _scriptWidget->setScriptFocus();
     }
 
-    void QueryWidget::handle(AutocompleteResponse *event)
-    {
-        if (event->isError()) {
-            // Do not show error message (error should be already logged)
-            return;
-        }
-
-        _scriptWidget->showAutocompletion(event->list, QtUtils::toQString(event->prefix) );
-    }
-
     void QueryWidget::on_dock_undock()
     {
         if (!_dock->isFloating()) {    // If output window docked 
@@ -405,5 +424,16 @@ namespace Robomongo
         }
 
         _viewer->present(_shell, results);
+        _findBar->invalidate();
+    }
+
+    bool QueryWidget::eventFilter(QObject *watched, QEvent *event)
+    {
+        if (watched == _outputPane && event->type() == QEvent::KeyPress
+            && static_cast<QKeyEvent *>(event)->matches(QKeySequence::Find)) {
+            _findBar->activate();
+            return true;
+        }
+        return QWidget::eventFilter(watched, event);
     }
 }
@@ -19,9 +19,10 @@ namespace Robomongo
 {
     class BsonWidget;
     class DocumentListLoadedEvent;
+    class QueryExplainedEvent;
     class ScriptExecutedEvent;
-    class AutocompleteResponse;
     class OutputWidget;
+    class ResultFindBar;
     class ScriptWidget;
     class MongoShell;
 
@@ -72,8 +73,12 @@ namespace Robomongo
         void hideProgress();
 
         void handle(DocumentListLoadedEvent *event);
+        void handle(QueryExplainedEvent *event);
         void handle(ScriptExecutedEvent *event);
-        void handle(AutocompleteResponse *event);
+
+    protected:
+        // Opens find in results on Ctrl+F in output window
+        bool eventFilter(QObject *watched, QEvent *event) override;
 
     private Q_SLOTS:
         // Make adjustments between output window dock/undock events
@@ -89,6 +94,8 @@ namespace Robomongo
 
         MongoShell *_shell;
         OutputWidget *_viewer;
+        ResultFindBar *_findBar;
+        QWidget *_outputPane;       // _viewer and _findBar
         ScriptWidget *_scriptWidget;
         QLabel *_outputLabel;
         QDockWidget *_dock;
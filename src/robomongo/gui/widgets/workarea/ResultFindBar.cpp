@@ -0,0 +1,158 @@
+#include "robomongo/gui/widgets/workarea/ResultFindBar.h"
+
+#include <QHBoxLayout>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QToolButton>
+#include <QLabel>
+#include <QKeyEvent>
+#include <QApplication>
+
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/OutputWidget.h"
+
+namespace Robomongo
+{
+    ResultFindBar::ResultFindBar(OutputWidget *output, QWidget *parent) :
+        QFrame(parent),
+        _output(output),
+        _text(new QLineEdit(this)),
+        _fieldPath(new QLineEdit(this)),
+        _caseSensitive(new QCheckBox("Match case", this)),
+        _regex(new QCheckBox("Regex", this)),
+        _next(new QPushButton("Next", this)),
+        _prev(new QPushButton("Previous", this)),
+        _status(new QLabel(this)),
+        _close(new QToolButton(this)),
+        _current(-1),
+        _isSearched(false)
+    {
+        _text->setPlaceholderText("Find in results");
+        _fieldPath->setPlaceholderText("In field (i.e. address.city)");
+        _fieldPath->setMaximumWidth(200);
+        _close->setIcon(QIcon(":/robomongo/icons/close_2_16x16.png"));
+        _close->setToolButtonStyle(Qt::ToolButtonIconOnly);
+        _close->setIconSize(QSize(16, 16));
+        _close->setAutoRaise(true);
+
+        QHBoxLayout *layout = new QHBoxLayout();
+        layout->setContentsMargins(2, 2, 6, 2);
+        layout->setSpacing(7);
+        layout->addWidget(_text, 1);
+        layout->addWidget(_fieldPath);
+        layout->addWidget(_next);
+        layout->addWidget(_prev);
+        layout->addWidget(_caseSensitive);
+        layout->addWidget(_regex);
+        layout->addWidget(_status);
+        layout->addWidget(_close);
+        setLayout(layout);
+        hide();
+
+        VERIFY(connect(_text, SIGNAL(returnPressed()), this, SLOT(findNext())));
+        VERIFY(connect(_fieldPath, SIGNAL(returnPressed()), this, SLOT(findNext())));
+        VERIFY(connect(_next, SIGNAL(clicked()), this, SLOT(findNext())));
+        VERIFY(connect(_prev, SIGNAL(clicked()), this, SLOT(findPrevious())));
+        VERIFY(connect(_text, SIGNAL(textChanged(const QString&)), this, SLOT(optionsChanged())));
+        VERIFY(connect(_fieldPath, SIGNAL(textChanged(const QString&)), this, SLOT(optionsChanged())));
+        VERIFY(connect(_caseSensitive, SIGNAL(toggled(bool)), this, SLOT(optionsChanged())));
+        VERIFY(connect(_regex, SIGNAL(toggled(bool)), this, SLOT(optionsChanged())));
+        VERIFY(connect(_close, SIGNAL(clicked()), this, SLOT(hide())));
+    }
+
+    void ResultFindBar::activate()
+    {
+        show();
+        _text->setFocus();
+        _text->selectAll();
+    }
+
+    void ResultFindBar::invalidate()
+    {
+        optionsChanged();
+    }
+
+    void ResultFindBar::keyPressEvent(QKeyEvent *event)
+    {
+        if (event->key() == Qt::Key_Escape) {
+            hide();
+            return event->accept();
+        }
+        QFrame::keyPressEvent(event);
+    }
+
+    void ResultFindBar::optionsChanged()
+    {
+        _isSearched = false;
+        _matches.clear();
+        _current = -1;
+        _status->clear();
+        setNotFound(false);
+    }
+
+    void ResultFindBar::findNext()
+    {
+        // Shift+Enter in search text
+        if (QApplication::keyboardModifiers() & Qt::ShiftModifier)
+            return findPrevious();
+
+        if (search())
+            showMatch((_current + 1) % _matches.size());
+    }
+
+    void ResultFindBar::findPrevious()
+    {
+        if (search())
+            showMatch(_current <= 0 ? _matches.size() - 1 : _current - 1);
+    }
+
+    bool ResultFindBar::search()
+    {
+        if (_isSearched)
+            return !_matches.empty();
+
+        if (_text->text().isEmpty())
+            return false;
+
+        ResultSearchOptions options;
+        options.text = _text->text();
+        options.caseSensitive = _caseSensitive->isChecked();
+        options.regex = _regex->isChecked();
+        options.fieldPath = _fieldPath->text();
+
+        ResultSearch const search(options);
+        if (!search.isValid()) {
+            _status->setText(search.errorString());
+            setNotFound(true);
+            return false;
+        }
+
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        _matches = search.find(_output->documentLists(), MaxMatches);
+        QApplication::restoreOverrideCursor();
+
+        _isSearched = true;
+        _current = -1;
+        setNotFound(_matches.empty());
+        if (_matches.empty())
+            _status->setText("Not found");
+
+        return !_matches.empty();
+    }
+
+    void ResultFindBar::showMatch(int index)
+    {
+        _current = index;
+        QString const total = static_cast<int>(_matches.size()) < MaxMatches
+            ? QString::number(_matches.size()) : QString("%1+").arg(MaxMatches);
+        _status->setText(QString("%1 of %2").arg(index + 1).arg(total));
+
+        _output->showMatch(_matches[index]);
+    }
+
+    void ResultFindBar::setNotFound(bool notFound)
+    {
+        _text->setStyleSheet(notFound ? "QLineEdit { background-color: #FFC7C7; }" : "");
+    }
+}
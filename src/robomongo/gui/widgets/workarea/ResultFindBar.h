@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+#include <QFrame>
+
+QT_BEGIN_NAMESPACE
+class QLineEdit;
+class QCheckBox;
+class QPushButton;
+class QToolButton;
+class QLabel;
+QT_END_NAMESPACE
+
+#include "robomongo/core/domain/ResultSearch.h"
+
+namespace Robomongo
+{
+    class OutputWidget;
+
+    /**
+     * @brief Find panel below query results: searches values of documents of all
+     *        results of OutputWidget (see ResultSearch) and selects matches one by
+     *        one in tree or table view of their result.
+     */
+    class ResultFindBar : public QFrame
+    {
+        Q_OBJECT
+
+    public:
+        // Matches beyond this are not collected, status shows "N+"
+        static const int MaxMatches = 10000;
+
+        explicit ResultFindBar(OutputWidget *output, QWidget *parent = nullptr);
+
+        // Shows panel and focuses search text
+        void activate();
+
+        // Results were changed, matches are searched again on next find
+        void invalidate();
+
+    protected:
+        void keyPressEvent(QKeyEvent *event) override;
+
+    private Q_SLOTS:
+        void findNext();
+        void findPrevious();
+        void optionsChanged();
+
+    private:
+        // Searches again if options or results changed, false if there are no matches
+        bool search();
+        void showMatch(int index);
+        void setNotFound(bool notFound);
+
+        OutputWidget *const _output;
+        QLineEdit *const _text;
+        QLineEdit *const _fieldPath;
+        QCheckBox *const _caseSensitive;
+        QCheckBox *const _regex;
+        QPushButton *const _next;
+        QPushButton *const _prev;
+        QLabel *const _status;
+        QToolButton *const _close;
+
+        std::vector<ResultMatch> _matches;
+        int _current;
+        bool _isSearched;
+    };
+}
@@ -15,7 +15,7 @@
 #include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
 #include "robomongo/gui/widgets/workarea/QueryWidget.h"
 #include "robomongo/gui/GuiRegistry.h"
-#include "robomongo/gui/editors/JSLexer.h"
+#include "robomongo/gui/editors/IncrementalJSLexer.h"
 #include "robomongo/gui/editors/FindFrame.h"
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
 
@@ -207,7 +207,14 @@ namespace Robomongo
             return;
         }
 
-        _shell->autocomplete(QtUtils::toStdString(_currentAutoCompletionInfo.text()));
+        QString const prefix = _currentAutoCompletionInfo.text();
+        QStringList const list = _shell->complete(prefix);
+        if (list.isEmpty()) {
+            hideAutocompletion();
+            return;
+        }
+
+        showAutocompletion(list, prefix);
     }
 
     void ScriptWidget::hideAutocompletion()
@@ -239,6 +246,11 @@ namespace Robomongo
             if (editorTotalHeight > maxHeight) {
                 editorTotalHeight = maxHeight;
             }
+
+            // Typing in long scripts changes number of lines, but not the height
+            if (editorTotalHeight == _queryText->sciScintilla()->height())
+                return;
+
             // Hide & Show solves problem of UI blinking
             _queryText->hide();
             _queryText->setFixedHeight(editorTotalHeight);
@@ -296,7 +308,7 @@ namespace Robomongo
     */
     void ScriptWidget::configureQueryText()
     {
-        QsciLexerJavaScript *javaScriptLexer = new JSLexer(this);
+        QsciLexer *javaScriptLexer = new IncrementalJSLexer(this);
         javaScriptLexer->setFont(GuiRegistry::instance().font());
         int height = editorHeight(1);
         _queryText->sciScintilla()->setMinimumHeight(height);
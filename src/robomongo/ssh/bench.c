@@ -0,0 +1,525 @@
+/*
+ * Loopback benchmark of the tunnel event loop (see tunnel.c).
+ *
+ * SSH server is replaced by an in-process stand-in: a thread that accepts one
+ * TCP connection (the "transport" socket) and echoes back frames of a trivial
+ * multiplexing protocol (channel id and length, followed by payload). This way
+ * numbers show the cost of the tunnel itself, not of crypto or the network.
+ *
+ * Usage: ssh_bench [connections] [megabytes per connection]
+ */
+
+#include "robomongo/ssh/private.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    FRAME_HEADER = 8,                   // channel id and payload length, network byte order
+    MAX_FRAME = 16384,
+    CHANNEL_WINDOW = 256 * 1024,        // max bytes in flight per client, like SSH window
+    PING_SIZE = 64,
+    PINGS_PER_CONNECTION = 2000,
+};
+
+static double now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static rbm_socket_t listen_loopback(int *port) {
+    struct sockaddr_in sin;
+    socklen_t sinlen = sizeof(sin);
+
+    rbm_socket_t sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == rbm_socket_invalid)
+        return rbm_socket_invalid;
+
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(0);
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(sock, (struct sockaddr *) &sin, sinlen) || listen(sock, 128) ||
+        getsockname(sock, (struct sockaddr *) &sin, &sinlen)) {
+        rbm_socket_close(sock);
+        return rbm_socket_invalid;
+    }
+
+    *port = ntohs(sin.sin_port);
+    return sock;
+}
+
+static rbm_socket_t connect_loopback(int port) {
+    struct sockaddr_in sin;
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(port);
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    rbm_socket_t sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == rbm_socket_invalid)
+        return rbm_socket_invalid;
+
+    if (connect(sock, (struct sockaddr *) &sin, sizeof(sin))) {
+        rbm_socket_close(sock);
+        return rbm_socket_invalid;
+    }
+
+    rbm_socket_set_nodelay(sock);
+    return sock;
+}
+
+static int read_all(rbm_socket_t sock, char *buf, int len) {
+    int done = 0;
+    while (done < len) {
+        int rc = recv(sock, buf + done, len - done, 0);
+        if (rc <= 0)
+            return RBM_ERROR;
+        done += rc;
+    }
+    return RBM_SUCCESS;
+}
+
+static int write_all(rbm_socket_t sock, const char *buf, int len) {
+    int done = 0;
+    while (done < len) {
+        int rc = send(sock, buf + done, len - done, 0);
+        if (rc <= 0)
+            return RBM_ERROR;
+        done += rc;
+    }
+    return RBM_SUCCESS;
+}
+
+//===----------------------------------------------------------------------===//
+// Stand-in for SSH server: echoes every frame back
+//===----------------------------------------------------------------------===//
+
+static void *echo_server(void *arg) {
+    rbm_socket_t listensock = *(rbm_socket_t *) arg;
+    rbm_socket_t sock = accept(listensock, NULL, NULL);
+    if (sock == rbm_socket_invalid)
+        return NULL;
+
+    rbm_socket_set_nodelay(sock);
+
+    char frame[FRAME_HEADER + MAX_FRAME];
+    while (read_all(sock, frame, FRAME_HEADER) == RBM_SUCCESS) {
+        unsigned int len;
+        memcpy(&len, frame + 4, 4);
+        len = ntohl(len);
+        if (len > MAX_FRAME || read_all(sock, frame + FRAME_HEADER, len) ||
+            write_all(sock, frame, FRAME_HEADER + len))
+            break;
+    }
+
+    rbm_socket_close(sock);
+    return NULL;
+}
+
+//===----------------------------------------------------------------------===//
+// Transport that speaks the stand-in protocol
+//===----------------------------------------------------------------------===//
+
+struct bench_channel {
+    unsigned int id;
+    struct rbm_ringbuf in;
+};
+
+struct bench_transport {
+    rbm_socket_t socket;
+    unsigned int nextid;
+    struct bench_channel **channels;
+    int channelssize;
+
+    struct rbm_ringbuf out;
+
+    // Frame being received
+    char header[FRAME_HEADER];
+    int headersize;
+    struct bench_channel *current;
+    int remaining;
+};
+
+static int flush_out(struct bench_transport *t) {
+    while (!rbm_ringbuf_empty(&t->out)) {
+        int len;
+        char *ptr = rbm_ringbuf_read_ptr(&t->out, &len);
+        int rc = send(t->socket, ptr, len, 0);
+        if (rc < 0)
+            return rbm_socket_would_block() ? RBM_SUCCESS : RBM_ERROR;
+        rbm_ringbuf_consume(&t->out, rc);
+    }
+    return RBM_SUCCESS;
+}
+
+static void put_bytes(struct rbm_ringbuf *buf, const char *data, int len) {
+    while (len > 0) {
+        int space;
+        char *ptr = rbm_ringbuf_write_ptr(buf, &space);
+        int n = len < space ? len : space;
+        memcpy(ptr, data, n);
+        rbm_ringbuf_commit(buf, n);
+        data += n;
+        len -= n;
+    }
+}
+
+static struct bench_channel *find_channel(struct bench_transport *t, unsigned int id) {
+    for (int i = 0; i < t->channelssize; i++)
+        if (t->channels[i]->id == id)
+            return t->channels[i];
+    return NULL;
+}
+
+static void *bench_channel_open(void *context, int *err) {
+    struct bench_transport *t = context;
+    struct bench_channel *channel = malloc(sizeof(struct bench_channel));
+    if (!channel || rbm_ringbuf_init(&channel->in, CHANNEL_WINDOW)) {
+        free(channel);
+        *err = RBM_ERROR;
+        return NULL;
+    }
+
+    channel->id = t->nextid++;
+    rbm_array_add((void ***) &t->channels, &t->channelssize, channel);
+    return channel;
+}
+
+static int bench_channel_read(void *context, void *channel, char *buf, int len) {
+    (void) context;
+    struct bench_channel *c = channel;
+    int total = 0;
+    while (total < len && !rbm_ringbuf_empty(&c->in)) {
+        int n;
+        char *ptr = rbm_ringbuf_read_ptr(&c->in, &n);
+        if (n > len - total)
+            n = len - total;
+        memcpy(buf + total, ptr, n);
+        rbm_ringbuf_consume(&c->in, n);
+        total += n;
+    }
+    return total > 0 ? total : RBM_AGAIN;
+}
+
+static int bench_channel_write(void *context, void *channel, const char *buf, int len) {
+    struct bench_transport *t = context;
+    struct bench_channel *c = channel;
+
+    int space = rbm_ringbuf_space(&t->out) - FRAME_HEADER;
+    if (space <= 0)
+        return RBM_AGAIN;
+
+    if (len > space)
+        len = space;
+    if (len > MAX_FRAME)
+        len = MAX_FRAME;
+
+    unsigned int header[2] = { htonl(c->id), htonl(len) };
+    put_bytes(&t->out, (const char *) header, FRAME_HEADER);
+    put_bytes(&t->out, buf, len);
+
+    return flush_out(t) ? RBM_ERROR : len;
+}
+
+static int bench_channel_pending(void *context, void *channel) {
+    (void) context;
+    return !rbm_ringbuf_empty(&((struct bench_channel *) channel)->in);
+}
+
+static void bench_channel_free(void *context, void *channel) {
+    struct bench_transport *t = context;
+    struct bench_channel *c = channel;
+    if (t->current == c)
+        t->current = NULL;  // rest of the frame is dropped
+
+    rbm_array_remove((void ***) &t->channels, &t->channelssize, c);
+    rbm_ringbuf_free(&c->in);
+    free(c);
+}
+
+static int bench_receive(void *context) {
+    struct bench_transport *t = context;
+    char buf[65536];
+
+    if (flush_out(t))
+        return RBM_ERROR;
+
+    while (1) {
+        int rc = recv(t->socket, buf, sizeof(buf), 0);
+        if (rc == 0)
+            return RBM_ERROR;
+        if (rc < 0)
+            return rbm_socket_would_block() ? RBM_SUCCESS : RBM_ERROR;
+
+        // Split stream into frames and queue payload to channels
+        char *ptr = buf;
+        while (rc > 0) {
+            if (t->headersize < FRAME_HEADER) {
+                int n = FRAME_HEADER - t->headersize;
+                if (n > rc)
+                    n = rc;
+                memcpy(t->header + t->headersize, ptr, n);
+                t->headersize += n;
+                ptr += n;
+                rc -= n;
+
+                if (t->headersize == FRAME_HEADER) {
+                    unsigned int header[2];
+                    memcpy(header, t->header, FRAME_HEADER);
+                    t->current = find_channel(t, ntohl(header[0]));
+                    t->remaining = ntohl(header[1]);
+                }
+                continue;
+            }
+
+            int n = t->remaining < rc ? t->remaining : rc;
+            // Window of client guarantees that there is enough space
+            if (t->current)
+                put_bytes(&t->current->in, ptr, n);
+            ptr += n;
+            rc -= n;
+            t->remaining -= n;
+            if (t->remaining == 0)
+                t->headersize = 0;
+        }
+    }
+}
+
+static int bench_want_write(void *context) {
+    return !rbm_ringbuf_empty(&((struct bench_transport *) context)->out);
+}
+
+//===----------------------------------------------------------------------===//
+// Clients
+//===----------------------------------------------------------------------===//
+
+struct client {
+    pthread_t thread;
+    int port;
+    long long bytes;        // throughput phase: bytes to echo
+    double *latencies;      // latency phase: round trip times (us)
+    double elapsed;
+    int failed;
+};
+
+static void *latency_client(void *arg) {
+    struct client *client = arg;
+    char buf[PING_SIZE];
+    memset(buf, 'p', sizeof(buf));
+
+    rbm_socket_t sock = connect_loopback(client->port);
+    if (sock == rbm_socket_invalid) {
+        client->failed = 1;
+        return NULL;
+    }
+
+    for (int i = 0; i < PINGS_PER_CONNECTION; i++) {
+        double start = now_us();
+        if (write_all(sock, buf, sizeof(buf)) || read_all(sock, buf, sizeof(buf))) {
+            client->failed = 1;
+            break;
+        }
+        client->latencies[i] = now_us() - start;
+    }
+
+    rbm_socket_close(sock);
+    return NULL;
+}
+
+static void *throughput_client(void *arg) {
+    struct client *client = arg;
+    static char data[MAX_FRAME];
+    char buf[65536];
+    long long sent = 0, received = 0;
+
+    rbm_socket_t sock = connect_loopback(client->port);
+    if (sock == rbm_socket_invalid || rbm_socket_set_nonblocking(sock)) {
+        client->failed = 1;
+        return NULL;
+    }
+
+    double start = now_us();
+    while (received < client->bytes) {
+        long long inflight = sent - received;
+        long long tosend = client->bytes - sent;
+        if (tosend > CHANNEL_WINDOW - inflight)
+            tosend = CHANNEL_WINDOW - inflight;
+        if (tosend > (long long) sizeof(data))
+            tosend = sizeof(data);
+
+        struct pollfd pfd = { sock, POLLIN | (tosend > 0 ? POLLOUT : 0), 0 };
+        if (poll(&pfd, 1, 5000) <= 0) {
+            client->failed = 1;
+            break;
+        }
+
+        if ((pfd.revents & POLLOUT) && tosend > 0) {
+            int rc = send(sock, data, (int) tosend, 0);
+            if (rc > 0)
+                sent += rc;
+        }
+
+        if (pfd.revents & (POLLIN | POLLERR | POLLHUP)) {
+            int rc = recv(sock, buf, sizeof(buf), 0);
+            if (rc == 0 || (rc < 0 && !rbm_socket_would_block())) {
+                client->failed = 1;
+                break;
+            }
+            if (rc > 0)
+                received += rc;
+        }
+    }
+    client->elapsed = now_us() - start;
+
+    rbm_socket_close(sock);
+    return NULL;
+}
+
+static void *tunnel_thread(void *arg) {
+    struct rbm_session *session = arg;
+    if (rbm_tunnel_run(session))
+        fprintf(stderr, "Tunnel failed: %s\n", session->lasterror);
+    return NULL;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return x < y ? -1 : x > y;
+}
+
+/*
+ * Runs tunnel until all 'count' clients, started with 'body', are done.
+ */
+static int run_phase(struct rbm_session *session, struct client *clients, int count, void *(*body)(void *)) {
+    pthread_t tunnel;
+    session->stopping = 0;
+    if (pthread_create(&tunnel, NULL, tunnel_thread, session))
+        return RBM_ERROR;
+
+    for (int i = 0; i < count; i++)
+        pthread_create(&clients[i].thread, NULL, body, &clients[i]);
+
+    int failed = 0;
+    for (int i = 0; i < count; i++) {
+        pthread_join(clients[i].thread, NULL);
+        failed |= clients[i].failed;
+    }
+
+    rbm_tunnel_stop(session);
+    pthread_join(tunnel, NULL);
+    return failed ? RBM_ERROR : RBM_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    int connections = argc > 1 ? atoi(argv[1]) : 8;
+    int megabytes = argc > 2 ? atoi(argv[2]) : 64;
+    if (connections <= 0 || megabytes <= 0) {
+        fprintf(stderr, "Usage: %s [connections] [megabytes per connection]\n", argv[0]);
+        return 1;
+    }
+
+    // Stand-in server and transport connection to it
+    int serverport;
+    rbm_socket_t serversock = listen_loopback(&serverport);
+    pthread_t server;
+    if (serversock == rbm_socket_invalid || pthread_create(&server, NULL, echo_server, &serversock)) {
+        fprintf(stderr, "Failed to start stand-in server\n");
+        return 1;
+    }
+
+    struct bench_transport t;
+    memset(&t, 0, sizeof(t));
+    t.socket = connect_loopback(serverport);
+    if (t.socket == rbm_socket_invalid || rbm_socket_set_nonblocking(t.socket) ||
+        rbm_ringbuf_init(&t.out, RBM_BUFSIZE)) {
+        fprintf(stderr, "Failed to connect to stand-in server\n");
+        return 1;
+    }
+
+    struct rbm_ssh_tunnel_config config;
+    memset(&config, 0, sizeof(config));
+    config.loglevel = RBM_SSH_LOG_TYPE_ERROR;
+    config.remotehost = "stand-in";
+
+    struct rbm_session session;
+    memset(&session, 0, sizeof(session));
+    session.config = &config;
+    session.transport.context = &t;
+    session.transport.socket = t.socket;
+    session.transport.channel_open = bench_channel_open;
+    session.transport.channel_read = bench_channel_read;
+    session.transport.channel_write = bench_channel_write;
+    session.transport.channel_pending = bench_channel_pending;
+    session.transport.channel_free = bench_channel_free;
+    session.transport.receive = bench_receive;
+    session.transport.want_write = bench_want_write;
+
+    int localport;
+    session.localsocket = listen_loopback(&localport);
+    if (session.localsocket == rbm_socket_invalid) {
+        fprintf(stderr, "Failed to listen on loopback\n");
+        return 1;
+    }
+
+    struct client *clients = calloc(connections, sizeof(struct client));
+    double *latencies = malloc(sizeof(double) * connections * PINGS_PER_CONNECTION);
+    for (int i = 0; i < connections; i++) {
+        clients[i].port = localport;
+        clients[i].bytes = (long long) megabytes * 1024 * 1024;
+        clients[i].latencies = latencies + i * PINGS_PER_CONNECTION;
+    }
+
+    // Latency: request/response of small messages, like most of MongoDB traffic
+    if (run_phase(&session, clients, connections, latency_client)) {
+        fprintf(stderr, "Latency phase failed\n");
+        return 1;
+    }
+
+    int samples = connections * PINGS_PER_CONNECTION;
+    double sum = 0;
+    for (int i = 0; i < samples; i++)
+        sum += latencies[i];
+    qsort(latencies, samples, sizeof(double), compare_double);
+
+    printf("Connections:  %d\n", connections);
+    printf("Round trip:   avg %.1f us, p50 %.1f us, p99 %.1f us (%d x %d bytes)\n",
+           sum / samples, latencies[samples / 2], latencies[samples * 99 / 100], samples, PING_SIZE);
+
+    // Throughput: all connections stream data concurrently
+    if (run_phase(&session, clients, connections, throughput_client)) {
+        fprintf(stderr, "Throughput phase failed\n");
+        return 1;
+    }
+
+    double elapsed = 0;
+    for (int i = 0; i < connections; i++)
+        if (clients[i].elapsed > elapsed)
+            elapsed = clients[i].elapsed;
+
+    double total = (double) megabytes * connections;
+    printf("Throughput:   %.1f MB/s (%.0f MB echoed in %.2f s)\n", total / (elapsed / 1e6), total, elapsed / 1e6);
+
+    rbm_socket_close(t.socket);
+    pthread_join(server, NULL);
+    rbm_socket_close(serversock);
+    rbm_socket_close(session.localsocket);
+    rbm_ringbuf_free(&t.out);
+    free(t.channels);
+    free(latencies);
+    free(clients);
+    return 0;
+}
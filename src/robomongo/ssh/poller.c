@@ -0,0 +1,306 @@
+#include "robomongo/ssh/private.h"
+#include "robomongo/ssh/libssh2_config.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+/*
+ * Readiness notification for tunnel sockets. Unlike select(), it is not limited
+ * by FD_SETSIZE and does not scan all descriptors up to the biggest one on every
+ * wakeup: epoll reports only ready sockets, and poll() fallback scans only
+ * registered ones.
+ */
+
+#ifdef __linux__
+
+struct rbm_poller {
+    int epfd;
+};
+
+static unsigned int to_epoll_events(int events) {
+    unsigned int result = 0;
+    if (events & RBM_POLL_IN)
+        result |= EPOLLIN;
+    if (events & RBM_POLL_OUT)
+        result |= EPOLLOUT;
+    return result;
+}
+
+struct rbm_poller *rbm_poller_create() {
+    struct rbm_poller *poller = malloc(sizeof(struct rbm_poller));
+    if (!poller)
+        return NULL;
+
+    poller->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (poller->epfd == -1) {
+        free(poller);
+        return NULL;
+    }
+
+    return poller;
+}
+
+void rbm_poller_free(struct rbm_poller *poller) {
+    if (!poller)
+        return;
+
+    close(poller->epfd);
+    free(poller);
+}
+
+static int poller_ctl(struct rbm_poller *poller, int op, rbm_socket_t socket, int events, void *data) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = to_epoll_events(events);
+    ev.data.ptr = data;
+    return epoll_ctl(poller->epfd, op, socket, &ev) == 0 ? RBM_SUCCESS : RBM_ERROR;
+}
+
+int rbm_poller_add(struct rbm_poller *poller, rbm_socket_t socket, int events, void *data) {
+    return poller_ctl(poller, EPOLL_CTL_ADD, socket, events, data);
+}
+
+int rbm_poller_modify(struct rbm_poller *poller, rbm_socket_t socket, int events, void *data) {
+    return poller_ctl(poller, EPOLL_CTL_MOD, socket, events, data);
+}
+
+int rbm_poller_remove(struct rbm_poller *poller, rbm_socket_t socket) {
+    return poller_ctl(poller, EPOLL_CTL_DEL, socket, 0, NULL);
+}
+
+/*
+ * Waits for events on registered sockets. 'timeoutms' -1 means no timeout.
+ * Returns number of events (0 on timeout), or RBM_ERROR.
+ * Note: epoll does not report socket itself, only 'data' registered with it.
+ */
+int rbm_poller_wait(struct rbm_poller *poller, struct rbm_poller_event *events, int maxevents, int timeoutms) {
+    struct epoll_event ready[64];
+    if (maxevents > 64)
+        maxevents = 64;
+
+    int n = epoll_wait(poller->epfd, ready, maxevents, timeoutms);
+    if (n == -1)
+        return errno == EINTR ? 0 : RBM_ERROR;
+
+    for (int i = 0; i < n; i++) {
+        events[i].socket = rbm_socket_invalid;
+        events[i].data = ready[i].data.ptr;
+        events[i].events = 0;
+        if (ready[i].events & EPOLLIN)
+            events[i].events |= RBM_POLL_IN;
+        if (ready[i].events & EPOLLOUT)
+            events[i].events |= RBM_POLL_OUT;
+        if (ready[i].events & (EPOLLERR | EPOLLHUP))
+            events[i].events |= RBM_POLL_ERR;
+    }
+
+    return n;
+}
+
+#else // poll() or WSAPoll()
+
+#ifdef WIN32
+#define poll WSAPoll
+#endif
+
+struct rbm_poller {
+    struct pollfd *fds;
+    void **data;
+    int size;
+    int capacity;
+};
+
+static short to_poll_events(int events) {
+    short result = 0;
+    if (events & RBM_POLL_IN)
+        result |= POLLIN;
+    if (events & RBM_POLL_OUT)
+        result |= POLLOUT;
+    return result;
+}
+
+static int poller_find(struct rbm_poller *poller, rbm_socket_t socket) {
+    for (int i = 0; i < poller->size; i++)
+        if (poller->fds[i].fd == socket)
+            return i;
+
+    return -1;
+}
+
+struct rbm_poller *rbm_poller_create() {
+    struct rbm_poller *poller = malloc(sizeof(struct rbm_poller));
+    if (!poller)
+        return NULL;
+
+    poller->fds = NULL;
+    poller->data = NULL;
+    poller->size = 0;
+    poller->capacity = 0;
+    return poller;
+}
+
+void rbm_poller_free(struct rbm_poller *poller) {
+    if (!poller)
+        return;
+
+    free(poller->fds);
+    free(poller->data);
+    free(poller);
+}
+
+int rbm_poller_add(struct rbm_poller *poller, rbm_socket_t socket, int events, void *data) {
+    if (poller->size == poller->capacity) {
+        int capacity = poller->capacity ? poller->capacity * 2 : 16;
+        struct pollfd *fds = realloc(poller->fds, capacity * sizeof(struct pollfd));
+        if (!fds)
+            return RBM_ERROR;
+        poller->fds = fds;
+
+        void **newdata = realloc(poller->data, capacity * sizeof(void *));
+        if (!newdata)
+            return RBM_ERROR;
+        poller->data = newdata;
+        poller->capacity = capacity;
+    }
+
+    poller->fds[poller->size].fd = socket;
+    poller->fds[poller->size].events = to_poll_events(events);
+    poller->fds[poller->size].revents = 0;
+    poller->data[poller->size] = data;
+    poller->size++;
+    return RBM_SUCCESS;
+}
+
+int rbm_poller_modify(struct rbm_poller *poller, rbm_socket_t socket, int events, void *data) {
+    int i = poller_find(poller, socket);
+    if (i == -1)
+        return RBM_ERROR;
+
+    poller->fds[i].events = to_poll_events(events);
+    poller->data[i] = data;
+    return RBM_SUCCESS;
+}
+
+int rbm_poller_remove(struct rbm_poller *poller, rbm_socket_t socket) {
+    int i = poller_find(poller, socket);
+    if (i == -1)
+        return RBM_ERROR;
+
+    // Order of sockets does not matter, move the last one in place of removed
+    poller->size--;
+    poller->fds[i] = poller->fds[poller->size];
+    poller->data[i] = poller->data[poller->size];
+    return RBM_SUCCESS;
+}
+
+int rbm_poller_wait(struct rbm_poller *poller, struct rbm_poller_event *events, int maxevents, int timeoutms) {
+    int n = poll(poller->fds, poller->size, timeoutms);
+    if (n < 0)
+        return errno == EINTR ? 0 : RBM_ERROR;
+
+    int count = 0;
+    for (int i = 0; i < poller->size && count < n && count < maxevents; i++) {
+        short revents = poller->fds[i].revents;
+        if (!revents)
+            continue;
+
+        events[count].socket = poller->fds[i].fd;
+        events[count].data = poller->data[i];
+        events[count].events = 0;
+        if (revents & POLLIN)
+            events[count].events |= RBM_POLL_IN;
+        if (revents & POLLOUT)
+            events[count].events |= RBM_POLL_OUT;
+        if (revents & (POLLERR | POLLHUP | POLLNVAL))
+            events[count].events |= RBM_POLL_ERR;
+        count++;
+    }
+
+    return count;
+}
+
+#endif
+
+//===----------------------------------------------------------------------===//
+// Socket utils
+//===----------------------------------------------------------------------===//
+
+void rbm_socket_close(rbm_socket_t socket) {
+#ifdef WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+int rbm_socket_set_nonblocking(rbm_socket_t socket) {
+#ifdef WIN32
+    u_long mode = 1;
+    return ioctlsocket(socket, FIONBIO, &mode) == 0 ? RBM_SUCCESS : RBM_ERROR;
+#else
+    int flags = fcntl(socket, F_GETFL, 0);
+    if (flags == -1)
+        return RBM_ERROR;
+
+    return fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0 ? RBM_SUCCESS : RBM_ERROR;
+#endif
+}
+
+/*
+ * Disables Nagle's algorithm: tunnel forwards small request/response messages
+ * and should not delay them.
+ */
+int rbm_socket_set_nodelay(rbm_socket_t socket) {
+#ifdef WIN32
+    char flag = 1;
+#else
+    int flag = 1;
+#endif
+    return setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) == 0 ? RBM_SUCCESS : RBM_ERROR;
+}
+
+/*
+ * Returns non zero, if last socket operation failed only because it would block
+ */
+int rbm_socket_would_block() {
+#ifdef WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+/*
+ * Monotonic clock in milliseconds
+ */
+long long rbm_time_ms() {
+#ifdef WIN32
+    return (long long) GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
@@ -28,21 +28,104 @@ extern "C" {
 enum {
     RBM_SUCCESS = 0,
     RBM_ERROR   = -1,
-    RBM_CHANNEL_CREATION_ERROR   = -10,
-    RBM_BUFSIZE = 16384, // Size of the in/out buffers
+    RBM_AGAIN   = -2,    // Operation would block, retry when socket is ready
+    RBM_BUFSIZE = 65536, // Capacity of per-channel ring buffers (for each direction)
+    RBM_CHANNEL_OPEN_TIMEOUT_MS = 10000,
+    RBM_KEEPALIVE_INTERVAL_S = 30,   // keeps idle SSH session alive between queries
 };
 
+//===----------------------------------------------------------------------===//
+// Ring buffer
+//===----------------------------------------------------------------------===//
+
+/*
+ * Fixed size byte FIFO. Data is accessed in place by (pointer, length) pairs
+ * of contiguous regions, so that recv/send/libssh2 work directly on it.
+ */
+struct rbm_ringbuf {
+    char *data;
+    int capacity;
+    int start;      // offset of the first byte of data
+    int size;       // number of bytes of data
+};
+
+int rbm_ringbuf_init(struct rbm_ringbuf *buf, int capacity);
+void rbm_ringbuf_free(struct rbm_ringbuf *buf);
+char *rbm_ringbuf_write_ptr(struct rbm_ringbuf *buf, int *len);
+void rbm_ringbuf_commit(struct rbm_ringbuf *buf, int len);
+char *rbm_ringbuf_read_ptr(struct rbm_ringbuf *buf, int *len);
+void rbm_ringbuf_consume(struct rbm_ringbuf *buf, int len);
+
+#define rbm_ringbuf_space(buf) ((buf)->capacity - (buf)->size)
+#define rbm_ringbuf_empty(buf) ((buf)->size == 0)
+
+//===----------------------------------------------------------------------===//
+// Poller (epoll on Linux, poll() / WSAPoll() elsewhere)
+//===----------------------------------------------------------------------===//
+
+enum {
+    RBM_POLL_IN  = 1,
+    RBM_POLL_OUT = 2,
+    RBM_POLL_ERR = 4,   // error or hang up, reported regardless of requested events
+};
+
+struct rbm_poller_event {
+    rbm_socket_t socket;
+    int events;
+    void *data;
+};
+
+struct rbm_poller;
+
+struct rbm_poller *rbm_poller_create();
+void rbm_poller_free(struct rbm_poller *poller);
+int rbm_poller_add(struct rbm_poller *poller, rbm_socket_t socket, int events, void *data);
+int rbm_poller_modify(struct rbm_poller *poller, rbm_socket_t socket, int events, void *data);
+int rbm_poller_remove(struct rbm_poller *poller, rbm_socket_t socket);
+int rbm_poller_wait(struct rbm_poller *poller, struct rbm_poller_event *events, int maxevents, int timeoutms);
+
+void rbm_socket_close(rbm_socket_t socket);
+int rbm_socket_set_nonblocking(rbm_socket_t socket);
+int rbm_socket_set_nodelay(rbm_socket_t socket);
+int rbm_socket_would_block();
+long long rbm_time_ms();
+
 //===----------------------------------------------------------------------===//
 // Data structures
 //===----------------------------------------------------------------------===//
 
+/*
+ * Upstream side of the tunnel. Normally these are libssh2 direct-tcpip channels,
+ * multiplexed over single SSH socket (see ssh.c), but benchmark replaces it with
+ * an in-process stand-in. All functions are non-blocking: they return RBM_AGAIN
+ * (or NULL with *err == RBM_AGAIN) when operation should be retried later.
+ */
+struct rbm_transport {
+    void *context;
+    rbm_socket_t socket;    // socket that carries all channels
+
+    void *(*channel_open)(void *context, int *err);
+    int (*channel_read)(void *context, void *channel, char *buf, int len);   // 0 means EOF
+    int (*channel_write)(void *context, void *channel, const char *buf, int len);
+    int (*channel_pending)(void *context, void *channel);   // data or EOF is queued, read will not block
+    void (*channel_free)(void *context, void *channel);
+
+    int (*receive)(void *context);      // read everything available on socket into channel queues
+    int (*want_write)(void *context);   // non zero, if transport waits for socket to be writable
+    int (*keepalive)(void *context);    // optional, returns ms until next call or negative on error
+};
+
 struct rbm_channel {
-    struct rbm_session* session;
-    LIBSSH2_CHANNEL *channel;
+    struct rbm_session *session;
+    void *channel;                  // transport channel, NULL while it is being opened
     rbm_socket_t socket;
-    char *inbuf;
-    char *outbuf;
-    int bufmaxsize;
+    struct rbm_ringbuf tosocket;    // upstream -> client
+    struct rbm_ringbuf toupstream;  // client -> upstream
+    int events;                     // events, currently registered in poller for socket
+    long long openstarted;          // time when channel opening started (ms)
+    int clienteof;                  // client closed connection, flush "toupstream" and close
+    int upstreameof;                // upstream closed channel, flush "tosocket" and close
+    int failed;                     // socket error, close immediately
 };
 
 struct rbm_session {
@@ -54,15 +137,23 @@ struct rbm_session {
     struct rbm_channel **channels;      // array of channels
     int channelssize;                       // number of channels
 
+    struct rbm_transport transport;
+    struct rbm_poller *poller;          // valid only while tunnel is running
+    int openingchannels;                // number of channels with transport channel being opened
+    volatile int stopping;              // set by rbm_tunnel_stop() from any thread
+
     struct rbm_ssh_session *publicsession;
     char lasterror[2048];
 };
 
 
 // Channels
-struct rbm_channel *rbm_channel_create(struct rbm_session* session, rbm_socket_t socket, LIBSSH2_CHANNEL *lchannel);
+struct rbm_channel *rbm_channel_create(struct rbm_session *session, rbm_socket_t socket);
 void rbm_channel_close(struct rbm_channel *channel);
-struct rbm_channel *rbm_channel_find_by_socket(struct rbm_session *session, rbm_socket_t socket);
+
+// Runs event loop until rbm_tunnel_stop() is called (see tunnel.c)
+int rbm_tunnel_run(struct rbm_session *session);
+int rbm_tunnel_stop(struct rbm_session *session);
 
 void rbm_session_cleanup(struct rbm_session *session);
 int rbm_open_tunnel(struct rbm_session *connection);
@@ -0,0 +1,65 @@
+#include "robomongo/ssh/private.h"
+#include <stdlib.h>
+
+/*
+ * Allocates buffer of 'capacity' bytes.
+ * Returns 0 if succeeded, or RBM_ERROR when out of memory.
+ */
+int rbm_ringbuf_init(struct rbm_ringbuf *buf, int capacity) {
+    buf->data = malloc(capacity);
+    buf->capacity = buf->data ? capacity : 0;
+    buf->start = 0;
+    buf->size = 0;
+    return buf->data ? RBM_SUCCESS : RBM_ERROR;
+}
+
+void rbm_ringbuf_free(struct rbm_ringbuf *buf) {
+    free(buf->data);
+    buf->data = NULL;
+    buf->capacity = 0;
+    buf->start = 0;
+    buf->size = 0;
+}
+
+/*
+ * Returns pointer to contiguous free region and its length in 'len'.
+ * Length is 0 when buffer is full. Call rbm_ringbuf_commit() with number
+ * of bytes actually written.
+ */
+char *rbm_ringbuf_write_ptr(struct rbm_ringbuf *buf, int *len) {
+    int end = buf->start + buf->size;
+    if (end >= buf->capacity) {
+        // Free region is between wrapped end of data and start
+        end -= buf->capacity;
+        *len = buf->start - end;
+    } else {
+        *len = buf->capacity - end;
+    }
+    return buf->data + end;
+}
+
+void rbm_ringbuf_commit(struct rbm_ringbuf *buf, int len) {
+    buf->size += len;
+}
+
+/*
+ * Returns pointer to contiguous region of data and its length in 'len'.
+ * Length is 0 when buffer is empty. Call rbm_ringbuf_consume() with number
+ * of bytes actually processed.
+ */
+char *rbm_ringbuf_read_ptr(struct rbm_ringbuf *buf, int *len) {
+    int end = buf->start + buf->size;
+    *len = end > buf->capacity ? buf->capacity - buf->start : buf->size;
+    return buf->data + buf->start;
+}
+
+void rbm_ringbuf_consume(struct rbm_ringbuf *buf, int len) {
+    buf->size -= len;
+    buf->start += len;
+    if (buf->start >= buf->capacity)
+        buf->start -= buf->capacity;
+
+    // Empty buffer starts from the beginning, so that next write is not split
+    if (buf->size == 0)
+        buf->start = 0;
+}
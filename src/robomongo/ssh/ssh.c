@@ -24,12 +24,7 @@
 #include <signal.h>
 #include <stdio.h>
 
-static int handle_new_client_connections(struct rbm_session *connection, int *fdmax, fd_set *masterset);
-static int handle_ssh_connections(struct rbm_session *connection, fd_set *masterset);
-static int handle_client_connections(struct rbm_session *connection, rbm_socket_t i, fd_set *masterset);
-
-static void rbm_sleep_ms(int ms);
-static void rbm_socket_close(rbm_socket_t socket);
+static void setup_transport(struct rbm_session *session);
 
 //===----------------------------------------------------------------------===//
 // Public API
@@ -95,7 +90,11 @@ struct rbm_ssh_session *rbm_ssh_session_create(struct rbm_ssh_tunnel_config *con
     session->config = config;
     session->channels = NULL;
     session->channelssize = 0;
+    session->poller = NULL;
+    session->openingchannels = 0;
+    session->stopping = 0;
     session->lasterror[0] = '\0';
+    setup_transport(session);
 
     // Check that loglevel is valid
     if (config->loglevel != RBM_SSH_LOG_TYPE_ERROR &&
@@ -144,7 +143,7 @@ int rbm_ssh_open_tunnel(struct rbm_ssh_session *sshsession) {
         if (rc == 0)
             break;
 
-        if (rc == RBM_CHANNEL_CREATION_ERROR)
+        if (connection->stopping)
             return RBM_ERROR;
 
         // Cleanup SSH connection we hope that local connection
@@ -160,6 +159,14 @@ int rbm_ssh_open_tunnel(struct rbm_ssh_session *sshsession) {
 }
 
 
+/*
+ * Returns 0 if succeeded, or a negative value for error.
+ */
+int rbm_ssh_session_stop(struct rbm_ssh_session *sshsession) {
+    struct rbm_session *session = (struct rbm_session*)sshsession->handle;
+    return rbm_tunnel_stop(session);
+}
+
 // Returns -1 on error, 0 when otherwise
 int rbm_ssh_session_setup(struct rbm_ssh_session *sshsession) {
     struct rbm_session *session = (struct rbm_session*)sshsession->handle;
@@ -185,73 +192,6 @@ int rbm_ssh_session_setup(struct rbm_ssh_session *sshsession) {
 //===----------------------------------------------------------------------===//
 
 
-// Returns NULL on error, or valid rbm_ssh_channel otherwise.
-struct rbm_channel *rbm_channel_create(struct rbm_session* session, rbm_socket_t socket, LIBSSH2_CHANNEL *lchannel) {
-    struct rbm_channel *channel = malloc(sizeof(struct rbm_channel));
-    if (!channel)
-        return NULL;
-
-    char *inbuf = malloc(sizeof(char) * RBM_BUFSIZE);
-    if (!inbuf)
-        return NULL;
-
-    char *outbuf = malloc(sizeof(char) * RBM_BUFSIZE);
-    if (!outbuf)
-        return NULL;
-
-    channel->session = session;
-    channel->channel = lchannel;
-    channel->socket = socket;
-    channel->inbuf = inbuf;
-    channel->outbuf = outbuf;
-    channel->bufmaxsize = RBM_BUFSIZE;
-
-    if (rbm_array_add((void ***)&session->channels, &session->channelssize, channel))
-        return NULL;
-
-    return channel;
-}
-
-void rbm_channel_close(struct rbm_channel *channel) {
-    struct rbm_session *session = channel->session;
-    if (rbm_array_remove((void ***)&session->channels, &session->channelssize, channel))
-        return;
-
-    // 3. Close socket
-    if (channel->socket != rbm_socket_invalid) {
-        rbm_socket_close(channel->socket);
-        channel->socket = rbm_socket_invalid;
-    }
-
-    // 1. Free libssh2 channel
-    if (channel->channel) {
-        libssh2_channel_free(channel->channel);
-        channel->channel = NULL;
-    }
-
-    // 2. Free input/output buffers
-    free(channel->inbuf);
-    free(channel->outbuf);
-    channel->inbuf = NULL;
-    channel->outbuf = NULL;
-
-    // 4. Free channel struct
-    free(channel);
-
-    ssh_log_debug(session, "Channel closed");
-}
-
-/*
- * Returns channel for specified socket, or NULL otherwise
- */
-struct rbm_channel *rbm_channel_find_by_socket(struct rbm_session *session, rbm_socket_t socket) {
-    for (int i = 0; i < session->channelssize; i++)
-        if (session->channels[i]->socket == socket)
-            return session->channels[i];
-
-    return NULL;
-}
-
 // Returns -1 on error, 0 when otherwise
 int rbm_ssh_setup(struct rbm_session *session) {
     struct rbm_ssh_tunnel_config *config = session->config;
@@ -273,6 +213,12 @@ int rbm_ssh_setup(struct rbm_session *session) {
     // Must use non-blocking IO hereafter due to the current libssh3 API
     libssh2_session_set_blocking(session->sshsession, 0);
 
+    // Nagle's algorithm only delays small requests, failure is not fatal
+    rbm_socket_set_nodelay(session->sshsocket);
+
+    // Tunnel stays open between queries, do not let idle session be dropped
+    libssh2_keepalive_config(session->sshsession, 0, RBM_KEEPALIVE_INTERVAL_S);
+
     return RBM_SUCCESS;
 }
 
@@ -309,299 +255,122 @@ void rbm_session_cleanup(struct rbm_session *session) {
 
 
 int rbm_open_tunnel(struct rbm_session *connection) {
-    rbm_socket_t local_socket = connection->localsocket;
-    rbm_socket_t ssh_socket = connection->sshsocket;
-
-    const int maxerrors = 25;   // number of serial errors, when we probably should stop the loop
-    int errors = 0;             // counter for serial errors
-    int rc = 0;
-
-    int fdmax;       // maximum socket (file descriptor) number
-    int isocket;     // index for traversing sockets
-    fd_set masterset, readset;
-    FD_ZERO(&masterset);
-
-    // Add the listener to the master set
-    FD_SET(local_socket, &masterset);
-    FD_SET(ssh_socket, &masterset);
-
-    // Keep track of the biggest file descriptor
-    fdmax = local_socket > ssh_socket ? local_socket : ssh_socket;
+    connection->transport.socket = connection->sshsocket;
 
-    while (errors < maxerrors) {
-
-        readset = masterset; // copy set
+    return rbm_tunnel_run(connection);
+}
 
-        // If local (accept) socket is closed, it means that
-        // session is closed and we should stop our work
-        if (!FD_ISSET(local_socket, &readset))
-            break;
+//===----------------------------------------------------------------------===//
+// libssh2 transport: direct-tcpip channels over SSH session
+//===----------------------------------------------------------------------===//
 
-        ssh_log_debug(connection, "* Okay, we are ready to select.");
-        if (select(fdmax + 1, &readset, NULL, NULL, NULL) == -1) {
-            ssh_log_error(connection, "Error on select()");
-            break;
-        }
-        ssh_log_debug(connection, "* Selected!");
-
-        // Run through the existing connections looking for data to read
-        for(isocket = 0; isocket <= fdmax; isocket++) {
-
-            // Skip connections that are not available for reading
-            if (!FD_ISSET(isocket, &readset))
-                continue;
-
-            if (isocket == local_socket) {
-                rc = handle_new_client_connections(connection, &fdmax, &masterset);
-                goto next;
-            }
-
-            if (isocket == ssh_socket) {
-                rc = handle_ssh_connections(connection, &masterset);
-                goto next;
-            }
-
-            rc = handle_client_connections(connection, isocket, &masterset);
-
-            next:
-            // Increment "errors" counter, if we found an error,
-            // or zero it, if not.
-            errors = (rc == -2) ? errors + 1 : 0;
-            if (errors > 0) {
-                ssh_log_warn(connection, "*** COLLECTED %d AGAIN ***", errors);
-            }
-
-            if (rc == -1) {
-                ssh_log_warn(connection, "SSH tunnel shutdown because of error");
-                return RBM_ERROR;
-            }
-
-            if (rc == RBM_CHANNEL_CREATION_ERROR) {
-                return RBM_CHANNEL_CREATION_ERROR;
-            }
-        }
-    }
+static void *ssh_channel_open(void *context, int *err) {
+    struct rbm_session *session = context;
+    struct rbm_ssh_tunnel_config *config = session->config;
 
-    if (errors >= maxerrors) {
-        ssh_log_warn(connection, "SSH tunnel shutdown because of series of successive EAGAIN errors");
-        return RBM_ERROR;
+    LIBSSH2_CHANNEL *channel = libssh2_channel_direct_tcpip_ex(session->sshsession, config->remotehost, config->remoteport,
+                                                               config->localip, config->localport);
+    if (!channel) {
+        int lerr = libssh2_session_last_error(session->sshsession, NULL, NULL, 0);
+        *err = lerr == LIBSSH2_ERROR_EAGAIN ? RBM_AGAIN : RBM_ERROR;
+        if (*err != RBM_AGAIN)
+            ssh_log_warn(session, "Could not open the direct TCP/IP channel (%d)", lerr);
     }
 
-    rbm_ssh_session_close(connection->publicsession);
-    return RBM_SUCCESS;
+    return channel;
 }
 
-// Return -1 on error. 0 otherwise.
-static int handle_new_client_connections(struct rbm_session *connection, int *fdmax, fd_set *masterset) {
-    rbm_socket_t local_socket = connection->localsocket;
-    rbm_socket_t ssh_socket = connection->sshsocket;
-    LIBSSH2_SESSION* session = connection->sshsession;
-    struct rbm_ssh_tunnel_config* config = connection->config;
-    rbm_socket_t newfd = rbm_socket_invalid;
-
-    ssh_log_debug(connection, "Data on accept socket is available");
+static int ssh_channel_read(void *context, void *channel, char *buf, int len) {
+    ssize_t rc = libssh2_channel_read((LIBSSH2_CHANNEL *) channel, buf, len);
+    if (rc == LIBSSH2_ERROR_EAGAIN)
+        return RBM_AGAIN;
 
-    struct sockaddr_in remoteaddr;
-    socklen_t slen = sizeof(remoteaddr);
-
-    // handle new connections
-    if ((newfd = accept(local_socket, (struct sockaddr *) &remoteaddr, &slen)) == -1) {
-        ssh_log_error(connection, "Error on accept()");
+    if (rc < 0) {
+        ssh_log_error(context, "libssh2_channel_read: %d", (int) rc);
         return RBM_ERROR;
-    } else {
-        FD_SET(newfd, masterset); // add to master set
-
-        if (newfd > *fdmax) {       // keep track of the maximum
-            *fdmax = newfd;
-        }
-
-        ssh_log_debug(connection, "New connection from %s on socket %d", inet_ntoa(remoteaddr.sin_addr), newfd);
     }
 
-    LIBSSH2_CHANNEL *channel = NULL;
-    int maxattempts = 25; //45;
-    int attempts = 0;
-    while (attempts < maxattempts) {
-        ++attempts;
-        channel = libssh2_channel_direct_tcpip_ex(session, config->remotehost, config->remoteport,
-                                                  config->localip, config->localport);
+    // Zero is returned also when there is no data in the queue
+    if (rc == 0 && !libssh2_channel_eof((LIBSSH2_CHANNEL *) channel))
+        return RBM_AGAIN;
 
-        int errsave = errno;
-        if (!channel) {
-            int lerr = libssh2_session_last_error(connection->sshsession, NULL, NULL, 0);
-
-            ssh_log_warn(connection, "Could not open the direct TCP/IP channel (%d)", lerr);
-
-            // Error 35: Resource temporarily unavailable.
-            if (lerr == LIBSSH2_ERROR_EAGAIN) {
-                rbm_sleep_ms(200);
-//                usleep(200 * 1000);
-                continue;
-            }
-
-            break;
-        }
-
-        ssh_log_debug(connection, "Channel successfully created!");
-        break;
-    }
+    return (int) rc;
+}
 
-    if (!channel) {
-        ssh_log_error(connection, "Failed to create SSH channel");
-        return RBM_CHANNEL_CREATION_ERROR;
-    }
+static int ssh_channel_write(void *context, void *channel, const char *buf, int len) {
+    ssize_t rc = libssh2_channel_write((LIBSSH2_CHANNEL *) channel, buf, len);
+    if (rc == LIBSSH2_ERROR_EAGAIN)
+        return RBM_AGAIN;
 
-    if (rbm_channel_create(connection, newfd, channel) == NULL) {
+    if (rc < 0) {
+        ssh_log_error(context, "libssh2_channel_write: %d", (int) rc);
         return RBM_ERROR;
     }
 
-    return RBM_SUCCESS;
+    return (int) rc;
 }
 
-//  0: success
-// -1:
-static int handle_ssh_connections(struct rbm_session *connection, fd_set *masterset) {
-    const int AGAIN = -2;
-    struct rbm_ssh_tunnel_config* config = connection->config;
+static int ssh_channel_pending(void *context, void *channel) {
+    (void) context;
+    // Checks only packets already read from socket
+    return libssh2_poll_channel_read((LIBSSH2_CHANNEL *) channel, 0) > 0
+        || libssh2_channel_eof((LIBSSH2_CHANNEL *) channel);
+}
 
-    ssh_log_debug(connection, "Data on SSH socket is available");
-    ssh_log_debug(connection, "[%d]  <-  Number of channels", connection->channelssize);
+static void ssh_channel_free(void *context, void *channel) {
+    (void) context;
+    libssh2_channel_free((LIBSSH2_CHANNEL *) channel);
+}
 
-    if (connection->channelssize == 0) {
-        FD_CLR(connection->localsocket, masterset); // remove from master set
-        FD_CLR(connection->sshsocket, masterset);   // remove from master set
-        return RBM_SUCCESS;
-    }
+static int ssh_receive(void *context) {
+    struct rbm_session *session = context;
+
+    // libssh2 has no session-level read, but any channel read first processes
+    // all packets available on socket. Zero length read does only that.
+    for (int i = 0; i < session->channelssize; i++) {
+        LIBSSH2_CHANNEL *channel = session->channels[i]->channel;
+        if (!channel)
+            continue;
 
-    int s = 0;
-    int result = RBM_SUCCESS;
-    int eagain = 0;
-    while (s < connection->channelssize) {
-        struct rbm_channel *context = connection->channels[s];
-        ++s;
-
-        int firstflag = 1;
-        while (1) {
-            int len;
-            len = libssh2_channel_read(context->channel, context->outbuf, context->bufmaxsize);
-            if (len == LIBSSH2_ERROR_EAGAIN) {
-
-                if (firstflag) {
-                    ++eagain;
-
-                    if (eagain == connection->channelssize) {
-                        result = AGAIN;
-                        ssh_log_warn(connection, "All channels are in a non ready state (EAGAIN)");
-                    }
-                }
-
-                // Proceed with the next channel
-                break;
-            } else if (len < 0) {
-
-                // ETIMEDOUT (60) Connection timed out
-                // We need to reconnect
-                // if (errno == 60) {
-                //    return 2;
-                // }
-                // Endless cycle:
-                // Network is down. libssh2_channel_read: -43. (Error #50)
-
-                result = RBM_ERROR;
-                ssh_log_error(connection, "libssh2_channel_read: %d", len);
-                return RBM_ERROR;
-            }
-
-            firstflag = 0;
-            ssh_log_debug(connection, "Received %d bytes from tunnel", len);
-
-            int wr = 0;
-            int rc = 0; // result
-            while (wr < len) {
-                rc = send(context->socket, context->outbuf + wr, len - wr, 0);
-                if (rc <= 0) {
-                    result = RBM_ERROR;
-                    ssh_log_error(connection, "Failure to write data to client");
-                    break;
-                }
-                wr += rc;
-            }
-            if (libssh2_channel_eof(context->channel)) {
-                result = RBM_SUCCESS;
-                ssh_log_debug(connection, "The server at %s:%d disconnected!\n",
-                              config->remotehost, config->remoteport);
-                break;
-            }
+        char dummy;
+        ssize_t rc = libssh2_channel_read(channel, &dummy, 0);
+        if (rc < 0 && rc != LIBSSH2_ERROR_EAGAIN) {
+            ssh_log_error(session, "libssh2_channel_read: %d", (int) rc);
+            return RBM_ERROR;
         }
+        break;
     }
 
-    return result;
+    return RBM_SUCCESS;
 }
 
-static int handle_client_connections(struct rbm_session *connection, rbm_socket_t i, fd_set *masterset) {
-    int result = RBM_SUCCESS;
-    ssh_log_debug(connection, "Data on client socket is available");
+static int ssh_want_write(void *context) {
+    struct rbm_session *session = context;
+    return session->sshsession &&
+        (libssh2_session_block_directions(session->sshsession) & LIBSSH2_SESSION_BLOCK_OUTBOUND);
+}
 
-    struct rbm_channel *context = rbm_channel_find_by_socket(connection, i);
-    if (!context) {
-        rbm_socket_close(i); // bye!
-        FD_CLR(i, masterset); // remove from master set
+static int ssh_keepalive(void *context) {
+    struct rbm_session *session = context;
+    int next = 0;
+    if (libssh2_keepalive_send(session->sshsession, &next))
         return RBM_ERROR;
-    }
-
-    // Read data from a client
-    int nbytes = recv(context->socket, context->inbuf, context->bufmaxsize, 0);
-    if (nbytes <= 0) {
-        if (nbytes == 0) {
-            // Normal situation
-            result = RBM_SUCCESS;
-            ssh_log_debug(connection, "Client disconnected");
-        } else {
-            // Got error
-            result = RBM_ERROR;
-            ssh_log_error(connection, "Error when recv()");
-        }
-
-        // In both these cases, close and cleanup connection
-//        rbm_socket_close(context->socket); // bye!
-        FD_CLR(context->socket, masterset); // remove from master set
-        rbm_channel_close(context);
-
-        if (connection->channelssize == 0) {
-            FD_CLR(connection->localsocket, masterset); // remove from master set
-            FD_CLR(connection->sshsocket, masterset);   // remove from master set
-        }
 
-        return result;
-    }
-    ssh_log_debug(connection, "Received %d bytes from client", nbytes);
-
-    // Write data to ssh tunnel
-    const int againmax = 100;
-    int again = 0;
-    int wr = 0;
-    int rc = 0; // result
-    while (wr < nbytes) {
-        rc = libssh2_channel_write(context->channel, context->inbuf + wr, nbytes - wr);
-        if (LIBSSH2_ERROR_EAGAIN == rc) {
-            ++again;
-
-            if (again > againmax) {
-                ssh_log_warn(connection, "Number of attempts to libssh2_channel_write exсeed max value");
-                return RBM_ERROR;
-            }
-
-            continue;
-        }
-        if (rc < 0) {
-            ssh_log_error(connection, "Failed to write to SSH channel");
-            return RBM_ERROR;
-        }
-        wr += rc;
-    }
-    ssh_log_debug(connection, "Written %d bytes to tunnel", wr);
+    return next * 1000;
+}
 
-    return RBM_SUCCESS;
+static void setup_transport(struct rbm_session *session) {
+    struct rbm_transport *transport = &session->transport;
+    transport->context = session;
+    transport->socket = rbm_socket_invalid;
+    transport->channel_open = ssh_channel_open;
+    transport->channel_read = ssh_channel_read;
+    transport->channel_write = ssh_channel_write;
+    transport->channel_pending = ssh_channel_pending;
+    transport->channel_free = ssh_channel_free;
+    transport->receive = ssh_receive;
+    transport->want_write = ssh_want_write;
+    transport->keepalive = ssh_keepalive;
 }
 
 /*
@@ -768,19 +537,3 @@ LIBSSH2_SESSION *ssh_connect(struct rbm_session *rsession, rbm_socket_t sock, en
 
     return session;
 }
-
-static void rbm_sleep_ms(int ms) {
-#ifdef WIN32
-    Sleep(ms);
-#else
-    usleep(ms * 1000);
-#endif
-}
-
-static void rbm_socket_close(rbm_socket_t socket) {
-#ifdef WIN32
-    closesocket(socket);
-#else
-    close(socket);
-#endif
-}
@@ -60,8 +60,20 @@ int rbm_ssh_init();
 void rbm_ssh_cleanup();
 
 struct rbm_ssh_session* rbm_ssh_session_create(struct rbm_ssh_tunnel_config *config);
+
+/*
+ * Forwards local connections until rbm_ssh_session_stop() is called (or
+ * unrecoverable error). All connections share single SSH session, errors
+ * of one connection (i.e. channel refused by server) close only it. Session
+ * is not closed on return, call rbm_ssh_session_close() afterwards.
+ */
 int rbm_ssh_open_tunnel(struct rbm_ssh_session *connection);
 int rbm_ssh_session_setup(struct rbm_ssh_session *session);
+
+/*
+ * Asks rbm_ssh_open_tunnel() to return. Can be called from any thread.
+ */
+int rbm_ssh_session_stop(struct rbm_ssh_session *session);
 void rbm_ssh_session_close(struct rbm_ssh_session *session);
 
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <string.h>
 
 #include "robomongo/ssh/private.h"
 
@@ -124,6 +125,70 @@ int add_with_incorrect_params() {
     return 0;
 }
 
+int ringbuf_wraps_around() {
+    struct rbm_ringbuf buf;
+    int len;
+    char *ptr;
+
+    assert(rbm_ringbuf_init(&buf, 8) == 0);
+    assert(rbm_ringbuf_empty(&buf));
+
+    ptr = rbm_ringbuf_write_ptr(&buf, &len);
+    assert(len == 8);
+    memcpy(ptr, "abcdef", 6);
+    rbm_ringbuf_commit(&buf, 6);
+    assert(rbm_ringbuf_space(&buf) == 2);
+
+    rbm_ringbuf_read_ptr(&buf, &len);
+    assert(len == 6);
+    rbm_ringbuf_consume(&buf, 4);
+
+    // Free space is split: 2 bytes at the end, 4 bytes at the beginning
+    ptr = rbm_ringbuf_write_ptr(&buf, &len);
+    assert(len == 2);
+    memcpy(ptr, "gh", 2);
+    rbm_ringbuf_commit(&buf, 2);
+    ptr = rbm_ringbuf_write_ptr(&buf, &len);
+    assert(len == 4);
+    memcpy(ptr, "ijkl", 4);
+    rbm_ringbuf_commit(&buf, 4);
+    assert(rbm_ringbuf_space(&buf) == 0);
+
+    ptr = rbm_ringbuf_write_ptr(&buf, &len);
+    assert(len == 0);
+
+    // Data is read in two contiguous parts
+    ptr = rbm_ringbuf_read_ptr(&buf, &len);
+    assert(len == 4);
+    assert(memcmp(ptr, "efgh", 4) == 0);
+    rbm_ringbuf_consume(&buf, 4);
+    ptr = rbm_ringbuf_read_ptr(&buf, &len);
+    assert(len == 4);
+    assert(memcmp(ptr, "ijkl", 4) == 0);
+    rbm_ringbuf_consume(&buf, 4);
+    assert(rbm_ringbuf_empty(&buf));
+
+    rbm_ringbuf_free(&buf);
+    return 0;
+}
+
+int ringbuf_empty_restarts_from_beginning() {
+    struct rbm_ringbuf buf;
+    int len;
+
+    assert(rbm_ringbuf_init(&buf, 8) == 0);
+    rbm_ringbuf_write_ptr(&buf, &len);
+    rbm_ringbuf_commit(&buf, 5);
+    rbm_ringbuf_consume(&buf, 5);
+
+    // Whole capacity is available as a single region again
+    rbm_ringbuf_write_ptr(&buf, &len);
+    assert(len == 8);
+
+    rbm_ringbuf_free(&buf);
+    return 0;
+}
+
 void init() {
     elem1 = malloc(sizeof(int));
     elem2 = malloc(sizeof(int));
@@ -145,7 +210,7 @@ void cleanup() {
     free(elem5);
 }
 
-int main(int argc, char *argv[]) {
+int main(void) {
     init();
     add_one_element();
     add_two_elements();
@@ -155,6 +220,8 @@ int main(int argc, char *argv[]) {
     array_remove_when_five_elements();
     remove_last_element();
     add_with_incorrect_params();
+    ringbuf_wraps_around();
+    ringbuf_empty_restarts_from_beginning();
     cleanup();
     printf("All tests completed successfully.\n");
 }
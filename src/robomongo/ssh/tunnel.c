@@ -0,0 +1,535 @@
+#include "robomongo/ssh/private.h"
+#include "robomongo/ssh/libssh2_config.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+
+#include <stdlib.h>
+
+/*
+ * Event loop of the tunnel.
+ *
+ * All sockets are non-blocking and registered in a poller, so a wakeup costs
+ * only the sockets that are actually ready. Each client connection has two
+ * ring buffers, one per direction. We read from a side only while the buffer
+ * towards the other side has free space, so a slow reader (client or upstream)
+ * stops the writer instead of stalling the whole loop or growing memory.
+ *
+ * Upstream channels are multiplexed over the single transport socket. Any read
+ * of it (libssh2 reads everything available) moves incoming data of all
+ * channels into per-channel queues, so after transport events we only pump
+ * channels that have something queued.
+ */
+
+enum {
+    RBM_MAX_EVENTS = 64,
+    RBM_OPEN_RETRY_MS = 100,    // poll timeout while some channels are being opened
+};
+
+static int pump_channel(struct rbm_channel *channel);
+static int finish_channel(struct rbm_channel *channel);
+
+//===----------------------------------------------------------------------===//
+// Channels
+//===----------------------------------------------------------------------===//
+
+/*
+ * Creates channel for accepted client 'socket' and starts opening of transport
+ * channel. Returns NULL on error (socket is not closed in this case).
+ */
+struct rbm_channel *rbm_channel_create(struct rbm_session *session, rbm_socket_t socket) {
+    struct rbm_channel *channel = malloc(sizeof(struct rbm_channel));
+    if (!channel)
+        return NULL;
+
+    channel->session = session;
+    channel->channel = NULL;
+    channel->socket = socket;
+    channel->events = RBM_POLL_IN;
+    channel->openstarted = rbm_time_ms();
+    channel->clienteof = 0;
+    channel->upstreameof = 0;
+    channel->failed = 0;
+
+    if (rbm_ringbuf_init(&channel->tosocket, RBM_BUFSIZE)) {
+        free(channel);
+        return NULL;
+    }
+
+    if (rbm_ringbuf_init(&channel->toupstream, RBM_BUFSIZE)) {
+        rbm_ringbuf_free(&channel->tosocket);
+        free(channel);
+        return NULL;
+    }
+
+    if (rbm_poller_add(session->poller, socket, channel->events, channel))
+        goto error;
+
+    if (rbm_array_add((void ***)&session->channels, &session->channelssize, channel)) {
+        rbm_poller_remove(session->poller, socket);
+        goto error;
+    }
+
+    session->openingchannels++;
+    return channel;
+
+error:
+    rbm_ringbuf_free(&channel->tosocket);
+    rbm_ringbuf_free(&channel->toupstream);
+    free(channel);
+    return NULL;
+}
+
+void rbm_channel_close(struct rbm_channel *channel) {
+    struct rbm_session *session = channel->session;
+    if (rbm_array_remove((void ***)&session->channels, &session->channelssize, channel))
+        return;
+
+    // 1. Close socket
+    if (channel->socket != rbm_socket_invalid) {
+        // Poller is already freed, when tunnel is not running
+        if (session->poller)
+            rbm_poller_remove(session->poller, channel->socket);
+
+        rbm_socket_close(channel->socket);
+        channel->socket = rbm_socket_invalid;
+    }
+
+    // 2. Free transport channel
+    if (channel->channel) {
+        session->transport.channel_free(session->transport.context, channel->channel);
+        channel->channel = NULL;
+    } else {
+        session->openingchannels--;
+    }
+
+    // 3. Free buffers and channel struct
+    rbm_ringbuf_free(&channel->tosocket);
+    rbm_ringbuf_free(&channel->toupstream);
+    free(channel);
+
+    ssh_log_debug(session, "Channel closed");
+}
+
+//===----------------------------------------------------------------------===//
+// Client side
+//===----------------------------------------------------------------------===//
+
+static void read_from_client(struct rbm_channel *channel) {
+    while (!channel->clienteof && rbm_ringbuf_space(&channel->toupstream) > 0) {
+        int len;
+        char *ptr = rbm_ringbuf_write_ptr(&channel->toupstream, &len);
+
+        int rc = recv(channel->socket, ptr, len, 0);
+        if (rc > 0) {
+            rbm_ringbuf_commit(&channel->toupstream, rc);
+            ssh_log_debug(channel->session, "Received %d bytes from client", rc);
+
+            // Short read means that socket is drained
+            if (rc < len)
+                break;
+
+            continue;
+        }
+
+        if (rc == 0) {
+            // Normal situation
+            channel->clienteof = 1;
+            ssh_log_debug(channel->session, "Client disconnected");
+        } else if (!rbm_socket_would_block()) {
+            channel->failed = 1;
+            ssh_log_error(channel->session, "Error when recv()");
+        }
+        break;
+    }
+}
+
+static void write_to_client(struct rbm_channel *channel) {
+    while (!rbm_ringbuf_empty(&channel->tosocket)) {
+        int len;
+        char *ptr = rbm_ringbuf_read_ptr(&channel->tosocket, &len);
+
+        int rc = send(channel->socket, ptr, len, 0);
+        if (rc > 0) {
+            rbm_ringbuf_consume(&channel->tosocket, rc);
+            continue;
+        }
+
+        if (rc < 0 && !rbm_socket_would_block()) {
+            channel->failed = 1;
+            ssh_log_error(channel->session, "Failure to write data to client");
+        }
+        break;
+    }
+}
+
+static void accept_clients(struct rbm_session *session) {
+    while (1) {
+        struct sockaddr_in remoteaddr;
+        socklen_t slen = sizeof(remoteaddr);
+
+        rbm_socket_t newfd = accept(session->localsocket, (struct sockaddr *) &remoteaddr, &slen);
+        if (newfd == rbm_socket_invalid) {
+            // Client may also reset connection before it is accepted,
+            // the listening socket stays usable in both cases
+            if (!rbm_socket_would_block())
+                ssh_log_error(session, "Error on accept()");
+            return;
+        }
+
+        // Wake up connection of rbm_tunnel_stop()
+        if (session->stopping) {
+            rbm_socket_close(newfd);
+            return;
+        }
+
+        ssh_log_debug(session, "New connection from %s on socket %d", inet_ntoa(remoteaddr.sin_addr), newfd);
+
+        // Nagle's algorithm only delays small replies, failure is not fatal
+        rbm_socket_set_nodelay(newfd);
+
+        struct rbm_channel *channel = NULL;
+        if (rbm_socket_set_nonblocking(newfd) == RBM_SUCCESS)
+            channel = rbm_channel_create(session, newfd);
+
+        if (!channel) {
+            ssh_log_error(session, "Failed to setup client connection");
+            rbm_socket_close(newfd);
+            continue;
+        }
+
+        // Start opening of transport channel right away
+        pump_channel(channel);
+        finish_channel(channel);
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// Upstream side
+//===----------------------------------------------------------------------===//
+
+/*
+ * Moves data between channel buffers, transport and client socket.
+ * Returns number of bytes moved. Errors of this channel only mark it
+ * failed, so that finish_channel() closes it and other clients are served.
+ */
+static int pump_channel(struct rbm_channel *channel) {
+    struct rbm_session *session = channel->session;
+    struct rbm_transport *transport = &session->transport;
+    int moved = 0;
+
+    if (channel->failed)
+        return 0;
+
+    if (!channel->channel) {
+        int err = RBM_SUCCESS;
+        channel->channel = transport->channel_open(transport->context, &err);
+        if (!channel->channel) {
+            if (err != RBM_AGAIN) {
+                ssh_log_error(session, "Failed to create SSH channel");
+                channel->failed = 1;
+                return 0;
+            }
+
+            if (rbm_time_ms() - channel->openstarted > RBM_CHANNEL_OPEN_TIMEOUT_MS) {
+                ssh_log_error(session, "Failed to create SSH channel: timeout");
+                channel->failed = 1;
+                return 0;
+            }
+
+            return 0;
+        }
+
+        session->openingchannels--;
+        ssh_log_debug(session, "Channel successfully created!");
+    }
+
+    // Upstream -> client, only while there is free space (backpressure)
+    while (!channel->upstreameof && rbm_ringbuf_space(&channel->tosocket) > 0) {
+        int len;
+        char *ptr = rbm_ringbuf_write_ptr(&channel->tosocket, &len);
+
+        int rc = transport->channel_read(transport->context, channel->channel, ptr, len);
+        if (rc == RBM_AGAIN)
+            break;
+
+        if (rc < 0) {
+            ssh_log_error(session, "Failed to read from SSH channel");
+            channel->failed = 1;
+            return moved;
+        }
+
+        if (rc == 0) {
+            channel->upstreameof = 1;
+            ssh_log_debug(session, "The server at %s:%d disconnected!",
+                          session->config->remotehost, session->config->remoteport);
+            break;
+        }
+
+        rbm_ringbuf_commit(&channel->tosocket, rc);
+        moved += rc;
+        ssh_log_debug(session, "Received %d bytes from tunnel", rc);
+    }
+
+    // Client -> upstream
+    while (!channel->upstreameof && !rbm_ringbuf_empty(&channel->toupstream)) {
+        int len;
+        char *ptr = rbm_ringbuf_read_ptr(&channel->toupstream, &len);
+
+        int rc = transport->channel_write(transport->context, channel->channel, ptr, len);
+        if (rc == RBM_AGAIN)
+            break;
+
+        if (rc < 0) {
+            ssh_log_error(session, "Failed to write to SSH channel");
+            channel->failed = 1;
+            return moved;
+        }
+
+        rbm_ringbuf_consume(&channel->toupstream, rc);
+        moved += rc;
+        ssh_log_debug(session, "Written %d bytes to tunnel", rc);
+    }
+
+    // Most of the time client socket is writable, so do not wait for the poller
+    write_to_client(channel);
+
+    // Upstream is gone, nobody will read the rest
+    if (channel->upstreameof)
+        rbm_ringbuf_consume(&channel->toupstream, channel->toupstream.size);
+
+    return moved;
+}
+
+/*
+ * Closes channel, if it is done, or updates events we are waiting for.
+ * Returns 1 if channel was closed.
+ */
+static int finish_channel(struct rbm_channel *channel) {
+    int done = channel->failed
+        || (channel->clienteof && rbm_ringbuf_empty(&channel->toupstream))
+        || (channel->upstreameof && rbm_ringbuf_empty(&channel->tosocket));
+
+    if (!done) {
+        int events = 0;
+        if (!channel->clienteof && rbm_ringbuf_space(&channel->toupstream) > 0)
+            events |= RBM_POLL_IN;
+        if (!rbm_ringbuf_empty(&channel->tosocket))
+            events |= RBM_POLL_OUT;
+
+        if (events == channel->events)
+            return 0;
+
+        if (rbm_poller_modify(channel->session->poller, channel->socket, events, channel) == RBM_SUCCESS) {
+            channel->events = events;
+            return 0;
+        }
+
+        ssh_log_error(channel->session, "Failed to update client socket in poller");
+    }
+
+    rbm_channel_close(channel);
+    return 1;
+}
+
+/*
+ * Pumps channels that can make progress without waiting for the poller:
+ * with data (or EOF) queued by transport, and, after transport socket
+ * became ready, those that are being opened or wait to write.
+ */
+static int sweep_channels(struct rbm_session *session, int transportready) {
+    struct rbm_transport *transport = &session->transport;
+    int progress;
+
+    if (transportready && session->channelssize > 0) {
+        if (transport->receive(transport->context)) {
+            ssh_log_error(session, "Failed to read from SSH socket");
+            return RBM_ERROR;
+        }
+    }
+
+    do {
+        progress = 0;
+
+        // Backwards, because channels may be closed (and removed) in the loop
+        for (int i = session->channelssize - 1; i >= 0; i--) {
+            struct rbm_channel *channel = session->channels[i];
+
+            int pending;
+            if (!channel->channel)
+                pending = transportready;
+            else
+                pending = (transportready && !rbm_ringbuf_empty(&channel->toupstream))
+                    || (!channel->upstreameof && rbm_ringbuf_space(&channel->tosocket) > 0
+                        && transport->channel_pending(transport->context, channel->channel));
+
+            if (!pending)
+                continue;
+
+            if (pump_channel(channel) > 0)
+                progress = 1;
+
+            finish_channel(channel);
+        }
+    } while (progress);
+
+    return RBM_SUCCESS;
+}
+
+static int update_transport(struct rbm_session *session, int *events, int *timeout) {
+    struct rbm_transport *transport = &session->transport;
+
+    *timeout = session->openingchannels > 0 ? RBM_OPEN_RETRY_MS : -1;
+    if (transport->keepalive) {
+        int next = transport->keepalive(transport->context);
+        if (next < 0) {
+            ssh_log_error(session, "Failed to send keepalive message");
+            return RBM_ERROR;
+        }
+
+        if (next > 0 && (*timeout < 0 || next < *timeout))
+            *timeout = next;
+    }
+
+    // Without channels nobody reads the transport socket, so do not wait for it
+    int newevents = session->channelssize > 0 ? RBM_POLL_IN : 0;
+    if (transport->want_write(transport->context))
+        newevents |= RBM_POLL_OUT;
+
+    if (newevents == *events)
+        return RBM_SUCCESS;
+
+    if (rbm_poller_modify(session->poller, transport->socket, newevents, transport)) {
+        ssh_log_error(session, "Failed to update SSH socket in poller");
+        return RBM_ERROR;
+    }
+
+    *events = newevents;
+    return RBM_SUCCESS;
+}
+
+//===----------------------------------------------------------------------===//
+// Event loop
+//===----------------------------------------------------------------------===//
+
+static int tunnel_loop(struct rbm_session *session) {
+    struct rbm_transport *transport = &session->transport;
+    struct rbm_poller_event events[RBM_MAX_EVENTS];
+    int transportevents = 0;
+    int timeout = -1;
+
+    if (rbm_socket_set_nonblocking(session->localsocket) ||
+        rbm_poller_add(session->poller, session->localsocket, RBM_POLL_IN, &session->localsocket) ||
+        rbm_poller_add(session->poller, transport->socket, transportevents, transport)) {
+        ssh_log_error(session, "Failed to register sockets in poller");
+        return RBM_ERROR;
+    }
+
+    if (update_transport(session, &transportevents, &timeout))
+        return RBM_ERROR;
+
+    // Tunnel is shared by all connections (i.e. of every shell tab), so it is kept
+    // open even without clients, until rbm_tunnel_stop() is called
+    while (!session->stopping) {
+        int count = rbm_poller_wait(session->poller, events, RBM_MAX_EVENTS, timeout);
+        if (count < 0) {
+            ssh_log_error(session, "Error on waiting for socket events");
+            return RBM_ERROR;
+        }
+
+        // On timeout retry opening of channels
+        int transportready = (count == 0);
+
+        for (int i = 0; i < count; i++) {
+            struct rbm_poller_event *event = &events[i];
+
+            if (event->data == &session->localsocket) {
+                accept_clients(session);
+                continue;
+            }
+
+            if (event->data == transport) {
+                transportready = 1;
+                continue;
+            }
+
+            struct rbm_channel *channel = event->data;
+            if (event->events & (RBM_POLL_IN | RBM_POLL_ERR))
+                read_from_client(channel);
+
+            // Error or hang up, but we cannot read anything
+            if ((event->events & RBM_POLL_ERR) && !(channel->events & RBM_POLL_IN))
+                channel->failed = 1;
+
+            if (event->events & RBM_POLL_OUT)
+                write_to_client(channel);
+
+            pump_channel(channel);
+            finish_channel(channel);
+        }
+
+        int rc = sweep_channels(session, transportready);
+        if (rc < 0)
+            return rc;
+
+        if (update_transport(session, &transportevents, &timeout))
+            return RBM_ERROR;
+    }
+
+    return RBM_SUCCESS;
+}
+
+/*
+ * Forwards connections, accepted on session->localsocket, through transport
+ * until rbm_tunnel_stop() is called.
+ * Failures of single client connections (accept, channel open, read or
+ * write) close only that connection. Returns 0 if succeeded, or RBM_ERROR
+ * for errors of the transport session itself.
+ */
+int rbm_tunnel_run(struct rbm_session *session) {
+    session->poller = rbm_poller_create();
+    if (!session->poller) {
+        ssh_log_error(session, "Failed to create poller");
+        return RBM_ERROR;
+    }
+
+    int rc = tunnel_loop(session);
+    if (rc == RBM_ERROR)
+        ssh_log_warn(session, "SSH tunnel shutdown because of error");
+
+    rbm_poller_free(session->poller);
+    session->poller = NULL;
+    return rc;
+}
+
+/*
+ * Asks rbm_tunnel_run() to return. Can be called from any thread: sets the
+ * flag and wakes up the poller by connecting to our own listening socket.
+ */
+int rbm_tunnel_stop(struct rbm_session *session) {
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+
+    session->stopping = 1;
+
+    if (getsockname(session->localsocket, (struct sockaddr *) &addr, &addrlen))
+        return RBM_ERROR;
+
+    if (addr.sin_addr.s_addr == htonl(INADDR_ANY))
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    rbm_socket_t sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == rbm_socket_invalid)
+        return RBM_ERROR;
+
+    int rc = connect(sock, (struct sockaddr *) &addr, addrlen) == 0 ? RBM_SUCCESS : RBM_ERROR;
+    rbm_socket_close(sock);
+    return rc;
+}